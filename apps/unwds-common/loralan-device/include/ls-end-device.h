@@ -210,6 +210,10 @@ typedef struct {
 	ls_frame_t current_frame;
 	mutex_t curr_frame_mutex; /**< Mutex on current frame */
 
+	/* Expanded keys, set up again only when the keys in use change */
+	ls_crypto_session_t session;
+	mutex_t session_mutex; /**< Mutex on the session, used from the RX and TX threads */
+
 	int16_t last_rssi;		  /**< RSSI value of the last frame received */
     
     bool last_cad_success;     /**< last Channel Activity Detection result */
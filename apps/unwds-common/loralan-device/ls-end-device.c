@@ -68,6 +68,40 @@ static msg_t msg_ack_timeout;
 
 static ls_ed_t *p_ls;
 
+/* Locks the session and sets it up for the network keys or the join key */
+static ls_crypto_session_t *session_lock(ls_ed_t *ls, bool join)
+{
+    mutex_lock(&ls->_internal.session_mutex);
+
+    if (join) {
+        ls_crypto_session_update(&ls->_internal.session, ls->settings.crypto.join_key, ls->settings.crypto.join_key);
+    }
+    else {
+        ls_crypto_session_update(&ls->_internal.session, ls->settings.crypto.mic_key, ls->settings.crypto.aes_key);
+    }
+
+    return &ls->_internal.session;
+}
+
+static void session_unlock(ls_ed_t *ls)
+{
+    mutex_unlock(&ls->_internal.session_mutex);
+}
+
+static bool validate_mic(ls_ed_t *ls, ls_frame_t *frame, bool join)
+{
+    bool valid = ls_session_validate_frame_mic(session_lock(ls, join), frame);
+    session_unlock(ls);
+
+    return valid;
+}
+
+static void decrypt_payload(ls_ed_t *ls, ls_frame_t *frame, bool join)
+{
+    ls_session_decrypt_frame_payload(session_lock(ls, join), frame);
+    session_unlock(ls);
+}
+
 static void configure_sx127x(ls_ed_t *ls)
 {
     ls_datarate_t dr = (!ls->_internal.use_rx_window_2_settings) ? ls->settings.dr : LS_RX2_DR;
@@ -334,12 +368,12 @@ static bool frame_recv(ls_ed_t *ls, ls_frame_t *frame)
             return false;
         }
 
-        if (!ls_validate_frame_mic(ls->settings.crypto.mic_key, frame)) {
+        if (!validate_mic(ls, frame, false)) {
             DEBUG("[LoRa] invalid MIC\n");
             return false;
         }
     } else {
-        if (!ls_validate_frame_mic(ls->settings.crypto.join_key, frame)) {
+        if (!validate_mic(ls, frame, true)) {
             DEBUG("[LoRa] invalid MIC\n");
             return false;
         }
@@ -350,7 +384,7 @@ static bool frame_recv(ls_ed_t *ls, ls_frame_t *frame)
     		/* Validate and decipher incoming broadcast message */
             DEBUG("[LoRa] broadcast message\n");
             
-            ls_decrypt_frame_payload(ls->settings.crypto.join_key, frame);
+            decrypt_payload(ls, frame, true);
 
             /* Notify application code about incoming data */
             if (ls->broadcast_appdata_received_cb != NULL) {
@@ -372,7 +406,7 @@ static bool frame_recv(ls_ed_t *ls, ls_frame_t *frame)
             }
 
             DEBUG("[LoRa] decrypting payload\n");
-            ls_decrypt_frame_payload(ls->settings.crypto.aes_key, frame);
+            decrypt_payload(ls, frame, false);
 
             bool close_rx_window = ack_recv(ls, frame);
             data_recv(ls, frame);
@@ -395,7 +429,7 @@ static bool frame_recv(ls_ed_t *ls, ls_frame_t *frame)
         case LS_DL:         /* Downlink frame */
             DEBUG("[LoRa] donwlink frame received\n");
             DEBUG("[LoRa] decrypting payload\n");
-            ls_decrypt_frame_payload(ls->settings.crypto.aes_key, frame);
+            decrypt_payload(ls, frame, false);
 
             data_recv(ls, frame);
             return true;
@@ -414,7 +448,7 @@ static bool frame_recv(ls_ed_t *ls, ls_frame_t *frame)
             }
 
             DEBUG("[LoRa] decrypting payload\n");
-            ls_decrypt_frame_payload(ls->settings.crypto.join_key, frame);
+            decrypt_payload(ls, frame, true);
 
             ls_join_ack_t ack = { 0 };
             memcpy(&ack, frame->payload.data, sizeof(ls_join_ack_t));
@@ -482,7 +516,7 @@ static bool frame_recv(ls_ed_t *ls, ls_frame_t *frame)
             }
 
             DEBUG("[LoRa] decrypting payload\n");
-            ls_decrypt_frame_payload(ls->settings.crypto.join_key, frame);
+            decrypt_payload(ls, frame, true);
 
             /* Check device ID */
             ls_invite_t ack;
@@ -509,7 +543,7 @@ static bool frame_recv(ls_ed_t *ls, ls_frame_t *frame)
         }
         
         case LS_DL_TIME_ACK: {
-            ls_decrypt_frame_payload(ls->settings.crypto.aes_key, frame);
+            decrypt_payload(ls, frame, false);
 
             ls_time_req_ack_t ack;
             memcpy(&ack, frame->payload.data, sizeof(ls_time_req_ack_t));
@@ -770,12 +804,13 @@ static void *uq_handler(void *arg)
         /* Apply cryptography procedures */
         if (f->header.type != LS_UL_JOIN_REQ) {
             DEBUG("[LoRa] encrypt regular frame\n");
-            ls_encrypt_frame(ls->settings.crypto.mic_key, ls->settings.crypto.aes_key, f, &payload_size);
+            ls_session_encrypt_frame(session_lock(ls, false), f, &payload_size);
         }
         else {
             DEBUG("[LoRa] encrypt join request\n");
-            ls_encrypt_frame(ls->settings.crypto.join_key, ls->settings.crypto.join_key, f, &payload_size);
+            ls_session_encrypt_frame(session_lock(ls, true), f, &payload_size);
         }
+        session_unlock(ls);
         /* Listen Before Talk with LoRa CAD support */
         /* delays between CAD requests */
         int delay_ms = 5 + ((100 + 10*ls->settings.dr) >> ls->settings.dr);
@@ -1023,6 +1058,8 @@ int ls_ed_init(ls_ed_t *ls)
     }
 
     mutex_init(&p_ls->_internal.curr_frame_mutex);
+    mutex_init(&p_ls->_internal.session_mutex);
+    p_ls->_internal.session.valid = false;
     memset(&p_ls->status, 0, sizeof(ls_device_status_t));
 
     /* Initialize appdata queue */
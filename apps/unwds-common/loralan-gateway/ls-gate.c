@@ -50,11 +50,25 @@ extern "C" {
 #include <stdint.h>
 
 #define SX127X_LORA_MSG_QUEUE   (16U)
-#define SX127X_STACKSIZE        (2*THREAD_STACKSIZE_DEFAULT)
+/* MIC validation of a batch of frames keeps a SHA-256 lane per frame on the stack */
+#define SX127X_STACKSIZE        (3*THREAD_STACKSIZE_DEFAULT)
 #define MSG_TYPE_ISR            (0x3456)
 static char isr_stack[SX127X_STACKSIZE];
 static kernel_pid_t isr_pid;
 
+/* Frames received while further radio events are queued are validated together */
+#ifndef LS_GATE_RX_BATCH
+#define LS_GATE_RX_BATCH        (SHA256_MB_LANES)
+#endif
+
+typedef struct {
+    ls_gate_channel_t *ch;
+    uint8_t data[LS_FRAME_SIZE];
+} rx_frame_t;
+
+static rx_frame_t rx_batch[LS_GATE_RX_BATCH];
+static unsigned rx_batch_len;
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -293,7 +307,7 @@ static void app_data_recv(ls_gate_t *ls, ls_gate_channel_t *ch, ls_gate_node_t *
     ls->app_data_received_cb(node, ch, frame->payload.data, frame->payload.len, frame->header.status);
 }
 
-static bool frame_recv(ls_gate_t *ls, ls_gate_channel_t *ch, ls_frame_t *frame)
+static bool frame_recv(ls_gate_t *ls, ls_gate_channel_t *ch, ls_frame_t *frame, uint8_t *aes_key, bool mic_valid)
 {
     DEBUG("ls-gate: frame received\n");
     
@@ -308,18 +322,12 @@ static bool frame_recv(ls_gate_t *ls, ls_gate_channel_t *ch, ls_frame_t *frame)
     	}
     }
 
-    /* Derive cryptographic keys */
-    uint8_t mic_key[AES_BLOCK_SIZE];
-    uint8_t aes_key[AES_BLOCK_SIZE];
-
     if (node) {
         /* Update node's last seen time */
         node->last_seen = ls->_internal.ping_count;
-        
-        ls_derive_keys(node->nonce[node->num_nonces - 1], node->app_nonce, node->addr, mic_key, aes_key);
 
         /* Validate frame MIC */
-        if (!ls_validate_frame_mic(mic_key, frame)) {
+        if (!mic_valid) {
             DEBUG("ls-gate: MIC validation failed\n");
             return false;
         }
@@ -469,7 +477,7 @@ static bool frame_recv(ls_gate_t *ls, ls_gate_channel_t *ch, ls_frame_t *frame)
                 return false;
             }
 
-            if (!ls_validate_frame_mic(ls->settings.join_key, frame)) {
+            if (!mic_valid) {
                 DEBUG("ls-gate: MIC validation failed\n");
                 return false;
             }
@@ -520,6 +528,70 @@ static bool frame_recv(ls_gate_t *ls, ls_gate_channel_t *ch, ls_frame_t *frame)
     }
 }
 
+/**
+ * Derives the keys of a received frame, returns its MIC key or NULL if it has none.
+ */
+static const uint8_t *frame_keys(ls_gate_t *ls, ls_frame_t *frame, uint8_t *mic_key, uint8_t *aes_key)
+{
+    if (frame->header.dev_addr == LS_ADDR_UNDEFINED) {
+        return (frame->header.type == LS_UL_JOIN_REQ) ? ls->settings.join_key : NULL;
+    }
+
+    ls_gate_node_t *node = ls_devlist_get(&ls->devices, frame->header.dev_addr);
+    if (node == NULL) {
+        return NULL;
+    }
+
+    ls_derive_keys(node->nonce[node->num_nonces - 1], node->app_nonce, node->addr, mic_key, aes_key);
+    return mic_key;
+}
+
+/**
+ * Validates the MICs of the frames received so far and processes them in order.
+ *
+ * The keys are derived before any frame of the batch is processed. A node can't
+ * use keys of a join handled in the same batch, it learns them from the join ack.
+ */
+static void rx_batch_flush(void)
+{
+    uint8_t mic_keys[LS_GATE_RX_BATCH][AES_BLOCK_SIZE];
+    uint8_t aes_keys[LS_GATE_RX_BATCH][AES_BLOCK_SIZE];
+    const uint8_t *keys[LS_GATE_RX_BATCH];
+    ls_frame_t *frames[LS_GATE_RX_BATCH];
+    bool valid[LS_GATE_RX_BATCH];
+    unsigned idx[LS_GATE_RX_BATCH];
+    unsigned num = 0;
+
+    for (unsigned i = 0; i < rx_batch_len; i++) {
+        ls_gate_t *ls = (ls_gate_t *) rx_batch[i].ch->_internal.gate;
+        ls_frame_t *frame = (ls_frame_t *) rx_batch[i].data;
+        const uint8_t *key = frame_keys(ls, frame, mic_keys[i], aes_keys[i]);
+
+        if (key != NULL) {
+            keys[num] = key;
+            frames[num] = frame;
+            idx[num++] = i;
+        }
+    }
+
+    bool mic_valid[LS_GATE_RX_BATCH] = { false };
+
+    ls_validate_frames_mic(keys, frames, valid, num);
+    for (unsigned n = 0; n < num; n++) {
+        mic_valid[idx[n]] = valid[n];
+    }
+
+    for (unsigned i = 0; i < rx_batch_len; i++) {
+        ls_gate_t *ls = (ls_gate_t *) rx_batch[i].ch->_internal.gate;
+
+        if (!frame_recv(ls, rx_batch[i].ch, (ls_frame_t *) rx_batch[i].data, aes_keys[i], mic_valid[i])) {
+            DEBUG("ls-gate: ls-gate: well-formed frame discarded\n");
+        }
+    }
+
+    rx_batch_len = 0;
+}
+
 static void sx127x_handler(netdev_t *dev, netdev_event_t event)
 {
     if (event == NETDEV_EVENT_ISR) {
@@ -536,7 +608,6 @@ static void sx127x_handler(netdev_t *dev, netdev_event_t event)
         case NETDEV_EVENT_RX_COMPLETE: {
             int len;
             netdev_lora_rx_info_t  packet_info;
-            ls_gate_t *ls = (ls_gate_t *) channel->_internal.gate;
             uint8_t message[LS_FRAME_SIZE];
             
             len = dev->driver->recv(dev, NULL, 0, 0);
@@ -563,14 +634,14 @@ static void sx127x_handler(netdev_t *dev, netdev_event_t event)
             
             channel->last_rssi = packet_info.rssi;
 
-            /* Copy packet's data as a frame to our stack */
-            ls_frame_t *frame = (ls_frame_t *) message;
-
-            /* Check frame format */
+            /* Check frame format, then copy it into the batch to be validated */
             if (ls_validate_frame(message, len)) {
-                if (!frame_recv(ls, channel, frame)) {
-                    DEBUG("ls-gate: ls-gate: well-formed frame discarded\n");
+                if (rx_batch_len == LS_GATE_RX_BATCH) {
+                    rx_batch_flush();
                 }
+                rx_batch[rx_batch_len].ch = channel;
+                memcpy(rx_batch[rx_batch_len].data, message, len);
+                rx_batch_len++;
             }
             else {
                 DEBUG("ls-gate: ls-gate: malformed data discarded\n");
@@ -632,6 +703,11 @@ void *isr_thread(void *arg)
         else {
             puts("[LoRa] isr_thread: unexpected msg type");
         }
+
+        /* Frames received in a burst are validated once the events are handled */
+        if (msg_avail() == 0) {
+            rx_batch_flush();
+        }
     }
 }
 
@@ -31,7 +31,10 @@
 #ifndef LS_CRYPTO_H_
 #define LS_CRYPTO_H_
 
+#include <stdbool.h>
+
 #include "crypto/aes.h"
+#include "hashes/sha256.h"
 #include "ls-mac-types.h"
 
 #define LS_MIC_KEY_LEN AES_KEY_SIZE
@@ -45,6 +48,84 @@ typedef struct {
 	uint8_t join_key[AES_KEY_SIZE];
 } ls_crypto_t;
 
+/**
+ * @brief Expanded keys of a session.
+ *
+ * The AES key schedule and the HMAC state after the MIC key are set up once
+ * and reused for every frame of the session.
+ */
+typedef struct {
+	uint8_t mic_key[LS_MIC_KEY_LEN];	/**< key the HMAC state was set up with */
+	uint8_t aes_key[AES_KEY_SIZE];		/**< key the AES schedule was expanded from */
+	hmac_sha256_key_t mic;				/**< HMAC states after the MIC key pads */
+	aes_schedule_t aes;					/**< expanded AES key */
+	bool valid;							/**< session has been set up */
+} ls_crypto_session_t;
+
+/**
+ * @brief Sets up a session for the specified keys
+ *
+ * @param	[OUT]	*session	the session to set up
+ * @param	[IN]	*key_mic	key for the MIC calculation
+ * @param	[IN]	*key_aes	key for the AES encryption
+ */
+void ls_crypto_session_init(ls_crypto_session_t *session, const uint8_t *key_mic, const uint8_t *key_aes);
+
+/**
+ * @brief Sets up a session again if it was not set up for the specified keys
+ *
+ * @param	[IN,OUT]	*session	the session to update
+ * @param	[IN]		*key_mic	key for the MIC calculation
+ * @param	[IN]		*key_aes	key for the AES encryption
+ */
+void ls_crypto_session_update(ls_crypto_session_t *session, const uint8_t *key_mic, const uint8_t *key_aes);
+
+/**
+ * @brief Calculates Message Integrity Code for the specified frame with the MIC key of a session
+ *
+ * @param	[IN]	*session		the session
+ * @param	[IN]	*frame			frame for which the MIC will be calculated
+ * @param	[IN]	payload_size	size of the frame payload
+ *
+ * @return MIC for the specified frame
+ */
+ls_mic_t ls_session_calculate_mic(const ls_crypto_session_t *session, ls_frame_t *frame, uint8_t payload_size);
+
+/**
+ * @brief Validates Message Integrity Code for the specified frame with the MIC key of a session
+ *
+ * @param	[IN]	*session	the session
+ * @param	[IN]	*frame		frame for which the MIC will be validated
+ *
+ * @return true if MIC is valid, false otherwise
+ */
+bool ls_session_validate_frame_mic(const ls_crypto_session_t *session, ls_frame_t *frame);
+
+/**
+ * @brief Encrypts payload of the specified frame with the AES key of a session
+ *
+ * @param	[IN]	*session	the session
+ * @param	[IN]	*frame		pointer to the frame to encrypt it's payload
+ */
+void ls_session_encrypt_frame_payload(const ls_crypto_session_t *session, ls_frame_t *frame);
+
+/**
+ * @brief Decrypts payload of the specified frame with the AES key of a session
+ *
+ * @param	[IN]	*session	the session
+ * @param	[IN]	*frame		pointer to the frame to decrypt it's payload
+ */
+void ls_session_decrypt_frame_payload(const ls_crypto_session_t *session, ls_frame_t *frame);
+
+/**
+ * @brief Encrypts frame payload and calculates frame's MIC with the keys of a session
+ *
+ * @param	[IN]	*session	the session
+ * @param	[IN]	*frame		the frame to work with
+ * @param	[OUT]	*newsize	new size of payload (resizes after encryption)
+ */
+void ls_session_encrypt_frame(const ls_crypto_session_t *session, ls_frame_t *frame, size_t *newsize);
+
 /**
  * @brief Calculates Message Integrity Code for the specified frame
  *
@@ -65,6 +146,19 @@ ls_mic_t ls_calculate_mic(uint8_t *key, ls_frame_t *frame, uint8_t payload_size)
  */
 bool ls_validate_frame_mic(uint8_t *key, ls_frame_t *frame);
 
+/**
+ * @brief Validates Message Integrity Codes of several frames at once
+ *
+ * Same as ls_validate_frame_mic() for each frame, but the HMACs of up to
+ * SHA256_MB_LANES frames are calculated side by side, see hmac_sha256_mb().
+ *
+ * @param	[IN]	keys	MIC key of each frame
+ * @param	[IN]	frames	frames for which the MICs will be validated
+ * @param	[OUT]	valid	true for each frame with a valid MIC, false otherwise
+ * @param	[IN]	num		number of frames
+ */
+void ls_validate_frames_mic(const uint8_t *const *keys, ls_frame_t *const *frames, bool *valid, size_t num);
+
 /**
  * @brief Encrypts payload of the specified frame with specified key.
  *
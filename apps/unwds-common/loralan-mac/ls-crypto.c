@@ -30,6 +30,7 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 
 #include "random.h"
 #include "assert.h"
@@ -58,26 +59,155 @@ typedef struct  __attribute__((packed)) {
 extern "C" {
 #endif
 
-ls_mic_t ls_calculate_mic(uint8_t *key, ls_frame_t *frame, uint8_t payload_size)
+/* Number of keystream blocks encrypted at once */
+#define LS_CRYPTO_BLOCKS    (4U)
+
+static const uint8_t *mic_data(const ls_frame_t *frame, uint8_t payload_size, size_t *size)
 {
+    /* Calculate amount of data to check. Skip MHDR and MIC fields */
+    *size = sizeof(ls_header_t) - 4 + sizeof(ls_payload_len_t) + payload_size;
+
     /* Get pointer to the frame data after MIC field */
-    uint8_t *ptr = ((uint8_t *) frame) + 4; /* Skip 1 byte of MHDR and 3 bytes of MIC */
+    return ((const uint8_t *) frame) + 4; /* Skip 1 byte of MHDR and 3 bytes of MIC */
+}
 
-    /* Calculate amount of data to check. Skip MHDR and MIC fields */
-    uint8_t size = sizeof(ls_header_t) - 4 + sizeof(ls_payload_len_t) + payload_size;
+static ls_mic_t mic_from_hmac(const unsigned char *hmac)
+{
+    /* Take first 3 bytes of hash as a MIC */
+    return (hmac[0] << 16)
+           | (hmac[1] << 8)
+           | (hmac[2]);
+}
+
+static ls_mic_t calculate_mic(hmac_context_t *ctx, ls_frame_t *frame, uint8_t payload_size)
+{
+    size_t size;
+    const uint8_t *ptr = mic_data(frame, payload_size, &size);
 
     /* SHA-256 HMAC result */
     unsigned char hmac[SHA256_DIGEST_LENGTH];
 
     /* Calculate HMAC */
-    hmac_sha256(key, LS_MIC_KEY_LEN, (unsigned *) ptr, size, hmac);
+    hmac_sha256_update(ctx, ptr, size);
+    hmac_sha256_final(ctx, hmac);
 
-    /* Take first 3 bytes of hash as a MIC */
-    ls_mic_t mic = (hmac[0] << 16)
-                   | (hmac[1] << 8)
-                   | (hmac[2]);
+    return mic_from_hmac(hmac);
+}
+
+static void encrypt_frame_payload(const aes_schedule_t *aes, ls_frame_t *frame)
+{
+    uint16_t size = frame->payload.len;
+
+    if (size == 0) {
+        return; /* Nothing to do with empty payload */
+    }
+
+    uint8_t s_blocks[LS_CRYPTO_BLOCKS * AES_BLOCK_SIZE];
+
+    lorawan_block_t a_block;
+    uint16_t ctr = 1;
 
-    return mic;
+    a_block.fb = 0x1;
+    a_block.u8_pad = 0;
+    a_block.dir = frame->header.type;
+    a_block.dev_addr = byteorder_btoll(byteorder_htonl(frame->header.dev_addr));
+    a_block.fcnt = byteorder_btoll(byteorder_htonl(frame->header.fid));
+    a_block.u32_pad = 0;
+
+    uint8_t *buffer = frame->payload.data;
+
+    while (size > 0) {
+        /* Encrypt the A blocks for up to LS_CRYPTO_BLOCKS blocks of payload at once */
+        unsigned nblocks = (size + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+        if (nblocks > LS_CRYPTO_BLOCKS) {
+            nblocks = LS_CRYPTO_BLOCKS;
+        }
+
+        for (unsigned n = 0; n < nblocks; n++) {
+            a_block.len = ((ctr) & 0xFF);
+            ctr++;
+            memcpy(s_blocks + n * AES_BLOCK_SIZE, &a_block, AES_BLOCK_SIZE);
+        }
+        aes_schedule_encrypt_blocks(aes, s_blocks, s_blocks, nblocks);
+
+        uint16_t len = nblocks * AES_BLOCK_SIZE;
+        if (len > size) {
+            len = size;
+        }
+        for (uint16_t i = 0; i < len; i++) {
+            buffer[i] = buffer[i] ^ s_blocks[i];
+        }
+
+        size -= len;
+        buffer += len;
+    }
+}
+
+void ls_crypto_session_init(ls_crypto_session_t *session, const uint8_t *key_mic, const uint8_t *key_aes)
+{
+    memcpy(session->mic_key, key_mic, LS_MIC_KEY_LEN);
+    memcpy(session->aes_key, key_aes, AES_KEY_SIZE);
+
+    hmac_sha256_key_init(&session->mic, key_mic, LS_MIC_KEY_LEN);
+    aes_schedule_init(&session->aes, key_aes, AES_KEY_SIZE);
+
+    session->valid = true;
+}
+
+void ls_crypto_session_update(ls_crypto_session_t *session, const uint8_t *key_mic, const uint8_t *key_aes)
+{
+    if (!session->valid ||
+        memcmp(session->mic_key, key_mic, LS_MIC_KEY_LEN) ||
+        memcmp(session->aes_key, key_aes, AES_KEY_SIZE)) {
+        ls_crypto_session_init(session, key_mic, key_aes);
+    }
+}
+
+ls_mic_t ls_session_calculate_mic(const ls_crypto_session_t *session, ls_frame_t *frame, uint8_t payload_size)
+{
+    /* Start from the state after the key */
+    hmac_context_t ctx;
+
+    hmac_sha256_init_key(&ctx, &session->mic);
+
+    return calculate_mic(&ctx, frame, payload_size);
+}
+
+bool ls_session_validate_frame_mic(const ls_crypto_session_t *session, ls_frame_t *frame)
+{
+    /* Compare MIC from header and actual */
+    ls_mic_t expected_mic = ls_session_calculate_mic(session, frame, frame->payload.len);
+    ls_mic_t actual_mic = frame->header.mic;
+
+    return actual_mic == expected_mic;
+}
+
+void ls_session_encrypt_frame_payload(const ls_crypto_session_t *session, ls_frame_t *frame)
+{
+    encrypt_frame_payload(&session->aes, frame);
+}
+
+void ls_session_decrypt_frame_payload(const ls_crypto_session_t *session, ls_frame_t *frame)
+{
+    encrypt_frame_payload(&session->aes, frame);
+}
+
+void ls_session_encrypt_frame(const ls_crypto_session_t *session, ls_frame_t *frame, size_t *newsize)
+{
+    *newsize = frame->payload.len;
+
+    encrypt_frame_payload(&session->aes, frame);
+
+    frame->header.mic = ls_session_calculate_mic(session, frame, *newsize);
+}
+
+ls_mic_t ls_calculate_mic(uint8_t *key, ls_frame_t *frame, uint8_t payload_size)
+{
+    hmac_context_t ctx;
+
+    hmac_sha256_init(&ctx, key, LS_MIC_KEY_LEN);
+
+    return calculate_mic(&ctx, frame, payload_size);
 }
 
 bool ls_validate_frame_mic(uint8_t *key, ls_frame_t *frame)
@@ -92,6 +222,37 @@ bool ls_validate_frame_mic(uint8_t *key, ls_frame_t *frame)
     return actual_mic == expected_mic;
 }
 
+void ls_validate_frames_mic(const uint8_t *const *keys, ls_frame_t *const *frames, bool *valid, size_t num)
+{
+    hmac_sha256_key_t mic[SHA256_MB_LANES];
+    unsigned char hmac[SHA256_MB_LANES][SHA256_DIGEST_LENGTH];
+    const void *data[SHA256_MB_LANES];
+    size_t size[SHA256_MB_LANES];
+    void *digest[SHA256_MB_LANES];
+
+    /* Up to one frame per lane, the key pads and then the frames are hashed side by side */
+    while (num > 0) {
+        size_t n = (num < SHA256_MB_LANES) ? num : SHA256_MB_LANES;
+
+        for (size_t i = 0; i < n; i++) {
+            data[i] = mic_data(frames[i], frames[i]->payload.len, &size[i]);
+            digest[i] = hmac[i];
+        }
+
+        hmac_sha256_key_init_mb(mic, (const void *const *) keys, LS_MIC_KEY_LEN, n);
+        hmac_sha256_mb(mic, data, size, digest, n);
+
+        for (size_t i = 0; i < n; i++) {
+            valid[i] = (frames[i]->header.mic == mic_from_hmac(hmac[i]));
+        }
+
+        keys += n;
+        frames += n;
+        valid += n;
+        num -= n;
+    }
+}
+
 void ls_encrypt_frame(uint8_t *key_mic, uint8_t *key_aes, ls_frame_t *frame, size_t *newsize)
 {
     *newsize = frame->payload.len;
@@ -108,51 +269,14 @@ void ls_encrypt_frame(uint8_t *key_mic, uint8_t *key_aes, ls_frame_t *frame, siz
 
 void ls_encrypt_frame_payload(uint8_t *key, ls_frame_t *frame)
 {
-	uint16_t size = frame->payload.len;
-
-    if (size == 0) {
+    if (frame->payload.len == 0) {
         return; /* Nothing to do with empty payload */
     }
 
-    uint8_t s_block[AES_BLOCK_SIZE] = { 0x00, };
+    aes_schedule_t aes;
 
-    lorawan_block_t a_block;
-    uint16_t i;
-    uint8_t buf_idx = 0;
-    uint16_t ctr = 1;
-
-    cipher_t context;
-
-    cipher_init(&context, CIPHER_AES_128, key, AES_KEY_SIZE);
-
-    a_block.fb = 0x1;
-    a_block.u8_pad = 0;
-    a_block.dir = frame->header.type;
-    a_block.dev_addr = byteorder_btoll(byteorder_htonl(frame->header.dev_addr));
-    a_block.fcnt = byteorder_btoll(byteorder_htonl(frame->header.fid));
-
-    uint8_t *buffer = frame->payload.data;
-
-    while (size >= AES_BLOCK_SIZE) {
-        a_block.len = ((ctr) & 0xFF);
-        ctr++;
-
-        cipher_encrypt(&context, (uint8_t *) &a_block, s_block);
-        for (i = 0; i < AES_BLOCK_SIZE; i++) {
-            buffer[buf_idx + i] = buffer[buf_idx + i] ^ s_block[i];
-        }
-
-        size -= AES_BLOCK_SIZE;
-        buf_idx += AES_BLOCK_SIZE;
-    }
-
-    if (size > 0) {
-        a_block.len = ((ctr) & 0xFF);
-        cipher_encrypt(&context, (uint8_t *) &a_block, s_block);
-        for (i = 0; i < size; i++) {
-            buffer[buf_idx + i] = buffer[buf_idx + i] ^ s_block[i];
-        }
-    }
+    aes_schedule_init(&aes, key, AES_KEY_SIZE);
+    encrypt_frame_payload(&aes, frame);
 }
 
 inline void ls_decrypt_frame_payload(uint8_t *key, ls_frame_t *frame)
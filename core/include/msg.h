@@ -231,6 +231,25 @@ int msg_send(msg_t *m, kernel_pid_t target_pid);
  */
 int msg_try_send(msg_t *m, kernel_pid_t target_pid);
 
+/**
+ * @brief Send a message (non-blocking) without switching to the receiver.
+ *
+ * Like msg_try_send(), but must be called with interrupts disabled and never
+ * yields, even if the receiver has a higher priority than the sender. This
+ * allows to wake up several receivers in one critical section and to call
+ * thread_yield_higher() once afterwards.
+ *
+ * @param[in] m             Pointer to preallocated ``msg_t`` structure, must
+ *                          not be NULL.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return 1, if sending was successful (message delivered directly or to a
+ *         queue)
+ * @return 0, if receiver is not waiting or has a full message queue
+ * @return -1, on error (invalid PID)
+ */
+int msg_try_send_noyield(msg_t *m, kernel_pid_t target_pid);
+
 
 /**
  * @brief Send a message to the current thread.
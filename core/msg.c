@@ -37,7 +37,8 @@
 #include "debug.h"
 
 static int _msg_receive(msg_t *m, int block);
-static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state);
+static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
+                     unsigned state, bool yield);
 
 static int queue_msg(thread_t *target, const msg_t *m)
 {
@@ -65,7 +66,7 @@ int msg_send(msg_t *m, kernel_pid_t target_pid)
     if (sched_active_pid == target_pid) {
         return msg_send_to_self(m);
     }
-    return _msg_send(m, target_pid, true, irq_disable());
+    return _msg_send(m, target_pid, true, irq_disable(), true);
 }
 
 int msg_try_send(msg_t *m, kernel_pid_t target_pid)
@@ -76,10 +77,19 @@ int msg_try_send(msg_t *m, kernel_pid_t target_pid)
     if (sched_active_pid == target_pid) {
         return msg_send_to_self(m);
     }
-    return _msg_send(m, target_pid, false, irq_disable());
+    return _msg_send(m, target_pid, false, irq_disable(), true);
 }
 
-static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state)
+int msg_try_send_noyield(msg_t *m, kernel_pid_t target_pid)
+{
+    /* interrupts are disabled already, the state restored is the same */
+    return _msg_send(m, target_pid, false, irq_disable(), false);
+}
+
+/* with yield == false, the sender keeps running even if the receiver is of
+ * higher priority, it must not block then */
+static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
+                     unsigned state, bool yield)
 {
 #ifdef DEVELHELP
     if (!pid_is_valid(target_pid)) {
@@ -89,7 +99,8 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
 
     thread_t *target = (thread_t*) sched_threads[target_pid];
 
-    m->sender_pid = sched_active_pid;
+    assert(yield || !block);
+    m->sender_pid = (!yield && irq_is_in()) ? KERNEL_PID_ISR : sched_active_pid;
 
     if (target == NULL) {
         DEBUG("msg_send(): target thread does not exist\n");
@@ -113,7 +124,7 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
                   " has a msg_queue. Queueing message.\n", RIOT_FILE_RELATIVE,
                   __LINE__, target_pid);
             irq_restore(state);
-            if (me->status == STATUS_REPLY_BLOCKED) {
+            if (yield && (me->status == STATUS_REPLY_BLOCKED)) {
                 thread_yield_higher();
             }
             return 1;
@@ -165,7 +176,9 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
         sched_set_status(target, STATUS_PENDING);
 
         irq_restore(state);
-        thread_yield_higher();
+        if (yield) {
+            thread_yield_higher();
+        }
     }
 
     return 1;
@@ -229,7 +242,7 @@ int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
      * overwritten if the target is not in RECEIVE_BLOCKED */
     *reply = *m;
     /* msg_send blocks until reply received */
-    return _msg_send(reply, target_pid, true, state);
+    return _msg_send(reply, target_pid, true, state, true);
 }
 
 int msg_reply(msg_t *m, msg_t *reply)
@@ -22,6 +22,7 @@ PSEUDOMODULES += gnrc_ipv6_nib_dns
 PSEUDOMODULES += gnrc_ipv6_nib_router
 PSEUDOMODULES += gnrc_netdev_default
 PSEUDOMODULES += gnrc_neterr
+PSEUDOMODULES += gnrc_netapi_burst
 PSEUDOMODULES += gnrc_netapi_callbacks
 PSEUDOMODULES += gnrc_netapi_mbox
 PSEUDOMODULES += gnrc_netif_shell
@@ -29,11 +30,13 @@ PSEUDOMODULES += gnrc_pktbuf_cmd
 PSEUDOMODULES += gnrc_sixloenc
 PSEUDOMODULES += gnrc_sixlowpan_border_router_default
 PSEUDOMODULES += gnrc_sixlowpan_default
+PSEUDOMODULES += gnrc_sixlowpan_frag_vrb
 PSEUDOMODULES += gnrc_sixlowpan_iphc_nhc
 PSEUDOMODULES += gnrc_sixlowpan_nd_border_router
 PSEUDOMODULES += gnrc_sixlowpan_router
 PSEUDOMODULES += gnrc_sixlowpan_router_default
 PSEUDOMODULES += gnrc_sock_check_reuse
+PSEUDOMODULES += gnrc_tcp_pacing
 PSEUDOMODULES += gnrc_txtsnd
 PSEUDOMODULES += l2filter_blacklist
 PSEUDOMODULES += l2filter_whitelist
@@ -68,6 +71,7 @@ PSEUDOMODULES += saul_gpio
 PSEUDOMODULES += schedstatistics
 PSEUDOMODULES += shell_password
 PSEUDOMODULES += sock
+PSEUDOMODULES += sock_dns_cache
 PSEUDOMODULES += sock_ip
 PSEUDOMODULES += sock_tcp
 PSEUDOMODULES += sock_udp
@@ -142,5 +146,21 @@ PSEUDOMODULES += ds18_optimized
 PSEUDOMODULES += crypto_aes_precalculated
 # This pseudomodule causes a loop in AES to be unrolled (more flash, less CPU)
 PSEUDOMODULES += crypto_aes_unroll
+# AES encryption with the AES instructions of x86 CPUs, where available
+PSEUDOMODULES += crypto_aes_ni
+# Constant-time bitsliced AES encryption instead of the T tables
+PSEUDOMODULES += crypto_aes_ct
+# GHASH of GCM with the carry-less multiply instruction of x86 CPUs
+PSEUDOMODULES += crypto_gcm_pclmul
+# Eight ChaCha blocks side by side with SSE2 or AVX2 on x86 CPUs
+PSEUDOMODULES += crypto_chacha_simd
+# Unrolled rounds of SHA-256 (more flash, less CPU)
+PSEUDOMODULES += hashes_sha256_unroll
+# SHA-256 with the SHA instructions of x86 CPUs, where available
+PSEUDOMODULES += hashes_sha256_ni
+# CRC-32 with the carry-less multiply instruction of x86 CPUs
+PSEUDOMODULES += checksum_crc32_pclmul
+# CRC-32C with the crc32 instruction of x86 CPUs (SSE 4.2)
+PSEUDOMODULES += checksum_crc32c_sse42
 
 # Packages may also add modules to PSEUDOMODULES in their `Makefile.include`.
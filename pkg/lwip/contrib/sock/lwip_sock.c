@@ -485,10 +485,19 @@ int lwip_sock_recv(struct netconn *conn, uint32_t timeout, struct netbuf **buf)
 
 ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
                        int proto, const struct _sock_tl_ep *remote, int type)
+{
+    iolist_t snip = { .iol_base = (void *)data, .iol_len = len };
+
+    return lwip_sock_sendv(conn, &snip, proto, remote, type);
+}
+
+ssize_t lwip_sock_sendv(struct netconn **conn, const iolist_t *snips,
+                        int proto, const struct _sock_tl_ep *remote, int type)
 {
     ip_addr_t remote_addr;
     struct netconn *tmp;
     struct netbuf *buf;
+    size_t len = 0;
     int res;
     err_t err;
     u16_t remote_port = 0;
@@ -507,12 +516,24 @@ ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
         }
     }
 
+    for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+        assert((snip->iol_len == 0) || (snip->iol_base != NULL));
+        len += snip->iol_len;
+    }
     buf = netbuf_new();
-    if ((buf == NULL) || (netbuf_alloc(buf, len) == NULL) ||
-        (netbuf_take(buf, data, len) != ERR_OK)) {
+    if ((buf == NULL) || (netbuf_alloc(buf, len) == NULL)) {
         netbuf_delete(buf);
         return -ENOMEM;
     }
+    len = 0;
+    for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+        if (pbuf_take_at(buf->p, snip->iol_base, snip->iol_len,
+                         len) != ERR_OK) {
+            netbuf_delete(buf);
+            return -ENOMEM;
+        }
+        len += snip->iol_len;
+    }
     if (((conn == NULL) || (*conn == NULL)) && (remote != NULL)) {
         if ((res = _create(type, proto, 0, &tmp)) < 0) {
             netbuf_delete(buf);
@@ -541,7 +562,10 @@ ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
     }
 #if LWIP_TCP
     else if (tmp->type & NETCONN_TCP) {
-        err = netconn_write_partly(tmp, data, len, 0, (size_t *)(&res));
+        /* sock_tcp only ever passes a single buffer */
+        assert(snips->iol_next == NULL);
+        err = netconn_write_partly(tmp, snips->iol_base, len, 0,
+                                   (size_t *)(&res));
     }
 #endif /* LWIP_TCP */
     else {
@@ -32,6 +32,10 @@
 #include "lptimer.h"
 #endif
 
+#ifdef MODULE_CRYPTO_BACKEND
+#include "crypto/backend.h"
+#endif
+
 #ifdef MODULE_GNRC_SIXLOWPAN
 #include "net/gnrc/sixlowpan.h"
 #endif
@@ -105,6 +109,10 @@ void auto_init(void)
     DEBUG("Auto init xtimer module.\n");
     xtimer_init();
 #endif
+#ifdef MODULE_CRYPTO_BACKEND
+    DEBUG("Auto init crypto_backend module.\n");
+    crypto_backend_init();
+#endif
 #ifdef MODULE_LPTIMER
     DEBUG("Auto init lptimer module.\n");
     lptimer_init();
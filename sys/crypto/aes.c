@@ -38,6 +38,23 @@
 #include <stdint.h>
 #include "crypto/aes.h"
 #include "crypto/ciphers.h"
+#ifdef MODULE_CRYPTO_BACKEND
+#include "crypto/backend.h"
+#endif
+
+#if defined(MODULE_CRYPTO_AES_NI) && (defined(__x86_64__) || defined(__i386__))
+#include <wmmintrin.h>
+#include "x86_cpu_features.h"
+#endif
+
+#ifdef MODULE_TINYCRYPT
+#include "kernel_defines.h"
+#include "tinycrypt/aes.h"
+#endif
+
+#if defined(MODULE_CRYPTO_AES_CT) && defined(MODULE_CRYPTO_AES_PRECALCULATED)
+#error "crypto_aes_ct does not use the precalculated encryption tables"
+#endif
 
 /**
  * Interface to the aes cipher
@@ -47,7 +64,8 @@ static const cipher_interface_t aes_interface = {
     AES_KEY_SIZE,
     aes_init,
     aes_encrypt,
-    aes_decrypt
+    aes_decrypt,
+    aes_encrypt_blocks
 };
 const cipher_id_t CIPHER_AES_128 = &aes_interface;
 
@@ -1019,23 +1037,14 @@ static int aes_set_decrypt_key(const unsigned char *userKey, const int bits,
 #endif /* AES_NO_DECRYPTION */
 
 #ifndef AES_ASM
+#ifndef MODULE_CRYPTO_AES_CT
 /*
- * Encrypt a single block
+ * Encrypt a single block with the T tables
  * in and out can overlap
  */
-int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
-                uint8_t *cipherBlock)
+static void aes_encrypt_block(const AES_KEY *key, const uint8_t *plainBlock,
+                              uint8_t *cipherBlock)
 {
-    /* setup AES_KEY */
-    int res;
-    AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-    res = aes_set_encrypt_key((unsigned char *)context->context,
-                                   AES_KEY_SIZE * 8, &aeskey);
-    if (res < 0) {
-        return res;
-    }
-
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef MODULE_CRYPTO_AES_UNROLL
@@ -1275,9 +1284,634 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
         (Te4((t2) & 0xff)       & 0x000000ff) ^
         rk[3];
     PUTU32(cipherBlock + 12, s3);
+}
+#endif /* !MODULE_CRYPTO_AES_CT */
+
+#if defined(MODULE_CRYPTO_AES_NI) && (defined(__x86_64__) || defined(__i386__))
+#define AES_NI_TARGET   __attribute__((target("aes,sse2")))
+
+#define AES_NI_EXPAND(rk, i, rcon) \
+    rk[i] = aes_ni_expand(rk[i - 1], _mm_aeskeygenassist_si128(rk[i - 1], rcon))
+
+static AES_NI_TARGET __m128i aes_ni_expand(__m128i key, __m128i assist)
+{
+    assist = _mm_shuffle_epi32(assist, 0xff);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+/*
+ * Expand the cipher key into the round keys for the AES instructions
+ */
+static AES_NI_TARGET void aes_ni_set_encrypt_key(const uint8_t *userKey,
+                                                 uint8_t *out)
+{
+    __m128i rk[11];
+
+    rk[0] = _mm_loadu_si128((const __m128i *)userKey);
+    AES_NI_EXPAND(rk, 1, 0x01);
+    AES_NI_EXPAND(rk, 2, 0x02);
+    AES_NI_EXPAND(rk, 3, 0x04);
+    AES_NI_EXPAND(rk, 4, 0x08);
+    AES_NI_EXPAND(rk, 5, 0x10);
+    AES_NI_EXPAND(rk, 6, 0x20);
+    AES_NI_EXPAND(rk, 7, 0x40);
+    AES_NI_EXPAND(rk, 8, 0x80);
+    AES_NI_EXPAND(rk, 9, 0x1b);
+    AES_NI_EXPAND(rk, 10, 0x36);
+    for (int r = 0; r < 11; r++) {
+        _mm_storeu_si128((__m128i *)(out + r * AES_BLOCK_SIZE), rk[r]);
+    }
+}
+
+/*
+ * Encrypt blocks with the AES instructions, four at a time to keep the
+ * pipeline of the AES unit busy
+ * in and out can overlap
+ */
+static AES_NI_TARGET void aes_ni_encrypt_blocks(const uint8_t *round_keys,
+                                                const uint8_t *in,
+                                                uint8_t *out, size_t nblocks)
+{
+    __m128i rk[11];
+    int r;
+
+    for (r = 0; r < 11; r++) {
+        rk[r] = _mm_loadu_si128((const __m128i *)(round_keys +
+                                                  r * AES_BLOCK_SIZE));
+    }
+
+    for (; nblocks >= 4; nblocks -= 4) {
+        const __m128i *src = (const __m128i *)in;
+        __m128i *dst = (__m128i *)out;
+        __m128i b0 = _mm_xor_si128(_mm_loadu_si128(src), rk[0]);
+        __m128i b1 = _mm_xor_si128(_mm_loadu_si128(src + 1), rk[0]);
+        __m128i b2 = _mm_xor_si128(_mm_loadu_si128(src + 2), rk[0]);
+        __m128i b3 = _mm_xor_si128(_mm_loadu_si128(src + 3), rk[0]);
+
+        for (r = 1; r < 10; r++) {
+            b0 = _mm_aesenc_si128(b0, rk[r]);
+            b1 = _mm_aesenc_si128(b1, rk[r]);
+            b2 = _mm_aesenc_si128(b2, rk[r]);
+            b3 = _mm_aesenc_si128(b3, rk[r]);
+        }
+        _mm_storeu_si128(dst, _mm_aesenclast_si128(b0, rk[10]));
+        _mm_storeu_si128(dst + 1, _mm_aesenclast_si128(b1, rk[10]));
+        _mm_storeu_si128(dst + 2, _mm_aesenclast_si128(b2, rk[10]));
+        _mm_storeu_si128(dst + 3, _mm_aesenclast_si128(b3, rk[10]));
+        in += 4 * AES_BLOCK_SIZE;
+        out += 4 * AES_BLOCK_SIZE;
+    }
+    for (; nblocks > 0; nblocks--) {
+        __m128i b = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in), rk[0]);
+
+        for (r = 1; r < 10; r++) {
+            b = _mm_aesenc_si128(b, rk[r]);
+        }
+        _mm_storeu_si128((__m128i *)out, _mm_aesenclast_si128(b, rk[10]));
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+}
+
+/* the host running native may lack the instructions */
+static int aes_ni_available(void)
+{
+    return x86_cpu_supports(X86_CPU_FEATURE_AES);
+}
+#endif /* MODULE_CRYPTO_AES_NI && (__x86_64__ || __i386__) */
+
+#ifdef MODULE_CRYPTO_AES_CT
+/*
+ * Constant-time AES encryption, adapted from the aes_ct implementation of
+ * BearSSL by Thomas Pornin (MIT license).
+ *
+ * Two blocks are processed at once. Their state is kept as eight 32-bit
+ * words, word i holding bit i of every byte of both blocks, so that the
+ * S-box is computed with boolean operations instead of table lookups. The
+ * round keys are expanded in the same representation.
+ */
+
+/* Boyar-Peralta circuit of the S-box, on the bitsliced state */
+static void aes_ct_sbox(uint32_t *q)
+{
+    uint32_t x0, x1, x2, x3, x4, x5, x6, x7;
+    uint32_t y1, y2, y3, y4, y5, y6, y7, y8, y9;
+    uint32_t y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+    uint32_t y20, y21;
+    uint32_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+    uint32_t z10, z11, z12, z13, z14, z15, z16, z17;
+    uint32_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+    uint32_t t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    uint32_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+    uint32_t t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    uint32_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    uint32_t t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    uint32_t t60, t61, t62, t63, t64, t65, t66, t67;
+    uint32_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    /* top linear transformation */
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    /* non-linear section */
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    /* bottom linear transformation */
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+#define AES_CT_SWAPN(cl, ch, s, x, y) do { \
+        uint32_t a = (x), b = (y); \
+        (x) = (a & (uint32_t)(cl)) | ((b & (uint32_t)(cl)) << (s)); \
+        (y) = ((a & (uint32_t)(ch)) >> (s)) | (b & (uint32_t)(ch)); \
+} while (0)
+
+#define AES_CT_SWAP2(x, y)  AES_CT_SWAPN(0x55555555, 0xAAAAAAAA, 1, x, y)
+#define AES_CT_SWAP4(x, y)  AES_CT_SWAPN(0x33333333, 0xCCCCCCCC, 2, x, y)
+#define AES_CT_SWAP8(x, y)  AES_CT_SWAPN(0x0F0F0F0F, 0xF0F0F0F0, 4, x, y)
+
+/* converts between the byte-wise and the bitsliced representation */
+static void aes_ct_ortho(uint32_t *q)
+{
+    AES_CT_SWAP2(q[0], q[1]);
+    AES_CT_SWAP2(q[2], q[3]);
+    AES_CT_SWAP2(q[4], q[5]);
+    AES_CT_SWAP2(q[6], q[7]);
+
+    AES_CT_SWAP4(q[0], q[2]);
+    AES_CT_SWAP4(q[1], q[3]);
+    AES_CT_SWAP4(q[4], q[6]);
+    AES_CT_SWAP4(q[5], q[7]);
+
+    AES_CT_SWAP8(q[0], q[4]);
+    AES_CT_SWAP8(q[1], q[5]);
+    AES_CT_SWAP8(q[2], q[6]);
+    AES_CT_SWAP8(q[3], q[7]);
+}
+
+static inline uint32_t aes_ct_dec32le(const uint8_t *src)
+{
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) |
+           ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+static inline void aes_ct_enc32le(uint8_t *dst, uint32_t x)
+{
+    dst[0] = (uint8_t)x;
+    dst[1] = (uint8_t)(x >> 8);
+    dst[2] = (uint8_t)(x >> 16);
+    dst[3] = (uint8_t)(x >> 24);
+}
+
+static uint32_t aes_ct_sub_word(uint32_t x)
+{
+    uint32_t q[8];
+
+    for (int i = 0; i < 8; i++) {
+        q[i] = x;
+    }
+    aes_ct_ortho(q);
+    aes_ct_sbox(q);
+    aes_ct_ortho(q);
+    return q[0];
+}
+
+/*
+ * Expand the cipher key into the bitsliced encryption key schedule, eight
+ * words per round key
+ */
+static void aes_ct_set_encrypt_key(const uint8_t *userKey, uint32_t *skey)
+{
+    const int nk = AES_KEY_SIZE / 4;
+    const int nkf = (10 + 1) * 4;
+    uint32_t tmp = 0;
+    int i, j, k;
+
+    for (i = 0; i < nk; i++) {
+        tmp = aes_ct_dec32le(userKey + (i << 2));
+        skey[(i << 1) + 0] = tmp;
+        skey[(i << 1) + 1] = tmp;
+    }
+    for (i = nk, j = 0, k = 0; i < nkf; i++) {
+        if (j == 0) {
+            tmp = (tmp << 24) | (tmp >> 8);
+            tmp = aes_ct_sub_word(tmp) ^ (rcon[k] >> 24);
+        }
+        tmp ^= skey[(i - nk) << 1];
+        skey[(i << 1) + 0] = tmp;
+        skey[(i << 1) + 1] = tmp;
+        if (++j == nk) {
+            j = 0;
+            k++;
+        }
+    }
+    /* both copies of a word end up as the two halves of its bitsliced form */
+    for (i = 0; i < nkf; i += 4) {
+        aes_ct_ortho(skey + (i << 1));
+    }
+}
+
+static inline void aes_ct_add_round_key(uint32_t *q, const uint32_t *sk)
+{
+    for (int i = 0; i < 8; i++) {
+        q[i] ^= sk[i];
+    }
+}
+
+static inline void aes_ct_shift_rows(uint32_t *q)
+{
+    for (int i = 0; i < 8; i++) {
+        uint32_t x = q[i];
+
+        q[i] = (x & 0x000000FF)
+               | ((x & 0x0000FC00) >> 2) | ((x & 0x00000300) << 6)
+               | ((x & 0x00F00000) >> 4) | ((x & 0x000F0000) << 4)
+               | ((x & 0xC0000000) >> 6) | ((x & 0x3F000000) << 2);
+    }
+}
+
+static inline uint32_t aes_ct_rotr16(uint32_t x)
+{
+    return (x << 16) | (x >> 16);
+}
+
+static inline void aes_ct_mix_columns(uint32_t *q)
+{
+    uint32_t q0, q1, q2, q3, q4, q5, q6, q7;
+    uint32_t r0, r1, r2, r3, r4, r5, r6, r7;
+
+    q0 = q[0];
+    q1 = q[1];
+    q2 = q[2];
+    q3 = q[3];
+    q4 = q[4];
+    q5 = q[5];
+    q6 = q[6];
+    q7 = q[7];
+    r0 = (q0 >> 8) | (q0 << 24);
+    r1 = (q1 >> 8) | (q1 << 24);
+    r2 = (q2 >> 8) | (q2 << 24);
+    r3 = (q3 >> 8) | (q3 << 24);
+    r4 = (q4 >> 8) | (q4 << 24);
+    r5 = (q5 >> 8) | (q5 << 24);
+    r6 = (q6 >> 8) | (q6 << 24);
+    r7 = (q7 >> 8) | (q7 << 24);
+
+    q[0] = q7 ^ r7 ^ r0 ^ aes_ct_rotr16(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ aes_ct_rotr16(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ aes_ct_rotr16(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ aes_ct_rotr16(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ aes_ct_rotr16(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ aes_ct_rotr16(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ aes_ct_rotr16(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ aes_ct_rotr16(q7 ^ r7);
+}
+
+/*
+ * Encrypt two blocks, the second one is ignored if nblocks is 1
+ * in and out can overlap
+ */
+static void aes_ct_encrypt_pair(const uint32_t *skey, const uint8_t *in,
+                                uint8_t *out, size_t nblocks)
+{
+    uint32_t q[8] = { 0 };
+    int i, r;
+
+    for (i = 0; i < 4; i++) {
+        q[i << 1] = aes_ct_dec32le(in + (i << 2));
+    }
+    if (nblocks > 1) {
+        for (i = 0; i < 4; i++) {
+            q[(i << 1) + 1] = aes_ct_dec32le(in + AES_BLOCK_SIZE + (i << 2));
+        }
+    }
+    aes_ct_ortho(q);
+
+    aes_ct_add_round_key(q, skey);
+    for (r = 1; r < 10; r++) {
+        aes_ct_sbox(q);
+        aes_ct_shift_rows(q);
+        aes_ct_mix_columns(q);
+        aes_ct_add_round_key(q, skey + (r << 3));
+    }
+    aes_ct_sbox(q);
+    aes_ct_shift_rows(q);
+    aes_ct_add_round_key(q, skey + (10 << 3));
+
+    aes_ct_ortho(q);
+    for (i = 0; i < 4; i++) {
+        aes_ct_enc32le(out + (i << 2), q[i << 1]);
+    }
+    if (nblocks > 1) {
+        for (i = 0; i < 4; i++) {
+            aes_ct_enc32le(out + AES_BLOCK_SIZE + (i << 2), q[(i << 1) + 1]);
+        }
+    }
+}
+#endif /* MODULE_CRYPTO_AES_CT */
+
+/* the T-tables, or the bitsliced implementation with crypto_aes_ct */
+static void aes_soft_set_key(aes_schedule_t *sched, const uint8_t *key)
+{
+#ifdef MODULE_CRYPTO_AES_CT
+    aes_ct_set_encrypt_key(key, sched->rk.bitsliced);
+#else
+    aes_set_encrypt_key(key, AES_KEY_SIZE * 8, &sched->rk.table);
+#endif
+}
+
+static void aes_soft_encrypt_blocks(const aes_schedule_t *sched,
+                                    const uint8_t *input, uint8_t *output,
+                                    size_t nblocks)
+{
+#ifdef MODULE_CRYPTO_AES_CT
+    for (; nblocks >= 2; nblocks -= 2) {
+        aes_ct_encrypt_pair(sched->rk.bitsliced, input, output, 2);
+        input += 2 * AES_BLOCK_SIZE;
+        output += 2 * AES_BLOCK_SIZE;
+    }
+    if (nblocks > 0) {
+        aes_ct_encrypt_pair(sched->rk.bitsliced, input, output, 1);
+    }
+#else
+    for (; nblocks > 0; nblocks--) {
+        aes_encrypt_block(&sched->rk.table, input, output);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+#endif
+}
+
+#if AES_BACKEND_NI
+static void aes_ni_set_key(aes_schedule_t *sched, const uint8_t *key)
+{
+    aes_ni_set_encrypt_key(key, sched->rk.ni);
+}
+
+static void aes_ni_encrypt_sched(const aes_schedule_t *sched,
+                                 const uint8_t *input, uint8_t *output,
+                                 size_t nblocks)
+{
+    aes_ni_encrypt_blocks(sched->rk.ni, input, output, nblocks);
+}
+#endif
+
+#ifdef MODULE_TINYCRYPT
+static void aes_tc_set_key(aes_schedule_t *sched, const uint8_t *key)
+{
+    /* rk.tinycrypt stands in for the 44 words of the tinycrypt schedule */
+    BUILD_BUG_ON(sizeof(struct tc_aes_key_sched_struct) !=
+                 sizeof(sched->rk.tinycrypt));
+    tc_aes128_set_encrypt_key((TCAesKeySched_t)sched->rk.tinycrypt, key);
+}
+
+static void aes_tc_encrypt_blocks(const aes_schedule_t *sched,
+                                  const uint8_t *input, uint8_t *output,
+                                  size_t nblocks)
+{
+    for (; nblocks > 0; nblocks--) {
+        tc_aes_encrypt(output, input, (TCAesKeySched_t)sched->rk.tinycrypt);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+}
+#endif
+
+const aes_backend_t aes_backends[AES_BACKEND_NUMOF] = {
+#if AES_BACKEND_NI
+    { "ni", aes_ni_available, aes_ni_set_key, aes_ni_encrypt_sched },
+#endif
+#ifdef MODULE_CRYPTO_AES_CT
+    { "ct", NULL, aes_soft_set_key, aes_soft_encrypt_blocks },
+#else
+    { "table", NULL, aes_soft_set_key, aes_soft_encrypt_blocks },
+#endif
+#ifdef MODULE_TINYCRYPT
+    { "tinycrypt", NULL, aes_tc_set_key, aes_tc_encrypt_blocks },
+#endif
+};
+
+/* NULL until a backend is selected or looked up */
+static const aes_backend_t *aes_backend;
+
+int aes_backend_available(const aes_backend_t *backend)
+{
+    return (backend->available == NULL) || backend->available();
+}
+
+const aes_backend_t *aes_backend_get(void)
+{
+    const aes_backend_t *backend = aes_backend;
+
+    if (backend == NULL) {
+#ifdef MODULE_CRYPTO_BACKEND
+        /* only use a backend which passed the self-test */
+        crypto_backend_init();
+        backend = aes_backend;
+#else
+        /* the software backend is always available */
+        for (backend = aes_backends; !aes_backend_available(backend);
+             backend++) {}
+        aes_backend = backend;
+#endif
+    }
+    return backend;
+}
+
+int aes_backend_set(const aes_backend_t *backend)
+{
+    if (!aes_backend_available(backend)) {
+        return -1;
+    }
+    aes_backend = backend;
+    return 0;
+}
+
+int aes_schedule_init(aes_schedule_t *sched, const uint8_t *key,
+                      uint8_t key_size)
+{
+    if (key_size != AES_KEY_SIZE) {
+        return CIPHER_ERR_INVALID_KEY_SIZE;
+    }
+
+    sched->backend = aes_backend_get();
+    sched->backend->set_key(sched, key);
+    return CIPHER_INIT_SUCCESS;
+}
+
+/*
+ * Encrypt nblocks blocks with an expanded key
+ * in and out can overlap
+ */
+int aes_schedule_encrypt_blocks(const aes_schedule_t *sched,
+                                const uint8_t *input, uint8_t *output,
+                                size_t nblocks)
+{
+    sched->backend->encrypt_blocks(sched, input, output, nblocks);
     return 1;
 }
 
+/*
+ * Encrypt nblocks blocks, the key is expanded once for all of them
+ * in and out can overlap
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t nblocks)
+{
+    aes_schedule_t sched;
+    int res;
+
+    res = aes_schedule_init(&sched, context->context, AES_KEY_SIZE);
+    if (res != CIPHER_INIT_SUCCESS) {
+        return res;
+    }
+    return aes_schedule_encrypt_blocks(&sched, input, output, nblocks);
+}
+
+/*
+ * Encrypt a single block
+ * in and out can overlap
+ */
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
+{
+    return aes_encrypt_blocks(context, plainBlock, cipherBlock, 1);
+}
+
 /*
  * Decrypt a single block
  * in and out can overlap
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Self-test and benchmark of the cipher backends
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "crypto/backend.h"
+#include "panic.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* the benchmark reads the clock after this many runs */
+#define RUNS_PER_READ       (8U)
+
+/* FIPS-197, appendix C.1 */
+static const uint8_t _aes_key[AES_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static const uint8_t _aes_plain[AES_BLOCK_SIZE] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+static const uint8_t _aes_cipher[AES_BLOCK_SIZE] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+
+static crypto_backend_state_t _state[AES_BACKEND_NUMOF];
+static uint32_t _speed[AES_BACKEND_NUMOF];
+/* the choice of crypto_backend_select(), kept by crypto_backend_init() */
+static const aes_backend_t *_aes_selected;
+
+/*
+ * One block, then three blocks in place, which takes the paths of backends
+ * that encrypt several blocks at once
+ */
+static int _aes_self_test(const aes_backend_t *backend)
+{
+    aes_schedule_t sched;
+    uint8_t buf[3 * AES_BLOCK_SIZE];
+
+    sched.backend = backend;
+    backend->set_key(&sched, _aes_key);
+    backend->encrypt_blocks(&sched, _aes_plain, buf, 1);
+    if (memcmp(buf, _aes_cipher, AES_BLOCK_SIZE)) {
+        return -1;
+    }
+
+    for (unsigned i = 0; i < 3; i++) {
+        memcpy(buf + i * AES_BLOCK_SIZE, _aes_plain, AES_BLOCK_SIZE);
+    }
+    backend->encrypt_blocks(&sched, buf, buf, 3);
+    for (unsigned i = 0; i < 3; i++) {
+        if (memcmp(buf + i * AES_BLOCK_SIZE, _aes_cipher, AES_BLOCK_SIZE)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* KiB/s of expanding a key and encrypting a few blocks, as cipher_t does */
+static uint32_t _aes_bench(const aes_backend_t *backend)
+{
+    aes_schedule_t sched;
+    uint8_t buf[CRYPTO_BACKEND_BENCH_BLOCKS * AES_BLOCK_SIZE] = { 0 };
+    uint32_t runs = 0;
+    uint32_t start = xtimer_now_usec();
+    uint32_t time;
+
+    sched.backend = backend;
+    do {
+        for (unsigned i = 0; i < RUNS_PER_READ; i++) {
+            /* the key changes with every run */
+            backend->set_key(&sched, buf);
+            backend->encrypt_blocks(&sched, buf, buf,
+                                    CRYPTO_BACKEND_BENCH_BLOCKS);
+        }
+        runs += RUNS_PER_READ;
+        time = xtimer_now_usec() - start;
+    } while (time < CRYPTO_BACKEND_BENCH_USEC);
+
+    return ((uint64_t)runs * sizeof(buf) * US_PER_SEC) /
+           ((uint64_t)time * 1024);
+}
+
+void crypto_backend_init(void)
+{
+    const aes_backend_t *fastest = NULL;
+    uint32_t fastest_speed = 0;
+
+    for (unsigned i = 0; i < AES_BACKEND_NUMOF; i++) {
+        const aes_backend_t *backend = &aes_backends[i];
+
+        _speed[i] = 0;
+        if (!aes_backend_available(backend)) {
+            _state[i] = CRYPTO_BACKEND_UNAVAILABLE;
+            continue;
+        }
+        if (_aes_self_test(backend) < 0) {
+            DEBUG("crypto_backend: aes-128 %s failed\n", backend->name);
+            _state[i] = CRYPTO_BACKEND_FAILED;
+            continue;
+        }
+        _state[i] = CRYPTO_BACKEND_PASSED;
+        _speed[i] = _aes_bench(backend);
+        DEBUG("crypto_backend: aes-128 %s %lu KiB/s\n", backend->name,
+              (unsigned long)_speed[i]);
+        /* on a tie the backend listed first is preferred */
+        if ((fastest == NULL) || (_speed[i] > fastest_speed)) {
+            fastest = backend;
+            fastest_speed = _speed[i];
+        }
+    }
+
+    if (fastest == NULL) {
+        core_panic(PANIC_GENERAL_ERROR,
+                   "crypto_backend: no aes-128 backend passed the self-test");
+    }
+    if ((_aes_selected != NULL) &&
+        (_state[_aes_selected - aes_backends] == CRYPTO_BACKEND_PASSED)) {
+        fastest = _aes_selected;
+    }
+    else {
+        _aes_selected = NULL;
+    }
+    aes_backend_set(fastest);
+}
+
+unsigned crypto_backend_numof(void)
+{
+    return AES_BACKEND_NUMOF;
+}
+
+int crypto_backend_info(unsigned idx, crypto_backend_info_t *info)
+{
+    if (idx >= AES_BACKEND_NUMOF) {
+        return -1;
+    }
+
+    info->algo = "aes-128";
+    info->name = aes_backends[idx].name;
+    info->state = _state[idx];
+    info->speed = _speed[idx];
+    info->selected = (aes_backend_get() == &aes_backends[idx]);
+    return 0;
+}
+
+int crypto_backend_select(const char *algo, const char *name)
+{
+    if (strcmp(algo, "aes-128") != 0) {
+        return -1;
+    }
+
+    for (unsigned i = 0; i < AES_BACKEND_NUMOF; i++) {
+        if (strcmp(name, aes_backends[i].name) != 0) {
+            continue;
+        }
+        if (_state[i] == CRYPTO_BACKEND_UNTESTED) {
+            crypto_backend_init();
+        }
+        if ((_state[i] != CRYPTO_BACKEND_PASSED) ||
+            (aes_backend_set(&aes_backends[i]) < 0)) {
+            return -2;
+        }
+        _aes_selected = &aes_backends[i];
+        return 0;
+    }
+    return -1;
+}
@@ -39,6 +39,11 @@
 
 #include <string.h>
 
+#if defined(MODULE_CRYPTO_CHACHA_SIMD) && (defined(__x86_64__) || defined(__i386__))
+#define CHACHA_SIMD     (1)
+#include "x86_cpu_features.h"
+#endif
+
 static void _r(uint32_t *d, uint32_t *a, const uint32_t *b, unsigned c)
 {
     *a += *b;
@@ -112,6 +117,132 @@ void chacha_keystream_bytes(chacha_ctx *ctx, void *x)
     }
 }
 
+#ifdef CHACHA_SIMD
+#define CHACHA_LANES    (8)
+
+static void _add_counter(chacha_ctx *ctx, size_t nblocks)
+{
+    uint64_t counter = ((uint64_t)ctx->state[13] << 32) | ctx->state[12];
+
+    counter += nblocks;
+    ctx->state[12] = (uint32_t)counter;
+    ctx->state[13] = (uint32_t)(counter >> 32);
+}
+
+/* one word of eight consecutive blocks */
+typedef uint32_t chacha_vec_t __attribute__((vector_size(4 * CHACHA_LANES)));
+
+#define CHACHA_ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define CHACHA_QUARTERROUND(a, b, c, d) \
+    do { \
+        a += b; d ^= a; d = CHACHA_ROTL(d, 16); \
+        c += d; b ^= c; b = CHACHA_ROTL(b, 12); \
+        a += b; d ^= a; d = CHACHA_ROTL(d, 8); \
+        c += d; b ^= c; b = CHACHA_ROTL(b, 7); \
+    } while (0)
+
+/*
+ * Eight blocks at once, each vector holds the same word of all of them
+ */
+static inline __attribute__((always_inline))
+void _blocks8_body(const uint32_t state[16], unsigned rounds, void *out)
+{
+    chacha_vec_t in[16];
+    chacha_vec_t x[16];
+    uint32_t words[16][CHACHA_LANES];
+    uint8_t *dst = out;
+
+    for (unsigned i = 0; i < 16; i++) {
+        in[i] = (chacha_vec_t){ 0 } + state[i];
+    }
+    for (unsigned l = 0; l < CHACHA_LANES; l++) {
+        uint32_t lo = state[12] + l;
+
+        in[12][l] = lo;
+        in[13][l] = state[13] + (lo < state[12]);
+    }
+    memcpy(x, in, sizeof(x));
+
+    for (unsigned r = 0; r < rounds; r += 2) {
+        CHACHA_QUARTERROUND(x[0], x[4], x[8], x[12]);
+        CHACHA_QUARTERROUND(x[1], x[5], x[9], x[13]);
+        CHACHA_QUARTERROUND(x[2], x[6], x[10], x[14]);
+        CHACHA_QUARTERROUND(x[3], x[7], x[11], x[15]);
+        CHACHA_QUARTERROUND(x[0], x[5], x[10], x[15]);
+        CHACHA_QUARTERROUND(x[1], x[6], x[11], x[12]);
+        CHACHA_QUARTERROUND(x[2], x[7], x[8], x[13]);
+        CHACHA_QUARTERROUND(x[3], x[4], x[9], x[14]);
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        x[i] += in[i];
+    }
+    memcpy(words, x, sizeof(words));
+    for (unsigned l = 0; l < CHACHA_LANES; l++) {
+        uint32_t block[16];
+
+        for (unsigned i = 0; i < 16; i++) {
+            block[i] = words[i][l];
+        }
+        memcpy(dst + 64 * l, block, sizeof(block));
+    }
+}
+
+static __attribute__((target("sse2")))
+void _blocks8_sse2(const uint32_t state[16], unsigned rounds, void *out)
+{
+    _blocks8_body(state, rounds, out);
+}
+
+static __attribute__((target("avx2")))
+void _blocks8_avx2(const uint32_t state[16], unsigned rounds, void *out)
+{
+    _blocks8_body(state, rounds, out);
+}
+#endif /* CHACHA_SIMD */
+
+void chacha_keystream_blocks(chacha_ctx *ctx, void *x, size_t nblocks)
+{
+    uint8_t *out = x;
+
+#ifdef CHACHA_SIMD
+    /* 2 for AVX2, 1 for SSE2 and 0 for neither */
+    unsigned features = x86_cpu_features();
+    int simd = (features & X86_CPU_FEATURE_AVX2) ? 2 :
+               (features & X86_CPU_FEATURE_SSE2) ? 1 : 0;
+
+    while (simd && (nblocks >= CHACHA_LANES)) {
+        if (simd == 2) {
+            _blocks8_avx2(ctx->state, ctx->rounds, out);
+        }
+        else {
+            _blocks8_sse2(ctx->state, ctx->rounds, out);
+        }
+        _add_counter(ctx, CHACHA_LANES);
+        out += 64 * CHACHA_LANES;
+        nblocks -= CHACHA_LANES;
+    }
+    if (simd && (nblocks > 1)) {
+        uint32_t tmp[16 * CHACHA_LANES];
+
+        if (simd == 2) {
+            _blocks8_avx2(ctx->state, ctx->rounds, tmp);
+        }
+        else {
+            _blocks8_sse2(ctx->state, ctx->rounds, tmp);
+        }
+        memcpy(out, tmp, 64 * nblocks);
+        _add_counter(ctx, nblocks);
+        return;
+    }
+#endif
+    for (; nblocks > 0; nblocks--) {
+        chacha_keystream_bytes(ctx, out);
+        out += 64;
+    }
+}
+
 void chacha_encrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8_t *c)
 {
     uint8_t x[64];
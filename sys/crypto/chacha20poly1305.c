@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto_chacha20poly1305
+ * @{
+ *
+ * @file
+ * @brief       ChaCha20-Poly1305 implementation
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "crypto/chacha.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/helper.h"
+#include "crypto/poly1305.h"
+
+/* keystream generated per step, eight blocks for the SIMD implementation */
+#define STREAM_BLOCKS   (8U)
+
+static const uint8_t _zeros[16];
+
+/*
+ * The counter is the 32 bit word 12 of the state and the nonce fills words
+ * 13 to 15, which chacha_init() uses for its 64 bit counter and nonce. Block 0
+ * of the keystream is the Poly1305 key.
+ */
+static void _init(chacha_ctx *chacha, poly1305_ctx_t *poly,
+                  const uint8_t *key, const uint8_t *nonce)
+{
+    uint32_t block[16];
+
+    chacha_init(chacha, 20, key, CHACHA20POLY1305_KEY_BYTES, nonce + 4);
+    memcpy(&chacha->state[13], nonce, 4);
+
+    chacha_keystream_bytes(chacha, block);
+    poly1305_init(poly, (const uint8_t *)block);
+    crypto_secure_wipe(block, sizeof(block));
+}
+
+static void _pad16(poly1305_ctx_t *poly, size_t len)
+{
+    if (len & 15) {
+        poly1305_update(poly, _zeros, 16 - (len & 15));
+    }
+}
+
+static void _lengths(poly1305_ctx_t *poly, size_t aadlen, size_t msglen)
+{
+    uint8_t lengths[16];
+    uint64_t aad = aadlen;
+    uint64_t msg = msglen;
+
+    for (unsigned i = 0; i < 8; i++) {
+        lengths[i] = (uint8_t)(aad >> (8 * i));
+        lengths[8 + i] = (uint8_t)(msg >> (8 * i));
+    }
+    poly1305_update(poly, lengths, sizeof(lengths));
+}
+
+/* in and out may be the same buffer, neither needs to be aligned */
+static void _xor(uint8_t *out, const uint8_t *in, const uint8_t *stream,
+                 size_t len)
+{
+    size_t i = 0;
+
+    for (; i + sizeof(uint32_t) <= len; i += sizeof(uint32_t)) {
+        uint32_t a, b;
+
+        memcpy(&a, in + i, sizeof(a));
+        memcpy(&b, stream + i, sizeof(b));
+        a ^= b;
+        memcpy(out + i, &a, sizeof(a));
+    }
+    for (; i < len; i++) {
+        out[i] = in[i] ^ stream[i];
+    }
+}
+
+static void _crypt(chacha_ctx *chacha, uint8_t *out, const uint8_t *in,
+                   size_t len)
+{
+    uint32_t stream[16 * STREAM_BLOCKS];
+    /* the keystream written to stream, whole blocks */
+    size_t used = (len + 63) & ~(size_t)63;
+
+    used = (used < sizeof(stream)) ? used : sizeof(stream);
+
+    while (len) {
+        size_t blocks = (len + 63) / 64;
+        size_t n;
+
+        blocks = (blocks < STREAM_BLOCKS) ? blocks : STREAM_BLOCKS;
+        n = (len < 64 * blocks) ? len : 64 * blocks;
+        chacha_keystream_blocks(chacha, stream, blocks);
+        _xor(out, in, (const uint8_t *)stream, n);
+        in += n;
+        out += n;
+        len -= n;
+    }
+    crypto_secure_wipe(stream, used);
+}
+
+void chacha20poly1305_encrypt(uint8_t *cipher, const uint8_t *msg,
+                              size_t msglen, const uint8_t *aad, size_t aadlen,
+                              const uint8_t *key, const uint8_t *nonce)
+{
+    chacha_ctx chacha;
+    poly1305_ctx_t poly;
+
+    /* the 32 bit block counter must not wrap */
+    assert((uint64_t)msglen <= 64 * (uint64_t)UINT32_MAX - 64);
+
+    _init(&chacha, &poly, key, nonce);
+    poly1305_update(&poly, aad, aadlen);
+    _pad16(&poly, aadlen);
+
+    _crypt(&chacha, cipher, msg, msglen);
+    poly1305_update(&poly, cipher, msglen);
+    _pad16(&poly, msglen);
+
+    _lengths(&poly, aadlen, msglen);
+    poly1305_finish(&poly, cipher + msglen);
+
+    crypto_secure_wipe(&chacha, sizeof(chacha));
+    crypto_secure_wipe(&poly, sizeof(poly));
+}
+
+int chacha20poly1305_decrypt(const uint8_t *cipher, size_t cipherlen,
+                             uint8_t *msg, const uint8_t *aad, size_t aadlen,
+                             const uint8_t *key, const uint8_t *nonce)
+{
+    chacha_ctx chacha;
+    poly1305_ctx_t poly;
+    uint8_t tag[CHACHA20POLY1305_TAG_BYTES];
+    size_t msglen;
+    int res = -1;
+
+    if (cipherlen < CHACHA20POLY1305_TAG_BYTES) {
+        return -1;
+    }
+    msglen = cipherlen - CHACHA20POLY1305_TAG_BYTES;
+
+    /* the tag is checked first, nothing is decrypted if it is invalid */
+    _init(&chacha, &poly, key, nonce);
+    poly1305_update(&poly, aad, aadlen);
+    _pad16(&poly, aadlen);
+    poly1305_update(&poly, cipher, msglen);
+    _pad16(&poly, msglen);
+    _lengths(&poly, aadlen, msglen);
+    poly1305_finish(&poly, tag);
+
+    if (crypto_equals(tag, cipher + msglen, sizeof(tag))) {
+        _crypt(&chacha, msg, cipher, msglen);
+        res = 0;
+    }
+    else {
+        memset(msg, 0, msglen);
+    }
+
+    crypto_secure_wipe(&chacha, sizeof(chacha));
+    crypto_secure_wipe(&poly, sizeof(poly));
+    crypto_secure_wipe(tag, sizeof(tag));
+    return res;
+}
@@ -38,6 +38,28 @@ int cipher_encrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 }
 
 
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t nblocks)
+{
+    int res = 1;
+
+    if (cipher->interface->encrypt_blocks) {
+        return cipher->interface->encrypt_blocks(&cipher->context, input,
+                                                 output, nblocks);
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        res = cipher->interface->encrypt(&cipher->context, input, output);
+        if (res != 1) {
+            break;
+        }
+        input += cipher->interface->block_size;
+        output += cipher->interface->block_size;
+    }
+    return res;
+}
+
+
 int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output)
 {
     return cipher->interface->decrypt(&cipher->context, input, output);
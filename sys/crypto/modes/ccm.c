@@ -21,7 +21,6 @@
 #include <string.h>
 #include "debug.h"
 #include "crypto/helper.h"
-#include "crypto/modes/ctr.h"
 #include "crypto/modes/ccm.h"
 
 static inline int min(int a, int b)
@@ -34,113 +33,243 @@ static inline int min(int a, int b)
     }
 }
 
-int ccm_compute_cbc_mac(cipher_t* cipher, const uint8_t iv[16],
-                        const uint8_t* input, size_t length, uint8_t* mac)
+/* Check if 'value' can be stored in 'num_bytes' */
+static inline int _fits_in_nbytes(size_t value, uint8_t num_bytes)
 {
-    uint8_t offset, block_size, mac_enc[16] = {0};
-
-    block_size = cipher_get_block_size(cipher);
-    memmove(mac, iv, 16);
-    offset = 0;
-    do {
-        uint8_t block_size_input = (length - offset > block_size) ?
-                                   block_size : length - offset;
-
-        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (int i = 0; i < block_size_input; ++i) {
-            mac[i] ^= input[offset + i];
-        }
+    /* Not allowed to shift more or equal than left operand width
+     * So we shift by maximum num bits of size_t -1 and compare to 1
+     */
+    unsigned shift = (8 * min(sizeof(size_t), num_bytes)) - 1;
+    return (value >> shift) <= 1;
+}
 
-        if (cipher_encrypt(cipher, mac, mac_enc) != 1) {
-            return CIPHER_ERR_ENC_FAILED;
-        }
+static int _mac_block(cipher_ccm_ctx_t *ctx)
+{
+    if (cipher_encrypt(ctx->cipher, ctx->mac, ctx->mac) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    ctx->pos = 0;
+    return 0;
+}
 
-        memcpy(mac, mac_enc, block_size);
-        offset += block_size_input;
-    } while (offset < length);
+int cipher_ccm_init(cipher_ccm_ctx_t *ctx, const cipher_t *cipher,
+                    uint8_t mac_length, uint8_t length_encoding,
+                    const uint8_t *nonce, size_t nonce_len,
+                    uint32_t auth_data_len, size_t input_len)
+{
+    /* B_0 and A_0, encrypted with one call */
+    uint8_t blocks[2 * 16] = {0};
+    size_t len = input_len;
 
-    return offset;
-}
+    if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
+        return CCM_ERR_INVALID_MAC_LENGTH;
+    }
 
+    if (length_encoding < 2 || length_encoding > 8 ||
+            !_fits_in_nbytes(input_len, length_encoding)) {
+        return CCM_ERR_INVALID_LENGTH_ENCODING;
+    }
 
-int ccm_create_mac_iv(cipher_t* cipher, uint8_t auth_data_len, uint8_t M,
-                      uint8_t L, const uint8_t* nonce, uint8_t nonce_len,
-                      size_t plaintext_len, uint8_t X1[16])
-{
-    uint8_t M_, L_;
+    if (nonce_len > 15U - length_encoding) {
+        return CCM_ERR_INVALID_NONCE_LENGTH;
+    }
 
-    /* ensure everything is set to zero */
-    memset(X1, 0, 16);
+    /* If 0 < l(a) < (2^16 - 2^8), then the length field is encoded as two
+     * octets. (RFC3610 page 2)
+     */
+    if (auth_data_len > 0xFEFF) {
+        DEBUG("UNSUPPORTED Adata length: %" PRIu32 "\n", auth_data_len);
+        return -1;
+    }
 
     /* set flags in B[0] - bit format:
             7        6     5..3  2..0
         Reserved   Adata    M_    L_    */
-    M_ = (M - 2) / 2;
-    L_ = L - 1;
-    X1[0] = 64 * (auth_data_len > 0) + 8 * M_ + L_;
+    blocks[0] = 64 * (auth_data_len > 0) + 8 * ((mac_length - 2) / 2) +
+                (length_encoding - 1);
+    /* copy nonce to B[1..15-L] and write plaintext_len to B[16-L..15] */
+    memcpy(&blocks[1], nonce, nonce_len);
+    for (uint8_t i = 15; i > 15 - length_encoding; --i) {
+        blocks[i] = len & 0xff;
+        len >>= 8;
+    }
 
-    /* copy nonce to B[1..15-L] */
-    memcpy(&X1[1], nonce, min(nonce_len, 15 - L));
+    /* A_0 has the flags L_ and the nonce, the counter starts at 0 */
+    blocks[16] = length_encoding - 1;
+    memcpy(&blocks[17], nonce, nonce_len);
+    memcpy(ctx->ctr, &blocks[16], 16);
 
-    /* write plaintext_len to B[15..16-L] */
-    for (uint8_t i = 15; i > 16 - L; --i) {
-        X1[i] = plaintext_len & 0xff;
-        plaintext_len >>= 8;
+    if (cipher_encrypt_blocks(cipher, blocks, blocks, 2) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+
+    ctx->cipher = cipher;
+    memcpy(ctx->mac, blocks, 16);
+    memcpy(ctx->s0, &blocks[16], 16);
+    crypto_block_inc_ctr(ctx->ctr, length_encoding);
+    ctx->aad_left = auth_data_len;
+    ctx->input_left = input_len;
+    ctx->pos = 0;
+    ctx->stream_ready = 0;
+    ctx->mac_length = mac_length;
+    ctx->ctr_len = length_encoding;
+
+    /* the additional data starts with its length */
+    if (auth_data_len > 0) {
+        ctx->mac[0] ^= (auth_data_len >> 8) & 0xFF;
+        ctx->mac[1] ^= auth_data_len & 0xFF;
+        ctx->pos = 2;
+    }
+
+    crypto_secure_wipe(blocks, sizeof(blocks));
+    return 0;
+}
+
+int cipher_ccm_update_aad(cipher_ccm_ctx_t *ctx, const uint8_t *auth_data,
+                          size_t len)
+{
+    if (len > ctx->aad_left) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
     }
+    ctx->aad_left -= len;
 
-    /* if there is still data, plaintext_len was too big */
-    if (plaintext_len > 0) {
-        return CIPHER_ERR_INVALID_LENGTH;
+    for (size_t i = 0; i < len; i++) {
+        ctx->mac[ctx->pos++] ^= auth_data[i];
+        if (ctx->pos == 16 && _mac_block(ctx) < 0) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
     }
 
-    if (cipher_encrypt(cipher, X1, X1) != 1) {
+    /* the additional data is padded with zeros to a full block */
+    if (ctx->aad_left == 0 && ctx->pos > 0 && _mac_block(ctx) < 0) {
         return CIPHER_ERR_ENC_FAILED;
     }
     return 0;
 }
 
-int ccm_compute_adata_mac(cipher_t* cipher, const uint8_t* auth_data,
-                          uint32_t auth_data_len, uint8_t X1[16])
+static int _ccm_crypt(cipher_ccm_ctx_t *ctx, const uint8_t *input,
+                      size_t len, uint8_t *output, int decrypt)
 {
-    if (auth_data_len > 0) {
-        int len;
-
-        /* 16 octet block size + max. 10 len encoding  */
-        uint8_t auth_data_encoded[26], len_encoding = 0;
-
-        /* If 0 < l(a) < (2^16 - 2^8), then the length field is encoded as two
-         * octets. (RFC3610 page 2)
-         */
-        if (auth_data_len <= 0xFEFF) {
-            /* length (0x0001 ... 0xFEFF)  */
-            len_encoding = 2;
-
-            auth_data_encoded[1] = auth_data_len & 0xFF;
-            auth_data_encoded[0] = (auth_data_len >> 8) & 0xFF;
-        } else {
-            DEBUG("UNSUPPORTED Adata length: %" PRIu32 "\n", auth_data_len);
-            return -1;
+    size_t offset = 0;
+
+    if (ctx->aad_left > 0 || len > ctx->input_left) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
+    }
+    ctx->input_left -= len;
+
+    while (offset < len) {
+        if (!ctx->stream_ready) {
+            memcpy(ctx->stream, ctx->ctr, 16);
+            crypto_block_inc_ctr(ctx->ctr, ctx->ctr_len);
+            if (cipher_encrypt(ctx->cipher, ctx->stream, ctx->stream) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+            ctx->stream_ready = 1;
         }
 
-        memcpy(auth_data_encoded + len_encoding, auth_data, auth_data_len);
-        len = ccm_compute_cbc_mac(cipher, X1, auth_data_encoded, auth_data_len + len_encoding, X1);
-        if (len < 0) {
-            return -1;
+        if (ctx->pos == 0 && len - offset >= 16) {
+            /* A full block: its CBC-MAC and the key stream of the next block
+             * are computed with one call to the cipher */
+            uint8_t blocks[2 * 16];
+            size_t nblocks = 1;
+
+            for (unsigned i = 0; i < 16; i++) {
+                uint8_t in = input[offset + i];
+                uint8_t out = in ^ ctx->stream[i];
+
+                blocks[i] = ctx->mac[i] ^ (decrypt ? out : in);
+                output[offset + i] = out;
+            }
+            offset += 16;
+
+            if (ctx->input_left > 0 || offset < len) {
+                memcpy(&blocks[16], ctx->ctr, 16);
+                crypto_block_inc_ctr(ctx->ctr, ctx->ctr_len);
+                nblocks = 2;
+            }
+            if (cipher_encrypt_blocks(ctx->cipher, blocks, blocks,
+                                      nblocks) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+            memcpy(ctx->mac, blocks, 16);
+            if (nblocks == 2) {
+                memcpy(ctx->stream, &blocks[16], 16);
+            }
+            ctx->stream_ready = (nblocks == 2);
+        }
+        else {
+            uint8_t in = input[offset];
+            uint8_t out = in ^ ctx->stream[ctx->pos];
+
+            ctx->mac[ctx->pos++] ^= decrypt ? out : in;
+            output[offset++] = out;
+            if (ctx->pos == 16) {
+                if (_mac_block(ctx) < 0) {
+                    return CIPHER_ERR_ENC_FAILED;
+                }
+                ctx->stream_ready = 0;
+            }
         }
     }
 
+    return len;
+}
+
+int cipher_ccm_encrypt_update(cipher_ccm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output)
+{
+    return _ccm_crypt(ctx, input, len, output, 0);
+}
+
+int cipher_ccm_decrypt_update(cipher_ccm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output)
+{
+    return _ccm_crypt(ctx, input, len, output, 1);
+}
+
+/* auth value: mac ^ first stream block */
+static int _ccm_finish(cipher_ccm_ctx_t *ctx, uint8_t mac[16])
+{
+    if (ctx->aad_left > 0 || ctx->input_left > 0) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
+    }
+
+    /* the plaintext is padded with zeros to a full block */
+    if (ctx->pos > 0 && _mac_block(ctx) < 0) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+
+    for (uint8_t i = 0; i < 16; ++i) {
+        mac[i] = ctx->mac[i] ^ ctx->s0[i];
+    }
     return 0;
 }
 
+int cipher_ccm_encrypt_finish(cipher_ccm_ctx_t *ctx, uint8_t *mac)
+{
+    uint8_t mac_length = ctx->mac_length, mac_full[16];
+    int res = _ccm_finish(ctx, mac_full);
 
-/* Check if 'value' can be stored in 'num_bytes' */
-static inline int _fits_in_nbytes(size_t value, uint8_t num_bytes)
+    if (res == 0) {
+        memcpy(mac, mac_full, mac_length);
+        res = mac_length;
+    }
+    crypto_secure_wipe(mac_full, sizeof(mac_full));
+    crypto_secure_wipe(ctx, sizeof(*ctx));
+    return res;
+}
+
+int cipher_ccm_decrypt_finish(cipher_ccm_ctx_t *ctx, const uint8_t *mac)
 {
-    /* Not allowed to shift more or equal than left operand width
-     * So we shift by maximum num bits of size_t -1 and compare to 1
-     */
-    unsigned shift = (8 * min(sizeof(size_t), num_bytes)) - 1;
-    return (value >> shift) <= 1;
+    uint8_t mac_full[16];
+    int res = _ccm_finish(ctx, mac_full);
+
+    if (res == 0 && !crypto_equals(mac, mac_full, ctx->mac_length)) {
+        res = CCM_ERR_INVALID_CBC_MAC;
+    }
+    crypto_secure_wipe(mac_full, sizeof(mac_full));
+    crypto_secure_wipe(ctx, sizeof(*ctx));
+    return res;
 }
 
 
@@ -151,60 +280,31 @@ int cipher_encrypt_ccm(cipher_t* cipher,
                        const uint8_t* input, size_t input_len,
                        uint8_t* output)
 {
-    int len = -1;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                stream_block[16] = {0}, zero_block[16] = {0}, block_size;
-
-    if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
-        return CCM_ERR_INVALID_MAC_LENGTH;
-    }
-
-    if (length_encoding < 2 || length_encoding > 8 ||
-            !_fits_in_nbytes(input_len, length_encoding)) {
-        return CCM_ERR_INVALID_LENGTH_ENCODING;
-    }
+    cipher_ccm_ctx_t ctx;
+    int len;
 
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
-    block_size = cipher_get_block_size(cipher);
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, input_len, mac_iv) < 0) {
-        return CCM_ERR_INVALID_DATA_LENGTH;
-    }
-
-    /* MAC calulation (T) with additional data and plaintext */
-    len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
+    len = cipher_ccm_init(&ctx, cipher, mac_length, length_encoding,
+                          nonce, nonce_len, auth_data_len, input_len);
     if (len < 0) {
         return len;
     }
-    len = ccm_compute_cbc_mac(cipher, mac_iv, input, input_len, mac);
+
+    len = cipher_ccm_update_aad(&ctx, auth_data, auth_data_len);
     if (len < 0) {
         return len;
     }
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    memcpy(&nonce_counter[1], nonce,
-           min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size,
-                             zero_block, block_size, stream_block);
+    len = cipher_ccm_encrypt_update(&ctx, input, input_len, output);
     if (len < 0) {
         return len;
     }
 
-    /* Encrypt message in counter mode  */
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             input_len, output);
+    len = cipher_ccm_encrypt_finish(&ctx, output + input_len);
     if (len < 0) {
         return len;
     }
 
-    /* auth value: mac ^ first stream block */
-    for (uint8_t i = 0; i < mac_length; ++i) {
-        output[len + i] = mac[i] ^ stream_block[i];
-    }
-
-    return len + mac_length;
+    return input_len + len;
 }
 
 
@@ -215,10 +315,9 @@ int cipher_decrypt_ccm(cipher_t* cipher,
                        const uint8_t* input, size_t input_len,
                        uint8_t* plain)
 {
-    int len = -1;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                mac_recv[16] = {0}, stream_block[16] = {0}, zero_block[16] = {0},
-                                        plain_len, block_size;
+    cipher_ccm_ctx_t ctx;
+    size_t plain_len;
+    int len;
 
     if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
         return CCM_ERR_INVALID_MAC_LENGTH;
@@ -229,48 +328,30 @@ int cipher_decrypt_ccm(cipher_t* cipher,
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    block_size = cipher_get_block_size(cipher);
-    memcpy(&nonce_counter[1], nonce, min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size, zero_block,
-                             block_size, stream_block);
-    if (len < 0) {
-        return len;
+    if (input_len < mac_length) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
     }
-
-    /* Decrypt message in counter mode */
     plain_len = input_len - mac_length;
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             plain_len, plain);
+
+    len = cipher_ccm_init(&ctx, cipher, mac_length, length_encoding,
+                          nonce, nonce_len, auth_data_len, plain_len);
     if (len < 0) {
         return len;
     }
 
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, plain_len, mac_iv) < 0) {
-        return CCM_ERR_INVALID_DATA_LENGTH;
-    }
-
-    /* MAC calulation (T) with additional data and plaintext */
-    len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
+    len = cipher_ccm_update_aad(&ctx, auth_data, auth_data_len);
     if (len < 0) {
         return len;
     }
-    len = ccm_compute_cbc_mac(cipher, mac_iv, plain, plain_len, mac);
+
+    len = cipher_ccm_decrypt_update(&ctx, input, plain_len, plain);
     if (len < 0) {
         return len;
     }
 
-    /* mac = input[plain_len...plain_len+mac_length] ^ first stream block */
-    for (uint8_t i = 0; i < mac_length; ++i) {
-        mac_recv[i] = input[len + i] ^ stream_block[i];
-    }
-
-    if (!crypto_equals(mac_recv, mac, mac_length)) {
-        return CCM_ERR_INVALID_CBC_MAC;
+    len = cipher_ccm_decrypt_finish(&ctx, input + plain_len);
+    if (len < 0) {
+        return len;
     }
 
     return plain_len;
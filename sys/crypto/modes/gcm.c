@@ -0,0 +1,489 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Crypto mode - Galois/Counter Mode (NIST SP 800-38D)
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/helper.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/gcm.h"
+
+#if defined(MODULE_CRYPTO_GCM_PCLMUL) && (defined(__x86_64__) || defined(__i386__))
+#define GCM_PCLMUL
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+#include "x86_cpu_features.h"
+#endif
+
+#define GCM_BLOCK_SIZE      (16U)
+#define GCM_NONCE_SIZE      (12U)
+
+static inline uint64_t _get_be64(const uint8_t *buf)
+{
+    return ((uint64_t)buf[0] << 56) | ((uint64_t)buf[1] << 48) |
+           ((uint64_t)buf[2] << 40) | ((uint64_t)buf[3] << 32) |
+           ((uint64_t)buf[4] << 24) | ((uint64_t)buf[5] << 16) |
+           ((uint64_t)buf[6] << 8) | (uint64_t)buf[7];
+}
+
+static inline void _put_be64(uint8_t *buf, uint64_t val)
+{
+    for (int i = 7; i >= 0; i--) {
+        buf[i] = val & 0xff;
+        val >>= 8;
+    }
+}
+
+/*
+ * 4-bit tables as described in the GCM specification by McGrew and Viega:
+ * entry i holds H times the field element whose four highest bits are i.
+ * The bits of the field elements are reflected, 1 is 0x80 in the first byte.
+ */
+static void _ghash_table_init(cipher_gcm_ctx_t *ctx, const uint8_t h[16])
+{
+    uint64_t *hl = ctx->key.table.hl, *hh = ctx->key.table.hh;
+    uint64_t vh = _get_be64(h), vl = _get_be64(h + 8);
+
+    hl[0] = 0;
+    hh[0] = 0;
+    hl[8] = vl;
+    hh[8] = vh;
+    /* halving the element is a multiplication with x */
+    for (unsigned i = 4; i > 0; i >>= 1) {
+        uint64_t t = (vl & 1) * 0xe100000000000000ULL;
+
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ t;
+        hl[i] = vl;
+        hh[i] = vh;
+    }
+    for (unsigned i = 2; i <= 8; i *= 2) {
+        for (unsigned j = 1; j < i; j++) {
+            hh[i + j] = hh[i] ^ hh[j];
+            hl[i + j] = hl[i] ^ hl[j];
+        }
+    }
+}
+
+/* reduction of the four bits shifted out of the element */
+static const uint16_t _ghash_last4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static void _ghash_table_mult(const cipher_gcm_ctx_t *ctx, uint8_t x[16])
+{
+    const uint64_t *hl = ctx->key.table.hl, *hh = ctx->key.table.hh;
+    uint64_t zh = 0, zl = 0;
+
+    for (int i = 15; i >= 0; i--) {
+        uint8_t nibble[2] = { x[i] & 0xf, x[i] >> 4 };
+
+        for (unsigned n = 0; n < 2; n++) {
+            if (i != 15 || n != 0) {
+                uint8_t rem = zl & 0xf;
+
+                zl = (zh << 60) | (zl >> 4);
+                zh = (zh >> 4) ^ ((uint64_t)_ghash_last4[rem] << 48);
+            }
+            zh ^= hh[nibble[n]];
+            zl ^= hl[nibble[n]];
+        }
+    }
+
+    _put_be64(x, zh);
+    _put_be64(x + 8, zl);
+}
+
+#ifdef GCM_PCLMUL
+#define GCM_PCLMUL_TARGET   __attribute__((target("pclmul,ssse3,sse2")))
+
+/*
+ * Multiplication with carry-less multiply, following the Intel white paper
+ * "Intel Carry-Less Multiplication Instruction and its Usage for Computing
+ * the GCM Mode": the operands are byte-reflected, multiplied to 256 bits,
+ * shifted left by one bit for the bit reflection and reduced.
+ */
+static GCM_PCLMUL_TARGET void _ghash_pclmul_mult(const cipher_gcm_ctx_t *ctx,
+                                                 uint8_t x[16])
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                       8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)x), bswap);
+    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)ctx->key.h),
+                                 bswap);
+    __m128i lo, hi, mid, t1, t2, t3;
+
+    lo = _mm_clmulepi64_si128(a, b, 0x00);
+    mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10),
+                        _mm_clmulepi64_si128(a, b, 0x01));
+    hi = _mm_clmulepi64_si128(a, b, 0x11);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    /* shift the 256 bit product left by one */
+    t1 = _mm_srli_epi32(lo, 31);
+    t2 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    t3 = _mm_srli_si128(t1, 12);
+    t2 = _mm_slli_si128(t2, 4);
+    t1 = _mm_slli_si128(t1, 4);
+    lo = _mm_or_si128(lo, t1);
+    hi = _mm_or_si128(hi, t2);
+    hi = _mm_or_si128(hi, t3);
+
+    /* reduce modulo x^128 + x^7 + x^2 + x + 1 */
+    t1 = _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30));
+    t1 = _mm_xor_si128(t1, _mm_slli_epi32(lo, 25));
+    t2 = _mm_srli_si128(t1, 4);
+    t1 = _mm_slli_si128(t1, 12);
+    lo = _mm_xor_si128(lo, t1);
+    t3 = _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2));
+    t3 = _mm_xor_si128(t3, _mm_srli_epi32(lo, 7));
+    t3 = _mm_xor_si128(t3, t2);
+    lo = _mm_xor_si128(lo, t3);
+    hi = _mm_xor_si128(hi, lo);
+
+    _mm_storeu_si128((__m128i *)x, _mm_shuffle_epi8(hi, bswap));
+}
+#endif /* GCM_PCLMUL */
+
+static void _ghash_init(cipher_gcm_ctx_t *ctx, const uint8_t h[16])
+{
+#ifdef MODULE_CRYPTO_GCM_PCLMUL
+    ctx->use_pclmul = 0;
+#endif
+#ifdef GCM_PCLMUL
+    if (x86_cpu_supports(X86_CPU_FEATURE_PCLMUL)) {
+        ctx->use_pclmul = 1;
+        memcpy(ctx->key.h, h, GCM_BLOCK_SIZE);
+        return;
+    }
+#endif
+    _ghash_table_init(ctx, h);
+}
+
+/* ghash = ghash * H */
+static inline void _ghash_mult(cipher_gcm_ctx_t *ctx)
+{
+#ifdef GCM_PCLMUL
+    if (ctx->use_pclmul) {
+        _ghash_pclmul_mult(ctx, ctx->ghash);
+        return;
+    }
+#endif
+    _ghash_table_mult(ctx, ctx->ghash);
+}
+
+/* absorbs data that is padded with zeros to full blocks */
+static void _ghash_update(cipher_gcm_ctx_t *ctx, const uint8_t *data,
+                          size_t len)
+{
+    while (len > 0) {
+        size_t n = len < GCM_BLOCK_SIZE ? len : GCM_BLOCK_SIZE;
+
+        for (size_t i = 0; i < n; i++) {
+            ctx->ghash[i] ^= data[i];
+        }
+        _ghash_mult(ctx);
+        data += n;
+        len -= n;
+    }
+}
+
+static void _ghash_lengths(cipher_gcm_ctx_t *ctx, uint64_t len_a,
+                           uint64_t len_c)
+{
+    uint8_t block[GCM_BLOCK_SIZE];
+
+    _put_be64(block, len_a * 8);
+    _put_be64(block + 8, len_c * 8);
+    _ghash_update(ctx, block, sizeof(block));
+}
+
+int cipher_gcm_init(cipher_gcm_ctx_t *ctx, const cipher_t *cipher,
+                    const uint8_t *nonce, size_t nonce_len)
+{
+    /* H = E(K, 0^128) and, for a 96 bit nonce, E(K, J_0) at once */
+    uint8_t blocks[2 * GCM_BLOCK_SIZE] = {0};
+    size_t nblocks = 1;
+
+    if (nonce_len == 0) {
+        return GCM_ERR_INVALID_NONCE_LENGTH;
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->cipher = cipher;
+
+    if (nonce_len == GCM_NONCE_SIZE) {
+        memcpy(ctx->ctr, nonce, GCM_NONCE_SIZE);
+        ctx->ctr[GCM_BLOCK_SIZE - 1] = 1;
+        memcpy(&blocks[GCM_BLOCK_SIZE], ctx->ctr, GCM_BLOCK_SIZE);
+        nblocks = 2;
+    }
+
+    if (cipher_encrypt_blocks(cipher, blocks, blocks, nblocks) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    _ghash_init(ctx, blocks);
+
+    if (nonce_len != GCM_NONCE_SIZE) {
+        /* J_0 = GHASH(nonce || 0^s || 0^64 || [len(nonce)]_64) */
+        _ghash_update(ctx, nonce, nonce_len);
+        _ghash_lengths(ctx, 0, nonce_len);
+        memcpy(ctx->ctr, ctx->ghash, GCM_BLOCK_SIZE);
+        memset(ctx->ghash, 0, GCM_BLOCK_SIZE);
+        if (cipher_encrypt(cipher, ctx->ctr, &blocks[GCM_BLOCK_SIZE]) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+    }
+
+    memcpy(ctx->ek0, &blocks[GCM_BLOCK_SIZE], GCM_BLOCK_SIZE);
+    crypto_block_inc_ctr(ctx->ctr, 4);
+    crypto_secure_wipe(blocks, sizeof(blocks));
+    return 0;
+}
+
+int cipher_gcm_update_aad(cipher_gcm_ctx_t *ctx, const uint8_t *auth_data,
+                          size_t len)
+{
+    if (ctx->aad_done) {
+        return GCM_ERR_INVALID_DATA_LENGTH;
+    }
+    ctx->aad_len += len;
+
+    for (size_t i = 0; i < len; i++) {
+        ctx->ghash[ctx->pos++] ^= auth_data[i];
+        if (ctx->pos == GCM_BLOCK_SIZE) {
+            _ghash_mult(ctx);
+            ctx->pos = 0;
+        }
+    }
+    return 0;
+}
+
+/* the additional data is padded with zeros to a full block */
+static void _gcm_aad_finish(cipher_gcm_ctx_t *ctx)
+{
+    if (!ctx->aad_done) {
+        if (ctx->pos > 0) {
+            _ghash_mult(ctx);
+            ctx->pos = 0;
+        }
+        ctx->aad_done = 1;
+    }
+}
+
+static int _gcm_crypt(cipher_gcm_ctx_t *ctx, const uint8_t *input,
+                      size_t len, uint8_t *output, int decrypt)
+{
+    size_t offset = 0;
+
+    _gcm_aad_finish(ctx);
+    ctx->input_len += len;
+
+    while (offset < len) {
+        if (ctx->pos == 0 && len - offset >= GCM_BLOCK_SIZE) {
+            /* the key stream for up to CIPHER_CTR_BLOCKS full blocks */
+            uint8_t stream[CIPHER_CTR_BLOCKS * GCM_BLOCK_SIZE];
+            size_t nblocks = (len - offset) / GCM_BLOCK_SIZE;
+
+            if (nblocks > CIPHER_CTR_BLOCKS) {
+                nblocks = CIPHER_CTR_BLOCKS;
+            }
+            for (size_t n = 0; n < nblocks; n++) {
+                memcpy(&stream[n * GCM_BLOCK_SIZE], ctx->ctr, GCM_BLOCK_SIZE);
+                crypto_block_inc_ctr(ctx->ctr, 4);
+            }
+            if (cipher_encrypt_blocks(ctx->cipher, stream, stream,
+                                      nblocks) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+
+            for (size_t n = 0; n < nblocks; n++) {
+                const uint8_t *s = &stream[n * GCM_BLOCK_SIZE];
+
+                for (unsigned i = 0; i < GCM_BLOCK_SIZE; i++) {
+                    uint8_t in = input[offset + i];
+                    uint8_t out = in ^ s[i];
+
+                    ctx->ghash[i] ^= decrypt ? in : out;
+                    output[offset + i] = out;
+                }
+                _ghash_mult(ctx);
+                offset += GCM_BLOCK_SIZE;
+            }
+            crypto_secure_wipe(stream, sizeof(stream));
+        }
+        else {
+            uint8_t in = input[offset];
+            uint8_t out;
+
+            if (ctx->pos == 0) {
+                memcpy(ctx->stream, ctx->ctr, GCM_BLOCK_SIZE);
+                crypto_block_inc_ctr(ctx->ctr, 4);
+                if (cipher_encrypt(ctx->cipher, ctx->stream,
+                                   ctx->stream) != 1) {
+                    return CIPHER_ERR_ENC_FAILED;
+                }
+            }
+
+            out = in ^ ctx->stream[ctx->pos];
+            ctx->ghash[ctx->pos++] ^= decrypt ? in : out;
+            output[offset++] = out;
+            if (ctx->pos == GCM_BLOCK_SIZE) {
+                _ghash_mult(ctx);
+                ctx->pos = 0;
+            }
+        }
+    }
+
+    return len;
+}
+
+int cipher_gcm_encrypt_update(cipher_gcm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output)
+{
+    return _gcm_crypt(ctx, input, len, output, 0);
+}
+
+int cipher_gcm_decrypt_update(cipher_gcm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output)
+{
+    return _gcm_crypt(ctx, input, len, output, 1);
+}
+
+/* tag = GHASH(A, C) ^ E(K, J_0) */
+static void _gcm_finish(cipher_gcm_ctx_t *ctx, uint8_t tag[16])
+{
+    _gcm_aad_finish(ctx);
+    if (ctx->pos > 0) {
+        _ghash_mult(ctx);
+        ctx->pos = 0;
+    }
+    _ghash_lengths(ctx, ctx->aad_len, ctx->input_len);
+
+    for (unsigned i = 0; i < GCM_BLOCK_SIZE; i++) {
+        tag[i] = ctx->ghash[i] ^ ctx->ek0[i];
+    }
+}
+
+int cipher_gcm_encrypt_finish(cipher_gcm_ctx_t *ctx, uint8_t *tag,
+                              uint8_t tag_len)
+{
+    uint8_t tag_full[GCM_BLOCK_SIZE];
+
+    if (tag_len < 4 || tag_len > GCM_BLOCK_SIZE) {
+        return GCM_ERR_INVALID_TAG_LENGTH;
+    }
+
+    _gcm_finish(ctx, tag_full);
+    memcpy(tag, tag_full, tag_len);
+    crypto_secure_wipe(tag_full, sizeof(tag_full));
+    crypto_secure_wipe(ctx, sizeof(*ctx));
+    return tag_len;
+}
+
+int cipher_gcm_decrypt_finish(cipher_gcm_ctx_t *ctx, const uint8_t *tag,
+                              uint8_t tag_len)
+{
+    uint8_t tag_full[GCM_BLOCK_SIZE];
+    int res = 0;
+
+    if (tag_len < 4 || tag_len > GCM_BLOCK_SIZE) {
+        return GCM_ERR_INVALID_TAG_LENGTH;
+    }
+
+    _gcm_finish(ctx, tag_full);
+    if (!crypto_equals(tag, tag_full, tag_len)) {
+        res = GCM_ERR_INVALID_TAG;
+    }
+    crypto_secure_wipe(tag_full, sizeof(tag_full));
+    crypto_secure_wipe(ctx, sizeof(*ctx));
+    return res;
+}
+
+int cipher_encrypt_gcm(const cipher_t *cipher,
+                       const uint8_t *auth_data, size_t auth_data_len,
+                       uint8_t tag_len,
+                       const uint8_t *nonce, size_t nonce_len,
+                       const uint8_t *input, size_t input_len,
+                       uint8_t *output)
+{
+    cipher_gcm_ctx_t ctx;
+    int len;
+
+    if (tag_len < 4 || tag_len > GCM_BLOCK_SIZE) {
+        return GCM_ERR_INVALID_TAG_LENGTH;
+    }
+
+    len = cipher_gcm_init(&ctx, cipher, nonce, nonce_len);
+    if (len < 0) {
+        return len;
+    }
+
+    cipher_gcm_update_aad(&ctx, auth_data, auth_data_len);
+    len = cipher_gcm_encrypt_update(&ctx, input, input_len, output);
+    if (len < 0) {
+        return len;
+    }
+
+    return input_len + cipher_gcm_encrypt_finish(&ctx, output + input_len,
+                                                 tag_len);
+}
+
+int cipher_decrypt_gcm(const cipher_t *cipher,
+                       const uint8_t *auth_data, size_t auth_data_len,
+                       uint8_t tag_len,
+                       const uint8_t *nonce, size_t nonce_len,
+                       const uint8_t *input, size_t input_len,
+                       uint8_t *output)
+{
+    cipher_gcm_ctx_t ctx;
+    size_t plain_len;
+    int len;
+
+    if (tag_len < 4 || tag_len > GCM_BLOCK_SIZE) {
+        return GCM_ERR_INVALID_TAG_LENGTH;
+    }
+    if (input_len < tag_len) {
+        return GCM_ERR_INVALID_DATA_LENGTH;
+    }
+    plain_len = input_len - tag_len;
+
+    len = cipher_gcm_init(&ctx, cipher, nonce, nonce_len);
+    if (len < 0) {
+        return len;
+    }
+
+    cipher_gcm_update_aad(&ctx, auth_data, auth_data_len);
+    len = cipher_gcm_decrypt_update(&ctx, input, plain_len, output);
+    if (len < 0) {
+        return len;
+    }
+
+    len = cipher_gcm_decrypt_finish(&ctx, input + plain_len, tag_len);
+    if (len < 0) {
+        crypto_secure_wipe(output, plain_len);
+        return len;
+    }
+
+    return plain_len;
+}
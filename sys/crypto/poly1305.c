@@ -12,7 +12,8 @@
  * @{
  * @file
  * @brief   Implementation of Poly1305. Based on Floodberry's and Loup
- *          Valliant's implementation. Optimized for small flash size.
+ *          Valliant's implementation. Optimized for small flash size, or
+ *          with 64 bit limbs (poly1305-donna-64) for 64 bit CPUs.
  *
  * @author  Koen Zandberg <koen@bergzand.net>
  * @}
@@ -21,8 +22,6 @@
 #include <string.h>
 #include "crypto/poly1305.h"
 
-static void poly1305_block(poly1305_ctx_t *ctx, uint8_t c4);
-
 static uint32_t u8to32(const uint8_t *p)
 {
     return
@@ -32,6 +31,174 @@ static uint32_t u8to32(const uint8_t *p)
         ((uint32_t)p[3] << 24));
 }
 
+#if POLY1305_64BIT
+#define MASK44  (0xfffffffffffULL)
+#define MASK42  (0x3ffffffffffULL)
+
+typedef unsigned __int128 u128;
+
+static uint64_t u8to64(const uint8_t *p)
+{
+    return (uint64_t)u8to32(p) | ((uint64_t)u8to32(p + 4) << 32);
+}
+
+static void u64to8(uint8_t *p, uint64_t v)
+{
+    for (unsigned i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+/*
+ * Hash full blocks, hibit is 2^128 in the top limb, or 0 for the padded last
+ * block
+ */
+static void poly1305_blocks(poly1305_ctx_t *ctx, const uint8_t *data,
+                            size_t len, uint64_t hibit)
+{
+    const uint64_t r0 = ctx->r[0];
+    const uint64_t r1 = ctx->r[1];
+    const uint64_t r2 = ctx->r[2];
+    /* 2^130 = 5 modulo p, and r1, r2 are shifted by 2 bit to the limbs */
+    const uint64_t s1 = r1 * (5 << 2);
+    const uint64_t s2 = r2 * (5 << 2);
+    uint64_t h0 = ctx->h[0];
+    uint64_t h1 = ctx->h[1];
+    uint64_t h2 = ctx->h[2];
+
+    for (; len >= POLY1305_BLOCK_SIZE; len -= POLY1305_BLOCK_SIZE) {
+        const uint64_t t0 = u8to64(data);
+        const uint64_t t1 = u8to64(data + 8);
+
+        h0 += t0 & MASK44;
+        h1 += ((t0 >> 44) | (t1 << 20)) & MASK44;
+        h2 += ((t1 >> 24) & MASK42) | hibit;
+
+        /* h * r, without carry propagation */
+        u128 d0 = (u128)h0 * r0 + (u128)h1 * s2 + (u128)h2 * s1;
+        u128 d1 = (u128)h0 * r1 + (u128)h1 * r0 + (u128)h2 * s2;
+        u128 d2 = (u128)h0 * r2 + (u128)h1 * r1 + (u128)h2 * r0;
+
+        /* partial reduction modulo 2^130 - 5 */
+        uint64_t c = (uint64_t)(d0 >> 44);
+        h0 = (uint64_t)d0 & MASK44;
+        d1 += c;
+        c = (uint64_t)(d1 >> 44);
+        h1 = (uint64_t)d1 & MASK44;
+        d2 += c;
+        c = (uint64_t)(d2 >> 42);
+        h2 = (uint64_t)d2 & MASK42;
+        h0 += c * 5;
+        c = h0 >> 44;
+        h0 &= MASK44;
+        h1 += c;
+
+        data += POLY1305_BLOCK_SIZE;
+    }
+
+    ctx->h[0] = h0;
+    ctx->h[1] = h1;
+    ctx->h[2] = h2;
+}
+
+void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len)
+{
+    /* complete a started block */
+    if (ctx->c_idx) {
+        size_t n = POLY1305_BLOCK_SIZE - ctx->c_idx;
+
+        n = (len < n) ? len : n;
+        memcpy(ctx->c + ctx->c_idx, data, n);
+        ctx->c_idx += n;
+        data += n;
+        len -= n;
+        if (ctx->c_idx < POLY1305_BLOCK_SIZE) {
+            return;
+        }
+        poly1305_blocks(ctx, ctx->c, POLY1305_BLOCK_SIZE, (uint64_t)1 << 40);
+        ctx->c_idx = 0;
+    }
+
+    poly1305_blocks(ctx, data, len, (uint64_t)1 << 40);
+    data += len & ~(size_t)(POLY1305_BLOCK_SIZE - 1);
+    len &= POLY1305_BLOCK_SIZE - 1;
+
+    memcpy(ctx->c, data, len);
+    ctx->c_idx = len;
+}
+
+void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key)
+{
+    /* load and clamp key */
+    const uint64_t t0 = u8to64(key);
+    const uint64_t t1 = u8to64(key + 8);
+
+    ctx->r[0] = t0 & 0xffc0fffffffULL;
+    ctx->r[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffffULL;
+    ctx->r[2] = (t1 >> 24) & 0x00ffffffc0fULL;
+    ctx->pad[0] = u8to64(key + 16);
+    ctx->pad[1] = u8to64(key + 24);
+
+    /* Zero the hash */
+    memset(ctx->h, 0, sizeof(ctx->h));
+    ctx->c_idx = 0;
+}
+
+void poly1305_finish(poly1305_ctx_t *ctx, uint8_t *mac)
+{
+    /* Process the last block if there is data remaining */
+    if (ctx->c_idx) {
+        /* the final 1 according to remaining input length */
+        ctx->c[ctx->c_idx++] = 1;
+        memset(ctx->c + ctx->c_idx, 0, POLY1305_BLOCK_SIZE - ctx->c_idx);
+        poly1305_blocks(ctx, ctx->c, POLY1305_BLOCK_SIZE, 0);
+    }
+
+    /* full carry propagation */
+    uint64_t h0 = ctx->h[0];
+    uint64_t h1 = ctx->h[1];
+    uint64_t h2 = ctx->h[2];
+    uint64_t c;
+
+    c = h1 >> 44; h1 &= MASK44;
+    h2 += c;      c = h2 >> 42; h2 &= MASK42;
+    h0 += c * 5;  c = h0 >> 44; h0 &= MASK44;
+    h1 += c;      c = h1 >> 44; h1 &= MASK44;
+    h2 += c;      c = h2 >> 42; h2 &= MASK42;
+    h0 += c * 5;  c = h0 >> 44; h0 &= MASK44;
+    h1 += c;
+
+    /* g = h - (2^130 - 5), taken if it does not underflow */
+    uint64_t g0 = h0 + 5;
+    c = g0 >> 44;
+    g0 &= MASK44;
+    uint64_t g1 = h1 + c;
+    c = g1 >> 44;
+    g1 &= MASK44;
+    uint64_t g2 = h2 + c - ((uint64_t)1 << 42);
+
+    c = (g2 >> 63) - 1;
+    h0 = (h0 & ~c) | (g0 & c);
+    h1 = (h1 & ~c) | (g1 & c);
+    h2 = (h2 & ~c) | (g2 & c);
+
+    /* h + pad */
+    const uint64_t t0 = ctx->pad[0];
+    const uint64_t t1 = ctx->pad[1];
+
+    h0 += t0 & MASK44;
+    c = h0 >> 44;
+    h0 &= MASK44;
+    h1 += (((t0 >> 44) | (t1 << 20)) & MASK44) + c;
+    c = h1 >> 44;
+    h1 &= MASK44;
+    h2 += ((t1 >> 24) & MASK42) + c;
+    h2 &= MASK42;
+
+    u64to8(mac, h0 | (h1 << 44));
+    u64to8(mac + 8, (h1 >> 20) | (h2 << 24));
+}
+#else /* POLY1305_64BIT */
 static void u32to8(uint8_t *p, uint32_t v)
 {
     p[0] = (uint8_t)(v);
@@ -102,13 +269,30 @@ static void _take_input(poly1305_ctx_t *ctx, uint8_t input)
 
 void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len)
 {
-    for (size_t i = 0; i < len; i++) {
-        _take_input(ctx, data[i]);
+    /* complete a started block */
+    for (; ctx->c_idx && len; len--) {
+        _take_input(ctx, *data++);
         if (ctx->c_idx == 16) {
             poly1305_block(ctx, 1);
             _clear_c(ctx);
         }
     }
+
+    /* full blocks are read directly, a started block is complete by now */
+    if (len >= 16) {
+        for (; len >= 16; len -= 16) {
+            for (size_t i = 0; i < 4; i++) {
+                ctx->c[i] = u8to32(&data[4 * i]);
+            }
+            poly1305_block(ctx, 1);
+            data += 16;
+        }
+        _clear_c(ctx);
+    }
+
+    for (; len; len--) {
+        _take_input(ctx, *data++);
+    }
 }
 
 void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key)
@@ -161,6 +345,7 @@ void poly1305_finish(poly1305_ctx_t *ctx, uint8_t *mac)
     u32to8(mac+12, uu3);
 
 }
+#endif /* POLY1305_64BIT */
 
 void poly1305_auth(uint8_t *mac, const uint8_t *data, size_t len, const uint8_t *key)
 {
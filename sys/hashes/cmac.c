@@ -42,6 +42,31 @@ static void _leftshift(uint8_t *x, uint8_t *y)
     y[15] = x[15] << 1;
 }
 
+/* doubling in GF(2^128), for the subkeys */
+static void _subkey(uint8_t *x, uint8_t *y)
+{
+    uint8_t msb = x[0] & 0x80;
+
+    _leftshift(x, y);
+    if (msb) {
+        y[15] ^= 0x87;
+    }
+}
+
+/* in and out may be the same block */
+static void _encrypt(cmac_context_t *ctx, uint8_t *in, uint8_t *out)
+{
+    if (ctx->key) {
+        aes_schedule_encrypt_blocks(&ctx->key->aes, in, out, 1);
+    }
+    else {
+        uint8_t d[CMAC_BLOCK_SIZE];
+
+        cipher_encrypt(&ctx->aes_ctx, in, d);
+        memcpy(out, d, CMAC_BLOCK_SIZE);
+    }
+}
+
 int cmac_init(cmac_context_t *ctx, const uint8_t *key, uint8_t key_size)
 {
     if (key_size != CMAC_BLOCK_SIZE) {
@@ -52,17 +77,42 @@ int cmac_init(cmac_context_t *ctx, const uint8_t *key, uint8_t key_size)
     return cipher_init(&(ctx->aes_ctx), CIPHER_AES_128, key, key_size);
 }
 
-void cmac_update(cmac_context_t *ctx, const void *data, size_t len)
+int cmac_key_init(cmac_key_t *key, const uint8_t *k, uint8_t key_size)
 {
-    uint8_t d[16];
+    uint8_t L[CMAC_BLOCK_SIZE];
+    int res;
 
+    if (key_size != CMAC_BLOCK_SIZE) {
+        return CIPHER_ERR_INVALID_KEY_SIZE;
+    }
+
+    res = aes_schedule_init(&key->aes, k, key_size);
+    if (res != CIPHER_INIT_SUCCESS) {
+        return res;
+    }
+
+    memset(L, 0, CMAC_BLOCK_SIZE);
+    aes_schedule_encrypt_blocks(&key->aes, L, L, 1);
+    _subkey(L, key->K1);
+    _subkey(key->K1, key->K2);
+    return CIPHER_INIT_SUCCESS;
+}
+
+void cmac_init_key(cmac_context_t *ctx, const cmac_key_t *key)
+{
+    ctx->key = key;
+    memset(ctx->X, 0, CMAC_BLOCK_SIZE);
+    ctx->M_n = 0;
+}
+
+void cmac_update(cmac_context_t *ctx, const void *data, size_t len)
+{
     while (len) {
         uint8_t c;
         if (ctx->M_n == 16) {
             ctx->M_n = 0;
             _xor128(ctx->M_last, ctx->X);
-            cipher_encrypt(&ctx->aes_ctx, ctx->X, d);
-            memcpy(ctx->X, d, CMAC_BLOCK_SIZE);
+            _encrypt(ctx, ctx->X, ctx->X);
         }
         c = MIN(CMAC_BLOCK_SIZE - ctx->M_n, len);
         memcpy(ctx->M_last + ctx->M_n, data, c);
@@ -78,36 +128,32 @@ void cmac_update(cmac_context_t *ctx, const void *data, size_t len)
 
 void cmac_final(cmac_context_t *ctx, void *digest)
 {
-    /* Generate subkeys */
     uint8_t K[CMAC_BLOCK_SIZE];
-    uint8_t L[CMAC_BLOCK_SIZE];
-
-    memset(K, 0, CMAC_BLOCK_SIZE);
-    cipher_encrypt(&ctx->aes_ctx, K, L);
 
-    if (L[0] & 0x80) {
-        _leftshift(L, K);
-        K[15] ^= 0x87;
+    if (ctx->key) {
+        memcpy(K, (ctx->M_n != 16) ? ctx->key->K2 : ctx->key->K1,
+               CMAC_BLOCK_SIZE);
     }
     else {
-        _leftshift(L, K);
+        /* Generate subkeys */
+        uint8_t L[CMAC_BLOCK_SIZE];
+
+        memset(K, 0, CMAC_BLOCK_SIZE);
+        cipher_encrypt(&ctx->aes_ctx, K, L);
+        _subkey(L, K);
+        if (ctx->M_n != 16) {
+            /* Generate K2 */
+            _subkey(K, K);
+        }
     }
 
     if (ctx->M_n != 16) {
-        /* Generate K2 */
-        if (K[0] & 0x80) {
-            _leftshift(K, K);
-            K[15] ^= 0x87;
-        }
-        else {
-            _leftshift(K, K);
-        }
         /* Padding */
         memset(ctx->M_last + ctx->M_n, 0, CMAC_BLOCK_SIZE - ctx->M_n);
         ctx->M_last[ctx->M_n] = 0x80;
     }
     _xor128(K, ctx->M_last);
     _xor128(ctx->M_last, ctx->X);
-    cipher_encrypt(&ctx->aes_ctx, ctx->X, L);
-    memcpy(digest, L, CMAC_BLOCK_SIZE);
+    _encrypt(ctx, ctx->X, K);
+    memcpy(digest, K, CMAC_BLOCK_SIZE);
 }
@@ -50,6 +50,11 @@
 
 #include "hashes/sha256.h"
 
+#if defined(MODULE_HASHES_SHA256_NI) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#include "x86_cpu_features.h"
+#endif
+
 #ifdef __BIG_ENDIAN__
 /* Copy a vector of big-endian uint32_t into a vector of bytes */
 #define be32enc_vect memcpy
@@ -122,6 +127,80 @@ static const uint32_t K[64] = {
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
 };
 
+static const uint32_t IV[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+/*
+ * One round, the caller rotates the names of the working variables instead
+ * of moving their values. Works on uint32_t and on vectors of them.
+ */
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, k, w) \
+    do { \
+        h += S1(e) + Ch(e, f, g) + k + w; \
+        d += h; \
+        h += S0(a) + Maj(a, b, c); \
+    } while (0)
+
+/* 16 rounds, taking the words of the message schedule from W[0..15] */
+#define SHA256_ROUNDS_16(S, W, i) \
+    do { \
+        SHA256_ROUND(S[0], S[1], S[2], S[3], S[4], S[5], S[6], S[7], K[i +  0], W[0]); \
+        SHA256_ROUND(S[7], S[0], S[1], S[2], S[3], S[4], S[5], S[6], K[i +  1], W[1]); \
+        SHA256_ROUND(S[6], S[7], S[0], S[1], S[2], S[3], S[4], S[5], K[i +  2], W[2]); \
+        SHA256_ROUND(S[5], S[6], S[7], S[0], S[1], S[2], S[3], S[4], K[i +  3], W[3]); \
+        SHA256_ROUND(S[4], S[5], S[6], S[7], S[0], S[1], S[2], S[3], K[i +  4], W[4]); \
+        SHA256_ROUND(S[3], S[4], S[5], S[6], S[7], S[0], S[1], S[2], K[i +  5], W[5]); \
+        SHA256_ROUND(S[2], S[3], S[4], S[5], S[6], S[7], S[0], S[1], K[i +  6], W[6]); \
+        SHA256_ROUND(S[1], S[2], S[3], S[4], S[5], S[6], S[7], S[0], K[i +  7], W[7]); \
+        SHA256_ROUND(S[0], S[1], S[2], S[3], S[4], S[5], S[6], S[7], K[i +  8], W[8]); \
+        SHA256_ROUND(S[7], S[0], S[1], S[2], S[3], S[4], S[5], S[6], K[i +  9], W[9]); \
+        SHA256_ROUND(S[6], S[7], S[0], S[1], S[2], S[3], S[4], S[5], K[i + 10], W[10]); \
+        SHA256_ROUND(S[5], S[6], S[7], S[0], S[1], S[2], S[3], S[4], K[i + 11], W[11]); \
+        SHA256_ROUND(S[4], S[5], S[6], S[7], S[0], S[1], S[2], S[3], K[i + 12], W[12]); \
+        SHA256_ROUND(S[3], S[4], S[5], S[6], S[7], S[0], S[1], S[2], K[i + 13], W[13]); \
+        SHA256_ROUND(S[2], S[3], S[4], S[5], S[6], S[7], S[0], S[1], K[i + 14], W[14]); \
+        SHA256_ROUND(S[1], S[2], S[3], S[4], S[5], S[6], S[7], S[0], K[i + 15], W[15]); \
+    } while (0)
+
+/*
+ * Next 16 words of the message schedule, in place. Words W[j - 2] and
+ * W[j - 7] have already been replaced when W[j] is computed.
+ */
+#define SHA256_SCHEDULE_16(W) \
+    do { \
+        for (unsigned j = 0; j < 16; j++) { \
+            W[j] += s1(W[(j + 14) & 15]) + W[(j + 9) & 15] + \
+                    s0(W[(j + 1) & 15]); \
+        } \
+    } while (0)
+
+#ifdef MODULE_HASHES_SHA256_UNROLL
+/*
+ * SHA256 block compression function.  The 256-bit state is transformed via
+ * the 512-bit input block to produce a new state.
+ * The rounds are unrolled and only 16 words of the schedule are kept.
+ */
+static void sha256_transform(uint32_t *state, const unsigned char block[64])
+{
+    uint32_t W[16];
+    uint32_t S[8];
+
+    be32dec_vect(W, block, 64);
+    memcpy(S, state, 32);
+
+    SHA256_ROUNDS_16(S, W, 0);
+    for (unsigned i = 16; i < 64; i += 16) {
+        SHA256_SCHEDULE_16(W);
+        SHA256_ROUNDS_16(S, W, i);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        state[i] += S[i];
+    }
+}
+#else /* MODULE_HASHES_SHA256_UNROLL */
 /*
  * SHA256 block compression function.  The 256-bit state is transformed via
  * the 512-bit input block to produce a new state.
@@ -159,6 +238,88 @@ static void sha256_transform(uint32_t *state, const unsigned char block[64])
         state[i] += S[i];
     }
 }
+#endif /* MODULE_HASHES_SHA256_UNROLL */
+
+#if defined(MODULE_HASHES_SHA256_NI) && (defined(__x86_64__) || defined(__i386__))
+#define SHA256_NI_TARGET    __attribute__((target("sha,sse4.1,ssse3")))
+
+/*
+ * Compress blocks with the SHA instructions. Each sha256rnds2 does two
+ * rounds on the state split into ABEF and CDGH, sha256msg1 and sha256msg2
+ * extend the message schedule by four words.
+ */
+static SHA256_NI_TARGET void sha256_ni_transform(uint32_t *state,
+                                                 const unsigned char *data,
+                                                 size_t nblocks)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                         0x0405060700010203ULL);
+    __m128i tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+    __m128i st1 = _mm_loadu_si128((const __m128i *)&state[4]);
+    __m128i st0;
+
+    /* ABCD and EFGH to ABEF and CDGH */
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    st1 = _mm_shuffle_epi32(st1, 0x1B);
+    st0 = _mm_alignr_epi8(tmp, st1, 8);
+    st1 = _mm_blend_epi16(st1, tmp, 0xF0);
+
+    for (; nblocks > 0; nblocks--) {
+        __m128i abef = st0;
+        __m128i cdgh = st1;
+        __m128i msg[4];
+
+        for (unsigned i = 0; i < 4; i++) {
+            msg[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(data + 16 * i)), bswap);
+        }
+        for (unsigned g = 0; g < 16; g++) {
+            __m128i m = _mm_add_epi32(msg[g & 3],
+                                      _mm_loadu_si128((const __m128i *)&K[4 * g]));
+
+            st1 = _mm_sha256rnds2_epu32(st1, st0, m);
+            if (g >= 3 && g < 15) {
+                tmp = _mm_alignr_epi8(msg[g & 3], msg[(g + 3) & 3], 4);
+                msg[(g + 1) & 3] = _mm_add_epi32(msg[(g + 1) & 3], tmp);
+                msg[(g + 1) & 3] = _mm_sha256msg2_epu32(msg[(g + 1) & 3],
+                                                        msg[g & 3]);
+            }
+            m = _mm_shuffle_epi32(m, 0x0E);
+            st0 = _mm_sha256rnds2_epu32(st0, st1, m);
+            if (g >= 1 && g < 13) {
+                msg[(g + 3) & 3] = _mm_sha256msg1_epu32(msg[(g + 3) & 3],
+                                                        msg[g & 3]);
+            }
+        }
+        st0 = _mm_add_epi32(st0, abef);
+        st1 = _mm_add_epi32(st1, cdgh);
+        data += 64;
+    }
+
+    /* ABEF and CDGH back to ABCD and EFGH */
+    tmp = _mm_shuffle_epi32(st0, 0x1B);
+    st1 = _mm_shuffle_epi32(st1, 0xB1);
+    st0 = _mm_blend_epi16(tmp, st1, 0xF0);
+    st1 = _mm_alignr_epi8(st1, tmp, 8);
+    _mm_storeu_si128((__m128i *)&state[0], st0);
+    _mm_storeu_si128((__m128i *)&state[4], st1);
+}
+#endif /* MODULE_HASHES_SHA256_NI && (__x86_64__ || __i386__) */
+
+static void sha256_transform_blocks(uint32_t *state, const unsigned char *data,
+                                    size_t nblocks)
+{
+#if defined(MODULE_HASHES_SHA256_NI) && (defined(__x86_64__) || defined(__i386__))
+    if (x86_cpu_supports(X86_CPU_FEATURE_SHA | X86_CPU_FEATURE_SSE41)) {
+        sha256_ni_transform(state, data, nblocks);
+        return;
+    }
+#endif
+    for (; nblocks > 0; nblocks--) {
+        sha256_transform(state, data);
+        data += 64;
+    }
+}
 
 static unsigned char PAD[64] = {
     0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -194,14 +355,7 @@ void sha256_init(sha256_context_t *ctx)
     ctx->count[0] = ctx->count[1] = 0;
 
     /* Magic initialization constants */
-    ctx->state[0] = 0x6A09E667;
-    ctx->state[1] = 0xBB67AE85;
-    ctx->state[2] = 0x3C6EF372;
-    ctx->state[3] = 0xA54FF53A;
-    ctx->state[4] = 0x510E527F;
-    ctx->state[5] = 0x9B05688C;
-    ctx->state[6] = 0x1F83D9AB;
-    ctx->state[7] = 0x5BE0CD19;
+    memcpy(ctx->state, IV, sizeof(IV));
 }
 
 /* Add bytes into the hash */
@@ -233,16 +387,14 @@ void sha256_update(sha256_context_t *ctx, const void *data, size_t len)
     const unsigned char *src = data;
 
     memcpy(&ctx->buf[r], src, 64 - r);
-    sha256_transform(ctx->state, ctx->buf);
+    sha256_transform_blocks(ctx->state, ctx->buf, 1);
     src += 64 - r;
     len -= 64 - r;
 
     /* Perform complete blocks */
-    while (len >= 64) {
-        sha256_transform(ctx->state, src);
-        src += 64;
-        len -= 64;
-    }
+    sha256_transform_blocks(ctx->state, src, len / 64);
+    src += len & ~(size_t)0x3f;
+    len &= 0x3f;
 
     /* Copy left over data into buffer */
     memcpy(ctx->buf, src, len);
@@ -280,6 +432,209 @@ void *sha256(const void *data, size_t len, void *digest)
     return digest;
 }
 
+/* Vector of one word per lane, for the multi-buffer transform */
+typedef uint32_t sha256_vec_t __attribute__((vector_size(4 * SHA256_MB_LANES)));
+
+/* State of one lane of sha256_mb() */
+typedef struct {
+    const unsigned char *src;   /* next block of the message */
+    size_t blocks;              /* blocks left at src */
+    unsigned tail_blocks;       /* blocks in tail, once src is done */
+    size_t msg;                 /* index of the message */
+    unsigned char tail[128];    /* last partial block and the padding */
+} sha256_mb_lane_t;
+
+static inline __attribute__((always_inline))
+void sha256_mb_transform_body(sha256_vec_t *state,
+                              const unsigned char *const *block)
+{
+    sha256_vec_t W[16];
+    sha256_vec_t S[8];
+
+    /* transpose the message words into the lanes */
+    for (unsigned i = 0; i < 16; i++) {
+        for (unsigned l = 0; l < SHA256_MB_LANES; l++) {
+            const unsigned char *p = block[l] + 4 * i;
+
+            W[i][l] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                      ((uint32_t)p[2] << 8) | p[3];
+        }
+    }
+    memcpy(S, state, sizeof(S));
+
+    SHA256_ROUNDS_16(S, W, 0);
+    for (unsigned i = 16; i < 64; i += 16) {
+        SHA256_SCHEDULE_16(W);
+        SHA256_ROUNDS_16(S, W, i);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        state[i] += S[i];
+    }
+}
+
+static void sha256_mb_transform_generic(sha256_vec_t *state,
+                                        const unsigned char *const *block)
+{
+    sha256_mb_transform_body(state, block);
+}
+
+#if defined(MODULE_HASHES_SHA256_NI) && (defined(__x86_64__) || defined(__i386__))
+static __attribute__((target("avx2")))
+void sha256_mb_transform_avx2(sha256_vec_t *state,
+                              const unsigned char *const *block)
+{
+    sha256_mb_transform_body(state, block);
+}
+#endif
+
+static void sha256_mb_transform(sha256_vec_t *state,
+                                const unsigned char *const *block)
+{
+#if defined(MODULE_HASHES_SHA256_NI) && (defined(__x86_64__) || defined(__i386__))
+    if (x86_cpu_supports(X86_CPU_FEATURE_AVX2)) {
+        sha256_mb_transform_avx2(state, block);
+        return;
+    }
+#endif
+    sha256_mb_transform_generic(state, block);
+}
+
+/*
+ * Put a message into a lane, with its padding in the tail. The lane starts
+ * from iv, prefix bytes are counted as hashed already.
+ */
+static void sha256_mb_start(sha256_mb_lane_t *lane, sha256_vec_t *state,
+                            unsigned l, const uint32_t *iv, size_t prefix,
+                            const void *data, size_t len, size_t msg)
+{
+    size_t rem = len & 0x3f;
+    uint64_t bits = ((uint64_t)len + prefix) << 3;
+
+    unsigned tail_blocks = (rem < 56) ? 1 : 2;
+
+    memcpy(lane->tail, (const unsigned char *)data + (len - rem), rem);
+    memset(lane->tail + rem, 0, sizeof(lane->tail) - rem);
+    lane->tail[rem] = 0x80;
+    for (unsigned i = 0; i < 8; i++) {
+        lane->tail[tail_blocks * 64 - 1 - i] = (unsigned char)(bits >> (8 * i));
+    }
+    lane->msg = msg;
+    if (len >> 6) {
+        lane->src = data;
+        lane->blocks = len >> 6;
+        lane->tail_blocks = tail_blocks;
+    }
+    else {
+        lane->src = lane->tail;
+        lane->blocks = tail_blocks;
+        lane->tail_blocks = 0;
+    }
+    for (unsigned i = 0; i < 8; i++) {
+        state[i][l] = iv[i];
+    }
+}
+
+/*
+ * Put message msg into a lane. Without a key it is hashed from the IV,
+ * otherwise it continues the inner or outer hash of HMAC after key[msg].
+ * Without len the messages are digests.
+ */
+static void sha256_mb_next(sha256_mb_lane_t *lane, sha256_vec_t *state,
+                           unsigned l, const hmac_sha256_key_t *key,
+                           int outer, const void *const *data,
+                           const size_t *len, size_t msg)
+{
+    size_t msg_len = len ? len[msg] : SHA256_DIGEST_LENGTH;
+
+    if (key == NULL) {
+        sha256_mb_start(lane, state, l, IV, 0, data[msg], msg_len, msg);
+    }
+    else {
+        sha256_mb_start(lane, state, l, outer ? key[msg].out : key[msg].in,
+                        SHA256_INTERNAL_BLOCK_SIZE, data[msg], msg_len, msg);
+    }
+}
+
+static void sha256_mb_run(const hmac_sha256_key_t *key, int outer,
+                          const void *const *data, const size_t *len,
+                          void *const *digest, size_t num)
+{
+    sha256_mb_lane_t lanes[SHA256_MB_LANES];
+    sha256_vec_t state[8];
+    const unsigned char *block[SHA256_MB_LANES];
+    unsigned active = 0;
+    size_t next = 0;
+
+    for (unsigned l = 0; l < SHA256_MB_LANES; l++) {
+        if (next < num) {
+            sha256_mb_next(&lanes[l], state, l, key, outer, data, len, next);
+            next++;
+            active |= 1U << l;
+        }
+    }
+
+    /* the lanes are worth it as long as more than one message is left */
+    while ((active & (active - 1)) || (next < num)) {
+        for (unsigned l = 0; l < SHA256_MB_LANES; l++) {
+            /* an idle lane hashes anything, its result is not used */
+            block[l] = (active & (1U << l)) ? lanes[l].src : PAD;
+        }
+        sha256_mb_transform(state, block);
+        for (unsigned l = 0; l < SHA256_MB_LANES; l++) {
+            sha256_mb_lane_t *lane = &lanes[l];
+
+            if (!(active & (1U << l))) {
+                continue;
+            }
+            lane->src += 64;
+            if (--lane->blocks) {
+                continue;
+            }
+            if (lane->tail_blocks) {
+                lane->src = lane->tail;
+                lane->blocks = lane->tail_blocks;
+                lane->tail_blocks = 0;
+                continue;
+            }
+
+            uint32_t st[8];
+
+            for (unsigned i = 0; i < 8; i++) {
+                st[i] = state[i][l];
+            }
+            be32enc_vect(digest[lane->msg], st, 32);
+            if (next < num) {
+                sha256_mb_next(lane, state, l, key, outer, data, len, next);
+                next++;
+            }
+            else {
+                active &= ~(1U << l);
+            }
+        }
+    }
+
+    /* finish the last message on its own */
+    if (active) {
+        unsigned l = __builtin_ctz(active);
+        sha256_mb_lane_t *lane = &lanes[l];
+        uint32_t st[8];
+
+        for (unsigned i = 0; i < 8; i++) {
+            st[i] = state[i][l];
+        }
+        sha256_transform_blocks(st, lane->src, lane->blocks);
+        sha256_transform_blocks(st, lane->tail, lane->tail_blocks);
+        be32enc_vect(digest[lane->msg], st, 32);
+    }
+}
+
+void sha256_mb(const void *const *data, const size_t *len,
+               void *const *digest, size_t num)
+{
+    sha256_mb_run(NULL, 0, data, len, digest, num);
+}
+
 
 void hmac_sha256_init(hmac_context_t *ctx, const void *key, size_t key_length)
 {
@@ -323,6 +678,87 @@ void hmac_sha256_init(hmac_context_t *ctx, const void *key, size_t key_length)
 
 }
 
+void hmac_sha256_key_init(hmac_sha256_key_t *key, const void *k,
+                          size_t key_length)
+{
+    hmac_context_t ctx;
+
+    hmac_sha256_init(&ctx, k, key_length);
+    memcpy(key->in, ctx.c_in.state, sizeof(key->in));
+    memcpy(key->out, ctx.c_out.state, sizeof(key->out));
+}
+
+void hmac_sha256_key_init_mb(hmac_sha256_key_t *key, const void *const *k,
+                             size_t key_length, size_t num)
+{
+    unsigned char pad[SHA256_MB_LANES][SHA256_INTERNAL_BLOCK_SIZE];
+    const unsigned char *block[SHA256_MB_LANES];
+    sha256_vec_t state[8];
+
+    if (key_length > SHA256_INTERNAL_BLOCK_SIZE) {
+        /* the keys are hashed first */
+        for (size_t i = 0; i < num; i++) {
+            hmac_sha256_key_init(&key[i], k[i], key_length);
+        }
+        return;
+    }
+
+    /* the inner and outer pad of each key are one block in a lane each */
+    for (size_t p = 0; p < 2 * num; p += SHA256_MB_LANES) {
+        for (unsigned l = 0; l < SHA256_MB_LANES; l++) {
+            size_t n = p + l;
+
+            for (unsigned i = 0; i < 8; i++) {
+                state[i][l] = IV[i];
+            }
+            if (n >= 2 * num) {
+                block[l] = PAD;
+                continue;
+            }
+
+            const unsigned char *kn = k[n / 2];
+            unsigned char x = (n & 1) ? 0x5c : 0x36;
+
+            for (size_t i = 0; i < key_length; i++) {
+                pad[l][i] = kn[i] ^ x;
+            }
+            memset(pad[l] + key_length, x, sizeof(pad[l]) - key_length);
+            block[l] = pad[l];
+        }
+        sha256_mb_transform(state, block);
+        for (unsigned l = 0; (l < SHA256_MB_LANES) && (p + l < 2 * num); l++) {
+            size_t n = p + l;
+            uint32_t *dst = (n & 1) ? key[n / 2].out : key[n / 2].in;
+
+            for (unsigned i = 0; i < 8; i++) {
+                dst[i] = state[i][l];
+            }
+        }
+    }
+}
+
+void hmac_sha256_mb(const hmac_sha256_key_t *key, const void *const *data,
+                    const size_t *len, void *const *digest, size_t num)
+{
+    sha256_mb_run(key, 0, data, len, digest, num);
+    /* the inner digests are hashed in place */
+    sha256_mb_run(key, 1, (const void *const *)digest, NULL, digest, num);
+}
+
+static void _init_after_key_pad(sha256_context_t *ctx, const uint32_t *state)
+{
+    /* one block of key pad processed */
+    ctx->count[0] = 0;
+    ctx->count[1] = SHA256_INTERNAL_BLOCK_SIZE * 8;
+    memcpy(ctx->state, state, sizeof(ctx->state));
+}
+
+void hmac_sha256_init_key(hmac_context_t *ctx, const hmac_sha256_key_t *key)
+{
+    _init_after_key_pad(&ctx->c_in, key->in);
+    _init_after_key_pad(&ctx->c_out, key->out);
+}
+
 void hmac_sha256_update(hmac_context_t *ctx, const void *data, size_t len)
 {
     sha256_update(&ctx->c_in, data, len);
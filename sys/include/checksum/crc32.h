@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc32 CRC32
+ * @ingroup     sys_checksum
+ *
+ * @brief       CRC-32 and CRC-32C checksum algorithms
+ * @details     CRC-32 is the checksum of Ethernet, zlib and PNG (polynomial
+ *              0x04C11DB7), CRC-32C the one of iSCSI, ext4 and SCTP
+ *              (Castagnoli polynomial 0x1EDC6F41). Both are computed
+ *              reflected, starting from and finally inverted with
+ *              0xFFFFFFFF, which is what these standards use.
+ *
+ *              Eight bytes are processed per step with eight look-up tables
+ *              ("slicing-by-8"). These take 8 KiB of flash for each of the
+ *              two polynomials, only the tables of the functions in use are
+ *              linked.
+ *
+ *              On x86, the pseudomodule checksum_crc32_pclmul computes CRC-32
+ *              of longer buffers with the carry-less multiply instruction,
+ *              and checksum_crc32c_sse42 computes CRC-32C with the crc32
+ *              instruction of SSE 4.2, if the CPU has them.
+ *
+ *              crc32_combine() and crc32c_combine() join the checksums of
+ *              consecutive pieces, so the pieces can be checksummed in
+ *              any order or in parallel.
+ *
+ * @{
+ * @file
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef CHECKSUM_CRC32_H
+#define CHECKSUM_CRC32_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief           Update CRC-32
+ *
+ * @param[in]  crc  The checksum of the preceding data, as returned by
+ *                  crc32_calc() or crc32_update(), or 0 to start
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the preceding data and the specified memory
+ *                  area
+ */
+uint32_t crc32_update(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC-32
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area
+ */
+uint32_t crc32_calc(const void *buf, size_t len);
+
+/**
+ * @brief           Combine the CRC-32 of two consecutive pieces of data
+ *
+ * @param[in]  crc1 Checksum of the first piece
+ * @param[in]  crc2 Checksum of the second piece
+ * @param[in]  len2 Length of the second piece in bytes
+ *
+ * @return          Checksum of both pieces
+ */
+uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+
+/**
+ * @brief           Update CRC-32C
+ *
+ * @param[in]  crc  The checksum of the preceding data, as returned by
+ *                  crc32c_calc() or crc32c_update(), or 0 to start
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the preceding data and the specified memory
+ *                  area
+ */
+uint32_t crc32c_update(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC-32C
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area
+ */
+uint32_t crc32c_calc(const void *buf, size_t len);
+
+/**
+ * @brief           Combine the CRC-32C of two consecutive pieces of data
+ *
+ * @param[in]  crc1 Checksum of the first piece
+ * @param[in]  crc2 Checksum of the second piece
+ * @param[in]  len2 Length of the second piece in bytes
+ *
+ * @return          Checksum of both pieces
+ */
+uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHECKSUM_CRC32_H */
+
+/** @} */
@@ -24,6 +24,7 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -69,6 +70,108 @@ typedef struct {
     uint32_t context[(4 * (AES_MAXNR + 1)) + 1];
 } aes_context_t;
 
+/**
+ * @brief   AES-128 encryption key, expanded once for many calls to
+ *          aes_schedule_encrypt_blocks()
+ *
+ * Unlike cipher_t, which keeps the key and expands it for every call, this
+ * is meant for a key that encrypts many blocks over its lifetime, e.g. the
+ * key of a session.
+ */
+typedef struct {
+    /** @cond INTERNAL */
+    union {
+#ifdef MODULE_CRYPTO_AES_CT
+        uint32_t bitsliced[8 * (10 + 1)];
+#else
+        AES_KEY table;
+#endif
+#ifdef MODULE_CRYPTO_AES_NI
+        uint8_t ni[(10 + 1) * AES_BLOCK_SIZE];
+#endif
+#ifdef MODULE_TINYCRYPT
+        uint32_t tinycrypt[4 * (10 + 1)];
+#endif
+    } rk;
+    const struct aes_backend *backend;
+    /** @endcond */
+} aes_schedule_t;
+
+/**
+ * @brief   An implementation of AES-128 encryption
+ *
+ * The backends compiled in are listed in @ref aes_backends, the one in use
+ * is returned by aes_backend_get(). A key schedule keeps the backend it was
+ * expanded by, so switching backends does not affect schedules which exist
+ * already.
+ */
+typedef struct aes_backend {
+    const char *name;                   /**< name of the backend */
+    /** checks whether the CPU supports the backend, NULL if it always does */
+    int (*available)(void);
+    /** expands a key */
+    void (*set_key)(aes_schedule_t *sched, const uint8_t *key);
+    /** encrypts nblocks blocks, input may be equal to output */
+    void (*encrypt_blocks)(const aes_schedule_t *sched, const uint8_t *input,
+                           uint8_t *output, size_t nblocks);
+} aes_backend_t;
+
+/** @cond INTERNAL */
+#if defined(MODULE_CRYPTO_AES_NI) && (defined(__x86_64__) || defined(__i386__))
+#define AES_BACKEND_NI          (1)
+#else
+#define AES_BACKEND_NI          (0)
+#endif
+#ifdef MODULE_TINYCRYPT
+#define AES_BACKEND_TINYCRYPT   (1)
+#else
+#define AES_BACKEND_TINYCRYPT   (0)
+#endif
+/** @endcond */
+
+/**
+ * @brief   Number of AES backends compiled in
+ */
+#define AES_BACKEND_NUMOF       (1 + AES_BACKEND_NI + AES_BACKEND_TINYCRYPT)
+
+/**
+ * @brief   The AES backends compiled in, the preferred one first
+ *
+ * These are the AES instructions of x86 CPUs with the crypto_aes_ni
+ * pseudomodule ("ni"), the T-tables ("table") or with crypto_aes_ct the
+ * bitsliced implementation ("ct"), and the tinycrypt package ("tinycrypt")
+ * when it is used.
+ */
+extern const aes_backend_t aes_backends[AES_BACKEND_NUMOF];
+
+/**
+ * @brief   Returns the backend new key schedules are expanded by
+ *
+ * Unless aes_backend_set() was called, this is the first available backend
+ * of @ref aes_backends. With the crypto_backend module, it is the fastest
+ * backend which passed the self-test, see crypto_backend_init().
+ *
+ * @return  the backend in use
+ */
+const aes_backend_t *aes_backend_get(void);
+
+/**
+ * @brief   Selects the backend new key schedules are expanded by
+ *
+ * @param       backend       one of @ref aes_backends
+ * @return  0 on success
+ * @return  -1 if the CPU does not support the backend
+ */
+int aes_backend_set(const aes_backend_t *backend);
+
+/**
+ * @brief   Checks whether the CPU supports an AES backend
+ *
+ * @param       backend       one of @ref aes_backends
+ * @return  1 if the backend can be used, 0 otherwise
+ */
+int aes_backend_available(const aes_backend_t *backend);
+
 /**
  * @brief   initializes the AES Cipher-algorithm with the passed parameters
  *
@@ -104,6 +207,60 @@ int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize);
 int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
                 uint8_t *cipher_block);
 
+/**
+ * @brief   encrypts nblocks consecutive blocks of plaintext
+ *
+ *          The key schedule is expanded once for all blocks, by the backend
+ *          returned by aes_backend_get(). With the crypto_aes_ni
+ *          pseudomodule the AES instructions are used when the CPU provides
+ *          them (x86 only), with crypto_aes_ct the blocks are encrypted by a
+ *          bitsliced implementation which does not depend on table lookups
+ *          and runs in constant time. Decryption always uses the lookup
+ *          tables.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            encryption
+ * @param       input         a pointer to nblocks blocks of plaintext
+ * @param       output        a pointer to the place where the nblocks
+ *                            blocks of ciphertext will be stored, may be
+ *                            equal to input
+ * @param       nblocks       the number of blocks to encrypt
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t nblocks);
+
+/**
+ * @brief   expands an AES-128 key for encryption
+ *
+ * @param       sched         the key schedule to initialize
+ * @param       key           a pointer to the key
+ * @param       key_size      the size of the key, must be AES_KEY_SIZE
+ * @return  CIPHER_INIT_SUCCESS if the key was expanded
+ * @return  CIPHER_ERR_INVALID_KEY_SIZE if the key size is not supported
+ */
+int aes_schedule_init(aes_schedule_t *sched, const uint8_t *key,
+                      uint8_t key_size);
+
+/**
+ * @brief   encrypts nblocks consecutive blocks of plaintext with an expanded
+ *          key
+ *
+ * @param       sched         the key schedule initialized by
+ *                            aes_schedule_init()
+ * @param       input         a pointer to nblocks blocks of plaintext
+ * @param       output        a pointer to the place where the nblocks
+ *                            blocks of ciphertext will be stored, may be
+ *                            equal to input
+ * @param       nblocks       the number of blocks to encrypt
+ * @return  1 on success
+ */
+int aes_schedule_encrypt_blocks(const aes_schedule_t *sched,
+                                const uint8_t *input, uint8_t *output,
+                                size_t nblocks);
+
 /**
  * @brief   decrypts one cipher-block and saves the plain-block in plainBlock.
  *          decrypts one blocksize long block of ciphertext pointed to by
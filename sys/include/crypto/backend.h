@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Selection of the fastest cipher backend at boot
+ *
+ * Where several implementations of a cipher are compiled in (see
+ * @ref aes_backends), the crypto_backend module checks at boot which of them
+ * the CPU supports, verifies each against a known answer and measures how
+ * fast it is. The fastest one which passed is used from then on by cipher_t
+ * and everything built on it. The shell command `crypto` lists the backends
+ * and overrides the choice. A backend which failed its self-test is never
+ * used.
+ *
+ * The speed is measured for expanding a key and encrypting
+ * CRYPTO_BACKEND_BENCH_BLOCKS blocks with it, as a cipher_t call does.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef CRYPTO_BACKEND_H
+#define CRYPTO_BACKEND_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of blocks encrypted per key by the benchmark
+ */
+#ifndef CRYPTO_BACKEND_BENCH_BLOCKS
+#define CRYPTO_BACKEND_BENCH_BLOCKS     (4U)
+#endif
+
+/**
+ * @brief   Time each backend is benchmarked for, in microseconds
+ */
+#ifndef CRYPTO_BACKEND_BENCH_USEC
+#define CRYPTO_BACKEND_BENCH_USEC       (2000U)
+#endif
+
+/**
+ * @brief   Result of the checks of a backend
+ */
+typedef enum {
+    CRYPTO_BACKEND_UNTESTED,        /**< crypto_backend_init() did not run */
+    CRYPTO_BACKEND_UNAVAILABLE,     /**< the CPU does not support it */
+    CRYPTO_BACKEND_FAILED,          /**< wrong result of the self-test */
+    CRYPTO_BACKEND_PASSED,          /**< self-test passed */
+} crypto_backend_state_t;
+
+/**
+ * @brief   A backend of an algorithm
+ */
+typedef struct {
+    const char *algo;               /**< name of the algorithm */
+    const char *name;               /**< name of the backend */
+    crypto_backend_state_t state;   /**< result of the self-test */
+    uint32_t speed;                 /**< measured speed in KiB/s */
+    uint8_t selected;               /**< 1 if the backend is in use */
+} crypto_backend_info_t;
+
+/**
+ * @brief   Tests and benchmarks all backends and selects the fastest one of
+ *          each algorithm
+ *
+ * Called by auto_init, and by aes_backend_get() if no backend was selected
+ * yet. Calling it again repeats the measurement, but keeps a choice made by
+ * crypto_backend_select() as long as that backend passes the self-test.
+ *
+ * Panics if no backend of an algorithm passes the self-test.
+ */
+void crypto_backend_init(void);
+
+/**
+ * @brief   Returns the number of backends of all algorithms
+ *
+ * @return  number of backends
+ */
+unsigned crypto_backend_numof(void);
+
+/**
+ * @brief   Describes a backend
+ *
+ * @param[in]   idx     index of the backend, less than crypto_backend_numof()
+ * @param[out]  info    the description of the backend
+ *
+ * @return  0 on success
+ * @return  -1 if idx is out of range
+ */
+int crypto_backend_info(unsigned idx, crypto_backend_info_t *info);
+
+/**
+ * @brief   Selects a backend of an algorithm
+ *
+ * @param[in]   algo    name of the algorithm, e.g. "aes-128"
+ * @param[in]   name    name of the backend, e.g. "table"
+ *
+ * @return  0 on success
+ * @return  -1 if there is no such backend
+ * @return  -2 if the CPU does not support it or it did not pass the
+ *          self-test
+ */
+int crypto_backend_select(const char *algo, const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_BACKEND_H */
+/** @} */
@@ -81,6 +81,22 @@ int chacha_init(chacha_ctx *ctx,
  */
 void chacha_keystream_bytes(chacha_ctx *ctx, void *x);
 
+/**
+ * @brief Generate the next blocks of the keystream.
+ *
+ * @details Same as calling chacha_keystream_bytes() @p nblocks times. With
+ *          the pseudomodule crypto_chacha_simd, x86 CPUs compute eight
+ *          blocks at once with AVX2 or SSE2 instructions.
+ *
+ * @warning You need to re-initialize the context with a new nonce after 2^64
+ *          encrypted blocks, or the keystream will repeat!
+ *
+ * @param[in,out] ctx     The ChaCha context
+ * @param[out]    x       The blocks of the keystream (`64 * nblocks` bytes).
+ * @param[in]     nblocks Number of blocks to generate.
+ */
+void chacha_keystream_blocks(chacha_ctx *ctx, void *x, size_t nblocks);
+
 /**
  * @brief Encode or decode a block of data.
  *
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @defgroup    sys_crypto_chacha20poly1305 ChaCha20-Poly1305
+ * @brief       ChaCha20-Poly1305 authenticated encryption
+ *
+ * The AEAD construction of RFC 8439: ChaCha20 with a 96 bit nonce encrypts,
+ * Poly1305 with a key from the first block of the keystream authenticates
+ * the additional data and the ciphertext.
+ *
+ * @{
+ *
+ * @file
+ * @brief       ChaCha20-Poly1305 interface
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @see         https://tools.ietf.org/html/rfc8439#section-2.8
+ */
+
+#ifndef CRYPTO_CHACHA20POLY1305_H
+#define CRYPTO_CHACHA20POLY1305_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHACHA20POLY1305_KEY_BYTES      (32U)   /**< Key length in bytes */
+#define CHACHA20POLY1305_NONCE_BYTES    (12U)   /**< Nonce length in bytes */
+#define CHACHA20POLY1305_TAG_BYTES      (16U)   /**< Tag length in bytes */
+
+/**
+ * @brief   Encrypt and authenticate a message
+ *
+ * @param[out]  cipher  The ciphertext followed by the tag, of
+ *                      @p msglen + CHACHA20POLY1305_TAG_BYTES bytes
+ * @param[in]   msg     The plaintext, may be the same as @p cipher
+ * @param[in]   msglen  Length of the plaintext
+ * @param[in]   aad     Additional data to authenticate
+ * @param[in]   aadlen  Length of the additional data
+ * @param[in]   key     The key of CHACHA20POLY1305_KEY_BYTES
+ * @param[in]   nonce   The nonce of CHACHA20POLY1305_NONCE_BYTES, which must
+ *                      never be used twice with the same key
+ */
+void chacha20poly1305_encrypt(uint8_t *cipher, const uint8_t *msg,
+                              size_t msglen, const uint8_t *aad, size_t aadlen,
+                              const uint8_t *key, const uint8_t *nonce);
+
+/**
+ * @brief   Verify and decrypt a message
+ *
+ * @param[in]   cipher    The ciphertext followed by the tag
+ * @param[in]   cipherlen Length of the ciphertext with the tag
+ * @param[out]  msg       The plaintext of
+ *                        @p cipherlen - CHACHA20POLY1305_TAG_BYTES bytes, may
+ *                        be the same as @p cipher. It is wiped if the tag is
+ *                        invalid.
+ * @param[in]   aad       Additional data to authenticate
+ * @param[in]   aadlen    Length of the additional data
+ * @param[in]   key       The key of CHACHA20POLY1305_KEY_BYTES
+ * @param[in]   nonce     The nonce of CHACHA20POLY1305_NONCE_BYTES
+ *
+ * @return      0 if the message is authentic
+ * @return      -1 if the tag is invalid or @p cipherlen is too short
+ */
+int chacha20poly1305_decrypt(const uint8_t *cipher, size_t cipherlen,
+                             uint8_t *msg, const uint8_t *aad, size_t aadlen,
+                             const uint8_t *key, const uint8_t *nonce);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_CHACHA20POLY1305_H */
+/** @} */
@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -96,6 +97,10 @@ typedef struct cipher_interface_st {
     /** the decrypt function */
     int (*decrypt)(const cipher_context_t *ctx, const uint8_t *cipher_block,
                    uint8_t *plain_block);
+
+    /** encrypts several blocks at once, optional (may be NULL) */
+    int (*encrypt_blocks)(const cipher_context_t *ctx, const uint8_t *input,
+                          uint8_t *output, size_t nblocks);
 } cipher_interface_t;
 
 
@@ -151,6 +156,27 @@ int cipher_init(cipher_t *cipher, cipher_id_t cipher_id, const uint8_t *key,
 int cipher_encrypt(const cipher_t *cipher, const uint8_t *input, uint8_t *output);
 
 
+/**
+ * @brief Encrypt nblocks consecutive blocks of BLOCK_SIZE length
+ *
+ * Ciphers which can encrypt several blocks faster than one after another,
+ * e.g. because their key schedule is expanded for every call, do so here.
+ * The others encrypt the blocks one by one.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to nblocks blocks of input data to encrypt
+ * @param output     pointer to allocated memory for encrypted data. It has to
+ *                   be of size nblocks * BLOCK_SIZE and may be equal to input
+ * @param nblocks    number of blocks to encrypt
+ *
+ * @return           The result of the encrypt operation of the underlying
+ *                   cipher, which is always 1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_encrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t nblocks);
+
+
 /**
  * @brief Decrypt data of BLOCK_SIZE length
  * *
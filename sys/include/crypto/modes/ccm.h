@@ -37,6 +37,27 @@ extern "C" {
 #define CCM_ERR_INVALID_MAC_LENGTH          (-5)
 /** @} */
 
+/**
+ * @brief   Context of a CCM operation that is fed in pieces
+ *
+ * The CBC-MAC and the counter mode run in one pass over the data, so neither
+ * the plaintext nor the ciphertext has to be in memory at once. As CCM
+ * authenticates the lengths first, they have to be known up front.
+ */
+typedef struct {
+    const cipher_t *cipher;         /**< cipher, initialized with the key */
+    uint8_t mac[16];                /**< CBC-MAC of the data so far */
+    uint8_t ctr[16];                /**< next counter block */
+    uint8_t stream[16];             /**< key stream of the current block */
+    uint8_t s0[16];                 /**< key stream to encrypt the MAC with */
+    size_t aad_left;                /**< additional data still to come */
+    size_t input_left;              /**< plaintext still to come */
+    uint8_t pos;                    /**< bytes used of the current block */
+    uint8_t stream_ready;           /**< stream holds the current key stream */
+    uint8_t mac_length;             /**< length of the MAC */
+    uint8_t ctr_len;                /**< bytes of the counter to increment */
+} cipher_ccm_ctx_t;
+
 /**
  * @brief Encrypt and authenticate data of arbitrary length in ccm mode.
  *
@@ -93,6 +114,106 @@ int cipher_decrypt_ccm(cipher_t* cipher,
                        const uint8_t* input, size_t input_len,
                        uint8_t* output);
 
+/**
+ * @brief Start encrypting or decrypting data in ccm mode in pieces.
+ *
+ * @param ctx              Context to initialize
+ * @param cipher           Already initialized cipher struct, which has to stay
+ *                         valid until the operation is finished
+ * @param mac_length       length of the MAC (between 4 and 16 - only even
+ *                         values)
+ * @param length_encoding  maximal supported length of plaintext
+ *                         (2^(8*length_enc)).
+ * @param nonce            Nounce for ctr mode encryption
+ * @param nonce_len        Length of the nonce in octets
+ *                         (maximum: 15-length_encoding)
+ * @param auth_data_len    Total length of the additional data
+ * @param input_len        Total length of the plaintext
+ *
+ * @return                 0 on success
+ * @return                 A negative error code if something went wrong
+ */
+int cipher_ccm_init(cipher_ccm_ctx_t *ctx, const cipher_t *cipher,
+                    uint8_t mac_length, uint8_t length_encoding,
+                    const uint8_t *nonce, size_t nonce_len,
+                    uint32_t auth_data_len, size_t input_len);
+
+/**
+ * @brief Add additional data to authenticate.
+ *
+ * All additional data has to be added before the first call to
+ * cipher_ccm_encrypt_update() or cipher_ccm_decrypt_update().
+ *
+ * @param ctx              Initialized context
+ * @param auth_data        Piece of the additional data
+ * @param len              Length of the piece
+ *
+ * @return                 0 on success
+ * @return                 CCM_ERR_INVALID_DATA_LENGTH if there is more
+ *                         additional data than announced
+ */
+int cipher_ccm_update_aad(cipher_ccm_ctx_t *ctx, const uint8_t *auth_data,
+                          size_t len);
+
+/**
+ * @brief Encrypt the next piece of the plaintext.
+ *
+ * @param ctx              Initialized context
+ * @param input            Piece of the plaintext
+ * @param len              Length of the piece
+ * @param output           Memory for the ciphertext of the same length, may be
+ *                         the same as @p input
+ *
+ * @return                 @p len on success
+ * @return                 A negative error code if something went wrong
+ */
+int cipher_ccm_encrypt_update(cipher_ccm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output);
+
+/**
+ * @brief Decrypt the next piece of the ciphertext.
+ *
+ * The plaintext must not be used before cipher_ccm_decrypt_finish() has
+ * verified the MAC.
+ *
+ * @param ctx              Initialized context
+ * @param input            Piece of the ciphertext, without the MAC
+ * @param len              Length of the piece
+ * @param output           Memory for the plaintext of the same length, may be
+ *                         the same as @p input
+ *
+ * @return                 @p len on success
+ * @return                 A negative error code if something went wrong
+ */
+int cipher_ccm_decrypt_update(cipher_ccm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output);
+
+/**
+ * @brief Finish an encryption and write the MAC.
+ *
+ * @param ctx              Context all data has been passed to
+ * @param mac              Memory for the MAC, of the length given to
+ *                         cipher_ccm_init()
+ *
+ * @return                 Length of the MAC on success
+ * @return                 CCM_ERR_INVALID_DATA_LENGTH if less data was passed
+ *                         than announced
+ */
+int cipher_ccm_encrypt_finish(cipher_ccm_ctx_t *ctx, uint8_t *mac);
+
+/**
+ * @brief Finish a decryption and verify the MAC.
+ *
+ * @param ctx              Context all data has been passed to
+ * @param mac              The received MAC
+ *
+ * @return                 0 if the MAC is valid
+ * @return                 CCM_ERR_INVALID_CBC_MAC if it is not
+ * @return                 CCM_ERR_INVALID_DATA_LENGTH if less data was passed
+ *                         than announced
+ */
+int cipher_ccm_decrypt_finish(cipher_ccm_ctx_t *ctx, const uint8_t *mac);
+
 #ifdef __cplusplus
 }
 #endif
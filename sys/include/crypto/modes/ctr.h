@@ -26,6 +26,13 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Number of counter blocks encrypted with one call to the cipher
+ */
+#ifndef CIPHER_CTR_BLOCKS
+#define CIPHER_CTR_BLOCKS   (4U)
+#endif
+
 /**
  * @brief Encrypt data of arbitrary length in counter mode.
  *
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file        gcm.h
+ * @brief       Galois/Counter mode of operation for block ciphers
+ *
+ * GHASH multiplies with 4-bit tables of the hash key, which take 256 bytes in
+ * the context. Lookups in these tables depend on the data, so they are not
+ * constant-time. With the pseudomodule crypto_gcm_pclmul, x86 CPUs that have
+ * the carry-less multiply instruction use it instead.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef CRYPTO_MODES_GCM_H
+#define CRYPTO_MODES_GCM_H
+
+#include "crypto/ciphers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name GCM error codes
+ * @{
+ */
+#define GCM_ERR_INVALID_NONCE_LENGTH        (-2)
+#define GCM_ERR_INVALID_TAG                 (-3)
+#define GCM_ERR_INVALID_DATA_LENGTH         (-4)
+#define GCM_ERR_INVALID_TAG_LENGTH          (-5)
+/** @} */
+
+/**
+ * @brief   Context of a GCM operation that is fed in pieces
+ */
+typedef struct {
+    const cipher_t *cipher;         /**< cipher, initialized with the key */
+    union {
+        struct {
+            uint64_t hl[16];        /**< low halves of the multiples of H */
+            uint64_t hh[16];        /**< high halves of the multiples of H */
+        } table;                    /**< tables for GHASH */
+        uint8_t h[16];              /**< the hash key H */
+    } key;                          /**< hash key, as used by GHASH */
+    uint8_t ghash[16];              /**< GHASH of the data so far */
+    uint8_t ctr[16];                /**< next counter block */
+    uint8_t stream[16];             /**< key stream of the current block */
+    uint8_t ek0[16];                /**< key stream to encrypt the tag with */
+    uint64_t aad_len;               /**< length of the additional data */
+    uint64_t input_len;             /**< length of the plaintext */
+    uint8_t pos;                    /**< bytes used of the current block */
+    uint8_t aad_done;               /**< the additional data is complete */
+#ifdef MODULE_CRYPTO_GCM_PCLMUL
+    uint8_t use_pclmul;             /**< GHASH with carry-less multiply */
+#endif
+} cipher_gcm_ctx_t;
+
+/**
+ * @brief Encrypt and authenticate data of arbitrary length in gcm mode.
+ *
+ * @param cipher           Already initialized cipher struct
+ * @param auth_data        Additional data to authenticate
+ * @param auth_data_len    Length of additional data
+ * @param tag_len          Length of the appended tag (between 4 and 16)
+ * @param nonce            Nonce (IV), 12 octets are recommended
+ * @param nonce_len        Length of the nonce in octets
+ * @param input            pointer to input data to encrypt
+ * @param input_len        length of the input data
+ * @param output           pointer to allocated memory for encrypted data. It
+ *                         has to be of size input_len + tag_len.
+ *
+ * @return                 Length of encrypted data on a successful encryption
+ * @return                 A negative error code if something went wrong
+ */
+int cipher_encrypt_gcm(const cipher_t *cipher,
+                       const uint8_t *auth_data, size_t auth_data_len,
+                       uint8_t tag_len,
+                       const uint8_t *nonce, size_t nonce_len,
+                       const uint8_t *input, size_t input_len,
+                       uint8_t *output);
+
+/**
+ * @brief Decrypt data of arbitrary length in gcm mode.
+ *
+ * @param cipher           Already initialized cipher struct
+ * @param auth_data        Additional data to authenticate
+ * @param auth_data_len    Length of additional data
+ * @param tag_len          Length of the appended tag (between 4 and 16)
+ * @param nonce            Nonce (IV) used for encryption
+ * @param nonce_len        Length of the nonce in octets
+ * @param input            pointer to input data to decrypt, with the tag
+ * @param input_len        length of the input data
+ * @param output           pointer to allocated memory for decrypted data. It
+ *                         has to be of size input_len - tag_len. It is wiped
+ *                         if the tag is invalid.
+ *
+ * @return                 Length of the decrypted data on a successful
+ *                         decryption
+ * @return                 GCM_ERR_INVALID_TAG if the data is not authentic
+ * @return                 A negative error code if something else went wrong
+ */
+int cipher_decrypt_gcm(const cipher_t *cipher,
+                       const uint8_t *auth_data, size_t auth_data_len,
+                       uint8_t tag_len,
+                       const uint8_t *nonce, size_t nonce_len,
+                       const uint8_t *input, size_t input_len,
+                       uint8_t *output);
+
+/**
+ * @brief Start encrypting or decrypting data in gcm mode in pieces.
+ *
+ * @param ctx              Context to initialize
+ * @param cipher           Already initialized cipher struct with a block size
+ *                         of 16 octets, which has to stay valid until the
+ *                         operation is finished
+ * @param nonce            Nonce (IV), 12 octets are recommended
+ * @param nonce_len        Length of the nonce in octets
+ *
+ * @return                 0 on success
+ * @return                 A negative error code if something went wrong
+ */
+int cipher_gcm_init(cipher_gcm_ctx_t *ctx, const cipher_t *cipher,
+                    const uint8_t *nonce, size_t nonce_len);
+
+/**
+ * @brief Add additional data to authenticate.
+ *
+ * All additional data has to be added before the first call to
+ * cipher_gcm_encrypt_update() or cipher_gcm_decrypt_update().
+ *
+ * @param ctx              Initialized context
+ * @param auth_data        Piece of the additional data
+ * @param len              Length of the piece
+ *
+ * @return                 0 on success
+ * @return                 GCM_ERR_INVALID_DATA_LENGTH if the plaintext has
+ *                         already been started
+ */
+int cipher_gcm_update_aad(cipher_gcm_ctx_t *ctx, const uint8_t *auth_data,
+                          size_t len);
+
+/**
+ * @brief Encrypt the next piece of the plaintext.
+ *
+ * @param ctx              Initialized context
+ * @param input            Piece of the plaintext
+ * @param len              Length of the piece
+ * @param output           Memory for the ciphertext of the same length, may be
+ *                         the same as @p input
+ *
+ * @return                 @p len on success
+ * @return                 A negative error code if something went wrong
+ */
+int cipher_gcm_encrypt_update(cipher_gcm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output);
+
+/**
+ * @brief Decrypt the next piece of the ciphertext.
+ *
+ * The plaintext must not be used before cipher_gcm_decrypt_finish() has
+ * verified the tag.
+ *
+ * @param ctx              Initialized context
+ * @param input            Piece of the ciphertext, without the tag
+ * @param len              Length of the piece
+ * @param output           Memory for the plaintext of the same length, may be
+ *                         the same as @p input
+ *
+ * @return                 @p len on success
+ * @return                 A negative error code if something went wrong
+ */
+int cipher_gcm_decrypt_update(cipher_gcm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output);
+
+/**
+ * @brief Finish an encryption and write the tag.
+ *
+ * @param ctx              Context all data has been passed to
+ * @param tag              Memory for the tag
+ * @param tag_len          Length of the tag (between 4 and 16)
+ *
+ * @return                 Length of the tag on success
+ * @return                 GCM_ERR_INVALID_TAG_LENGTH if @p tag_len is invalid
+ */
+int cipher_gcm_encrypt_finish(cipher_gcm_ctx_t *ctx, uint8_t *tag,
+                              uint8_t tag_len);
+
+/**
+ * @brief Finish a decryption and verify the tag.
+ *
+ * @param ctx              Context all data has been passed to
+ * @param tag              The received tag
+ * @param tag_len          Length of the tag (between 4 and 16)
+ *
+ * @return                 0 if the tag is valid
+ * @return                 GCM_ERR_INVALID_TAG if it is not
+ * @return                 GCM_ERR_INVALID_TAG_LENGTH if @p tag_len is invalid
+ */
+int cipher_gcm_decrypt_finish(cipher_gcm_ctx_t *ctx, const uint8_t *tag,
+                              uint8_t tag_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_MODES_GCM_H */
+/** @} */
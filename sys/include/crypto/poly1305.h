@@ -40,14 +40,36 @@ extern "C" {
  */
 #define POLY1305_BLOCK_SIZE 16
 
+/**
+ * @brief Compute with three 44 bit limbs and 128 bit products
+ *
+ * This is faster on 64 bit CPUs with longer messages. It is the default if
+ * the compiler has a 128 bit integer type, define it to 0 to use 32 bit limbs
+ * anyway.
+ */
+#ifndef POLY1305_64BIT
+#ifdef __SIZEOF_INT128__
+#define POLY1305_64BIT (1)
+#else
+#define POLY1305_64BIT (0)
+#endif
+#endif
+
 /**
  * @brief Poly1305 context
  */
 typedef struct {
+#if POLY1305_64BIT
+    uint64_t r[3];                          /**< first key part         */
+    uint64_t pad[2];                        /**< Second key part        */
+    uint64_t h[3];                          /**< Hash                   */
+    uint8_t c[16];                          /**< Message chunk          */
+#else
     uint32_t r[4];                          /**< first key part         */
     uint32_t pad[4];                        /**< Second key part        */
     uint32_t h[5];                          /**< Hash                   */
     uint32_t c[4];                          /**< Message chunk          */
+#endif
     size_t c_idx;                           /**< Chunk length            */
 } poly1305_ctx_t;
 
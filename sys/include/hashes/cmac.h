@@ -23,6 +23,7 @@
 #define HASHES_CMAC_H
 
 #include <stdio.h>
+#include "crypto/aes.h"
 #include "crypto/ciphers.h"
 
 #ifdef __cplusplus
@@ -34,12 +35,27 @@ extern "C" {
  */
 #define CMAC_BLOCK_SIZE 16
 
+/**
+ * @brief   AES_CMAC key, expanded and with its subkeys derived once for many
+ *          messages
+ */
+typedef struct {
+    /** expanded AES128 key */
+    aes_schedule_t aes;
+    /** subkey for messages of whole blocks */
+    uint8_t K1[CMAC_BLOCK_SIZE];
+    /** subkey for padded messages */
+    uint8_t K2[CMAC_BLOCK_SIZE];
+} cmac_key_t;
+
 /**
  * @brief   AES_CMAC calculation context
  */
 typedef struct {
     /** AES128 context */
     cipher_t aes_ctx;
+    /** key of cmac_init_key(), NULL after cmac_init() */
+    const cmac_key_t *key;
     /** auxiliar array for CMAC calculations **/
     uint8_t X[CMAC_BLOCK_SIZE];
     /** current last block **/
@@ -60,6 +76,29 @@ typedef struct {
  */
 int cmac_init(cmac_context_t *ctx, const uint8_t *key, uint8_t key_size);
 
+/**
+ * @brief Expand a key and derive its subkeys for cmac_init_key()
+ *
+ * @param[out] key     Pointer to the key to set up
+ * @param[in] k        Key to be set
+ * @param[in] key_size Size of the key
+ *
+ * @return CIPHER_INIT_SUCCESS if the initialization was successful.
+ *         CIPHER_ERR_INVALID_KEY_SIZE if the key size is not valid.
+ */
+int cmac_key_init(cmac_key_t *key, const uint8_t *k, uint8_t key_size);
+
+/**
+ * @brief Initialize CMAC message digest context with a prepared key
+ *
+ * Unlike cmac_init(), this neither sets up the cipher nor derives subkeys.
+ *
+ * @param[out] ctx Pointer to the CMAC context to initialize
+ * @param[in] key  Key set up by cmac_key_init(), must stay valid until
+ *                 cmac_final()
+ */
+void cmac_init_key(cmac_context_t *ctx, const cmac_key_t *key);
+
 /**
  * @brief Update the CMAC context with a portion of the message being hashed
  *
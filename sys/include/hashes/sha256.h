@@ -34,6 +34,12 @@
  * @defgroup    sys_hashes_sha256 SHA-256
  * @ingroup     sys_hashes_unkeyed
  * @brief       Implementation of the SHA-256 hashing function
+ *
+ * The block function is a compact loop by default. The pseudomodule
+ * hashes_sha256_unroll unrolls its rounds (more flash, less CPU). With
+ * hashes_sha256_ni, x86 CPUs that have the SHA instructions use them, and
+ * sha256_mb() and hmac_sha256_mb() use AVX2 if available.
+ *
  * @{
  *
  * @file
@@ -65,6 +71,20 @@ extern "C" {
  */
 #define SHA256_INTERNAL_BLOCK_SIZE (64)
 
+/**
+ * @brief Number of messages sha256_mb() hashes side by side
+ *
+ * Eight with the pseudomodule hashes_sha256_ni on x86, where AVX2 registers
+ * hold eight words, four otherwise.
+ */
+#ifndef SHA256_MB_LANES
+#if defined(MODULE_HASHES_SHA256_NI) && (defined(__x86_64__) || defined(__i386__))
+#define SHA256_MB_LANES (8)
+#else
+#define SHA256_MB_LANES (4)
+#endif
+#endif
+
 /**
  * @brief Context for cipher operations based on sha256
  */
@@ -87,6 +107,17 @@ typedef struct {
     sha256_context_t c_out;
 } hmac_context_t;
 
+/**
+ * @brief HMAC SHA-256 key, hashed into the inner and outer key pads once
+ *        for many messages
+ */
+typedef struct {
+    /** state after the inner key pad */
+    uint32_t in[8];
+    /** state after the outer key pad */
+    uint32_t out[8];
+} hmac_sha256_key_t;
+
 /**
  * @brief sha256-chain indexed element
  */
@@ -134,6 +165,22 @@ void sha256_final(sha256_context_t *ctx, void *digest);
  */
 void *sha256(const void *data, size_t len, void *digest);
 
+/**
+ * @brief Hash several independent messages at once
+ *
+ * Up to SHA256_MB_LANES messages are compressed together, one per lane of a
+ * vector, which pays off for many short messages of similar length. A lane
+ * that finishes its message takes the next one.
+ *
+ * @param[in] data   pointers to the messages
+ * @param[in] len    lengths of the messages
+ * @param[out] digest pointers to arrays for the results, each of
+ *                    SHA256_DIGEST_LENGTH bytes
+ * @param[in] num    number of messages
+ */
+void sha256_mb(const void *const *data, const size_t *len,
+               void *const *digest, size_t num);
+
 /**
  * @brief hmac_sha256_init HMAC SHA-256 calculation. Initiate calculation of a HMAC
  * @param[in] ctx hmac_context_t handle to use
@@ -159,6 +206,52 @@ void hmac_sha256_update(hmac_context_t *ctx, const void *data, size_t len);
  */
 void hmac_sha256_final(hmac_context_t *ctx, void *digest);
 
+/**
+ * @brief hmac_sha256_key_init Hash a key into the inner and outer key pads
+ *        for hmac_sha256_init_key()
+ * @param[out] key the precomputed key
+ * @param[in] k key used in the hmac-sha256 computation
+ * @param[in] key_length the size in bytes of the key
+ */
+void hmac_sha256_key_init(hmac_sha256_key_t *key, const void *k,
+                          size_t key_length);
+
+/**
+ * @brief hmac_sha256_init_key Initiate calculation of a HMAC with a
+ *        precomputed key. This costs no hashing, unlike hmac_sha256_init(),
+ *        continue with hmac_sha256_update() and hmac_sha256_final()
+ * @param[out] ctx hmac_context_t handle to use
+ * @param[in] key key set up by hmac_sha256_key_init()
+ */
+void hmac_sha256_init_key(hmac_context_t *ctx, const hmac_sha256_key_t *key);
+
+/**
+ * @brief hmac_sha256_key_init_mb Precompute several keys at once, like
+ *        hmac_sha256_key_init() does for one, with the key pads hashed side
+ *        by side as in sha256_mb()
+ * @param[out] key array of num precomputed keys
+ * @param[in] k pointers to the keys
+ * @param[in] key_length the size in bytes of each key
+ * @param[in] num number of keys
+ */
+void hmac_sha256_key_init_mb(hmac_sha256_key_t *key, const void *const *k,
+                             size_t key_length, size_t num);
+
+/**
+ * @brief hmac_sha256_mb Compute the HMACs of several independent messages
+ *        at once, each with its own precomputed key, see sha256_mb()
+ * @param[in] key array of num keys set up by hmac_sha256_key_init() or
+ *            hmac_sha256_key_init_mb()
+ * @param[in] data pointers to the messages
+ * @param[in] len lengths of the messages
+ * @param[out] digest pointers to arrays for the results, each of
+ *             SHA256_DIGEST_LENGTH bytes, which must not overlap each other
+ *             or the messages
+ * @param[in] num number of messages
+ */
+void hmac_sha256_mb(const hmac_sha256_key_t *key, const void *const *data,
+                    const size_t *len, void *const *digest, size_t num);
+
 /**
  * @brief function to compute a hmac-sha256 from a given message
  *
@@ -59,6 +59,10 @@
  * - updating will message
  * - sending out periodic PINGREQ messages
  * - handling re-transmits
+ * - a window of QoS 1 PUBLISH messages awaiting their PUBACK (see
+ *   @ref EMCUTE_PUB_WINDOW)
+ * - collecting small publications to the same topic in one PUBLISH message
+ *   (see emcute_pub_batch())
  *
  * The following features are however still missing (but planned):
  * @todo        Gateway discovery (so far there is no support for handling
@@ -164,6 +168,33 @@ extern "C" {
 #define EMCUTE_N_RETRY          (3U)
 #endif
 
+#ifndef EMCUTE_PUB_WINDOW
+/**
+ * @brief   Number of QoS 1 PUBLISH messages that may await their PUBACK
+ *
+ * With a window of 1, emcute_pub() blocks until the gateway acknowledged a
+ * QoS 1 message. With a larger window, emcute_pub() returns once the message
+ * is sent and blocks only while the window is full. The emCute thread
+ * retransmits unacknowledged messages, and emcute_pub_flush() reports whether
+ * all of them were acknowledged.
+ *
+ * Each message in the window takes @ref EMCUTE_PUB_BUFSIZE byte of RAM.
+ */
+#define EMCUTE_PUB_WINDOW       (1U)
+#endif
+
+#ifndef EMCUTE_PUB_BUFSIZE
+/**
+ * @brief   Maximum size of a PUBLISH message in the window or built by
+ *          emcute_pub_batch() [in byte]
+ *
+ * Larger QoS 1 messages are sent one at a time, as with a window of 1.
+ *
+ * @note    **Must** not be larger than @ref EMCUTE_BUFSIZE.
+ */
+#define EMCUTE_PUB_BUFSIZE      (64U)
+#endif
+
 /**
  * @brief   MQTT-SN flags
  *
@@ -283,6 +314,13 @@ int emcute_reg(emcute_topic_t *topic);
  * @param[in] len       length of @p data in bytes
  * @param[in] flags     flags used for publication, allowed are QoS and retain
  *
+ * Publications collected by emcute_pub_batch() are sent first.
+ *
+ * With @ref EMCUTE_PUB_WINDOW larger than 1, a QoS 1 message that fits into
+ * @ref EMCUTE_PUB_BUFSIZE is not waited for: the function returns EMCUTE_OK
+ * once it is sent, and a rejection or timeout is reported by
+ * emcute_pub_flush().
+ *
  * @return  EMCUTE_OK on success
  * @return  EMCUTE_NOGW if not connected to a gateway
  * @return  EMCUTE_REJECT if publish message was rejected (QoS > 0 only)
@@ -293,6 +331,48 @@ int emcute_reg(emcute_topic_t *topic);
 int emcute_pub(emcute_topic_t *topic, const void *buf, size_t len,
                unsigned flags);
 
+/**
+ * @brief   Collect data to publish on the given topic
+ *
+ * The data is appended to the data collected before, and all of it is
+ * published in one PUBLISH message when the next data would not fit into
+ * @ref EMCUTE_PUB_BUFSIZE, is for another topic or uses other flags, or when
+ * emcute_pub() or emcute_pub_flush() is called. Subscribers receive the
+ * concatenation, so the data must be framed such that they can split it,
+ * e.g. as records of a fixed size.
+ *
+ * Data that does not fit into @ref EMCUTE_PUB_BUFSIZE by itself is published
+ * right away.
+ *
+ * @param[in] topic     topic to send data to, topic **must** be registered
+ *                      (topic.id **must** populated).
+ * @param[in] buf       data to publish
+ * @param[in] len       length of @p data in bytes
+ * @param[in] flags     flags used for publication, allowed are QoS and retain
+ *
+ * @return  EMCUTE_OK on success
+ * @return  EMCUTE_NOGW if not connected to a gateway
+ * @return  EMCUTE_OVERFLOW if length of data exceeds @ref EMCUTE_BUFSIZE
+ * @return  EMCUTE_NOTSUP on unsupported flag values
+ * @return  any error of emcute_pub() when sending the collected data failed,
+ *          the collected data and @p buf are dropped then
+ */
+int emcute_pub_batch(emcute_topic_t *topic, const void *buf, size_t len,
+                     unsigned flags);
+
+/**
+ * @brief   Publish the collected data and wait for all QoS 1 messages in
+ *          flight
+ *
+ * Call this before emcute_discon(), which drops the messages in flight.
+ *
+ * @return  EMCUTE_OK if all messages since the last call were acknowledged
+ * @return  EMCUTE_NOGW if not connected to a gateway
+ * @return  EMCUTE_REJECT if a message was rejected
+ * @return  EMCUTE_TIMEOUT if a message was not acknowledged
+ */
+int emcute_pub_flush(void);
+
 /**
  * @brief   Subscribe to the given topic
  *
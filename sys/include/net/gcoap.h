@@ -81,6 +81,23 @@
  * described above. In fact, the gcoap_response() function is inline, and uses
  * those two functions.
  *
+ * ### Block-wise transfers ###
+ *
+ * A representation larger than a PDU, like a firmware image or a log file,
+ * may be served in blocks (RFC 7959) without holding it in RAM. Describe it
+ * with a gcoap_block_resource_t, and use gcoap_block_handler() as the handler
+ * of the resource, with the gcoap_block_resource_t as its context. For a GET,
+ * the handler calls the _read_ callback for the block the client asked for
+ * (Block2). For a PUT or POST, it passes each block the client sends (Block1)
+ * to the _write_ callback, e.g. to append it to a file with vfs_write().
+ *
+ * Blocks are at most 2^NANOCOAP_BLOCK_SIZE_EXP_MAX bytes, and no larger than
+ * what fits in GCOAP_PDU_BUF_SIZE. gcoap keeps no state between the requests
+ * of a transfer, so any number of clients may transfer blocks at the same
+ * time, and a client may send the requests for several blocks without waiting
+ * for each response. Up to SOCK_MBOX_SIZE requests are queued while gcoap
+ * handles one.
+ *
  * ## Client Operation ##
  *
  * Client operation includes two phases:  creating and sending a request, and
@@ -190,6 +207,21 @@
  * times out. We track the response with an entry in the
  * `_coap_state.open_reqs` array.
  *
+ * ### Finding a resource ###
+ *
+ * The paths of all registered resources are kept in a hash index of
+ * GCOAP_RESOURCE_INDEX_SIZE entries, so a request finds its resource without
+ * comparing the path against every resource. If more resources are registered
+ * than fit, gcoap searches the listeners one by one instead.
+ *
+ * ### Sizing the tables ###
+ *
+ * The tables for open requests, resend buffers, Observe clients and Observe
+ * registrations have the sizes set at compile time by GCOAP_REQ_WAITING_MAX,
+ * GCOAP_RESEND_BUFS_MAX, GCOAP_OBS_CLIENTS_MAX and
+ * GCOAP_OBS_REGISTRATIONS_MAX. An application that serves many clients, like
+ * a gateway, may provide larger tables at startup with gcoap_set_pools().
+ *
  * ## Implementation Status ##
  * gcoap includes server and client capability. Available features include:
  *
@@ -207,6 +239,8 @@
  *   in a user provided callback.
  * - Client generates token; length defined at compile time.
  * - Options: Supports Content-Format for payload.
+ * - Block-wise extension: A server resource may transfer a representation in
+ *   blocks with gcoap_block_handler().
  *
  * @{
  *
@@ -453,6 +487,17 @@ extern "C" {
 #define GCOAP_RESEND_BUFS_MAX      (1)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Number of entries in the index of resource paths
+ *
+ * Must be a power of two. At most three quarters of the entries are used, to
+ * keep the search short. Set to 0 to disable the index.
+ */
+#ifndef GCOAP_RESOURCE_INDEX_SIZE
+#define GCOAP_RESOURCE_INDEX_SIZE   (16)
+#endif
+
 /**
  * @brief   A modular collection of resources for a server
  */
@@ -509,6 +554,71 @@ typedef struct {
     unsigned token_len;                 /**< Actual length of token attribute */
 } gcoap_observe_memo_t;
 
+/**
+ * @brief   Tables for requests and Observe registrations
+ *
+ * A NULL table selects the built-in table sized at compile time.
+ */
+typedef struct {
+    gcoap_request_memo_t *open_reqs;    /**< Requests awaiting a response */
+    size_t open_reqs_numof;             /**< Number of elements in open_reqs */
+    uint8_t *resend_bufs;               /**< resend_bufs_numof buffers of
+                                             GCOAP_PDU_BUF_SIZE bytes each, for
+                                             confirmable requests */
+    size_t resend_bufs_numof;           /**< Number of buffers in resend_bufs */
+    sock_udp_ep_t *observers;           /**< Observe clients */
+    size_t observers_numof;             /**< Number of elements in observers */
+    gcoap_observe_memo_t *observe_memos;
+                                        /**< Observe registrations */
+    size_t observe_memos_numof;         /**< Number of elements in
+                                             observe_memos */
+} gcoap_pools_t;
+
+/**
+ * @brief   Reads a block of a representation
+ *
+ * @param[in] ctx       Context of the block resource
+ * @param[in] offset    Offset of the block in the representation
+ * @param[out] buf      Buffer for the block
+ * @param[in] len       Number of bytes to read
+ *
+ * @return  number of bytes read, less than @p len at the end of the
+ *          representation
+ * @return  < 0 on error
+ */
+typedef ssize_t (*gcoap_block_read_t)(void *ctx, size_t offset, uint8_t *buf,
+                                      size_t len);
+
+/**
+ * @brief   Writes a block of a representation
+ *
+ * @param[in] ctx       Context of the block resource
+ * @param[in] offset    Offset of the block in the representation
+ * @param[in] buf       The block
+ * @param[in] len       Length of the block
+ * @param[in] more      true, if more blocks follow
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if the block is not the one expected next
+ * @return  -ENOSPC, if the representation is too large
+ * @return  < 0 on other errors
+ */
+typedef int (*gcoap_block_write_t)(void *ctx, size_t offset,
+                                   const uint8_t *buf, size_t len, bool more);
+
+/**
+ * @brief   Representation transferred in blocks by gcoap_block_handler()
+ */
+typedef struct {
+    gcoap_block_read_t read;            /**< Reads a block for a GET, may be
+                                             NULL */
+    gcoap_block_write_t write;          /**< Writes a block of a PUT or POST,
+                                             may be NULL */
+    unsigned format;                    /**< Content-Format of the
+                                             representation */
+    void *ctx;                          /**< Context of the callbacks */
+} gcoap_block_resource_t;
+
 /**
  * @brief   Initializes the gcoap thread and device
  *
@@ -527,6 +637,21 @@ kernel_pid_t gcoap_init(void);
  */
 void gcoap_register_listener(gcoap_listener_t *listener);
 
+/**
+ * @brief   Replaces the tables for requests and Observe registrations
+ *
+ * Call at startup, before sending requests or accepting Observe
+ * registrations. The tables are cleared and must stay valid while gcoap uses
+ * them.
+ *
+ * @param[in] pools     The new tables.
+ *
+ * @return  0 on success
+ * @return  -EBUSY, if a request is awaiting a response or a client observes
+ *          a resource
+ */
+int gcoap_set_pools(const gcoap_pools_t *pools);
+
 /**
  * @brief   Initializes a CoAP request PDU on a buffer.
  *
@@ -652,6 +777,25 @@ static inline ssize_t gcoap_response(coap_pkt_t *pdu, uint8_t *buf,
                 : -1;
 }
 
+/**
+ * @brief   Resource handler that transfers a representation in blocks
+ *
+ * Answers a GET with the block of the representation the Block2 option of the
+ * request asks for, or the first block. Passes the payload of a PUT or POST to
+ * the write callback, as the block its Block1 option describes, or as the
+ * whole representation.
+ *
+ * @param[in,out] pdu   Request, and response metadata
+ * @param[out] buf      Buffer for the response
+ * @param[in] len       Length of the buffer
+ * @param[in] ctx       The gcoap_block_resource_t of the resource
+ *
+ * @return  size of the response within the buffer
+ * @return  < 0 on error
+ */
+ssize_t gcoap_block_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            void *ctx);
+
 /**
  * @brief   Initializes a CoAP Observe notification packet on a buffer, for the
  *          observer registered for a resource
@@ -691,7 +835,7 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
  *
  * Useful for monitoring.
  *
- * @return  count of unanswered requests
+ * @return  count of unanswered requests, at most UINT8_MAX
  */
 uint8_t gcoap_op_state(void);
 
@@ -54,6 +54,28 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_burst   Burst extension
+ * @ingroup     net_gnrc_netapi
+ * @brief       Passes several received packets up the stack in one message
+ * @{
+ * @details The submodule `gnrc_netapi_burst` lets a thread collect the
+ *          packets it received for the same receivers in a
+ *          @ref gnrc_netapi_burst_t and hand them on together once its
+ *          message queue is empty. Threads registered with
+ *          @ref GNRC_NETREG_TYPE_BURST get all of them in one
+ *          @ref GNRC_NETAPI_MSG_TYPE_RCV_BURST message, all other receivers
+ *          get a @ref GNRC_NETAPI_MSG_TYPE_RCV message per packet, queued in
+ *          one critical section.
+ *
+ * `gnrc_netif`, `gnrc_ipv6` and `gnrc_udp` pass bursts up the stack with this
+ * module. To use, add the module `gnrc_netapi_burst` to the `USEMODULE` macro
+ * in your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_burst
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
  */
 
 #ifndef NET_GNRC_NETAPI_H
@@ -93,6 +115,40 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   @ref core_msg type for passing several packets up the network stack
+ *
+ * The content of the message is a packet snip whose data are the pointers to
+ * the packets, see gnrc_netapi_burst_numof() and gnrc_netapi_burst_pkts().
+ * The receiver takes over each of the packets and releases the snip.
+ *
+ * @note    Only sent to threads registered with @ref GNRC_NETREG_TYPE_BURST.
+ */
+#define GNRC_NETAPI_MSG_TYPE_RCV_BURST  (0x0206)
+
+#if defined(MODULE_GNRC_NETAPI_BURST) || defined(DOXYGEN)
+/**
+ * @brief   Maximum number of packets handed on in one burst
+ *
+ * @note    Only available with @ref net_gnrc_netapi_burst.
+ */
+#ifndef GNRC_NETAPI_BURST_SIZE
+#define GNRC_NETAPI_BURST_SIZE          (8U)
+#endif
+
+/**
+ * @brief   Packets collected for the same receivers
+ *
+ * @note    Only available with @ref net_gnrc_netapi_burst.
+ */
+typedef struct {
+    gnrc_nettype_t type;                /**< protocol type of the receivers */
+    uint32_t demux_ctx;                 /**< demux context of the receivers */
+    unsigned numof;                     /**< number of packets collected */
+    gnrc_pktsnip_t *pkts[GNRC_NETAPI_BURST_SIZE];   /**< the packets */
+} gnrc_netapi_burst_t;
+#endif
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
@@ -215,6 +271,72 @@ static inline int gnrc_netapi_dispatch_receive(gnrc_nettype_t type, uint32_t dem
     return gnrc_netapi_dispatch(type, demux_ctx, GNRC_NETAPI_MSG_TYPE_RCV, pkt);
 }
 
+#if defined(MODULE_GNRC_NETAPI_BURST) || defined(DOXYGEN)
+/**
+ * @brief   Adds a received packet to a burst for the subscribers to
+ *          (@p type, @p demux_ctx)
+ *
+ * The burst is handed on first if it holds packets for other subscribers, and
+ * afterwards if it is full.
+ *
+ * @note    Only available with @ref net_gnrc_netapi_burst.
+ *
+ * @param[in,out] burst     the burst, zero-initialized before first use
+ * @param[in] type          protocol type of the targeted network modules
+ * @param[in] demux_ctx     demultiplexing context for @p type
+ * @param[in] pkt           the packet, the burst takes it over
+ */
+void gnrc_netapi_burst_add(gnrc_netapi_burst_t *burst, gnrc_nettype_t type,
+                           uint32_t demux_ctx, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Hands the packets of a burst on to its subscribers
+ *
+ * Threads registered with @ref GNRC_NETREG_TYPE_BURST get one
+ * @ref GNRC_NETAPI_MSG_TYPE_RCV_BURST message, other threads a
+ * @ref GNRC_NETAPI_MSG_TYPE_RCV message for each packet. The messages to all
+ * threads are queued in one critical section, so that a thread of higher
+ * priority only runs after all got theirs. Packets without subscribers are
+ * released.
+ *
+ * @note    Only available with @ref net_gnrc_netapi_burst.
+ *
+ * @param[in,out] burst     the burst, empty afterwards
+ *
+ * @return  Number of subscribers the packets were handed to.
+ */
+int gnrc_netapi_burst_flush(gnrc_netapi_burst_t *burst);
+
+/**
+ * @brief   Gets the number of packets in a
+ *          @ref GNRC_NETAPI_MSG_TYPE_RCV_BURST message
+ *
+ * @note    Only available with @ref net_gnrc_netapi_burst.
+ *
+ * @param[in] burst     content of the message
+ *
+ * @return  Number of packets
+ */
+static inline unsigned gnrc_netapi_burst_numof(const gnrc_pktsnip_t *burst)
+{
+    return burst->size / sizeof(gnrc_pktsnip_t *);
+}
+
+/**
+ * @brief   Gets the packets of a @ref GNRC_NETAPI_MSG_TYPE_RCV_BURST message
+ *
+ * @note    Only available with @ref net_gnrc_netapi_burst.
+ *
+ * @param[in] burst     content of the message
+ *
+ * @return  Array of gnrc_netapi_burst_numof() packets
+ */
+static inline gnrc_pktsnip_t **gnrc_netapi_burst_pkts(const gnrc_pktsnip_t *burst)
+{
+    return (gnrc_pktsnip_t **)burst->data;
+}
+#endif
+
 /**
  * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_GET messages and
  *          parsing the returned @ref GNRC_NETAPI_MSG_TYPE_ACK message
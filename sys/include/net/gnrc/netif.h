@@ -104,6 +104,13 @@ typedef struct {
 #endif
 #if defined(MODULE_GNRC_SIXLOWPAN) || DOXYGEN
     gnrc_netif_6lo_t sixlo;                 /**< 6Lo component */
+#endif
+#if defined(MODULE_GNRC_NETAPI_BURST) || DOXYGEN
+    /**
+     * @brief   Received packets not yet handed on, see
+     *          @ref net_gnrc_netapi_burst
+     */
+    gnrc_netapi_burst_t rx_burst;
 #endif
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
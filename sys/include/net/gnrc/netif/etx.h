@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_etx ETX link estimation
+ * @ingroup     net_gnrc_netif
+ * @brief       Estimates the expected transmission count (ETX) to each
+ *              neighbor from the results of unicast transmissions
+ *
+ * The interface thread records the link layer destination of every unicast
+ * frame it sends. When the device reports the result of the transmission
+ * (@ref NETDEV_EVENT_TX_COMPLETE, @ref NETDEV_EVENT_TX_NOACK, ...), the
+ * number of transmissions it took, including link layer retries
+ * (@ref NETOPT_TX_RETRIES_NEEDED), updates an exponentially weighted moving
+ * average of the ETX of that neighbor. A frame that was not acknowledged
+ * counts as @ref GNRC_NETIF_ETX_NOACK transmissions.
+ *
+ * ETX values are fixed-point numbers in units of 1 / @ref GNRC_NETIF_ETX_DIVISOR,
+ * the unit RPL uses for the ETX metric.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6551#section-4.3.2">
+ *          RFC 6551, section 4.3.2
+ *      </a>
+ * @{
+ *
+ * @file
+ * @brief       ETX link estimation definitions
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+#ifndef NET_GNRC_NETIF_ETX_H
+#define NET_GNRC_NETIF_ETX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pkt.h"
+#include "net/netdev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of neighbors the ETX is estimated for
+ *
+ * The least recently used neighbor is replaced by a new one.
+ */
+#ifndef GNRC_NETIF_ETX_NUMOF
+#define GNRC_NETIF_ETX_NUMOF            (8U)
+#endif
+
+/**
+ * @brief   Fixed-point divisor of ETX values
+ */
+#define GNRC_NETIF_ETX_DIVISOR          (128U)
+
+/**
+ * @brief   ETX assumed for a neighbor before the first transmission to it
+ */
+#ifndef GNRC_NETIF_ETX_INIT
+#define GNRC_NETIF_ETX_INIT             (2 * GNRC_NETIF_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   Transmissions a frame that was not acknowledged counts as
+ */
+#ifndef GNRC_NETIF_ETX_NOACK
+#define GNRC_NETIF_ETX_NOACK            (8U)
+#endif
+
+/**
+ * @brief   Weight of a new sample in the moving average, as power of two
+ *
+ * Each sample contributes 1 / 2^GNRC_NETIF_ETX_EWMA_SHIFT.
+ */
+#ifndef GNRC_NETIF_ETX_EWMA_SHIFT
+#define GNRC_NETIF_ETX_EWMA_SHIFT       (3U)
+#endif
+
+/**
+ * @brief   Records the destination of a frame the interface is about to send
+ *
+ * Must be called from the interface thread.
+ *
+ * @param[in] netif     The interface.
+ * @param[in] pkt       The packet, starting with its @ref gnrc_netif_hdr_t.
+ */
+void gnrc_netif_etx_tx_start(gnrc_netif_t *netif, const gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Updates the ETX of the destination of the last frame with the
+ *          result of its transmission
+ *
+ * Must be called from the interface thread. Events other than the results
+ * of a transmission are ignored.
+ *
+ * @param[in] netif     The interface.
+ * @param[in] event     The event of the device.
+ */
+void gnrc_netif_etx_tx_done(gnrc_netif_t *netif, netdev_event_t event);
+
+/**
+ * @brief   Updates the ETX of a neighbor
+ *
+ * @param[in] iface         Interface to the neighbor.
+ * @param[in] l2addr        Link layer address of the neighbor.
+ * @param[in] l2addr_len    Length of @p l2addr.
+ * @param[in] tx            Number of transmissions of the frame.
+ * @param[in] acked         true, if the frame was acknowledged.
+ */
+void gnrc_netif_etx_update(kernel_pid_t iface, const uint8_t *l2addr,
+                           uint8_t l2addr_len, unsigned tx, bool acked);
+
+/**
+ * @brief   Gets the ETX of a neighbor
+ *
+ * @param[in] iface         Interface to the neighbor.
+ * @param[in] l2addr        Link layer address of the neighbor.
+ * @param[in] l2addr_len    Length of @p l2addr.
+ *
+ * @return  The ETX in units of 1 / @ref GNRC_NETIF_ETX_DIVISOR
+ * @return  @ref GNRC_NETIF_ETX_INIT, if nothing was sent to the neighbor yet
+ */
+uint16_t gnrc_netif_etx_get(kernel_pid_t iface, const uint8_t *l2addr,
+                            uint8_t l2addr_len);
+
+/**
+ * @brief   Forgets all neighbors
+ */
+void gnrc_netif_etx_reset(void);
+
+/**
+ * @brief   Prints the ETX of all neighbors
+ */
+void gnrc_netif_etx_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_ETX_H */
+/** @} */
@@ -36,7 +36,7 @@ extern "C" {
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
-    defined(DOXYGEN)
+    defined(MODULE_GNRC_NETAPI_BURST) || defined(DOXYGEN)
 /**
  *  @brief  The type of the netreg entry.
  *
@@ -47,8 +47,8 @@ typedef enum {
      * @brief   Use [default IPC](@ref core_msg) for
      *          [netapi](@ref net_gnrc_netapi) operations.
      *
-     * @note    Implicitly chosen without `gnrc_netapi_mbox` and
-     *          `gnrc_netapi_callbacks` modules.
+     * @note    Implicitly chosen without `gnrc_netapi_mbox`,
+     *          `gnrc_netapi_callbacks` and `gnrc_netapi_burst` modules.
      */
     GNRC_NETREG_TYPE_DEFAULT = 0,
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -69,6 +69,17 @@ typedef enum {
      */
     GNRC_NETREG_TYPE_CB,
 #endif
+#if defined(MODULE_GNRC_NETAPI_BURST) || defined(DOXYGEN)
+    /**
+     * @brief   Use [default IPC](@ref core_msg) for
+     *          [netapi](@ref net_gnrc_netapi) operations, and take several
+     *          received packets in one @ref GNRC_NETAPI_MSG_TYPE_RCV_BURST
+     *          message.
+     *
+     * @note    Only available with `gnrc_netapi_burst` module.
+     */
+    GNRC_NETREG_TYPE_BURST,
+#endif
 } gnrc_netreg_type_t;
 #endif
 
@@ -79,6 +90,18 @@ typedef enum {
  */
 #define GNRC_NETREG_DEMUX_CTX_ALL   (0xffff0000)
 
+#ifndef GNRC_NETREG_BUCKETS
+/**
+ * @brief   Number of lists the entries of each type are kept in, must be a
+ *          power of two
+ *
+ * The entries are spread over the lists by a hash of their demux context, so
+ * a lookup only walks the entries whose demux context falls into the same
+ * list. Each list takes a pointer per type.
+ */
+#define GNRC_NETREG_BUCKETS         (4U)
+#endif
+
 /**
  * @name    Static entry initialization macros
  * @anchor  net_gnrc_netreg_init_static
@@ -93,7 +116,8 @@ typedef enum {
  *
  * @return  An initialized netreg entry
  */
-#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
+    defined(MODULE_GNRC_NETAPI_BURST)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
                                                       { pid } }
@@ -133,8 +157,28 @@ typedef enum {
 #define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, _cbd)   { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_CB, \
                                                       { .cbd = _cbd } }
+#endif
+
+#if defined(MODULE_GNRC_NETAPI_BURST) || defined(DOXYGEN)
+/**
+ * @brief   Initializes a netreg entry statically with PID of a thread that
+ *          takes bursts of received packets
+ *
+ * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *                      for the netreg entry
+ * @param[in] pid       The PID of the registering thread
+ *
+ * @note    Only available with @ref net_gnrc_netapi_burst.
+ *
+ * @return  An initialized netreg entry
+ */
+#define GNRC_NETREG_ENTRY_INIT_BURST(demux_ctx, pid)    { NULL, demux_ctx, \
+                                                          GNRC_NETREG_TYPE_BURST, \
+                                                          { pid } }
+#endif
 /** @} */
 
+#if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
 /**
  * @brief   Packet handler callback for netreg entries with callback.
  *
@@ -181,12 +225,12 @@ typedef struct gnrc_netreg_entry {
      */
     uint32_t demux_ctx;
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
-    defined(DOXYGEN)
+    defined(MODULE_GNRC_NETAPI_BURST) || defined(DOXYGEN)
     /**
      * @brief   Type of the registry entry
      *
-     * @note    Only available with @ref net_gnrc_netapi_mbox or
-     *          @ref net_gnrc_netapi_callbacks.
+     * @note    Only available with @ref net_gnrc_netapi_mbox,
+     *          @ref net_gnrc_netapi_callbacks or @ref net_gnrc_netapi_burst.
      */
     gnrc_netreg_type_t type;
 #endif
@@ -237,7 +281,8 @@ static inline void gnrc_netreg_entry_init_pid(gnrc_netreg_entry_t *entry,
 {
     entry->next = NULL;
     entry->demux_ctx = demux_ctx;
-#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
+    defined(MODULE_GNRC_NETAPI_BURST)
     entry->type = GNRC_NETREG_TYPE_DEFAULT;
 #endif
     entry->target.pid = pid;
@@ -286,6 +331,29 @@ static inline void gnrc_netreg_entry_init_cb(gnrc_netreg_entry_t *entry,
     entry->target.cbd = cbd;
 }
 #endif
+
+#if defined(MODULE_GNRC_NETAPI_BURST) || defined(DOXYGEN)
+/**
+ * @brief   Initializes a netreg entry dynamically with PID of a thread that
+ *          takes bursts of received packets
+ *
+ * @param[out] entry    A netreg entry
+ * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *                      for the netreg entry
+ * @param[in] pid       The PID of the registering thread
+ *
+ * @note    Only available with @ref net_gnrc_netapi_burst.
+ */
+static inline void gnrc_netreg_entry_init_burst(gnrc_netreg_entry_t *entry,
+                                                uint32_t demux_ctx,
+                                                kernel_pid_t pid)
+{
+    entry->next = NULL;
+    entry->demux_ctx = demux_ctx;
+    entry->type = GNRC_NETREG_TYPE_BURST;
+    entry->target.pid = pid;
+}
+#endif
 /** @} */
 
 /**
@@ -306,8 +374,8 @@ static inline void gnrc_netreg_entry_init_cb(gnrc_netreg_entry_t *entry,
  *          allocated @p entry in. Otherwise it might get overwritten.
  *
  * @pre The calling thread must provide a [message queue](@ref msg_init_queue)
- *      when using @ref GNRC_NETREG_TYPE_DEFAULT for gnrc_netreg_entry_t::type
- *      of @p entry.
+ *      when using @ref GNRC_NETREG_TYPE_DEFAULT or @ref GNRC_NETREG_TYPE_BURST
+ *      for gnrc_netreg_entry_t::type of @p entry.
  *
  * @return  0 on success
  * @return  -EINVAL if @p type was < GNRC_NETTYPE_UNDEF or >= GNRC_NETTYPE_NUMOF
@@ -193,12 +193,20 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
+#else
 #define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#endif
 
 /**
  * @brief   Default Objective Code Point (OF0)
+ *
+ * Used by roots. Set to @ref GNRC_RPL_MRHOF_OCP to use MRHOF.
  */
+#ifndef GNRC_RPL_DEFAULT_OCP
 #define GNRC_RPL_DEFAULT_OCP (0)
+#endif
 
 /**
  * @brief   Default Instance ID
@@ -349,6 +357,24 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
  */
 #define GNRC_RPL_DAO_DELAY_JITTER   (1000UL)
 #endif
+#ifndef GNRC_RPL_DAO_DELAY_MAX
+/**
+ * @brief Maximum delay for DAOs in milli seconds
+ *
+ * Each DAO received from a child postpones the own DAO by
+ * @ref GNRC_RPL_DAO_DELAY_DEFAULT, so the targets of a burst of DAOs are
+ * aggregated. The own DAO is not postponed beyond this delay.
+ */
+#define GNRC_RPL_DAO_DELAY_MAX      (4 * GNRC_RPL_DAO_DELAY_DEFAULT)
+#endif
+#ifndef GNRC_RPL_DAO_TARGETS_NUMOF
+/**
+ * @brief Maximum number of targets aggregated into one DAO
+ *
+ * Further targets are sent in additional DAOs.
+ */
+#define GNRC_RPL_DAO_TARGETS_NUMOF  (8)
+#endif
 /** @} */
 
 /**
@@ -535,6 +561,9 @@ void gnrc_rpl_send_DIS(gnrc_rpl_instance_t *instance, ipv6_addr_t *destination,
 /**
  * @brief   Send a DAO of the @p dodag to the @p destination.
  *
+ * All targets share one transit information option. More than
+ * @ref GNRC_RPL_DAO_TARGETS_NUMOF targets are split into several DAOs.
+ *
  * @param[in] instance          Pointer to the instance.
  * @param[in] destination       IPv6 addres of the destination.
  * @param[in] lifetime          Lifetime of the route to announce.
@@ -601,6 +630,9 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6
 /**
  * @brief   Delay the DAO sending interval
  *
+ * Repeated calls postpone a scheduled DAO by @ref GNRC_RPL_DAO_DELAY_DEFAULT
+ * each, up to @ref GNRC_RPL_DAO_DELAY_MAX after the first call.
+ *
  * @param[in] dodag     The DODAG of the DAO
  */
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag);
@@ -129,6 +129,24 @@ void gnrc_rpl_dodag_remove_all_parents(gnrc_rpl_dodag_t *dodag);
 bool gnrc_rpl_parent_add_by_addr(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
                                  gnrc_rpl_parent_t **parent);
 
+/**
+ * @brief   Remove the worst parent of the @p dodag, if a parent with rank
+ *          @p rank ranks better.
+ *
+ * The parents of a DODAG are kept sorted by the objective function. When
+ * the parent table is full, a better parent can thereby replace the worst
+ * one. The preferred parent is never removed.
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ * @param[in] addr      IPv6 address of the new parent
+ * @param[in] rank      Rank of the new parent
+ *
+ * @return  true, if a parent was removed.
+ * @return  false, otherwise.
+ */
+bool gnrc_rpl_parent_evict_worse(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
+                                 uint16_t rank);
+
 /**
  * @brief   Remove the @p parent from its DODAG.
  *
@@ -143,7 +161,8 @@ bool gnrc_rpl_parent_remove(gnrc_rpl_parent_t *parent);
  * @brief   Update a @p parent of the @p dodag.
  *
  * @param[in] dodag     Pointer to the DODAG
- * @param[in] parent    Pointer to the parent
+ * @param[in] parent    Pointer to the parent, NULL to re-evaluate all parents,
+ *                      e.g. after their link metrics changed
  */
 void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent);
 
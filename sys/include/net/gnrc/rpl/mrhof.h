@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_mrhof Minimum Rank with Hysteresis Objective Function
+ * @ingroup     net_gnrc_rpl
+ * @brief       MRHOF with the ETX metric
+ *
+ * MRHOF selects the parent with the lowest path cost, i.e. the rank of the
+ * parent plus the ETX of the link to it, as estimated by
+ * @ref net_gnrc_netif_etx. The preferred parent is only replaced by a parent
+ * whose path cost is lower by more than
+ * @ref GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD.
+ *
+ * DIOs do not carry a metric container, the path cost is derived from the
+ * rank of the parent. The ETX of a parent is only updated while unicast
+ * traffic, such as DAOs, is sent to it.
+ *
+ * To have a DODAG use MRHOF, set @ref GNRC_RPL_DEFAULT_OCP to
+ * @ref GNRC_RPL_MRHOF_OCP on the root. The nodes take the objective function
+ * from the DODAG configuration option of its DIOs.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6719">
+ *          RFC 6719
+ *      </a>
+ * @{
+ *
+ * @file
+ * @brief       MRHOF definitions
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+#ifndef NET_GNRC_RPL_MRHOF_H
+#define NET_GNRC_RPL_MRHOF_H
+
+#include "net/gnrc/rpl/structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Objective code point of MRHOF
+ */
+#define GNRC_RPL_MRHOF_OCP                      (1)
+
+/**
+ * @brief   Maximum ETX of the link to an acceptable parent
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_LINK_METRIC
+#define GNRC_RPL_MRHOF_MAX_LINK_METRIC          (512U)
+#endif
+
+/**
+ * @brief   Maximum path cost of an acceptable parent
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_PATH_COST
+#define GNRC_RPL_MRHOF_MAX_PATH_COST            (32768U)
+#endif
+
+/**
+ * @brief   Path cost a parent needs to be better by to replace the
+ *          preferred parent
+ *
+ * The own rank is only changed by more than this as well.
+ */
+#ifndef GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+#define GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD  (192U)
+#endif
+
+/**
+ * @brief   Return the address to the MRHOF objective function
+ *
+ * @return  Address of the MRHOF objective function
+ */
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_MRHOF_H */
+/** @} */
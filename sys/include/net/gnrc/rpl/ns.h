@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_ns RPL non-storing mode root
+ * @ingroup     net_gnrc_rpl
+ * @brief       Downward routing of a DODAG root in non-storing mode
+ *
+ * In non-storing mode (@ref GNRC_RPL_MOP_NON_STORING_MODE) the nodes of a
+ * DODAG keep no downward routes. Each node reports its parent in a DAO sent
+ * directly to the root. The root keeps these (target, parent) pairs as a
+ * graph, computes the path to a destination by following the parents up to
+ * itself, and inserts it as RPL source routing header (@ref net_gnrc_rpl_srh)
+ * into every packet it sends down the DODAG.
+ *
+ * Computed routes are cached per destination until the graph changes.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6550#section-9.7">
+ *          RFC 6550, section 9.7, Non-Storing Mode
+ *      </a>
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the RPL non-storing mode root
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+#ifndef NET_GNRC_RPL_NS_H
+#define NET_GNRC_RPL_NS_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of nodes (DAO targets) the root keeps in its graph
+ */
+#ifndef GNRC_RPL_NS_NODES_NUMOF
+#define GNRC_RPL_NS_NODES_NUMOF         (32U)
+#endif
+
+/**
+ * @brief   Number of computed routes the root caches
+ */
+#ifndef GNRC_RPL_NS_ROUTE_CACHE_SIZE
+#define GNRC_RPL_NS_ROUTE_CACHE_SIZE    (8U)
+#endif
+
+/**
+ * @brief   Maximum number of hops between the root and a destination
+ */
+#ifndef GNRC_RPL_NS_MAX_HOPS
+#define GNRC_RPL_NS_MAX_HOPS            (16U)
+#endif
+
+/**
+ * @brief   Adds or updates a node in the graph of the root
+ *
+ * @param[in] target        Address of the node.
+ * @param[in] parent        Global address of the node's parent.
+ * @param[in] lifetime      Lifetime of the entry in seconds. 0 removes the
+ *                          node (No-Path DAO).
+ * @param[in] iface         Interface the DODAG is on.
+ *
+ * @return  0 on success
+ * @return  -ENOMEM, if the graph is full
+ */
+int gnrc_rpl_ns_update(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                       uint32_t lifetime, kernel_pid_t iface);
+
+/**
+ * @brief   Removes all nodes from the graph of the root
+ */
+void gnrc_rpl_ns_flush(void);
+
+/**
+ * @brief   Gets the source route to a destination
+ *
+ * Returns right away, without locking the graph, if it is empty, i.e. on
+ * all nodes but a non-storing root with nodes below it.
+ *
+ * @param[in] dst           The destination.
+ * @param[out] hops         The intermediate hops, starting with the child
+ *                          of the root.
+ * @param[in] max_hops      Number of elements in @p hops.
+ * @param[out] iface        Interface to send to the first hop.
+ *
+ * @return  Number of intermediate hops, 0 if @p dst is a child of the root
+ * @return  -ENOENT, if there is no route to @p dst
+ * @return  -ELOOP, if the route contains a loop or exceeds @p max_hops
+ */
+int gnrc_rpl_ns_get_route(const ipv6_addr_t *dst, ipv6_addr_t *hops,
+                          unsigned max_hops, kernel_pid_t *iface);
+
+/**
+ * @brief   Prints the graph of the root
+ */
+void gnrc_rpl_ns_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_NS_H */
+/** @} */
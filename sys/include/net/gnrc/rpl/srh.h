@@ -23,6 +23,7 @@
 #ifndef NET_GNRC_RPL_SRH_H
 #define NET_GNRC_RPL_SRH_H
 
+#include "net/gnrc/pkt.h"
 #include "net/ipv6/hdr.h"
 #include "net/ipv6/addr.h"
 
@@ -69,6 +70,29 @@ typedef struct __attribute__((packed)) {
  */
 int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh, void **err_ptr);
 
+/**
+ * @brief   Inserts a RPL source routing header into a packet.
+ *
+ * The addresses are compressed by eliding the prefix they have in common with
+ * the IPv6 destination address. The destination address of @p ipv6 becomes
+ * the last address of the routing header and the first hop the new
+ * destination address.
+ *
+ * @pre The header of @p ipv6 is filled in completely, in particular the
+ *      upper layer checksum was calculated with the final destination.
+ *
+ * @param[in, out] ipv6 The IPv6 header of the outgoing packet, must be
+ *                      writable.
+ * @param[in] hops      The intermediate hops to the destination, the first
+ *                      one is the next hop.
+ * @param[in] hops_num  Number of addresses in @p hops, must be > 0.
+ *
+ * @return  0, on success
+ * @return  -ENOMEM, if the header does not fit into the packet buffer
+ */
+int gnrc_rpl_srh_insert(gnrc_pktsnip_t *ipv6, const ipv6_addr_t *hops,
+                        unsigned hops_num);
+
 #ifdef __cplusplus
 }
 #endif
@@ -260,7 +260,20 @@ struct gnrc_rpl_parent {
 typedef struct {
     uint16_t ocp;   /**< objective code point */
     uint16_t (*calc_rank)(gnrc_rpl_parent_t *parent, uint16_t base_rank); /**< calculate the rank */
-    gnrc_rpl_parent_t *(*which_parent)(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *); /**< retrieve the better parent */
+
+    /**
+     * @brief   Decide whether to replace the preferred parent.
+     *
+     * Called once the parents are sorted, if another parent than the
+     * preferred one sorts first. Objective functions with a hysteresis keep
+     * the preferred parent here, unless the other one is clearly better.
+     *
+     * @param[in] p1    The current preferred parent.
+     * @param[in] p2    The parent sorted first.
+     *
+     * @return      The parent to prefer.
+     */
+    gnrc_rpl_parent_t *(*which_parent)(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2);
 
     /**
      * @brief   Compare two @ref gnrc_rpl_parent_t.
@@ -268,7 +281,8 @@ typedef struct {
      * Compares two parents based on the rank calculated by the objective
      * function. This function is used to determine the parent list order. The
      * parents are ordered from the preferred parent to the least preferred
-     * parent.
+     * parent. The result must only depend on the two parents, see
+     * gnrc_rpl_of_t::update_metric.
      *
      * @param[in] parent1 First parent to compare.
      * @param[in] parent2 Second parent to compare.
@@ -283,6 +297,17 @@ typedef struct {
     void (*parent_state_callback)(gnrc_rpl_parent_t *, int, int); /**< retrieves the state of a parent*/
     void (*init)(void);  /**< OF specific init function */
     void (*process_dio)(void);  /**< DIO processing callback (acc. to OF0 spec, chpt 5) */
+
+    /**
+     * @brief   Refresh the link metric of a parent, may be NULL.
+     *
+     * Called once for a parent whose DIO was received, or for all parents
+     * when the link metrics may have changed, before they are sorted by
+     * parent_cmp().
+     *
+     * @param[in] parent Parent to update.
+     */
+    void (*update_metric)(gnrc_rpl_parent_t *parent);
 } gnrc_rpl_of_t;
 
 /**
@@ -307,6 +332,8 @@ struct gnrc_rpl_dodag {
     uint8_t dao_seq;                /**< dao sequence number */
     uint8_t dao_counter;            /**< amount of retried DAOs */
     bool dao_ack_received;          /**< flag to check for DAO-ACK */
+    bool dao_delayed;               /**< a DAO is scheduled to aggregate further targets */
+    uint32_t dao_delay_since;       /**< time the scheduled DAO was first delayed (in ms) */
     uint8_t dio_opts;               /**< options in the next DIO
                                          (see @ref GNRC_RPL_REQ_DIO_OPTS "DIO Options") */
     evtimer_msg_event_t dao_event;  /**< DAO TX events (see @ref GNRC_RPL_MSG_TYPE_DODAG_DAO_TX) */
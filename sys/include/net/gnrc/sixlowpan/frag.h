@@ -50,6 +50,9 @@ extern "C" {
 
 /**
  * @brief   Message type for triggering garbage collection reassembly buffer
+ *
+ * With @ref net_gnrc_sixlowpan_frag_vrb this also garbage collects the
+ * virtual reassembly buffer.
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF     (0x0226)
 /** @} */
@@ -92,6 +95,7 @@ typedef struct {
     size_t datagram_size;   /**< Length of just the (uncompressed) IPv6 packet to be fragmented */
     uint16_t offset;        /**< Offset of the Nth fragment from the beginning of the
                              *   payload datagram */
+    uint16_t tag;           /**< Datagram tag of the fragments */
     kernel_pid_t pid;       /**< PID of the interface */
 } gnrc_sixlowpan_msg_frag_t;
 
@@ -103,6 +107,13 @@ typedef struct {
  */
 gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void);
 
+/**
+ * @brief   Generates a new datagram tag for an outgoing fragmented datagram
+ *
+ * @return  A new datagram tag.
+ */
+uint16_t gnrc_sixlowpan_frag_next_tag(void);
+
 /**
  * @brief   Sends a packet fragmented
  *
@@ -148,6 +159,9 @@ void gnrc_sixlowpan_frag_rbuf_remove(gnrc_sixlowpan_rbuf_t *rbuf);
  * @brief   Checks if a reassembly buffer entry is complete and dispatches it
  *          to the next layer if that is the case
  *
+ * With @ref net_gnrc_sixlowpan_frag_vrb an incomplete datagram that is to be
+ * forwarded is handed over to the virtual reassembly buffer instead.
+ *
  * @pre `rbuf != NULL`
  * @pre `netif != NULL`
  *
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_vrb 6LoWPAN virtual reassembly buffer
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       Per-hop forwarding of 6LoWPAN fragments
+ *
+ * A router that does not need to look at a fragmented datagram beyond its
+ * IPv6 header does not have to reassemble it before forwarding. Once the
+ * first fragment of a datagram not destined to this node was received, a
+ * virtual reassembly buffer (VRB) entry maps the incoming
+ * (source, datagram size, tag) tuple to the interface, link-layer
+ * destination and datagram tag of the next hop. All following fragments are
+ * then relayed as they arrive instead of being buffered.
+ *
+ * To use it, add the `gnrc_sixlowpan_frag_vrb` module to your application.
+ *
+ * @see [draft-ietf-lwig-6lowpan-virtual-reassembly-01](https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01)
+ * @{
+ *
+ * @file
+ * @brief   Virtual reassembly buffer definitions
+ *
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+#define NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/ieee802154.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_SIZE
+/**
+ * @brief   Number of datagrams that can be forwarded in parallel
+ */
+#define GNRC_SIXLOWPAN_FRAG_VRB_SIZE        (16U)
+#endif
+
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT
+/**
+ * @brief   Timeout for a VRB entry in microseconds
+ *
+ * An entry is removed if no fragment for it was received for this time.
+ */
+#define GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT     (3U * US_PER_SEC)
+#endif
+
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_INTS
+/**
+ * @brief   Number of disjoint byte ranges of a datagram a VRB entry can
+ *          keep track of
+ *
+ * Fragments that arrive in order extend one range. If more ranges would be
+ * needed, the fragment is still forwarded, but the entry only times out
+ * instead of being removed once the datagram passed.
+ */
+#define GNRC_SIXLOWPAN_FRAG_VRB_INTS        (4U)
+#endif
+
+/**
+ * @brief   A range of bytes of a datagram
+ */
+typedef struct {
+    uint16_t start;                 /**< first byte of the range */
+    uint16_t end;                   /**< last byte of the range */
+} gnrc_sixlowpan_frag_vrb_int_t;
+
+/**
+ * @brief   Representation of a VRB entry
+ */
+typedef struct {
+    gnrc_netif_t *out_netif;                        /**< interface to forward to,
+                                                     *   `NULL` for an empty entry */
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];       /**< source address */
+    uint8_t out_dst[IEEE802154_LONG_ADDRESS_LEN];   /**< link-layer address of
+                                                     *   the next hop */
+    uint32_t arrival;               /**< time in microseconds of arrival of
+                                     *   last received fragment */
+    uint16_t datagram_size;         /**< size of the (uncompressed) datagram */
+    uint16_t tag;                   /**< datagram tag of incoming fragments */
+    uint16_t out_tag;               /**< datagram tag for outgoing fragments */
+    uint16_t current_size;          /**< number of (uncompressed) bytes of the
+                                     *   datagram forwarded so far */
+    gnrc_sixlowpan_frag_vrb_int_t ints[GNRC_SIXLOWPAN_FRAG_VRB_INTS];
+                                    /**< byte ranges of the datagram forwarded
+                                     *   so far, sorted */
+    uint8_t ints_num;               /**< number of entries in
+                                     *   gnrc_sixlowpan_frag_vrb_t::ints */
+    uint8_t src_len;                /**< length of gnrc_sixlowpan_frag_vrb_t::src */
+    uint8_t out_dst_len;            /**< length of
+                                     *   gnrc_sixlowpan_frag_vrb_t::out_dst */
+} gnrc_sixlowpan_frag_vrb_t;
+
+/**
+ * @brief   Adds a new entry to the VRB
+ *
+ * The outgoing datagram tag is taken from
+ * @ref gnrc_sixlowpan_frag_next_tag().
+ *
+ * @pre `(rbuf != NULL) && (rbuf->pkt != NULL) && (out_netif != NULL)`
+ * @pre `out_dst_len <= IEEE802154_LONG_ADDRESS_LEN`
+ *
+ * @param[in] rbuf          Reassembly buffer entry of the datagram, providing
+ *                          source address, datagram size and tag.
+ * @param[in] out_netif     Interface to forward the fragments over.
+ * @param[in] out_dst       Link-layer address of the next hop.
+ * @param[in] out_dst_len   Length of @p out_dst.
+ *
+ * @return  The new VRB entry on success.
+ * @return  NULL, if the VRB is full.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(const gnrc_sixlowpan_rbuf_t *rbuf,
+                                                       gnrc_netif_t *out_netif,
+                                                       const uint8_t *out_dst,
+                                                       size_t out_dst_len);
+
+/**
+ * @brief   Looks up a VRB entry and refreshes its arrival time
+ *
+ * @param[in] src           Link-layer source address of the fragment.
+ * @param[in] src_len       Length of @p src.
+ * @param[in] datagram_size Size of the datagram as noted in the fragment
+ *                          header.
+ * @param[in] tag           Datagram tag of the fragment.
+ *
+ * @return  The matching VRB entry.
+ * @return  NULL, if there is no entry for the fragment.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(const uint8_t *src,
+                                                       size_t src_len,
+                                                       size_t datagram_size,
+                                                       uint16_t tag);
+
+/**
+ * @brief   Records that a fragment of a datagram is forwarded
+ *
+ * Adds the bytes of the fragment, that were not forwarded before, to
+ * gnrc_sixlowpan_frag_vrb_t::current_size.
+ *
+ * @param[in] vrb       A VRB entry. Must not be NULL.
+ * @param[in] offset    Offset of the fragment in the (uncompressed)
+ *                      datagram.
+ * @param[in] len       Number of (uncompressed) bytes of the datagram in the
+ *                      fragment. Must not be 0.
+ *
+ * @return  true, if the fragment carries bytes not forwarded before.
+ * @return  false, if the fragment is a duplicate.
+ */
+bool gnrc_sixlowpan_frag_vrb_received(gnrc_sixlowpan_frag_vrb_t *vrb,
+                                      uint16_t offset, size_t len);
+
+/**
+ * @brief   Removes an entry from the VRB
+ *
+ * @param[in] vrb   A VRB entry. Must not be NULL.
+ */
+static inline void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb)
+{
+    vrb->out_netif = NULL;
+}
+
+/**
+ * @brief   Removes timed out entries from the VRB
+ */
+void gnrc_sixlowpan_frag_vrb_gc(void);
+
+/**
+ * @brief   Sends the first fragment of a forwarded datagram
+ *
+ * @note    Provided by @ref net_gnrc_sixlowpan_frag
+ *
+ * The reconstructed (and potentially recompressed) head of the datagram is
+ * sent with the tag and next hop of @p vrb. If it does not fit into one frame
+ * anymore (e.g. because the addresses can not be compressed as well on the
+ * next link) the remainder is sent as an additional subsequent fragment.
+ *
+ * @param[in] pkt           Head of the datagram in sending order, starting
+ *                          with a @ref gnrc_netif_hdr_t. Will be released in
+ *                          any case.
+ * @param[in] vrb           VRB entry of the datagram.
+ * @param[in] uncomp_len    Number of bytes of the uncompressed datagram
+ *                          carried in @p pkt.
+ *
+ * @return  0 on success.
+ * @return  -ENOMEM if there was not enough space in the packet buffer.
+ */
+int gnrc_sixlowpan_frag_vrb_send_1st(gnrc_pktsnip_t *pkt,
+                                     gnrc_sixlowpan_frag_vrb_t *vrb,
+                                     size_t uncomp_len);
+
+/**
+ * @brief   Forwards a subsequent fragment according to a VRB entry
+ *
+ * @note    Provided by @ref net_gnrc_sixlowpan_frag
+ *
+ * Replaces the link-layer header and the datagram tag of @p pkt. If the whole
+ * datagram was forwarded by this, @p vrb is removed. Duplicates of fragments
+ * forwarded before are dropped.
+ *
+ * @param[in] pkt       A subsequent fragment, starting with its fragment
+ *                      header. Any @ref gnrc_netif_hdr_t in the packet is
+ *                      replaced. Will be released on error or if it is a
+ *                      duplicate.
+ * @param[in] vrb       VRB entry of the datagram.
+ *
+ * @return  0 on success.
+ * @return  -EMSGSIZE if the fragment does not fit the outgoing interface.
+ * @return  -ENOMEM if there was not enough space in the packet buffer.
+ */
+int gnrc_sixlowpan_frag_vrb_forward(gnrc_pktsnip_t *pkt,
+                                    gnrc_sixlowpan_frag_vrb_t *vrb);
+
+#if defined(TEST_SUITES) || defined(DOXYGEN)
+/**
+ * @brief   Resets the VRB to a clean state
+ *
+ * @note    Only available when @ref TEST_SUITES is defined
+ */
+void gnrc_sixlowpan_frag_vrb_reset(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_VRB_H */
+/** @} */
@@ -34,6 +34,25 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Per-connection statistics, see gnrc_tcp_get_stats().
+ */
+typedef struct {
+    uint32_t cwnd;              /**< Congestion window in byte */
+    uint32_t ssthresh;          /**< Slow start threshold in byte */
+    uint32_t flight;            /**< Sent, but unacknowledged byte */
+    uint16_t snd_wnd;           /**< Send window advertised by the peer */
+    uint16_t rcv_wnd;           /**< Receive window advertised to the peer */
+    int32_t srtt;               /**< Smoothed round trip time in microseconds,
+                                 *   negative if there is no measurement yet */
+    int32_t rtt_var;            /**< Round trip time variance in microseconds,
+                                 *   negative if there is no measurement yet */
+    int32_t rto;                /**< Retransmission timeout in microseconds */
+    uint32_t retransmits;       /**< Number of retransmitted segments */
+    uint32_t fast_retransmits;  /**< Number of fast retransmits */
+    uint32_t timeouts;          /**< Number of retransmission timeouts */
+} gnrc_tcp_stats_t;
+
 /**
  * @brief Initialize TCP
  *
@@ -52,6 +71,27 @@ int gnrc_tcp_init(void);
  */
 void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Assigns a receive buffer to a TCB, instead of one of the
+ *        "GNRC_TCP_RCV_BUFFERS" preallocated buffers.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p buf must not be NULL.
+ *
+ * @note The receive buffer size determines the receive window of the connection.
+ *       To receive segments out of order, it has to hold several segments.
+ *       Sizes above 65535 byte do not increase the receive window further.
+ *
+ * @param[in,out] tcb   TCB that should use @p buf.
+ * @param[in]     buf   Receive buffer. Must stay valid as long as @p tcb is used.
+ * @param[in]     len   Size of @p buf in byte.
+ *
+ * @returns   Zero on success.
+ *            -EISCONN if TCB is already in use.
+ */
+int gnrc_tcp_tcb_set_rcv_buf(gnrc_tcp_tcb_t *tcb, void *buf, size_t len);
+
 /**
  * @brief Opens a connection actively.
  *
@@ -122,6 +162,11 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ *       Data counts as transmitted once it was sent and placed in the
+ *       retransmission queue, acknowledgments are not awaited. The amount of
+ *       data in flight is limited by the send window, the congestion window
+ *       and "GNRC_TCP_SND_SEGMENTS". With gnrc_tcp_pacing, segments are spread
+ *       over the round trip time instead of being sent in bursts.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -189,6 +234,21 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb);
  */
 void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Get the congestion control state and statistics of a connection.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p stats must not be NULL.
+ *
+ * @note Can be called from another thread, while @p tcb is used. The counters
+ *       are reset when a connection is established.
+ *
+ * @param[in]  tcb     TCB holding the connection information.
+ * @param[out] stats   Statistics of the connection.
+ */
+void gnrc_tcp_get_stats(gnrc_tcp_tcb_t *tcb, gnrc_tcp_stats_t *stats);
+
 /**
  * @brief Calculate and set checksum in TCP header.
  *
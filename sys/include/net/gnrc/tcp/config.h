@@ -61,7 +61,7 @@ extern "C" {
 #endif
 
 /**
- * @brief Default receive window size
+ * @brief Default receive window size, used as size of the preallocated receive buffers
  */
 #ifndef GNRC_TCP_DEFAULT_WINDOW
 #define GNRC_TCP_DEFAULT_WINDOW (GNRC_TCP_MSS * GNRC_TCP_MSS_MULTIPLICATOR)
@@ -81,6 +81,36 @@ extern "C" {
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Number of out-of-order segments a connection holds in the packet buffer
+ *        until the missing data arrives. Must be at least 1.
+ */
+#ifndef GNRC_TCP_RCV_OOO_SEGMENTS
+#define GNRC_TCP_RCV_OOO_SEGMENTS (4U)
+#endif
+
+/**
+ * @brief Number of unacknowledged data segments a connection keeps in flight.
+ *        One additional slot of the retransmission queue is reserved for the FIN.
+ */
+#ifndef GNRC_TCP_SND_SEGMENTS
+#define GNRC_TCP_SND_SEGMENTS (4U)
+#endif
+
+/**
+ * @brief Initial congestion window in segments (see RFC 5681, section 3.1)
+ */
+#ifndef GNRC_TCP_CWND_INIT_SEGMENTS
+#define GNRC_TCP_CWND_INIT_SEGMENTS (2U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUPACK_THRESHOLD
+#define GNRC_TCP_DUPACK_THRESHOLD (3U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
@@ -73,14 +73,31 @@ typedef struct _transmission_control_block {
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
-    uint8_t retries;       /**< Number of retransmissions */
+    uint32_t rtt_seq;      /**< Sequence number that ends the timed segment */
+    uint8_t retries;       /**< Number of retransmission timeouts of the oldest segment */
+    uint8_t dupacks;       /**< Number of consecutive duplicate ACKs */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Highest sequence number sent when loss recovery started */
+#ifdef MODULE_GNRC_TCP_PACING
+    uint32_t snd_pace;     /**< Earliest time (in usec) to send the next segment */
+#endif
+    uint32_t cnt_retransmits;        /**< Number of retransmitted segments */
+    uint32_t cnt_fast_retransmits;   /**< Number of fast retransmits */
+    uint32_t cnt_timeouts;           /**< Number of retransmission timeouts */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    gnrc_pktsnip_t *pkt_retransmit[GNRC_TCP_SND_SEGMENTS + 1];  /**< Retransmission queue,
+                                                                  *   oldest segment first */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    uint8_t *rcv_buf_user;   /**< Receive buffer supplied by the user, NULL if none */
+    size_t rcv_buf_user_size;    /**< Size of rcv_buf_user */
+    gnrc_pktsnip_t *rcv_ooo[GNRC_TCP_RCV_OOO_SEGMENTS];  /**< Out-of-order received segments,
+                                                           *   sorted by sequence number */
+    uint32_t rcv_ooo_last;   /**< Sequence number of the latest out-of-order segment */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
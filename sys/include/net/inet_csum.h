@@ -10,6 +10,11 @@
  * @defgroup    net_inet_csum    Internet Checksum
  * @ingroup     net
  * @brief   Provides a function to calculate the Internet Checksum
+ *
+ * The checksum is accumulated in 32-bit words (with SSE2 in 128-bit vectors
+ * if the compiler targets it) in host byte order and folded back to 16 bits
+ * afterwards. For changes to single fields of an already checksummed domain
+ * use inet_csum_update() instead of calculating the checksum anew.
  * @{
  *
  * @file
@@ -73,6 +78,59 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates an Internet Checksum for a changed 16-bit word of its
+ *          checksum domain
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624#section-3">
+ *          RFC 1624, section 3
+ *      </a>
+ *
+ * @details Calculates HC' = ~(~HC + ~m + m'), so the rest of the domain does
+ *          not need to be summed up again. To update for a changed 8-bit field
+ *          pass the 16-bit word that contains it.
+ *
+ * @param[in] csum      The normalized checksum (i.e. the 1's complement as
+ *                      it is stored in a header) in host byte order.
+ * @param[in] old_word  The old value of the word in host byte order.
+ * @param[in] new_word  The new value of the word in host byte order.
+ *
+ * @return  The updated normalized checksum in host byte order.
+ */
+static inline uint16_t inet_csum_update(uint16_t csum, uint16_t old_word,
+                                        uint16_t new_word)
+{
+    uint32_t sum = (uint32_t)(uint16_t)~csum + (uint16_t)~old_word + new_word;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+/**
+ * @brief   Updates an Internet Checksum for a changed buffer within its
+ *          checksum domain
+ *
+ * @see inet_csum_update()
+ *
+ * @param[in] csum      The normalized checksum in host byte order.
+ * @param[in] old_buf   The old content of the buffer.
+ * @param[in] new_buf   The new content of the buffer.
+ * @param[in] len       Length of @p old_buf and @p new_buf in byte.
+ * @param[in] offset    Offset of the buffer from the start of the checksum
+ *                      domain.
+ *
+ * @return  The updated normalized checksum in host byte order.
+ */
+static inline uint16_t inet_csum_update_buf(uint16_t csum,
+                                            const uint8_t *old_buf,
+                                            const uint8_t *new_buf,
+                                            uint16_t len, size_t offset)
+{
+    return inet_csum_update(csum, inet_csum_slice(0, old_buf, len, offset),
+                            inet_csum_slice(0, new_buf, len, offset));
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -40,6 +40,11 @@
  * by data type. If the pkt _payload_len_ attribute is a positive value, start
  * to read it at the _payload_ pointer attribute.
  *
+ * coap_parse() records the number, position and value length of the first
+ * instance of each option in the coap_pkt_t _options_ array, which is sorted
+ * by option number. The getters find an option there by binary search, and
+ * only decode the option itself.
+ *
  * If a response does not require specific CoAP options, use
  * coap_reply_simple(). If there is a payload, it writes a Content-Format
  * option with the provided value.
@@ -239,6 +244,7 @@ typedef struct __attribute__((packed)) {
 typedef struct {
     uint16_t opt_num;           /**< full CoAP option number    */
     uint16_t offset;            /**< offset in packet           */
+    uint16_t len;               /**< length of the option value */
 } coap_optpos_t;
 
 /**
@@ -680,6 +686,22 @@ size_t coap_opt_put_block2(uint8_t *buf, uint16_t lastonum, coap_block_slicer_t
  */
 unsigned coap_get_content_type(coap_pkt_t *pkt);
 
+/**
+ * @brief   Get the value of an option
+ *
+ * For an option that is repeated, like COAP_OPT_URI_PATH, this is the value
+ * of its first instance.
+ *
+ * @param[in]   pkt         packet to read from
+ * @param[in]   opt_num     absolute option number
+ * @param[out]  value       start of the option value in the packet
+ *
+ * @return      length of the option value
+ * @return      -ENOENT if the option is not present
+ */
+ssize_t coap_opt_get_opaque(const coap_pkt_t *pkt, unsigned opt_num,
+                            uint8_t **value);
+
 /**
  * @brief   Read a full option as null terminated string into the target buffer
  *
@@ -51,6 +51,7 @@ typedef struct {
  * @{
  */
 #define DNS_TYPE_A              (1)
+#define DNS_TYPE_SOA            (6)
 #define DNS_TYPE_AAAA           (28)
 #define DNS_CLASS_IN            (1)
 
@@ -61,6 +62,42 @@ typedef struct {
 #define SOCK_DNS_QUERYBUF_LEN   (sizeof(sock_dns_hdr_t) + 4 + SOCK_DNS_MAX_NAME_LEN)
 /** @} */
 
+/**
+ * @name DNS cache
+ *
+ * With the `sock_dns_cache` module, sock_dns_query() keeps answers for as
+ * long as their TTL allows, including answers that a name does not exist or
+ * has no address of the requested family (RFC 2308). A query for a name that
+ * is being resolved by another thread waits for that answer instead of
+ * sending the same query again.
+ * @{
+ */
+#ifndef SOCK_DNS_CACHE_SIZE
+/**
+ * @brief   Number of names in the cache
+ */
+#define SOCK_DNS_CACHE_SIZE     (4U)
+#endif
+
+#ifndef SOCK_DNS_CACHE_NEG_TTL
+/**
+ * @brief   Time to keep a negative answer without a SOA record [in s]
+ */
+#define SOCK_DNS_CACHE_NEG_TTL  (60U)
+#endif
+/** @} */
+
+/**
+ * @brief   DNS cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /**< queries answered from the cache */
+    uint32_t neg_hits;      /**< hits that were negative answers */
+    uint32_t misses;        /**< queries sent to the server */
+    uint32_t coalesced;     /**< queries that waited for an identical one */
+    uint32_t evictions;     /**< names dropped before their TTL ran out */
+} sock_dns_cache_stats_t;
+
 /**
  * @brief Get IP address for DNS name
  *
@@ -80,11 +117,29 @@ typedef struct {
  * @param[out]  addr_out        buffer to write result into
  * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
  *
- * @return      0 on success
- * @return      !=0 otherwise
+ * @return      length of the address in @p addr_out on success
+ * @return      -EHOSTUNREACH if the name does not exist or has no address of
+ *              @p family
+ * @return      <0 otherwise
  */
 int sock_dns_query(const char *domain_name, void *addr_out, int family);
 
+#if defined(MODULE_SOCK_DNS_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Drop all answers from the cache
+ *
+ * Call this when @ref sock_dns_server changes.
+ */
+void sock_dns_cache_flush(void);
+
+/**
+ * @brief   Get the statistics of the cache since boot
+ *
+ * @param[out]  stats   the statistics
+ */
+void sock_dns_cache_stats(sock_dns_cache_stats_t *stats);
+#endif
+
 /**
  * @brief global DNS server endpoint
  */
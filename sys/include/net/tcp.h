@@ -43,6 +43,8 @@ extern "C" {
 #define TCP_OPTION_KIND_EOL (0x00)  /**< "End of List"-Option */
 #define TCP_OPTION_KIND_NOP (0x01)  /**< "No Operatrion"-Option */
 #define TCP_OPTION_KIND_MSS (0x02)  /**< "Maximum Segment Size"-Option */
+#define TCP_OPTION_KIND_SACK_PERM (0x04)  /**< "SACK Permitted"-Option (RFC 2018) */
+#define TCP_OPTION_KIND_SACK (0x05)       /**< "SACK"-Option (RFC 2018) */
 /** @} */
 
 /**
@@ -50,8 +52,15 @@ extern "C" {
  * @{
  */
 #define TCP_OPTION_LENGTH_MSS (0x04)  /**< MSS Option Size always 4 */
+#define TCP_OPTION_LENGTH_SACK_PERM (0x02)  /**< SACK Permitted Option Size always 2 */
+#define TCP_OPTION_LENGTH_SACK_MIN (0x0A)   /**< SACK Option Size with one block */
 /** @} */
 
+/**
+ * @brief Maximum number of blocks in a SACK option, limited by the option space.
+ */
+#define TCP_SACK_BLOCKS_MAX (4U)
+
 /**
  * @brief TCP header definition
  */
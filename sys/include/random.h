@@ -22,6 +22,7 @@
  *  - Simple Park-Miller PRNG
  *  - Musl C PRNG
  *  - Fortuna (CS)PRNG
+ *  - xoshiro128** with one stream per thread (prng_xoshiro)
  */
 
 #ifndef RANDOM_H
@@ -54,7 +55,8 @@ extern "C" {
  *
  * @warning Currently, the random module uses a global state
  * => multiple calls to @ref random_init will reset the existing
- * state of the PRNG.
+ * state of the PRNG. With prng_xoshiro, it restarts the streams of all
+ * threads.
  *
  * @param s seed for the PRNG
  */
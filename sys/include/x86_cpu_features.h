@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_x86_cpu_features x86 CPU features
+ * @ingroup     sys
+ * @brief       Run-time check for instruction set extensions of x86 CPUs
+ *
+ * Code built for native may run on any x86 host, so modules using e.g. AES-NI
+ * check that the CPU has the instructions before they use them. The CPU is
+ * probed on the first call only.
+ *
+ * @note    Only available on x86 CPUs (`__x86_64__` or `__i386__`).
+ *
+ * @{
+ *
+ * @file
+ * @brief       x86 CPU feature interface
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef X86_CPU_FEATURES_H
+#define X86_CPU_FEATURES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Instruction set extensions
+ * @{
+ */
+#define X86_CPU_FEATURE_SSE2        (1U << 0)   /**< SSE2 */
+#define X86_CPU_FEATURE_SSE41       (1U << 1)   /**< SSE4.1 */
+#define X86_CPU_FEATURE_SSE42       (1U << 2)   /**< SSE4.2 */
+#define X86_CPU_FEATURE_AVX2        (1U << 3)   /**< AVX2 */
+#define X86_CPU_FEATURE_AES         (1U << 4)   /**< AES-NI */
+#define X86_CPU_FEATURE_PCLMUL      (1U << 5)   /**< carry-less multiply */
+#define X86_CPU_FEATURE_SHA         (1U << 6)   /**< SHA extensions */
+/** @} */
+
+/**
+ * @brief   Gets the instruction set extensions of the CPU
+ *
+ * @return  Bitmask of X86_CPU_FEATURE_* flags
+ */
+unsigned x86_cpu_features(void);
+
+/**
+ * @brief   Checks if the CPU has all of the given instruction set extensions
+ *
+ * @param[in] features  Bitmask of X86_CPU_FEATURE_* flags
+ *
+ * @return  1 if all of @p features are supported, 0 otherwise
+ */
+static inline int x86_cpu_supports(unsigned features)
+{
+    return (x86_cpu_features() & features) == features;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* X86_CPU_FEATURES_H */
+/** @} */
@@ -27,12 +27,45 @@
 #include "byteorder.h"
 #endif
 
+#ifdef MODULE_SOCK_DNS_CACHE
+#include <stdbool.h>
+
+#include "mutex.h"
+#include "xtimer.h"
+#endif
+
 /* min domain name length is 1, so minimum record length is 7 */
 #define DNS_MIN_REPLY_LEN   (unsigned)(sizeof(sock_dns_hdr_t ) + 7)
 
+#define DNS_RCODE_MASK      (0x000f)
+#define DNS_RCODE_NOERROR   (0)
+#define DNS_RCODE_NXDOMAIN  (3)
+
 /* global DNS server UDP endpoint */
 sock_udp_ep_t sock_dns_server;
 
+#ifdef MODULE_SOCK_DNS_CACHE
+enum {
+    CACHE_FREE = 0,
+    CACHE_PENDING,          /* the query is outstanding */
+    CACHE_VALID,
+};
+
+typedef struct {
+    uint32_t expires;       /* time the entry expires at [in s] */
+    mutex_t done;           /* held while the query is outstanding */
+    uint8_t state;
+    uint8_t family;
+    uint8_t addrlen;        /* 0 for a name without addresses */
+    uint8_t addr[16];
+    char name[SOCK_DNS_MAX_NAME_LEN + 1];
+} _cache_entry_t;
+
+static mutex_t _cache_lock = MUTEX_INIT;
+static _cache_entry_t _cache[SOCK_DNS_CACHE_SIZE];
+static sock_dns_cache_stats_t _cache_stats;
+#endif
+
 static ssize_t _enc_domain_name(uint8_t *out, const char *domain_name)
 {
     /*
@@ -75,6 +108,13 @@ static unsigned _get_short(uint8_t *buf)
     return _tmp;
 }
 
+static uint32_t _get_long(uint8_t *buf)
+{
+    uint32_t _tmp;
+    memcpy(&_tmp, buf, 4);
+    return _tmp;
+}
+
 static ssize_t _skip_hostname(const uint8_t *buf, size_t len, uint8_t *bufpos)
 {
     const uint8_t *buflim = buf + len;
@@ -102,11 +142,52 @@ static ssize_t _skip_hostname(const uint8_t *buf, size_t len, uint8_t *bufpos)
     return res + 1;
 }
 
-static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family)
+/* returns the TTL of a negative answer, see RFC 2308, section 5 */
+static uint32_t _parse_neg_ttl(uint8_t *buf, size_t len, uint8_t *bufpos)
+{
+    const uint8_t *buflim = buf + len;
+    sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
+
+    for (unsigned n = 0; n < ntohs(hdr->nscount); n++) {
+        ssize_t tmp = _skip_hostname(buf, len, bufpos);
+        if (tmp < 0) {
+            break;
+        }
+        bufpos += tmp;
+        if ((bufpos + RR_TYPE_LENGTH + RR_CLASS_LENGTH + RR_TTL_LENGTH +
+             RR_RDLENGTH_LENGTH) > buflim) {
+            break;
+        }
+        uint16_t _type = ntohs(_get_short(bufpos));
+        bufpos += (RR_TYPE_LENGTH + RR_CLASS_LENGTH);
+        uint32_t ttl = ntohl(_get_long(bufpos));
+        bufpos += RR_TTL_LENGTH;
+        unsigned rdlength = ntohs(_get_short(bufpos));
+        bufpos += RR_RDLENGTH_LENGTH;
+        if ((bufpos + rdlength) > buflim) {
+            break;
+        }
+        if ((_type == DNS_TYPE_SOA) && (rdlength >= 4)) {
+            /* the MINIMUM field ends the SOA record */
+            uint32_t minimum = ntohl(_get_long(bufpos + rdlength - 4));
+            return (ttl < minimum) ? ttl : minimum;
+        }
+        bufpos += rdlength;
+    }
+    return SOCK_DNS_CACHE_NEG_TTL;
+}
+
+static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out,
+                            int family, uint32_t *ttl)
 {
     const uint8_t *buflim = buf + len;
     sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
     uint8_t *bufpos = buf + sizeof(*hdr);
+    unsigned rcode = ntohs(hdr->flags) & DNS_RCODE_MASK;
+
+    if ((rcode != DNS_RCODE_NOERROR) && (rcode != DNS_RCODE_NXDOMAIN)) {
+        return -EBADMSG;
+    }
 
     /* skip all queries that are part of the reply */
     for (unsigned n = 0; n < ntohs(hdr->qdcount); n++) {
@@ -125,16 +206,19 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
             return tmp;
         }
         bufpos += tmp;
-        if ((bufpos + RR_TYPE_LENGTH + RR_CLASS_LENGTH + RR_TTL_LENGTH) >= buflim) {
+        if ((bufpos + RR_TYPE_LENGTH + RR_CLASS_LENGTH + RR_TTL_LENGTH +
+             RR_RDLENGTH_LENGTH) > buflim) {
             return -EBADMSG;
         }
         uint16_t _type = ntohs(_get_short(bufpos));
         bufpos += RR_TYPE_LENGTH;
         uint16_t class = ntohs(_get_short(bufpos));
         bufpos += RR_CLASS_LENGTH;
-        bufpos += RR_TTL_LENGTH; /* skip ttl */
+        *ttl = ntohl(_get_long(bufpos));
+        bufpos += RR_TTL_LENGTH;
 
         unsigned addrlen = ntohs(_get_short(bufpos));
+        bufpos += RR_RDLENGTH_LENGTH;
         /* skip unwanted answers */
         if ((class != DNS_CLASS_IN) ||
                 ((_type == DNS_TYPE_A) && (family == AF_INET6)) ||
@@ -156,8 +240,7 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
              (family == AF_UNSPEC))) {
             return -EBADMSG;
         }
-        bufpos += RR_RDLENGTH_LENGTH;
-        if ((bufpos + addrlen) >= buflim) {
+        if ((bufpos + addrlen) > buflim) {
             return -EBADMSG;
         }
 
@@ -165,22 +248,17 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
         return addrlen;
     }
 
-    return -1;
+    /* the name does not exist or has no address of the family */
+    *ttl = _parse_neg_ttl(buf, len, bufpos);
+    return -EHOSTUNREACH;
 }
 
-int sock_dns_query(const char *domain_name, void *addr_out, int family)
+static int _query(const char *domain_name, void *addr_out, int family,
+                  uint32_t *ttl)
 {
     uint8_t buf[SOCK_DNS_QUERYBUF_LEN];
     uint8_t reply_buf[512];
 
-    if (sock_dns_server.port == 0) {
-        return -ECONNREFUSED;
-    }
-
-    if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
-        return -ENOSPC;
-    }
-
     sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
     memset(hdr, 0, sizeof(*hdr));
     hdr->id = 0; /* random? */
@@ -223,8 +301,9 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         res = sock_udp_recv(&sock_dns, reply_buf, sizeof(reply_buf), 1000000LU, NULL);
         if (res > 0) {
             if (res > (int)DNS_MIN_REPLY_LEN) {
-                if ((res = _parse_dns_reply(reply_buf, res, addr_out,
-                                            family)) > 0) {
+                res = _parse_dns_reply(reply_buf, res, addr_out, family, ttl);
+                /* a negative answer is final, too */
+                if ((res > 0) || (res == -EHOSTUNREACH)) {
                     goto out;
                 }
             }
@@ -238,3 +317,153 @@ out:
     sock_udp_close(&sock_dns);
     return res;
 }
+
+#ifdef MODULE_SOCK_DNS_CACHE
+static uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+/* must be called with _cache_lock held */
+static _cache_entry_t *_cache_find(const char *domain_name, int family)
+{
+    uint32_t now = _now();
+
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        _cache_entry_t *entry = &_cache[i];
+
+        if ((entry->state == CACHE_VALID) &&
+            ((int32_t)(entry->expires - now) <= 0)) {
+            entry->state = CACHE_FREE;
+        }
+        if ((entry->state != CACHE_FREE) && (entry->family == family) &&
+            (strcmp(entry->name, domain_name) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* takes a free entry, or the one that expires first, for an outstanding
+ * query, must be called with _cache_lock held */
+static _cache_entry_t *_cache_claim(const char *domain_name, int family)
+{
+    _cache_entry_t *entry = NULL;
+
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        if (_cache[i].state == CACHE_FREE) {
+            entry = &_cache[i];
+            break;
+        }
+        if ((_cache[i].state == CACHE_VALID) &&
+            (!entry || ((int32_t)(_cache[i].expires - entry->expires) < 0))) {
+            entry = &_cache[i];
+        }
+    }
+    if (!entry) {
+        /* all entries wait for answers */
+        return NULL;
+    }
+    if (entry->state == CACHE_VALID) {
+        _cache_stats.evictions++;
+    }
+    entry->state = CACHE_PENDING;
+    entry->family = family;
+    strcpy(entry->name, domain_name);
+    mutex_lock(&entry->done);
+    return entry;
+}
+
+static int _cache_query(const char *domain_name, void *addr_out, int family)
+{
+    _cache_entry_t *entry;
+    bool waited = false;
+    uint32_t ttl = 0;
+    int res;
+
+    mutex_lock(&_cache_lock);
+    while ((entry = _cache_find(domain_name, family)) &&
+           (entry->state == CACHE_PENDING)) {
+        /* wait for the answer to the identical query, if that fails, this
+         * query is sent by itself */
+        if (!waited) {
+            _cache_stats.coalesced++;
+            waited = true;
+        }
+        mutex_unlock(&_cache_lock);
+        mutex_lock(&entry->done);
+        mutex_unlock(&entry->done);
+        mutex_lock(&_cache_lock);
+    }
+    if (entry) {
+        _cache_stats.hits++;
+        if (entry->addrlen == 0) {
+            _cache_stats.neg_hits++;
+            res = -EHOSTUNREACH;
+        }
+        else {
+            memcpy(addr_out, entry->addr, entry->addrlen);
+            res = entry->addrlen;
+        }
+        mutex_unlock(&_cache_lock);
+        return res;
+    }
+    _cache_stats.misses++;
+    entry = _cache_claim(domain_name, family);
+    mutex_unlock(&_cache_lock);
+
+    res = _query(domain_name, addr_out, family, &ttl);
+
+    if (entry) {
+        mutex_lock(&_cache_lock);
+        if (((res > 0) || (res == -EHOSTUNREACH)) && (ttl > 0)) {
+            entry->state = CACHE_VALID;
+            entry->expires = _now() + ((ttl > INT32_MAX) ? INT32_MAX : ttl);
+            entry->addrlen = (res > 0) ? res : 0;
+            memcpy(entry->addr, addr_out, entry->addrlen);
+        }
+        else {
+            entry->state = CACHE_FREE;
+        }
+        mutex_unlock(&entry->done);
+        mutex_unlock(&_cache_lock);
+    }
+    return res;
+}
+
+void sock_dns_cache_flush(void)
+{
+    mutex_lock(&_cache_lock);
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        if (_cache[i].state == CACHE_VALID) {
+            _cache[i].state = CACHE_FREE;
+        }
+    }
+    mutex_unlock(&_cache_lock);
+}
+
+void sock_dns_cache_stats(sock_dns_cache_stats_t *stats)
+{
+    mutex_lock(&_cache_lock);
+    memcpy(stats, &_cache_stats, sizeof(*stats));
+    mutex_unlock(&_cache_lock);
+}
+#endif
+
+int sock_dns_query(const char *domain_name, void *addr_out, int family)
+{
+    if (sock_dns_server.port == 0) {
+        return -ECONNREFUSED;
+    }
+
+    if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
+        return -ENOSPC;
+    }
+
+#ifdef MODULE_SOCK_DNS_CACHE
+    return _cache_query(domain_name, addr_out, family);
+#else
+    uint32_t ttl;
+    return _query(domain_name, addr_out, family, &ttl);
+#endif
+}
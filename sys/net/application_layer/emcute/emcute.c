@@ -41,6 +41,22 @@
 #define TFLAGS_RESP         (0x0001)
 #define TFLAGS_TIMEOUT      (0x0002)
 #define TFLAGS_ANY          (TFLAGS_RESP | TFLAGS_TIMEOUT)
+#define TFLAGS_WINDOW       (0x0004)
+
+#define T_RETRY_US          (EMCUTE_T_RETRY * US_PER_SEC)
+
+#if EMCUTE_PUB_WINDOW > 1
+/**
+ * @brief   QoS 1 PUBLISH message awaiting its PUBACK
+ */
+typedef struct {
+    uint32_t sent;                      /**< time of the last transmission */
+    uint16_t len;                       /**< length of the message, 0 if free */
+    uint16_t id;                        /**< message ID */
+    uint8_t retries;                    /**< retransmissions so far */
+    uint8_t buf[EMCUTE_PUB_BUFSIZE];    /**< the message */
+} pub_slot_t;
+#endif
 
 
 static const char *cli_id;
@@ -60,6 +76,20 @@ static volatile uint8_t waiton = 0xff;
 static volatile uint16_t waitonid = 0;
 static volatile int result;
 
+/* publishes collected by emcute_pub_batch(), all on the same topic */
+static uint8_t batch[EMCUTE_PUB_BUFSIZE];
+static size_t batch_len = 0;
+static uint16_t batch_topic;
+static unsigned batch_flags;
+
+#if EMCUTE_PUB_WINDOW > 1
+static mutex_t winlock = MUTEX_INIT;
+static pub_slot_t slots[EMCUTE_PUB_WINDOW];
+static thread_t *win_waiter = NULL;
+/* first error since the last call to emcute_pub_flush() */
+static int pub_res = EMCUTE_OK;
+#endif
+
 static size_t set_len(uint8_t *buf, size_t len)
 {
     if (len < (0xff - 7)) {
@@ -68,11 +98,18 @@ static size_t set_len(uint8_t *buf, size_t len)
     }
     else {
         buf[0] = 0x01;
-        byteorder_htobebufs(&tbuf[1], (uint16_t)(len + 3));
+        byteorder_htobebufs(&buf[1], (uint16_t)(len + 3));
         return 3;
     }
 }
 
+static size_t pub_len(size_t len)
+{
+    /* type, flags, topic ID and message ID follow the length field */
+    len += 6;
+    return len + ((len < (0xff - 7)) ? 1 : 3);
+}
+
 static size_t get_len(uint8_t *buf, uint16_t *len)
 {
     if (buf[0] != 0x01) {
@@ -147,6 +184,131 @@ static void on_ack(uint8_t type, int id_pos, int ret_pos, int res_pos)
     }
 }
 
+#if EMCUTE_PUB_WINDOW > 1
+/* the following functions must be called with winlock held */
+static void pub_done(pub_slot_t *slot, int res)
+{
+    slot->len = 0;
+    if (pub_res == EMCUTE_OK) {
+        pub_res = res;
+    }
+    if (win_waiter) {
+        thread_flags_set(win_waiter, TFLAGS_WINDOW);
+        win_waiter = NULL;
+    }
+}
+
+static void pub_wait(void)
+{
+    win_waiter = (thread_t *)sched_active_thread;
+    thread_flags_clear(TFLAGS_WINDOW);
+    mutex_unlock(&winlock);
+    thread_flags_wait_any(TFLAGS_WINDOW);
+    mutex_lock(&winlock);
+}
+
+static bool pub_inflight(void)
+{
+    for (unsigned i = 0; i < EMCUTE_PUB_WINDOW; i++) {
+        if (slots[i].len > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* waits for a free slot, must be called with txlock held */
+static pub_slot_t *pub_slot_get(void)
+{
+    mutex_lock(&winlock);
+    while (1) {
+        for (unsigned i = 0; i < EMCUTE_PUB_WINDOW; i++) {
+            if (slots[i].len == 0) {
+                mutex_unlock(&winlock);
+                return &slots[i];
+            }
+        }
+        pub_wait();
+    }
+}
+
+/* resends the messages that are due, returns the time until the next one */
+static uint32_t pub_retransmit(void)
+{
+    uint32_t next = T_RETRY_US;
+
+    mutex_lock(&winlock);
+    uint32_t now = xtimer_now_usec();
+    for (unsigned i = 0; i < EMCUTE_PUB_WINDOW; i++) {
+        pub_slot_t *slot = &slots[i];
+        uint32_t age = now - slot->sent;
+
+        if (slot->len == 0) {
+            continue;
+        }
+        if (age >= T_RETRY_US) {
+            if ((slot->retries >= EMCUTE_N_RETRY) || (gateway.port == 0)) {
+                DEBUG("[emcute] pub: no PUBACK for message %i\n",
+                      (int)slot->id);
+                pub_done(slot, EMCUTE_TIMEOUT);
+                continue;
+            }
+            /* the flags follow the length field and the type */
+            slot->buf[(slot->buf[0] == 0x01) ? 4 : 2] |= EMCUTE_DUP;
+            sock_udp_send(&sock, slot->buf, slot->len, &gateway);
+            slot->sent = now;
+            slot->retries++;
+            age = 0;
+        }
+        if ((T_RETRY_US - age) < next) {
+            next = T_RETRY_US - age;
+        }
+    }
+    mutex_unlock(&winlock);
+    return next;
+}
+#endif
+
+/* drops all publishes that are batched or in flight */
+static void pub_reset(void)
+{
+    batch_len = 0;
+#if EMCUTE_PUB_WINDOW > 1
+    mutex_lock(&winlock);
+    for (unsigned i = 0; i < EMCUTE_PUB_WINDOW; i++) {
+        if (slots[i].len > 0) {
+            pub_done(&slots[i], EMCUTE_OK);
+        }
+    }
+    pub_res = EMCUTE_OK;
+    mutex_unlock(&winlock);
+#endif
+}
+
+static void on_puback(size_t len)
+{
+#if EMCUTE_PUB_WINDOW > 1
+    if (len >= 7) {
+        uint16_t id = byteorder_bebuftohs(&rbuf[4]);
+
+        mutex_lock(&winlock);
+        for (unsigned i = 0; i < EMCUTE_PUB_WINDOW; i++) {
+            if ((slots[i].len > 0) && (slots[i].id == id)) {
+                pub_done(&slots[i], (rbuf[6] == ACCEPT) ? EMCUTE_OK
+                                                        : EMCUTE_REJECT);
+                mutex_unlock(&winlock);
+                return;
+            }
+        }
+        mutex_unlock(&winlock);
+    }
+#else
+    (void)len;
+#endif
+    /* not in the window, so emcute_pub() waits for it */
+    on_ack(PUBACK, 4, 6, 0);
+}
+
 static void on_publish(size_t len, size_t pos)
 {
     /* make sure packet length is valid - if not, drop packet silently */
@@ -224,6 +386,7 @@ int emcute_con(sock_udp_ep_t *remote, bool clean, const char *will_topic,
         return EMCUTE_NOGW;
     }
     memcpy(&gateway, remote, sizeof(sock_udp_ep_t));
+    pub_reset();
 
     /* figure out which flags to set */
     uint8_t flags = (clean) ? EMCUTE_CS : 0;
@@ -290,6 +453,7 @@ int emcute_discon(void)
 
     mutex_lock(&txlock);
 
+    pub_reset();
     tbuf[0] = 2;
     tbuf[1] = DISCONNECT;
 
@@ -324,6 +488,58 @@ int emcute_reg(emcute_topic_t *topic)
     return res;
 }
 
+/* sends a PUBLISH message, must be called with txlock held */
+static int pub_send(uint16_t topic_id, const void *data, size_t len,
+                    unsigned flags)
+{
+    uint8_t *buf = tbuf;
+#if EMCUTE_PUB_WINDOW > 1
+    pub_slot_t *slot = NULL;
+
+    if ((flags & EMCUTE_QOS_1) && (pub_len(len) <= EMCUTE_PUB_BUFSIZE)) {
+        slot = pub_slot_get();
+        buf = slot->buf;
+    }
+#endif
+
+    size_t pos = set_len(buf, (len + 6));
+    size_t pkt_len = (pos + 6 + len);
+    uint16_t id = id_next++;
+    buf[pos++] = PUBLISH;
+    buf[pos++] = flags;
+    byteorder_htobebufs(&buf[pos], topic_id);
+    pos += 2;
+    byteorder_htobebufs(&buf[pos], id);
+    pos += 2;
+    memcpy(&buf[pos], data, len);
+
+#if EMCUTE_PUB_WINDOW > 1
+    if (slot) {
+        mutex_lock(&winlock);
+        slot->len = pkt_len;
+        slot->id = id;
+        slot->retries = 0;
+        slot->sent = xtimer_now_usec();
+        sock_udp_send(&sock, buf, pkt_len, &gateway);
+        mutex_unlock(&winlock);
+        return EMCUTE_OK;
+    }
+#endif
+    if (flags & EMCUTE_QOS_1) {
+        waitonid = id;
+        return syncsend(PUBACK, pkt_len, false);
+    }
+    sock_udp_send(&sock, tbuf, pkt_len, &gateway);
+    return EMCUTE_OK;
+}
+
+static int pub_batch_send(void)
+{
+    int res = pub_send(batch_topic, batch, batch_len, batch_flags);
+    batch_len = 0;
+    return res;
+}
+
 int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
                unsigned flags)
 {
@@ -343,25 +559,84 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
 
     mutex_lock(&txlock);
 
-    size_t pos = set_len(tbuf, (len + 6));
-    len += (pos + 6);
-    tbuf[pos++] = PUBLISH;
-    tbuf[pos++] = flags;
-    byteorder_htobebufs(&tbuf[pos], topic->id);
-    pos += 2;
-    byteorder_htobebufs(&tbuf[pos], id_next);
-    waitonid = id_next++;
-    pos += 2;
-    memcpy(&tbuf[pos], data, len);
+    /* keep the order of all publishes */
+    if (batch_len > 0) {
+        res = pub_batch_send();
+    }
+    if (res == EMCUTE_OK) {
+        res = pub_send(topic->id, data, len, flags);
+    }
 
-    if (flags & EMCUTE_QOS_1) {
-        res = syncsend(PUBACK, len, true);
+    mutex_unlock(&txlock);
+    return res;
+}
+
+int emcute_pub_batch(emcute_topic_t *topic, const void *data, size_t len,
+                     unsigned flags)
+{
+    int res = EMCUTE_OK;
+
+    assert((topic->id != 0) && data && (len > 0) && !(flags & ~PUB_FLAGS));
+
+    if (gateway.port == 0) {
+        return EMCUTE_NOGW;
     }
-    else {
-        sock_udp_send(&sock, tbuf, len, &gateway);
-        mutex_unlock(&txlock);
+    if (len >= (EMCUTE_BUFSIZE - 9)) {
+        return EMCUTE_OVERFLOW;
+    }
+    if (flags & EMCUTE_QOS_2) {
+        return EMCUTE_NOTSUP;
     }
 
+    mutex_lock(&txlock);
+
+    if ((batch_len > 0) &&
+        ((batch_topic != topic->id) || (batch_flags != flags) ||
+         (pub_len(batch_len + len) > EMCUTE_PUB_BUFSIZE))) {
+        res = pub_batch_send();
+    }
+    if (res == EMCUTE_OK) {
+        if (pub_len(len) > EMCUTE_PUB_BUFSIZE) {
+            res = pub_send(topic->id, data, len, flags);
+        }
+        else {
+            batch_topic = topic->id;
+            batch_flags = flags;
+            memcpy(&batch[batch_len], data, len);
+            batch_len += len;
+        }
+    }
+
+    mutex_unlock(&txlock);
+    return res;
+}
+
+int emcute_pub_flush(void)
+{
+    int res = EMCUTE_OK;
+
+    if (gateway.port == 0) {
+        return EMCUTE_NOGW;
+    }
+
+    mutex_lock(&txlock);
+
+    if (batch_len > 0) {
+        res = pub_batch_send();
+    }
+#if EMCUTE_PUB_WINDOW > 1
+    mutex_lock(&winlock);
+    while (pub_inflight()) {
+        pub_wait();
+    }
+    if (res == EMCUTE_OK) {
+        res = pub_res;
+    }
+    pub_res = EMCUTE_OK;
+    mutex_unlock(&winlock);
+#endif
+
+    mutex_unlock(&txlock);
     return res;
 }
 
@@ -538,7 +813,7 @@ void emcute_run(uint16_t port, const char *id)
                 case WILLMSGREQ:    on_ack(type, 0, 0, 0);              break;
                 case REGACK:        on_ack(type, 4, 6, 2);              break;
                 case PUBLISH:       on_publish((size_t)pkt_len, pos);   break;
-                case PUBACK:        on_ack(type, 4, 6, 0);              break;
+                case PUBACK:        on_puback((size_t)pkt_len);         break;
                 case SUBACK:        on_ack(type, 5, 7, 3);              break;
                 case UNSUBACK:      on_ack(type, 2, 0, 0);              break;
                 case PINGREQ:       on_pingreq(&remote);                break;
@@ -561,5 +836,13 @@ void emcute_run(uint16_t port, const char *id)
         else {
             t_out = (EMCUTE_KEEPALIVE * US_PER_SEC) - (now - start);
         }
+#if EMCUTE_PUB_WINDOW > 1
+        /* without messages in flight, this wakes up every T_RETRY, so a
+         * retransmission can be late by up to that */
+        uint32_t t_pub = pub_retransmit();
+        if (t_pub < t_out) {
+            t_out = t_pub;
+        }
+#endif
     }
 }
@@ -24,6 +24,7 @@
 #include <string.h>
 
 #include "assert.h"
+#include "hashes.h"
 #include "net/gcoap.h"
 #include "net/sock/util.h"
 #include "mutex.h"
@@ -54,6 +55,10 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource);
+static void _index_add(gcoap_listener_t *listener);
+static void _index_set_obs_memo(const coap_resource_t *resource,
+                                gcoap_observe_memo_t *memo);
+static void _clear_pools(void);
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -67,28 +72,59 @@ static gcoap_listener_t _default_listener = {
     NULL
 };
 
+/* Entry of the index of resource paths */
+typedef struct {
+    const coap_resource_t *resource;    /* Indexed resource; unused if NULL */
+    gcoap_listener_t *listener;         /* Listener of the resource */
+    gcoap_observe_memo_t *obs_memo;     /* Last registration for the resource;
+                                           valid only if the memo still refers
+                                           to the resource */
+    uint32_t hash;                      /* Hash of the resource path */
+} gcoap_index_entry_t;
+
 /* Container for the state of gcoap itself */
 typedef struct {
     mutex_t lock;                       /* Shares state attributes safely */
     gcoap_listener_t *listeners;        /* List of registered listeners */
-    gcoap_request_memo_t open_reqs[GCOAP_REQ_WAITING_MAX];
-                                        /* Storage for open requests; if first
+    gcoap_request_memo_t *open_reqs;    /* Storage for open requests; if first
                                            byte of an entry is zero, the entry
                                            is available */
+    unsigned open_reqs_numof;           /* Number of entries in open_reqs */
     atomic_uint next_message_id;        /* Next message ID to use */
-    sock_udp_ep_t observers[GCOAP_OBS_CLIENTS_MAX];
-                                        /* Observe clients; allows reuse for
+    sock_udp_ep_t *observers;           /* Observe clients; allows reuse for
                                            observe memos */
-    gcoap_observe_memo_t observe_memos[GCOAP_OBS_REGISTRATIONS_MAX];
+    unsigned observers_numof;           /* Number of entries in observers */
+    gcoap_observe_memo_t *observe_memos;
                                         /* Observed resource registrations */
-    uint8_t resend_bufs[GCOAP_RESEND_BUFS_MAX][GCOAP_PDU_BUF_SIZE];
-                                        /* Buffers for PDU for request resends;
+    unsigned observe_memos_numof;       /* Number of entries in observe_memos */
+    uint8_t *resend_bufs;               /* Buffers for PDU for request resends;
                                            if first byte of an entry is zero,
                                            the entry is available */
+    unsigned resend_bufs_numof;         /* Number of buffers in resend_bufs */
+#if GCOAP_RESOURCE_INDEX_SIZE
+    gcoap_index_entry_t index[GCOAP_RESOURCE_INDEX_SIZE];
+                                        /* Resources by hash of their path */
+    unsigned index_used;                /* Number of used index entries */
+    bool index_full;                    /* Some resources are not indexed */
+#endif
 } gcoap_state_t;
 
+/* Built-in tables, used unless gcoap_set_pools() provides others */
+static gcoap_request_memo_t _open_reqs[GCOAP_REQ_WAITING_MAX];
+static sock_udp_ep_t _observers[GCOAP_OBS_CLIENTS_MAX];
+static gcoap_observe_memo_t _observe_memos[GCOAP_OBS_REGISTRATIONS_MAX];
+static uint8_t _resend_bufs[GCOAP_RESEND_BUFS_MAX][GCOAP_PDU_BUF_SIZE];
+
 static gcoap_state_t _coap_state = {
-    .listeners   = &_default_listener,
+    .listeners           = &_default_listener,
+    .open_reqs           = _open_reqs,
+    .open_reqs_numof     = GCOAP_REQ_WAITING_MAX,
+    .observers           = _observers,
+    .observers_numof     = GCOAP_OBS_CLIENTS_MAX,
+    .observe_memos       = _observe_memos,
+    .observe_memos_numof = GCOAP_OBS_REGISTRATIONS_MAX,
+    .resend_bufs         = &_resend_bufs[0][0],
+    .resend_bufs_numof   = GCOAP_RESEND_BUFS_MAX,
 };
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
@@ -335,6 +371,7 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
             if (memo->token_len) {
                 memcpy(&memo->token[0], pdu->token, memo->token_len);
             }
+            _index_set_obs_memo(resource, memo);
             DEBUG("gcoap: Registered observer for: %s\n", memo->resource->path);
         }
 
@@ -343,6 +380,7 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         /* clear memo, and clear observer if no other memos */
         if (memo != NULL) {
             DEBUG("gcoap: Deregistering observer for: %s\n", memo->resource->path);
+            _index_set_obs_memo(memo->resource, NULL);
             memo->observer = NULL;
             memo           = NULL;
             _find_obs_memo(&memo, remote, NULL);
@@ -369,6 +407,99 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     return pdu_len;
 }
 
+#if GCOAP_RESOURCE_INDEX_SIZE
+static inline uint32_t _path_hash(const char *path)
+{
+    return djb2_hash((const uint8_t *)path, strlen(path));
+}
+
+/*
+ * Searches the index for the entry of a resource.
+ *
+ * return entry for the resource, or NULL if not indexed
+ */
+static gcoap_index_entry_t *_index_get(const coap_resource_t *resource)
+{
+    uint32_t hash = _path_hash(resource->path);
+    unsigned pos  = hash & (GCOAP_RESOURCE_INDEX_SIZE - 1);
+
+    for (unsigned i = 0; i < GCOAP_RESOURCE_INDEX_SIZE; i++) {
+        gcoap_index_entry_t *entry = &_coap_state.index[pos];
+        if (entry->resource == NULL) {
+            break;
+        }
+        if (entry->resource == resource) {
+            return entry;
+        }
+        pos = (pos + 1) & (GCOAP_RESOURCE_INDEX_SIZE - 1);
+    }
+    return NULL;
+}
+#endif
+
+/*
+ * Adds the resources of a listener to the index. Once a resource does not
+ * fit, the index is not used anymore.
+ */
+static void _index_add(gcoap_listener_t *listener)
+{
+#if GCOAP_RESOURCE_INDEX_SIZE
+    /* index of a power of two */
+    assert(!(GCOAP_RESOURCE_INDEX_SIZE & (GCOAP_RESOURCE_INDEX_SIZE - 1)));
+
+    if (_coap_state.index_full) {
+        return;
+    }
+    /* gcoap's own resources come first, as in the list of listeners */
+    if (_coap_state.index_used == 0) {
+        if (listener != &_default_listener) {
+            _index_add(&_default_listener);
+        }
+    }
+    else if (listener == &_default_listener) {
+        return;
+    }
+    for (size_t i = 0; i < listener->resources_len; i++) {
+        const coap_resource_t *resource = &listener->resources[i];
+
+        if (_coap_state.index_used >= (GCOAP_RESOURCE_INDEX_SIZE * 3) / 4) {
+            DEBUG("gcoap: resource index full\n");
+            _coap_state.index_full = true;
+            return;
+        }
+        /* linear probing; entries for the same path stay in the order of
+         * registration */
+        uint32_t hash = _path_hash(resource->path);
+        unsigned pos  = hash & (GCOAP_RESOURCE_INDEX_SIZE - 1);
+        while (_coap_state.index[pos].resource != NULL) {
+            pos = (pos + 1) & (GCOAP_RESOURCE_INDEX_SIZE - 1);
+        }
+        _coap_state.index[pos].listener = listener;
+        _coap_state.index[pos].obs_memo = NULL;
+        _coap_state.index[pos].hash     = hash;
+        _coap_state.index[pos].resource = resource;
+        _coap_state.index_used++;
+    }
+#else
+    (void)listener;
+#endif
+}
+
+/* Remembers the observe registration for a resource in the index. */
+static void _index_set_obs_memo(const coap_resource_t *resource,
+                                gcoap_observe_memo_t *memo)
+{
+#if GCOAP_RESOURCE_INDEX_SIZE
+    gcoap_index_entry_t *entry = _index_get(resource);
+    if (entry != NULL) {
+        entry->obs_memo = memo;
+    }
+#else
+    (void)resource;
+    (void)memo;
+#endif
+}
+
 /*
  * Searches listener registrations for the resource matching the path in a PDU.
  *
@@ -393,6 +524,35 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
         return GCOAP_RESOURCE_NO_PATH;
     }
 
+#if GCOAP_RESOURCE_INDEX_SIZE
+    if (!_coap_state.index_full) {
+        uint32_t hash = _path_hash((char *)&uri[0]);
+        unsigned pos  = hash & (GCOAP_RESOURCE_INDEX_SIZE - 1);
+
+        for (unsigned i = 0; i < GCOAP_RESOURCE_INDEX_SIZE; i++) {
+            gcoap_index_entry_t *entry = &_coap_state.index[pos];
+            pos = (pos + 1) & (GCOAP_RESOURCE_INDEX_SIZE - 1);
+
+            if (entry->resource == NULL) {
+                break;
+            }
+            if ((entry->hash != hash) ||
+                    (strcmp((char *)&uri[0], entry->resource->path) != 0)) {
+                continue;
+            }
+            if (! (entry->resource->methods & method_flag)) {
+                ret = GCOAP_RESOURCE_WRONG_METHOD;
+                continue;
+            }
+
+            *resource_ptr = entry->resource;
+            *listener_ptr = entry->listener;
+            return GCOAP_RESOURCE_FOUND;
+        }
+        return ret;
+    }
+#endif
+
     while (listener) {
         const coap_resource_t *resource = listener->resources;
         for (size_t i = 0; i < listener->resources_len; i++) {
@@ -442,7 +602,7 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     coap_pkt_t *memo_pdu = &memo_pdu_data;
     unsigned cmplen      = coap_get_token_len(src_pdu);
 
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+    for (unsigned i = 0; i < _coap_state.open_reqs_numof; i++) {
         if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED)
             continue;
 
@@ -521,7 +681,7 @@ static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
 {
     int empty_slot = -1;
     *observer      = NULL;
-    for (unsigned i = 0; i < GCOAP_OBS_CLIENTS_MAX; i++) {
+    for (unsigned i = 0; i < _coap_state.observers_numof; i++) {
 
         if (_coap_state.observers[i].family == AF_UNSPEC) {
             empty_slot = i;
@@ -553,7 +713,7 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
     sock_udp_ep_t *remote_observer = NULL;
     _find_observer(&remote_observer, remote);
 
-    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+    for (unsigned i = 0; i < _coap_state.observe_memos_numof; i++) {
         if (_coap_state.observe_memos[i].observer == NULL) {
             empty_slot = i;
             continue;
@@ -589,7 +749,18 @@ static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource)
 {
     *memo = NULL;
-    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+#if GCOAP_RESOURCE_INDEX_SIZE
+    gcoap_index_entry_t *entry = _index_get(resource);
+    if (entry != NULL) {
+        /* the memo may have been deregistered or reused meanwhile */
+        if ((entry->obs_memo != NULL) && (entry->obs_memo->observer != NULL)
+                && (entry->obs_memo->resource == resource)) {
+            *memo = entry->obs_memo;
+        }
+        return;
+    }
+#endif
+    for (unsigned i = 0; i < _coap_state.observe_memos_numof; i++) {
         if (_coap_state.observe_memos[i].observer != NULL
                 && _coap_state.observe_memos[i].resource == resource) {
             *memo = &_coap_state.observe_memos[i];
@@ -598,6 +769,24 @@ static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
     }
 }
 
+/* Blanks the tables, so we know if an entry is available. */
+static void _clear_pools(void)
+{
+    memset(_coap_state.open_reqs, 0,
+           _coap_state.open_reqs_numof * sizeof(_coap_state.open_reqs[0]));
+    memset(_coap_state.observers, 0,
+           _coap_state.observers_numof * sizeof(_coap_state.observers[0]));
+    memset(_coap_state.observe_memos, 0,
+           _coap_state.observe_memos_numof * sizeof(_coap_state.observe_memos[0]));
+    memset(_coap_state.resend_bufs, 0,
+           _coap_state.resend_bufs_numof * GCOAP_PDU_BUF_SIZE);
+#if GCOAP_RESOURCE_INDEX_SIZE
+    for (unsigned i = 0; i < GCOAP_RESOURCE_INDEX_SIZE; i++) {
+        _coap_state.index[i].obs_memo = NULL;
+    }
+#endif
+}
+
 /*
  * gcoap interface functions
  */
@@ -612,10 +801,8 @@ kernel_pid_t gcoap_init(void)
 
     mutex_init(&_coap_state.lock);
     /* Blank lists so we know if an entry is available. */
-    memset(&_coap_state.open_reqs[0], 0, sizeof(_coap_state.open_reqs));
-    memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
-    memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
-    memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
+    _clear_pools();
+    _index_add(&_default_listener);
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
 
@@ -631,9 +818,61 @@ void gcoap_register_listener(gcoap_listener_t *listener)
     }
 
     listener->next = NULL;
+    _index_add(listener);
     _last->next = listener;
 }
 
+int gcoap_set_pools(const gcoap_pools_t *pools)
+{
+    mutex_lock(&_coap_state.lock);
+    if (gcoap_op_state() > 0) {
+        mutex_unlock(&_coap_state.lock);
+        return -EBUSY;
+    }
+    for (unsigned i = 0; i < _coap_state.observers_numof; i++) {
+        if (_coap_state.observers[i].family != AF_UNSPEC) {
+            mutex_unlock(&_coap_state.lock);
+            return -EBUSY;
+        }
+    }
+
+    if (pools->open_reqs) {
+        _coap_state.open_reqs       = pools->open_reqs;
+        _coap_state.open_reqs_numof = pools->open_reqs_numof;
+    }
+    else {
+        _coap_state.open_reqs       = _open_reqs;
+        _coap_state.open_reqs_numof = GCOAP_REQ_WAITING_MAX;
+    }
+    if (pools->resend_bufs) {
+        _coap_state.resend_bufs       = pools->resend_bufs;
+        _coap_state.resend_bufs_numof = pools->resend_bufs_numof;
+    }
+    else {
+        _coap_state.resend_bufs       = &_resend_bufs[0][0];
+        _coap_state.resend_bufs_numof = GCOAP_RESEND_BUFS_MAX;
+    }
+    if (pools->observers) {
+        _coap_state.observers       = pools->observers;
+        _coap_state.observers_numof = pools->observers_numof;
+    }
+    else {
+        _coap_state.observers       = _observers;
+        _coap_state.observers_numof = GCOAP_OBS_CLIENTS_MAX;
+    }
+    if (pools->observe_memos) {
+        _coap_state.observe_memos       = pools->observe_memos;
+        _coap_state.observe_memos_numof = pools->observe_memos_numof;
+    }
+    else {
+        _coap_state.observe_memos       = _observe_memos;
+        _coap_state.observe_memos_numof = GCOAP_OBS_REGISTRATIONS_MAX;
+    }
+    _clear_pools();
+    mutex_unlock(&_coap_state.lock);
+    return 0;
+}
+
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                    unsigned code, const char *path)
 {
@@ -740,7 +979,7 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
     if ((resp_handler != NULL) || (msg_type == COAP_TYPE_CON)) {
         mutex_lock(&_coap_state.lock);
         /* Find empty slot in list of open requests. */
-        for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+        for (unsigned i = 0; i < _coap_state.open_reqs_numof; i++) {
             if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
                 memo = &_coap_state.open_reqs[i];
                 memo->state = GCOAP_MEMO_WAIT;
@@ -760,9 +999,10 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
         case COAP_TYPE_CON:
             /* copy buf to resend_bufs record */
             memo->msg.data.pdu_buf = NULL;
-            for (int i = 0; i < GCOAP_RESEND_BUFS_MAX; i++) {
-                if (!_coap_state.resend_bufs[i][0]) {
-                    memo->msg.data.pdu_buf = &_coap_state.resend_bufs[i][0];
+            for (unsigned i = 0; i < _coap_state.resend_bufs_numof; i++) {
+                uint8_t *resend_buf = &_coap_state.resend_bufs[i * GCOAP_PDU_BUF_SIZE];
+                if (!resend_buf[0]) {
+                    memo->msg.data.pdu_buf = resend_buf;
                     memcpy(memo->msg.data.pdu_buf, buf, GCOAP_PDU_BUF_SIZE);
                     memo->msg.data.pdu_len = len;
                     break;
@@ -858,6 +1098,119 @@ int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
     return 0;
 }
 
+/* Content-Format and Block2 options and the payload marker, at most */
+#define BLOCK2_OPTIONS_MAX  (3 + 5 + 1)
+
+static ssize_t _block2_read(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            const gcoap_block_resource_t *res)
+{
+    uint32_t blknum = 0;
+    unsigned szx = NANOCOAP_BLOCK_SIZE_EXP_MAX - 4;
+    unsigned req_szx;
+
+    if (coap_get_blockopt(pdu, COAP_OPT_BLOCK2, &blknum, &req_szx) >= 0) {
+        /* a smaller block size than requested covers the same offset */
+        if (req_szx < szx) {
+            szx = req_szx;
+        }
+        blknum <<= (req_szx - szx);
+    }
+
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+
+    /* read one byte more than the block to learn if more blocks follow,
+     * behind room for the options */
+    uint8_t *data = pdu->payload + BLOCK2_OPTIONS_MAX;
+    size_t room = (buf + len) - data;
+    while ((coap_szx2size(szx) >= room) && (szx > 0)) {
+        blknum <<= 1;
+        szx--;
+    }
+    size_t blksize = coap_szx2size(szx);
+    if (blksize >= room) {
+        return -ENOSPC;
+    }
+
+    ssize_t read = res->read(res->ctx, blknum * blksize, data, blksize + 1);
+    if (read < 0) {
+        DEBUG("gcoap: block read failed: %d\n", (int)read);
+        return read;
+    }
+    if ((read == 0) && (blknum > 0)) {
+        /* beyond the end of the representation */
+        return gcoap_response(pdu, buf, len, COAP_CODE_BAD_OPTION);
+    }
+    bool more = ((size_t)read > blksize);
+    if (more) {
+        read = blksize;
+    }
+
+    if (res->format != COAP_FORMAT_NONE) {
+        coap_opt_add_uint(pdu, COAP_OPT_CONTENT_FORMAT, res->format);
+    }
+    coap_opt_add_uint(pdu, COAP_OPT_BLOCK2,
+                      (blknum << 4) | (more ? 0x8 : 0) | szx);
+    if (read) {
+        *pdu->payload++ = 0xFF;
+        memmove(pdu->payload, data, read);
+    }
+    pdu->payload_len = read;
+
+    return pdu->payload_len + (pdu->payload - (uint8_t *)pdu->hdr);
+}
+
+static ssize_t _block1_write(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             const gcoap_block_resource_t *res)
+{
+    coap_block1_t block1;
+    unsigned code;
+
+    /* without a Block1 option, the payload is the whole representation */
+    bool blockwise = coap_get_block1(pdu, &block1);
+    int ret = res->write(res->ctx, block1.offset, pdu->payload,
+                         pdu->payload_len, (block1.more == 1));
+
+    if (ret == -EINVAL) {
+        code = COAP_CODE_REQUEST_ENTITY_INCOMPLETE;
+    }
+    else if (ret == -ENOSPC) {
+        code = COAP_CODE_REQUEST_ENTITY_TOO_LARGE;
+    }
+    else if (ret < 0) {
+        DEBUG("gcoap: block write failed: %d\n", ret);
+        return ret;
+    }
+    else {
+        code = (block1.more == 1) ? COAP_CODE_CONTINUE : COAP_CODE_CHANGED;
+    }
+
+    gcoap_resp_init(pdu, buf, len, code);
+    if (blockwise && (ret == 0)) {
+        coap_opt_add_uint(pdu, COAP_OPT_BLOCK1,
+                          (block1.blknum << 4) | (block1.more ? 0x8 : 0) |
+                          block1.szx);
+    }
+    return gcoap_finish(pdu, 0, COAP_FORMAT_NONE);
+}
+
+ssize_t gcoap_block_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            void *ctx)
+{
+    const gcoap_block_resource_t *res = ctx;
+    unsigned method = coap_get_code_detail(pdu);
+
+    assert(res != NULL);
+
+    if ((method == COAP_METHOD_GET) && res->read) {
+        return _block2_read(pdu, buf, len, res);
+    }
+    if (((method == COAP_METHOD_PUT) || (method == COAP_METHOD_POST)) &&
+        res->write) {
+        return _block1_write(pdu, buf, len, res);
+    }
+    return gcoap_response(pdu, buf, len, COAP_CODE_METHOD_NOT_ALLOWED);
+}
+
 int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                   const coap_resource_t *resource)
 {
@@ -908,9 +1261,11 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
 uint8_t gcoap_op_state(void)
 {
     uint8_t count = 0;
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+    for (unsigned i = 0; i < _coap_state.open_reqs_numof; i++) {
         if (_coap_state.open_reqs[i].state != GCOAP_MEMO_UNUSED) {
-            count++;
+            if (++count == UINT8_MAX) {
+                break;
+            }
         }
     }
     return count;
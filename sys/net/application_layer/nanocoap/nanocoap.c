@@ -114,6 +114,7 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
 
                 optpos->opt_num = option_nr;
                 optpos->offset = (uintptr_t)option_start - (uintptr_t)hdr;
+                optpos->len = option_len;
                 DEBUG("optpos option_nr=%u %u\n", (unsigned)option_nr, (unsigned)optpos->offset);
                 optpos++;
                 option_count++;
@@ -147,20 +148,63 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
     return 0;
 }
 
-uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
+/* options are indexed in order of their number, the first of equal numbers
+ * is the first instance of the option */
+static const coap_optpos_t *_find_optpos(const coap_pkt_t *pkt,
+                                         unsigned opt_num)
 {
-    const coap_optpos_t *optpos = pkt->options;
-    unsigned opt_count = pkt->options_len;
+    unsigned lo = 0, hi = pkt->options_len;
+
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
 
-    while (opt_count--) {
-        if (optpos->opt_num == opt_num) {
-            return (uint8_t*)pkt->hdr + optpos->offset;
+        if (pkt->options[mid].opt_num < opt_num) {
+            lo = mid + 1;
         }
-        optpos++;
+        else {
+            hi = mid;
+        }
+    }
+    if ((lo < pkt->options_len) && (pkt->options[lo].opt_num == opt_num)) {
+        return &pkt->options[lo];
     }
     return NULL;
 }
 
+/* the value follows the option byte and the extended delta and length,
+ * which coap_parse() already checked */
+static uint8_t *_optpos_value(const coap_pkt_t *pkt,
+                              const coap_optpos_t *optpos)
+{
+    static const uint8_t ext_len[16] = { [13] = 1, [14] = 2 };
+    uint8_t *option_start = (uint8_t *)pkt->hdr + optpos->offset;
+
+    return option_start + 1 + ext_len[*option_start >> 4]
+           + ext_len[*option_start & 0xf];
+}
+
+uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
+{
+    const coap_optpos_t *optpos = _find_optpos(pkt, opt_num);
+
+    if (optpos) {
+        return (uint8_t *)pkt->hdr + optpos->offset;
+    }
+    return NULL;
+}
+
+ssize_t coap_opt_get_opaque(const coap_pkt_t *pkt, unsigned opt_num,
+                            uint8_t **value)
+{
+    const coap_optpos_t *optpos = _find_optpos(pkt, opt_num);
+
+    if (!optpos) {
+        return -ENOENT;
+    }
+    *value = _optpos_value(pkt, optpos);
+    return optpos->len;
+}
+
 static uint8_t *_parse_option(const coap_pkt_t *pkt,
                               uint8_t *pkt_pos, uint16_t *delta, int *opt_len)
 {
@@ -182,23 +226,15 @@ int coap_get_option_uint(coap_pkt_t *pkt, unsigned opt_num, uint32_t *target)
 {
     assert(target);
 
-    uint8_t *opt_pos = coap_find_option(pkt, opt_num);
-    if (opt_pos) {
-        uint16_t delta;
-        int option_len = 0;
-        uint8_t *pkt_pos = _parse_option(pkt, opt_pos, &delta, &option_len);
-        if (option_len >= 0) {
-            if (option_len > 4) {
-                DEBUG("nanocoap: uint option with len > 4 (unsupported).\n");
-                return -ENOSPC;
-            }
-            *target = _decode_uint(pkt_pos, option_len);
-            return 0;
-        }
-        else {
-            DEBUG("nanocoap: discarding packet with invalid option length.\n");
-            return -EBADMSG;
+    uint8_t *value;
+    ssize_t option_len = coap_opt_get_opaque(pkt, opt_num, &value);
+    if (option_len >= 0) {
+        if (option_len > 4) {
+            DEBUG("nanocoap: uint option with len > 4 (unsupported).\n");
+            return -ENOSPC;
         }
+        *target = _decode_uint(value, option_len);
+        return 0;
     }
     return -1;
 }
@@ -222,21 +258,13 @@ uint8_t *coap_iterate_option(const coap_pkt_t *pkt, uint8_t **optpos,
 
 unsigned coap_get_content_type(coap_pkt_t *pkt)
 {
-    uint8_t *opt_pos = coap_find_option(pkt, COAP_OPT_CONTENT_FORMAT);
+    uint8_t *value;
+    ssize_t option_len = coap_opt_get_opaque(pkt, COAP_OPT_CONTENT_FORMAT,
+                                             &value);
     unsigned content_type = COAP_FORMAT_NONE;
-    if (opt_pos) {
-        uint16_t delta;
-        int option_len = 0;
-        uint8_t *pkt_pos = _parse_option(pkt, opt_pos, &delta, &option_len);
-
-        if (option_len == 0) {
-            content_type = 0;
-        } else if (option_len == 1) {
-            content_type = *pkt_pos;
-        } else if (option_len == 2) {
-            memcpy(&content_type, pkt_pos, 2);
-            content_type = ntohs(content_type);
-        }
+
+    if ((option_len >= 0) && (option_len <= 2)) {
+        content_type = _decode_uint(value, option_len);
     }
 
     return content_type;
@@ -278,20 +306,17 @@ ssize_t coap_opt_get_string(const coap_pkt_t *pkt, uint16_t optnum,
 
 int coap_get_blockopt(coap_pkt_t *pkt, uint16_t option, uint32_t *blknum, unsigned *szx)
 {
-    uint8_t *optpos = coap_find_option(pkt, option);
-    if (!optpos) {
+    uint8_t *data_start;
+    ssize_t option_len = coap_opt_get_opaque(pkt, option, &data_start);
+    if ((option_len < 0) || (option_len > 3)) {
         *blknum = 0;
         *szx = 0;
         return -1;
     }
 
-    int option_len;
-    uint16_t delta;
-
-    uint8_t *data_start = _parse_option(pkt, optpos, &delta, &option_len);
     uint32_t blkopt = _decode_uint(data_start, option_len);
 
-    DEBUG("nanocoap: blkopt len: %i\n", option_len);
+    DEBUG("nanocoap: blkopt len: %i\n", (int)option_len);
     DEBUG("nanocoap: blkopt: 0x%08x\n", (unsigned)blkopt);
     *blknum = blkopt >> COAP_BLOCKWISE_NUM_OFF;
     *szx = blkopt & COAP_BLOCKWISE_SZX_MASK;
@@ -734,6 +759,7 @@ static ssize_t _add_opt_pkt(coap_pkt_t *pkt, uint16_t optnum, uint8_t *val,
 
     pkt->options[pkt->options_len].opt_num = optnum;
     pkt->options[pkt->options_len].offset = pkt->payload - (uint8_t *)pkt->hdr;
+    pkt->options[pkt->options_len].len = val_len;
     pkt->options_len++;
     pkt->payload += optlen;
     pkt->payload_len -= optlen;
@@ -14,12 +14,128 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* word types that may alias the byte buffer; only used on aligned addresses */
+typedef uint16_t __attribute__((__may_alias__)) _u16_alias_t;
+typedef uint32_t __attribute__((__may_alias__)) _u32_alias_t;
+
+/**
+ * @brief   Adds @p word to @p csum with end-around carry
+ */
+static inline uint32_t _add32(uint32_t csum, uint32_t word)
+{
+    csum += word;
+    return csum + (csum < word);
+}
+
+/**
+ * @brief   Folds a 32-bit 1's complement sum to 16 bit
+ */
+static inline uint16_t _fold(uint32_t csum)
+{
+    csum = (csum & 0xffff) + (csum >> 16);
+    csum = (csum & 0xffff) + (csum >> 16);
+    return (uint16_t)csum;
+}
+
+/**
+ * @brief   Sums up @p buf word-wise in host byte order
+ *
+ * Due to the byte order independence of the Internet Checksum (see
+ * [RFC 1071, section 2 (B)](https://tools.ietf.org/html/rfc1071#section-2))
+ * the result only needs to be byte-swapped on little endian platforms to get
+ * the sum in network byte order.
+ *
+ * @pre @p buf is 2-byte aligned
+ *
+ * @return  Folded sum of @p buf in host byte order. An odd trailing byte is
+ *          padded with zero.
+ */
+static uint16_t _sum_aligned(const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = 0;
+
+    if ((len >= 2) && ((uintptr_t)buf & 2)) {
+        csum = *((const _u16_alias_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+#ifdef __SSE2__
+    if (len >= 16) {
+        /* every 32-bit lane gains at most 2 * 0xffff per 16 byte, so for a
+         * uint16_t length the lanes can not overflow */
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = zero;
+        uint32_t lanes[4];
+
+        for (; len >= 16; buf += 16, len -= 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)buf);
+
+            acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v, zero));
+            acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(v, zero));
+        }
+        _mm_storeu_si128((__m128i *)lanes, acc);
+        for (unsigned i = 0; i < 4; i++) {
+            csum = _add32(csum, lanes[i]);
+        }
+    }
+#endif
+    /* unrolled to amortize the carry checks */
+    for (; len >= 16; buf += 16, len -= 16) {
+        const _u32_alias_t *words = (const _u32_alias_t *)buf;
+        uint64_t acc = (uint64_t)words[0] + words[1] + words[2] + words[3];
+
+        csum = _add32(csum, (uint32_t)acc);
+        csum = _add32(csum, (uint32_t)(acc >> 32));
+    }
+    for (; len >= 4; buf += 4, len -= 4) {
+        csum = _add32(csum, *((const _u32_alias_t *)buf));
+    }
+    if (len >= 2) {
+        csum = _add32(csum, *((const _u16_alias_t *)buf));
+        buf += 2;
+        len -= 2;
+    }
+    if (len) {
+        /* pad the last byte to the top half of a 16-bit word */
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        csum = _add32(csum, *buf);
+#else
+        csum = _add32(csum, (uint32_t)(*buf << 8));
+#endif
+    }
+    return _fold(csum);
+}
+
+/**
+ * @brief   Sums up @p buf as a sequence of 16-bit words in network byte order
+ *
+ * @return  Folded sum of @p buf. An odd trailing byte is padded with zero.
+ */
+static uint16_t _sum(const uint8_t *buf, uint16_t len)
+{
+    uint16_t csum;
+
+    if ((uintptr_t)buf & 1) {
+        /* the remainder is summed from an aligned address, so all its bytes
+         * land in the wrong half of their 16-bit word: swap that partial sum
+         * back and add the first byte as top half */
+        csum = byteorder_swaps(ntohs(_sum_aligned(buf + 1, len - 1)));
+        return _fold((uint32_t)csum + (uint16_t)(*buf << 8));
+    }
+    return ntohs(_sum_aligned(buf, len));
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -41,21 +157,15 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
     }
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    if (len > 0) {
+        /* add remaining bytes grouped by 16-bit words, with an odd last byte
+         * as top half of a 16-bit word */
+        csum += _sum(buf, len);
     }
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
-
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
-    }
+    csum = _fold(csum);
 
     DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
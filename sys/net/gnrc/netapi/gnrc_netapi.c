@@ -18,11 +18,15 @@
  * @}
  */
 
+#include <stdbool.h>
+
+#include "irq.h"
 #include "mbox.h"
 #include "msg.h"
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
+#include "thread.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -79,57 +83,209 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
+/* true for entries that are sent messages of the default IPC */
+static inline bool _is_thread(const gnrc_netreg_entry_t *entry)
+{
+#if defined(MODULE_GNRC_NETAPI_BURST)
+    return (entry->type == GNRC_NETREG_TYPE_DEFAULT) ||
+           (entry->type == GNRC_NETREG_TYPE_BURST);
+#elif defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    return (entry->type == GNRC_NETREG_TYPE_DEFAULT);
+#else
+    (void)entry;
+    return true;
+#endif
+}
+
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+/* hands pkt to an entry that is no thread, returns 0 if it was dropped */
+static int _dispatch_other(gnrc_netreg_entry_t *sendto, uint16_t cmd,
+                           gnrc_pktsnip_t *pkt)
+{
+    switch (sendto->type) {
+#ifdef MODULE_GNRC_NETAPI_MBOX
+        case GNRC_NETREG_TYPE_MBOX:
+            return (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) >= 1);
+#endif
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+        case GNRC_NETREG_TYPE_CB:
+            sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
+            return 1;
+#endif
+        default:
+            /* unknown dispatch type */
+            return 0;
+    }
+}
+#endif
+
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
     int numof = gnrc_netreg_num(type, demux_ctx);
 
     if (numof != 0) {
-        gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+        gnrc_netreg_entry_t *first = gnrc_netreg_lookup(type, demux_ctx);
+        gnrc_netreg_entry_t *sendto;
+        int release = 0, sent = 0;
+        msg_t msg;
 
         gnrc_pktbuf_hold(pkt, numof - 1);
 
-        while (sendto) {
-#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-            int release = 0;
-            switch (sendto->type) {
-                case GNRC_NETREG_TYPE_DEFAULT:
-                    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt,
-                                               cmd) < 1) {
-                        /* unable to dispatch packet */
-                        release = 1;
-                    }
-                    break;
-#ifdef MODULE_GNRC_NETAPI_MBOX
-                case GNRC_NETREG_TYPE_MBOX:
-                    if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        release = 1;
-                    }
-                    break;
-#endif
-#ifdef MODULE_GNRC_NETAPI_CALLBACKS
-                case GNRC_NETREG_TYPE_CB:
-                    sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
-                    break;
-#endif
-                default:
-                    /* unknown dispatch type */
-                    release = 1;
-                    break;
+        /* wake up all receiving threads at once, so none of higher priority
+         * preempts the dispatch before the others got the packet */
+        msg.type = cmd;
+        msg.content.ptr = (void *)pkt;
+        unsigned state = irq_disable();
+        for (sendto = first; sendto; sendto = gnrc_netreg_getnext(sendto)) {
+            if (!_is_thread(sendto)) {
+                continue;
             }
-            if (release) {
-                gnrc_pktbuf_release(pkt);
+            if (msg_try_send_noyield(&msg, sendto->target.pid) < 1) {
+                /* unable to dispatch packet */
+                release++;
             }
-#else
-            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+            else {
+                sent++;
+            }
+        }
+        irq_restore(state);
+
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+        for (sendto = first; sendto; sendto = gnrc_netreg_getnext(sendto)) {
+            if (!_is_thread(sendto) && !_dispatch_other(sendto, cmd, pkt)) {
                 /* unable to dispatch packet */
-                gnrc_pktbuf_release(pkt);
+                release++;
             }
+        }
 #endif
-            sendto = gnrc_netreg_getnext(sendto);
+        if (release) {
+            DEBUG("gnrc_netapi: dropped message to %i receivers\n", release);
+        }
+        while (release--) {
+            gnrc_pktbuf_release(pkt);
+        }
+        /* only a thread that got the packet may now preempt this one */
+        if (sent) {
+            thread_yield_higher();
         }
     }
 
     return numof;
 }
+
+#ifdef MODULE_GNRC_NETAPI_BURST
+void gnrc_netapi_burst_add(gnrc_netapi_burst_t *burst, gnrc_nettype_t type,
+                           uint32_t demux_ctx, gnrc_pktsnip_t *pkt)
+{
+    if ((burst->numof > 0) &&
+        ((burst->type != type) || (burst->demux_ctx != demux_ctx))) {
+        gnrc_netapi_burst_flush(burst);
+    }
+    burst->type = type;
+    burst->demux_ctx = demux_ctx;
+    burst->pkts[burst->numof++] = pkt;
+    if (burst->numof == GNRC_NETAPI_BURST_SIZE) {
+        gnrc_netapi_burst_flush(burst);
+    }
+}
+
+int gnrc_netapi_burst_flush(gnrc_netapi_burst_t *burst)
+{
+    unsigned numof = burst->numof;
+    int receivers = gnrc_netreg_num(burst->type, burst->demux_ctx);
+    gnrc_netreg_entry_t *first, *sendto;
+    gnrc_pktsnip_t *vec = NULL;
+    unsigned release[GNRC_NETAPI_BURST_SIZE] = { 0 };
+    unsigned vec_users = 0, vec_release = 0, sent = 0;
+    msg_t msg;
+
+    burst->numof = 0;
+    if ((numof == 0) || (receivers == 0)) {
+        for (unsigned i = 0; i < numof; i++) {
+            gnrc_pktbuf_release(burst->pkts[i]);
+        }
+        return 0;
+    }
+    first = gnrc_netreg_lookup(burst->type, burst->demux_ctx);
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_pktbuf_hold(burst->pkts[i], receivers - 1);
+    }
+
+    /* threads that take bursts share one list of the packets, without it
+     * they get the packets one by one */
+    if (numof > 1) {
+        for (sendto = first; sendto; sendto = gnrc_netreg_getnext(sendto)) {
+            vec_users += (sendto->type == GNRC_NETREG_TYPE_BURST);
+        }
+    }
+    if (vec_users > 0) {
+        vec = gnrc_pktbuf_add(NULL, burst->pkts,
+                              numof * sizeof(gnrc_pktsnip_t *),
+                              GNRC_NETTYPE_UNDEF);
+        if (vec != NULL) {
+            gnrc_pktbuf_hold(vec, vec_users - 1);
+        }
+    }
+
+    unsigned state = irq_disable();
+    for (sendto = first; sendto; sendto = gnrc_netreg_getnext(sendto)) {
+        if (!_is_thread(sendto)) {
+            continue;
+        }
+        if ((vec != NULL) && (sendto->type == GNRC_NETREG_TYPE_BURST)) {
+            msg.type = GNRC_NETAPI_MSG_TYPE_RCV_BURST;
+            msg.content.ptr = vec;
+            if (msg_try_send_noyield(&msg, sendto->target.pid) < 1) {
+                vec_release++;
+                for (unsigned i = 0; i < numof; i++) {
+                    release[i]++;
+                }
+            }
+            else {
+                sent++;
+            }
+            continue;
+        }
+        msg.type = GNRC_NETAPI_MSG_TYPE_RCV;
+        for (unsigned i = 0; i < numof; i++) {
+            msg.content.ptr = burst->pkts[i];
+            if (msg_try_send_noyield(&msg, sendto->target.pid) < 1) {
+                release[i]++;
+            }
+            else {
+                sent++;
+            }
+        }
+    }
+    irq_restore(state);
+
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    for (sendto = first; sendto; sendto = gnrc_netreg_getnext(sendto)) {
+        if (_is_thread(sendto)) {
+            continue;
+        }
+        for (unsigned i = 0; i < numof; i++) {
+            if (!_dispatch_other(sendto, GNRC_NETAPI_MSG_TYPE_RCV,
+                                 burst->pkts[i])) {
+                release[i]++;
+            }
+        }
+    }
+#endif
+    while (vec_release--) {
+        gnrc_pktbuf_release(vec);
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        while (release[i]--) {
+            gnrc_pktbuf_release(burst->pkts[i]);
+        }
+    }
+    /* only a thread that got a packet may now preempt this one */
+    if (sent) {
+        thread_yield_higher();
+    }
+
+    return receivers;
+}
+#endif
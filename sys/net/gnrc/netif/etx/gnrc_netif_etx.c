@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/etx.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define NB_USED         (0x01U)     /**< entry holds a neighbor */
+#define NB_PENDING      (0x02U)     /**< destination of the last unicast frame */
+
+/**
+ * @brief   ETX estimate of a neighbor
+ */
+typedef struct {
+    uint8_t l2addr[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];  /**< address of the neighbor */
+    uint32_t last_used;             /**< value of _clock at the last use */
+    uint16_t etx;                   /**< ETX estimate */
+    kernel_pid_t iface;             /**< interface to the neighbor */
+    uint8_t l2addr_len;             /**< length of l2addr */
+    uint8_t flags;                  /**< NB_* flags */
+} _nb_t;
+
+static _nb_t _nbs[GNRC_NETIF_ETX_NUMOF];
+static uint32_t _clock;
+static mutex_t _lock = MUTEX_INIT;
+
+/* must be called with _lock held */
+static _nb_t *_nb_get(kernel_pid_t iface, const uint8_t *l2addr,
+                      uint8_t l2addr_len, bool create)
+{
+    _nb_t *lru = NULL;
+
+    if (l2addr_len > GNRC_NETIF_HDR_L2ADDR_MAX_LEN) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < GNRC_NETIF_ETX_NUMOF; i++) {
+        _nb_t *nb = &_nbs[i];
+
+        if (!(nb->flags & NB_USED)) {
+            if ((lru == NULL) || (lru->flags & NB_USED)) {
+                lru = nb;
+            }
+            continue;
+        }
+        if ((nb->iface == iface) && (nb->l2addr_len == l2addr_len) &&
+            (memcmp(nb->l2addr, l2addr, l2addr_len) == 0)) {
+            nb->last_used = _clock++;
+            return nb;
+        }
+        if ((lru == NULL) ||
+            ((lru->flags & NB_USED) && ((int32_t)(nb->last_used - lru->last_used) < 0))) {
+            lru = nb;
+        }
+    }
+    if (!create || (lru == NULL)) {
+        return NULL;
+    }
+    memcpy(lru->l2addr, l2addr, l2addr_len);
+    lru->l2addr_len = l2addr_len;
+    lru->iface = iface;
+    lru->etx = GNRC_NETIF_ETX_INIT;
+    lru->flags = NB_USED;
+    lru->last_used = _clock++;
+    return lru;
+}
+
+/* must be called with _lock held */
+static void _nb_update(_nb_t *nb, unsigned tx, bool acked)
+{
+    uint32_t sample = (acked ? tx : GNRC_NETIF_ETX_NOACK) * GNRC_NETIF_ETX_DIVISOR;
+
+    if (sample > UINT16_MAX) {
+        sample = UINT16_MAX;
+    }
+    nb->etx = (uint16_t)(((uint32_t)nb->etx * ((1U << GNRC_NETIF_ETX_EWMA_SHIFT) - 1) +
+                          sample) >> GNRC_NETIF_ETX_EWMA_SHIFT);
+    DEBUG("gnrc_netif_etx: tx=%u acked=%u -> etx=%u\n", tx, (unsigned)acked,
+          nb->etx);
+}
+
+void gnrc_netif_etx_tx_start(gnrc_netif_t *netif, const gnrc_pktsnip_t *pkt)
+{
+    const gnrc_netif_hdr_t *hdr;
+
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < GNRC_NETIF_ETX_NUMOF; i++) {
+        if (_nbs[i].iface == netif->pid) {
+            _nbs[i].flags &= ~NB_PENDING;
+        }
+    }
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_NETIF)) {
+        mutex_unlock(&_lock);
+        return;
+    }
+    hdr = pkt->data;
+    /* only unicast frames are acknowledged */
+    if (!(hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) &&
+        (hdr->dst_l2addr_len > 0)) {
+        _nb_t *nb = _nb_get(netif->pid, gnrc_netif_hdr_get_dst_addr(hdr),
+                            hdr->dst_l2addr_len, true);
+
+        if (nb != NULL) {
+            nb->flags |= NB_PENDING;
+        }
+    }
+    mutex_unlock(&_lock);
+}
+
+void gnrc_netif_etx_tx_done(gnrc_netif_t *netif, netdev_event_t event)
+{
+    bool acked;
+
+    switch (event) {
+        case NETDEV_EVENT_TX_COMPLETE:
+        case NETDEV_EVENT_TX_COMPLETE_DATA_PENDING:
+            acked = true;
+            break;
+        case NETDEV_EVENT_TX_NOACK:
+            acked = false;
+            break;
+        case NETDEV_EVENT_TX_MEDIUM_BUSY:
+        case NETDEV_EVENT_TX_TIMEOUT:
+            /* nothing was sent, which says nothing about the link */
+            gnrc_netif_etx_tx_start(netif, NULL);
+            return;
+        default:
+            return;
+    }
+
+    uint8_t retries = 0;
+    netdev_t *dev = netif->dev;
+
+    if (dev->driver->get(dev, NETOPT_TX_RETRIES_NEEDED, &retries,
+                         sizeof(retries)) < 0) {
+        retries = 0;
+    }
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < GNRC_NETIF_ETX_NUMOF; i++) {
+        _nb_t *nb = &_nbs[i];
+
+        if ((nb->flags & NB_PENDING) && (nb->iface == netif->pid)) {
+            nb->flags &= ~NB_PENDING;
+            _nb_update(nb, retries + 1U, acked);
+            break;
+        }
+    }
+    mutex_unlock(&_lock);
+}
+
+void gnrc_netif_etx_update(kernel_pid_t iface, const uint8_t *l2addr,
+                           uint8_t l2addr_len, unsigned tx, bool acked)
+{
+    mutex_lock(&_lock);
+    _nb_t *nb = _nb_get(iface, l2addr, l2addr_len, true);
+
+    if (nb != NULL) {
+        _nb_update(nb, tx, acked);
+    }
+    mutex_unlock(&_lock);
+}
+
+uint16_t gnrc_netif_etx_get(kernel_pid_t iface, const uint8_t *l2addr,
+                            uint8_t l2addr_len)
+{
+    uint16_t etx = GNRC_NETIF_ETX_INIT;
+
+    mutex_lock(&_lock);
+    _nb_t *nb = _nb_get(iface, l2addr, l2addr_len, false);
+
+    if (nb != NULL) {
+        etx = nb->etx;
+    }
+    mutex_unlock(&_lock);
+    return etx;
+}
+
+void gnrc_netif_etx_reset(void)
+{
+    mutex_lock(&_lock);
+    memset(_nbs, 0, sizeof(_nbs));
+    mutex_unlock(&_lock);
+}
+
+void gnrc_netif_etx_print(void)
+{
+    char addr_str[GNRC_NETIF_HDR_L2ADDR_PRINT_LEN];
+
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < GNRC_NETIF_ETX_NUMOF; i++) {
+        _nb_t *nb = &_nbs[i];
+
+        if (!(nb->flags & NB_USED)) {
+            continue;
+        }
+        printf("%-24s iface %2d ETX %u.%02u\n",
+               gnrc_netif_addr_to_str(nb->l2addr, nb->l2addr_len, addr_str),
+               (int)nb->iface, nb->etx / GNRC_NETIF_ETX_DIVISOR,
+               ((nb->etx % GNRC_NETIF_ETX_DIVISOR) * 100) / GNRC_NETIF_ETX_DIVISOR);
+    }
+    mutex_unlock(&_lock);
+}
+
+/** @} */
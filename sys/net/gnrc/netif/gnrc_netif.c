@@ -28,6 +28,9 @@
 #ifdef MODULE_NETSTATS_IPV6
 #include "net/netstats.h"
 #endif
+#ifdef MODULE_GNRC_NETIF_ETX
+#include "net/gnrc/netif/etx.h"
+#endif
 #include "fmt.h"
 #include "log.h"
 #include "sched.h"
@@ -1146,7 +1149,7 @@ static void _configure_netdev(netdev_t *dev)
     if (res < 0) {
         DEBUG("gnrc_netif: enable NETOPT_RX_END_IRQ failed: %d\n", res);
     }
-#ifdef MODULE_NETSTATS_L2
+#if defined(MODULE_NETSTATS_L2) || defined(MODULE_GNRC_NETIF_ETX)
     res = dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
     if (res < 0) {
         DEBUG("gnrc_netif: enable NETOPT_TX_END_IRQ failed: %d\n", res);
@@ -1306,6 +1309,12 @@ static void *_gnrc_netif_thread(void *args)
     gnrc_netif_release(netif);
 
     while (1) {
+#ifdef MODULE_GNRC_NETAPI_BURST
+        /* hand on the packets received so far before waiting */
+        if (msg_avail() == 0) {
+            gnrc_netapi_burst_flush(&netif->rx_burst);
+        }
+#endif
         DEBUG("gnrc_netif: waiting for incoming messages\n");
         msg_receive(&msg);
         /* dispatch netdev, MAC and gnrc_netapi messages */
@@ -1316,6 +1325,9 @@ static void *_gnrc_netif_thread(void *args)
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
+#ifdef MODULE_GNRC_NETIF_ETX
+                gnrc_netif_etx_tx_start(netif, msg.content.ptr);
+#endif
                 res = netif->ops->send(netif, msg.content.ptr);
                 if (res < 0) {
                     DEBUG("gnrc_netif: error sending packet %p (code: %u)\n",
@@ -1369,14 +1381,21 @@ static void *_gnrc_netif_thread(void *args)
     return NULL;
 }
 
-static void _pass_on_packet(gnrc_pktsnip_t *pkt)
+static void _pass_on_packet(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
+#ifdef MODULE_GNRC_NETAPI_BURST
+    /* the burst throws it away if no one is interested */
+    gnrc_netapi_burst_add(&netif->rx_burst, pkt->type,
+                          GNRC_NETREG_DEMUX_CTX_ALL, pkt);
+#else
+    (void)netif;
     /* throw away packet if no one is interested */
     if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
         DEBUG("gnrc_netif: unable to forward packet of type %i\n", pkt->type);
         gnrc_pktbuf_release(pkt);
         return;
     }
+#endif
 }
 
 static void _event_cb(netdev_t *dev, netdev_event_t event)
@@ -1393,12 +1412,15 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
     }
     else {
         DEBUG("gnrc_netif: event triggered -> %i\n", event);
+#ifdef MODULE_GNRC_NETIF_ETX
+        gnrc_netif_etx_tx_done(netif, event);
+#endif
         switch (event) {
             case NETDEV_EVENT_RX_COMPLETE: {
                     gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
 
                     if (pkt) {
-                        _pass_on_packet(pkt);
+                        _pass_on_packet(netif, pkt);
                     }
                 }
                 break;
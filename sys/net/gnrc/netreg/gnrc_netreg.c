@@ -28,24 +28,38 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#if (GNRC_NETREG_BUCKETS & (GNRC_NETREG_BUCKETS - 1)) != 0
+#error "GNRC_NETREG_BUCKETS must be a power of two"
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t and demux context */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_BUCKETS];
+
+static inline unsigned _bucket(uint32_t demux_ctx)
+{
+    /* fold GNRC_NETREG_DEMUX_CTX_ALL and port numbers alike */
+    return (demux_ctx ^ (demux_ctx >> 16)) & (GNRC_NETREG_BUCKETS - 1);
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
 {
 #if DEVELHELP
-# if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-    bool has_msg_q = (entry->type != GNRC_NETREG_TYPE_DEFAULT) ||
-                     thread_has_msg_queue(sched_threads[entry->target.pid]);
+# if defined(MODULE_GNRC_NETAPI_BURST)
+    bool is_thread = (entry->type == GNRC_NETREG_TYPE_DEFAULT) ||
+                     (entry->type == GNRC_NETREG_TYPE_BURST);
+# elif defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    bool is_thread = (entry->type == GNRC_NETREG_TYPE_DEFAULT);
 # else
-    bool has_msg_q = thread_has_msg_queue(sched_threads[entry->target.pid]);
+    bool is_thread = true;
 # endif
+    bool has_msg_q = !is_thread ||
+                     thread_has_msg_queue(sched_threads[entry->target.pid]);
 
     /* only threads with a message queue are allowed to register at gnrc */
     if (!has_msg_q) {
@@ -59,7 +73,7 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    LL_PREPEND(netreg[type][_bucket(entry->demux_ctx)], entry);
 
     return 0;
 }
@@ -70,7 +84,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(netreg[type][_bucket(entry->demux_ctx)], entry);
 }
 
 /**
@@ -92,7 +106,8 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
     gnrc_netreg_entry_t *res = NULL;
 
     if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
+        gnrc_netreg_entry_t *head = (from) ? from->next
+                                           : netreg[type][_bucket(demux_ctx)];
         LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
     }
 
@@ -59,10 +59,24 @@ static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
 fib_table_t gnrc_ipv6_fib_table;
 #endif
 
+#ifdef MODULE_GNRC_RPL_NS
+#include "net/gnrc/rpl/ns.h"
+#include "net/gnrc/rpl/srh.h"
+/**
+ * @brief hops of the source route of the packet being sent
+ */
+static ipv6_addr_t _srh_hops[GNRC_RPL_NS_MAX_HOPS];
+#endif
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 kernel_pid_t gnrc_ipv6_pid = KERNEL_PID_UNDEF;
 
+#ifdef MODULE_GNRC_NETAPI_BURST
+/* received packets not yet handed on to the next header's thread */
+static gnrc_netapi_burst_t _rx_burst;
+#endif
+
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
 /* Sends packet over the appropriate interface(s).
@@ -144,6 +158,18 @@ static void _dispatch_next_header(gnrc_pktsnip_t *pkt, unsigned nh,
         gnrc_pktbuf_hold(pkt, 1);   /* don't remove from packet buffer in
                                      * next dispatch */
     }
+#ifdef MODULE_GNRC_NETAPI_BURST
+    else {
+        /* only the receivers of pkt->type get it, so it can wait for the
+         * next packets */
+        gnrc_netapi_burst_add(&_rx_burst, pkt->type, GNRC_NETREG_DEMUX_CTX_ALL,
+                              pkt);
+        return;
+    }
+    /* the subscribers to the next header get pkt right away, so hand on the
+     * packets before it first to keep the order of the dispatches */
+    gnrc_netapi_burst_flush(&_rx_burst);
+#endif
     if (gnrc_netapi_dispatch_receive(pkt->type,
                                      GNRC_NETREG_DEMUX_CTX_ALL,
                                      pkt) == 0) {
@@ -165,8 +191,13 @@ static void _dispatch_next_header(gnrc_pktsnip_t *pkt, unsigned nh,
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+#ifdef MODULE_GNRC_NETAPI_BURST
+    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_BURST(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                              sched_active_pid);
+#else
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
 
     (void)args;
     msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
@@ -179,6 +210,12 @@ static void *_event_loop(void *args)
 
     /* start event loop */
     while (1) {
+#ifdef MODULE_GNRC_NETAPI_BURST
+        /* hand on the packets received so far before waiting */
+        if (msg_avail() == 0) {
+            gnrc_netapi_burst_flush(&_rx_burst);
+        }
+#endif
         DEBUG("ipv6: waiting for incoming message.\n");
         msg_receive(&msg);
 
@@ -188,6 +225,20 @@ static void *_event_loop(void *args)
                 _receive(msg.content.ptr);
                 break;
 
+#ifdef MODULE_GNRC_NETAPI_BURST
+            case GNRC_NETAPI_MSG_TYPE_RCV_BURST: {
+                gnrc_pktsnip_t *burst = msg.content.ptr;
+                gnrc_pktsnip_t **pkts = gnrc_netapi_burst_pkts(burst);
+
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV_BURST received\n");
+                for (unsigned i = 0; i < gnrc_netapi_burst_numof(burst); i++) {
+                    _receive(pkts[i]);
+                }
+                gnrc_pktbuf_release(burst);
+                break;
+            }
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
                 _send(msg.content.ptr, true);
@@ -501,6 +552,38 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
 #endif  /* GNRC_NETIF_NUMOF */
 }
 
+#ifdef MODULE_GNRC_RPL_NS
+/* source routes a packet down a non-storing mode DODAG, if this node is its
+ * root and the destination is further away than one hop.
+ * Returns 1 if the header was filled in and the routing header inserted,
+ * 0 if the packet is to be sent unchanged and -1 if it was released. */
+static int _insert_srh(gnrc_netif_t **netif, gnrc_pktsnip_t *pkt)
+{
+    ipv6_hdr_t *hdr = pkt->data;
+    kernel_pid_t iface;
+    int hops_num = gnrc_rpl_ns_get_route(&hdr->dst, _srh_hops,
+                                         GNRC_RPL_NS_MAX_HOPS, &iface);
+
+    if (hops_num <= 0) {
+        return 0;
+    }
+    if ((*netif == NULL) &&
+        ((*netif = gnrc_netif_get_by_pid(iface)) == NULL)) {
+        return 0;
+    }
+    /* the upper layer checksum covers the final destination, so complete the
+     * header before the first hop replaces it */
+    if (!_safe_fill_ipv6_hdr(*netif, pkt, true)) {
+        return -1;
+    }
+    if (gnrc_rpl_srh_insert(pkt, _srh_hops, hops_num) < 0) {
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    return 1;
+}
+#endif
+
 static void _send_to_self(gnrc_pktsnip_t *pkt, bool prep_hdr,
                           gnrc_netif_t *netif)
 {
@@ -590,6 +673,16 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
             _send_to_self(pkt, prep_hdr, tmp_netif);
         }
         else {
+#ifdef MODULE_GNRC_RPL_NS
+            if (prep_hdr) {
+                int res = _insert_srh(&netif, pkt);
+
+                if (res < 0) {
+                    return;
+                }
+                prep_hdr = (res == 0);
+            }
+#endif
             _send_unicast(pkt, prep_hdr, netif, ipv6_hdr, netif_hdr_flags);
         }
     }
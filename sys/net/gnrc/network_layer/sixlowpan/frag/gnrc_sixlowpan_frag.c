@@ -21,6 +21,9 @@
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
 #include "net/gnrc/sixlowpan/internal.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
@@ -32,7 +35,7 @@
 #include "debug.h"
 
 static gnrc_sixlowpan_msg_frag_t _fragment_msg = {
-        NULL, 0, 0, KERNEL_PID_UNDEF
+        NULL, 0, 0, 0, KERNEL_PID_UNDEF
     };
 
 #if ENABLE_DEBUG
@@ -86,14 +89,17 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
     return frag;
 }
 
+/* payload_len: actual size of the packet vs
+ * datagram_size: size of the uncompressed IPv6 packet
+ * payload_diff: difference between the uncompressed and the actual size of
+ *               the part of the datagram in pkt (datagram_size - payload_len
+ *               if pkt is the whole datagram) */
 static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size)
+                                   size_t payload_len, size_t datagram_size,
+                                   int payload_diff, uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     uint16_t local_offset = 0;
-    /* payload_len: actual size of the packet vs
-     * datagram_size: size of the uncompressed IPv6 packet */
-    int payload_diff = (datagram_size - payload_len);
     /* virtually add payload_diff to flooring to account for offset (must be divisable by 8)
      * in uncompressed datagram */
     uint16_t max_frag_size = _floor8(iface->sixlo.max_frag_size + payload_diff -
@@ -115,7 +121,7 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
 
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
 
     /* Tell the link layer that we will send more fragments */
     gnrc_netif_hdr_t *netif_hdr = frag->data;
@@ -138,14 +144,15 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
 
     DEBUG("6lo frag: send first fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, local_offset);
+          (unsigned int)datagram_size, tag, local_offset);
     gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
     return local_offset;
 }
 
 static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
                                    size_t payload_len, size_t datagram_size,
-                                   uint16_t offset)
+                                   int payload_diff, uint16_t offset,
+                                   uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     /* since dispatches aren't supposed to go into subsequent fragments, we need not account
@@ -171,9 +178,9 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     /* XXX: truncation of datagram_size > 4095 may happen here */
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
     /* don't mention payload diff in offset */
-    hdr->offset = (uint8_t)((offset + (datagram_size - payload_len)) >> 3);
+    hdr->offset = (uint8_t)((offset + payload_diff) >> 3);
     pkt = pkt->next;    /* don't copy netif header */
 
     while ((pkt != NULL) && (offset_count != offset)) {   /* go to offset */
@@ -223,7 +230,7 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     DEBUG("6lo frag: send subsequent fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
           "fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, hdr->offset, hdr->offset << 3,
+          (unsigned int)datagram_size, tag, hdr->offset, hdr->offset << 3,
           local_offset);
     gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
     return local_offset;
@@ -234,6 +241,99 @@ gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void)
     return (_fragment_msg.pkt == NULL) ? &_fragment_msg : NULL;
 }
 
+uint16_t gnrc_sixlowpan_frag_next_tag(void)
+{
+    return ++_tag;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+int gnrc_sixlowpan_frag_vrb_send_1st(gnrc_pktsnip_t *pkt,
+                                     gnrc_sixlowpan_frag_vrb_t *vrb,
+                                     size_t uncomp_len)
+{
+    size_t payload_len = gnrc_pkt_len(pkt->next);
+    int payload_diff = (int)uncomp_len - (int)payload_len;
+    uint16_t offset;
+    int res = 0;
+
+    assert(pkt->type == GNRC_NETTYPE_NETIF);
+    assert(vrb != NULL);
+    offset = _send_1st_fragment(vrb->out_netif, pkt, payload_len,
+                                vrb->datagram_size, payload_diff,
+                                vrb->out_tag);
+    if (offset == 0) {
+        DEBUG("6lo frag: error forwarding 1st fragment\n");
+        res = -ENOMEM;
+    }
+    /* the head of the datagram may not fit into one frame on the outgoing
+     * link anymore, e.g. when the addresses compress worse than before */
+    while ((res == 0) && (offset < payload_len)) {
+        uint16_t sent = _send_nth_fragment(vrb->out_netif, pkt, payload_len,
+                                           vrb->datagram_size, payload_diff,
+                                           offset, vrb->out_tag);
+        if (sent == 0) {
+            DEBUG("6lo frag: error forwarding remainder of 1st fragment\n");
+            res = -ENOMEM;
+        }
+        offset += sent;
+    }
+    if (res == 0) {
+        gnrc_sixlowpan_frag_vrb_received(vrb, 0, uncomp_len);
+    }
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+int gnrc_sixlowpan_frag_vrb_forward(gnrc_pktsnip_t *pkt,
+                                    gnrc_sixlowpan_frag_vrb_t *vrb)
+{
+    gnrc_pktsnip_t *netif;
+    gnrc_netif_hdr_t *netif_hdr;
+    sixlowpan_frag_n_t *hdr;
+
+    assert((pkt != NULL) && (pkt->type == GNRC_NETTYPE_SIXLOWPAN));
+    assert((vrb != NULL) && (vrb->out_netif != NULL));
+    if (pkt->size > vrb->out_netif->sixlo.max_frag_size) {
+        DEBUG("6lo frag: fragment too big for interface %u, dropping "
+              "datagram\n", (unsigned)vrb->out_netif->pid);
+        gnrc_sixlowpan_frag_vrb_rm(vrb);
+        gnrc_pktbuf_release(pkt);
+        return -EMSGSIZE;
+    }
+    hdr = pkt->data;
+    if (!gnrc_sixlowpan_frag_vrb_received(vrb, (uint16_t)hdr->offset << 3,
+                                          pkt->size - sizeof(sixlowpan_frag_n_t))) {
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+    netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    if (netif != NULL) {
+        pkt = gnrc_pktbuf_remove_snip(pkt, netif);
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, vrb->out_dst, vrb->out_dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo frag: error allocating new link-layer header\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOMEM;
+    }
+    netif_hdr = netif->data;
+    netif_hdr->if_pid = vrb->out_netif->pid;
+    hdr = pkt->data;
+    hdr->tag = byteorder_htons(vrb->out_tag);
+    DEBUG("6lo frag: forward subsequent fragment (datagram size: %u, "
+          "datagram tag: %u -> %u, offset: %u)\n",
+          (unsigned)vrb->datagram_size, (unsigned)vrb->tag,
+          (unsigned)vrb->out_tag, (unsigned)hdr->offset << 3);
+    if (vrb->current_size >= vrb->datagram_size) {
+        /* whole datagram passed through */
+        gnrc_sixlowpan_frag_vrb_rm(vrb);
+    }
+    LL_PREPEND(pkt, netif);
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, 0);
+    return 0;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
 void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 {
     assert(ctx != NULL);
@@ -262,9 +362,11 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     /* Check whether to send the first or an Nth fragment */
     if (fragment_msg->offset == 0) {
         /* increment tag for successive, fragmented datagrams */
-        _tag++;
+        fragment_msg->tag = gnrc_sixlowpan_frag_next_tag();
         if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len,
-                                      fragment_msg->datagram_size)) == 0) {
+                                      fragment_msg->datagram_size,
+                                      fragment_msg->datagram_size - payload_len,
+                                      fragment_msg->tag)) == 0) {
             /* error sending first fragment */
             DEBUG("6lo frag: error sending 1st fragment\n");
             goto error;
@@ -274,7 +376,9 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     else if (fragment_msg->offset < payload_len) {
         if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len,
                                       fragment_msg->datagram_size,
-                                      fragment_msg->offset)) == 0) {
+                                      fragment_msg->datagram_size - payload_len,
+                                      fragment_msg->offset,
+                                      fragment_msg->tag)) == 0) {
             /* error sending subsequent fragment */
             DEBUG("6lo frag: error sending subsequent fragment"
                   "(offset = %u)\n", fragment_msg->offset);
@@ -321,12 +425,35 @@ void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             return;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_t *vrb;
+
+    vrb = gnrc_sixlowpan_frag_vrb_get(gnrc_netif_hdr_get_src_addr(hdr),
+                                      hdr->src_l2addr_len,
+                                      byteorder_ntohs(frag->disp_size) &
+                                      SIXLOWPAN_FRAG_SIZE_MASK,
+                                      byteorder_ntohs(frag->tag));
+    if (vrb != NULL) {
+        if (offset == 0) {
+            DEBUG("6lo frag: first fragment was already forwarded\n");
+            gnrc_pktbuf_release(pkt);
+        }
+        else {
+            gnrc_sixlowpan_frag_vrb_forward(pkt, vrb);
+        }
+        return;
+    }
+#endif
+
     rbuf_add(hdr, pkt, offset, page);
 }
 
 void gnrc_sixlowpan_frag_rbuf_gc(void)
 {
     rbuf_gc();
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_gc();
+#endif
 }
 
 void gnrc_sixlowpan_frag_rbuf_remove(gnrc_sixlowpan_rbuf_t *rbuf)
@@ -366,6 +493,11 @@ void gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(gnrc_sixlowpan_rbuf_t *rbuf
         gnrc_sixlowpan_dispatch_recv(rbuf->pkt, NULL, 0);
         gnrc_sixlowpan_frag_rbuf_remove(rbuf);
     }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    else if (rbuf_vrb_forward((rbuf_t *)rbuf)) {
+        DEBUG("6lo rbuf: datagram handed to virtual reassembly buffer\n");
+    }
+#endif
 }
 
 /** @} */
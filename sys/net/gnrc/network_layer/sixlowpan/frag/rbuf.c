@@ -25,6 +25,13 @@
 #include "thread.h"
 #include "xtimer.h"
 #include "utlist.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/udp.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -370,6 +377,135 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     return res;
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+static gnrc_pktsnip_t *_vrb_build_head(gnrc_sixlowpan_frag_vrb_t *vrb,
+                                       const uint8_t *data, size_t len)
+{
+    gnrc_pktsnip_t *payload, *ipv6, *netif;
+
+    payload = gnrc_pktbuf_add(NULL, data + sizeof(ipv6_hdr_t),
+                              len - sizeof(ipv6_hdr_t), GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    ipv6 = gnrc_pktbuf_add(payload, data, sizeof(ipv6_hdr_t),
+                           GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    /* act as the IPv6 layer would when forwarding */
+    ((ipv6_hdr_t *)ipv6->data)->hl--;
+    netif = gnrc_netif_hdr_build(NULL, 0, vrb->out_dst, vrb->out_dst_len);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = vrb->out_netif->pid;
+    LL_PREPEND(ipv6, netif);
+    return ipv6;
+}
+
+static int _vrb_send_head(gnrc_sixlowpan_frag_vrb_t *vrb, gnrc_pktsnip_t *pkt,
+                          size_t len)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    if (vrb->out_netif->flags & GNRC_NETIF_FLAGS_6LO_HC) {
+        /* IPHC hands the compressed head to the VRB for sending */
+        gnrc_sixlowpan_iphc_send(pkt, vrb, 0);
+        return 0;
+    }
+#endif
+    gnrc_pktsnip_t *disp = gnrc_pktbuf_add(pkt->next, NULL, sizeof(uint8_t),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+
+    if (disp == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOMEM;
+    }
+    ((uint8_t *)disp->data)[0] = SIXLOWPAN_UNCOMP;
+    pkt->next = disp;
+    return gnrc_sixlowpan_frag_vrb_send_1st(pkt, vrb, len);
+}
+
+bool rbuf_vrb_forward(rbuf_t *entry)
+{
+    uint8_t *data = entry->super.pkt->data;
+    ipv6_hdr_t *ipv6_hdr = (ipv6_hdr_t *)data;
+    gnrc_sixlowpan_frag_vrb_t *vrb;
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_netif_t *netif;
+    gnrc_pktsnip_t *pkt;
+    /* uncompressed length of the first fragment */
+    size_t first_len = entry->super.current_size;
+
+    /* first bytes of the datagram are cleared on creation, so the IPv6 header
+     * is only there after the first fragment was received */
+    if (!ipv6_hdr_is(ipv6_hdr)) {
+        return false;
+    }
+    for (rbuf_int_t *ptr = entry->ints; ptr != NULL; ptr = ptr->next) {
+        if (ptr->start != 0) {
+            first_len -= (ptr->end - ptr->start + 1);
+        }
+    }
+    /* IPHC expects a complete UDP header behind the IPv6 header, hop-by-hop
+     * options need to be handled by the IPv6 layer */
+    if ((first_len < (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t))) ||
+        (ipv6_hdr->nh == PROTNUM_IPV6_EXT_HOPOPT) || (ipv6_hdr->hl <= 1) ||
+        ipv6_addr_is_multicast(&ipv6_hdr->dst) ||
+        ipv6_addr_is_link_local(&ipv6_hdr->dst) ||
+        (gnrc_netif_get_by_ipv6_addr(&ipv6_hdr->dst) != NULL)) {
+        return false;
+    }
+    if (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, NULL, NULL,
+                                          &nce) < 0) {
+        return false;
+    }
+    netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
+    if ((netif == NULL) || !gnrc_netif_is_6ln(netif) ||
+        (netif->sixlo.max_frag_size == 0) ||
+        (nce.l2addr_len > IEEE802154_LONG_ADDRESS_LEN)) {
+        return false;
+    }
+    vrb = gnrc_sixlowpan_frag_vrb_add(&entry->super, netif, nce.l2addr,
+                                      nce.l2addr_len);
+    if (vrb == NULL) {
+        return false;
+    }
+    if ((pkt = _vrb_build_head(vrb, data, first_len)) == NULL) {
+        DEBUG("6lo rbuf: unable to build head of datagram for VRB\n");
+        gnrc_sixlowpan_frag_vrb_rm(vrb);
+        return false;
+    }
+    _vrb_send_head(vrb, pkt, first_len);
+    /* pass on subsequent fragments that overtook the first one */
+    for (rbuf_int_t *ptr = entry->ints; ptr != NULL; ptr = ptr->next) {
+        sixlowpan_frag_n_t *hdr;
+        size_t frag_size = ptr->end - ptr->start + 1;
+
+        if (ptr->start == 0) {
+            continue;
+        }
+        pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_frag_n_t) + frag_size,
+                              GNRC_NETTYPE_SIXLOWPAN);
+        if (pkt == NULL) {
+            DEBUG("6lo rbuf: unable to pass fragment to VRB\n");
+            break;
+        }
+        hdr = pkt->data;
+        hdr->disp_size = byteorder_htons(vrb->datagram_size);
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->offset = (uint8_t)(ptr->start >> 3);
+        memcpy(hdr + 1, data + ptr->start, frag_size);
+        gnrc_sixlowpan_frag_vrb_forward(pkt, vrb);
+    }
+    gnrc_pktbuf_release(entry->super.pkt);
+    rbuf_rm(entry);
+    return true;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
 #ifdef TEST_SUITES
 void rbuf_reset(void)
 {
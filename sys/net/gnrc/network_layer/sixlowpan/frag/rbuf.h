@@ -96,6 +96,28 @@ static inline bool rbuf_entry_empty(const rbuf_t *rbuf) {
     return (rbuf->super.pkt == NULL);
 }
 
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || defined(DOXYGEN)
+/**
+ * @brief   Hands a datagram over to the virtual reassembly buffer if it is to
+ *          be forwarded
+ *
+ * Checks the IPv6 header of the datagram, once the first fragment was
+ * received. If the datagram is to be forwarded over a 6LoWPAN interface a
+ * VRB entry for it is created, all fragments received so far are sent to the
+ * next hop and @p rbuf is removed from the reassembly buffer.
+ *
+ * @note    Only available with @ref net_gnrc_sixlowpan_frag_vrb
+ *
+ * @param[in] rbuf  An incomplete reassembly buffer entry.
+ *
+ * @return  true, if the datagram is forwarded by the VRB. @p rbuf was removed.
+ * @return  false, if the datagram needs to be reassembled.
+ *
+ * @internal
+ */
+bool rbuf_vrb_forward(rbuf_t *rbuf);
+#endif
+
 #if defined(TEST_SUITES) || defined(DOXYGEN)
 /**
  * @brief   Resets the packet buffer to a clean state
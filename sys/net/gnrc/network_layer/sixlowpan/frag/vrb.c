@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+
+#include <assert.h>
+#include <string.h>
+
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static gnrc_sixlowpan_frag_vrb_t _vrb[GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(const gnrc_sixlowpan_rbuf_t *rbuf,
+                                                       gnrc_netif_t *out_netif,
+                                                       const uint8_t *out_dst,
+                                                       size_t out_dst_len)
+{
+    gnrc_sixlowpan_frag_vrb_t *res = NULL;
+
+    assert((rbuf != NULL) && (rbuf->pkt != NULL) && (out_netif != NULL));
+    assert(out_dst_len <= IEEE802154_LONG_ADDRESS_LEN);
+    gnrc_sixlowpan_frag_vrb_gc();
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if (_vrb[i].out_netif == NULL) {
+            res = &_vrb[i];
+            break;
+        }
+    }
+    if (res == NULL) {
+        DEBUG("6lo vrb: virtual reassembly buffer full\n");
+        return NULL;
+    }
+    memcpy(res->src, rbuf->src, rbuf->src_len);
+    memcpy(res->out_dst, out_dst, out_dst_len);
+    res->out_netif = out_netif;
+    res->arrival = xtimer_now_usec();
+    res->datagram_size = (uint16_t)rbuf->pkt->size;
+    res->tag = rbuf->tag;
+    res->out_tag = gnrc_sixlowpan_frag_next_tag();
+    res->current_size = 0;
+    res->ints_num = 0;
+    res->src_len = rbuf->src_len;
+    res->out_dst_len = (uint8_t)out_dst_len;
+    DEBUG("6lo vrb: forwarding datagram (size: %u, tag: %u) over interface %u "
+          "with tag %u\n", (unsigned)res->datagram_size, (unsigned)res->tag,
+          (unsigned)out_netif->pid, (unsigned)res->out_tag);
+    return res;
+}
+
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(const uint8_t *src,
+                                                       size_t src_len,
+                                                       size_t datagram_size,
+                                                       uint16_t tag)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        gnrc_sixlowpan_frag_vrb_t *vrb = &_vrb[i];
+
+        if ((vrb->out_netif != NULL) && (vrb->tag == tag) &&
+            (vrb->datagram_size == datagram_size) &&
+            (vrb->src_len == src_len) &&
+            (memcmp(vrb->src, src, src_len) == 0)) {
+            vrb->arrival = xtimer_now_usec();
+            return vrb;
+        }
+    }
+    return NULL;
+}
+
+bool gnrc_sixlowpan_frag_vrb_received(gnrc_sixlowpan_frag_vrb_t *vrb,
+                                      uint16_t offset, size_t len)
+{
+    gnrc_sixlowpan_frag_vrb_int_t *ints = vrb->ints;
+    uint16_t start = offset;
+    uint16_t end = offset + len - 1;
+    size_t known = 0;
+    unsigned first, last;
+
+    assert(len > 0);
+    /* the ranges are sorted and neither overlap nor touch each other */
+    for (first = 0; (first < vrb->ints_num) && ((ints[first].end + 1) < start);
+         first++) {}
+    for (last = first; (last < vrb->ints_num) && (ints[last].start <= (end + 1));
+         last++) {
+        uint16_t from = (ints[last].start > start) ? ints[last].start : start;
+        uint16_t to = (ints[last].end < end) ? ints[last].end : end;
+
+        if (from <= to) {
+            known += to - from + 1;
+        }
+    }
+    if (known == len) {
+        DEBUG("6lo vrb: duplicate fragment (offset: %u, length: %u)\n",
+              (unsigned)offset, (unsigned)len);
+        return false;
+    }
+    if (first < last) {
+        /* merge the new range with the ones it overlaps or touches */
+        if (ints[first].start < start) {
+            start = ints[first].start;
+        }
+        if (ints[last - 1].end > end) {
+            end = ints[last - 1].end;
+        }
+        memmove(&ints[first + 1], &ints[last],
+                (vrb->ints_num - last) * sizeof(ints[0]));
+        vrb->ints_num -= last - first - 1;
+    }
+    else if (vrb->ints_num < GNRC_SIXLOWPAN_FRAG_VRB_INTS) {
+        memmove(&ints[first + 1], &ints[first],
+                (vrb->ints_num - first) * sizeof(ints[0]));
+        vrb->ints_num++;
+    }
+    else {
+        /* forward it anyway, the entry will time out */
+        DEBUG("6lo vrb: too many gaps in datagram (tag: %u)\n",
+              (unsigned)vrb->tag);
+        return true;
+    }
+    ints[first].start = start;
+    ints[first].end = end;
+    vrb->current_size += len - known;
+    return true;
+}
+
+void gnrc_sixlowpan_frag_vrb_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if ((_vrb[i].out_netif != NULL) &&
+            ((now_usec - _vrb[i].arrival) > GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT)) {
+            DEBUG("6lo vrb: entry (size: %u, tag: %u) timed out\n",
+                  (unsigned)_vrb[i].datagram_size, (unsigned)_vrb[i].tag);
+            gnrc_sixlowpan_frag_vrb_rm(&_vrb[i]);
+        }
+    }
+}
+
+#ifdef TEST_SUITES
+void gnrc_sixlowpan_frag_vrb_reset(void)
+{
+    memset(_vrb, 0, sizeof(_vrb));
+}
+#endif
+
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+typedef int dont_be_pedantic;
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+/** @} */
@@ -25,6 +25,9 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
 #include "net/gnrc/sixlowpan/internal.h"
 #include "net/sixlowpan.h"
 #include "utlist.h"
@@ -1032,6 +1035,14 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     dispatch->next = pkt->next;
     pkt->next = dispatch;
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    if (ctx != NULL) {
+        /* pkt is only the head of a datagram that is forwarded fragment by
+         * fragment */
+        gnrc_sixlowpan_frag_vrb_send_1st(pkt, ctx, orig_datagram_size);
+        return;
+    }
+#endif
     gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(netif_hdr);
     assert(netif != NULL);
     gnrc_sixlowpan_multiplex_by_size(pkt, orig_datagram_size, netif, page);
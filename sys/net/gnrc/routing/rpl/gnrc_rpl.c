@@ -321,6 +321,17 @@ void _update_lifetime(void)
 
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag)
 {
+    uint32_t now = (uint32_t)(xtimer_now_usec64() / US_PER_MS);
+
+    if (!dodag->dao_delayed) {
+        dodag->dao_delayed = true;
+        dodag->dao_delay_since = now;
+    }
+    /* keep the scheduled DAO, it already waited long enough for further targets */
+    else if (((now - dodag->dao_delay_since) + GNRC_RPL_DAO_DELAY_DEFAULT +
+              GNRC_RPL_DAO_DELAY_JITTER) > GNRC_RPL_DAO_DELAY_MAX) {
+        return;
+    }
     evtimer_del(&gnrc_rpl_evtimer, (evtimer_event_t *)&dodag->dao_event);
     ((evtimer_event_t *)&(dodag->dao_event))->offset = random_uint32_range(
         GNRC_RPL_DAO_DELAY_DEFAULT,
@@ -333,6 +344,7 @@ void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag)
 
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
 {
+    dodag->dao_delayed = false;
     evtimer_del(&gnrc_rpl_evtimer, (evtimer_event_t *)&dodag->dao_event);
     ((evtimer_event_t *)&(dodag->dao_event))->offset = random_uint32_range(
         GNRC_RPL_DAO_DELAY_LONG,
@@ -345,6 +357,7 @@ void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
 
 void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
 {
+    dodag->dao_delayed = false;
     if (dodag->node_status == GNRC_RPL_ROOT_NODE) {
         return;
     }
@@ -353,6 +366,11 @@ void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
         return;
     }
 #endif
+    /* link metrics changed since the last DAO, which is also sent when
+     * the preferred parent changed */
+    if (dodag->parents != NULL) {
+        gnrc_rpl_parent_update(dodag, NULL);
+    }
     if ((dodag->dao_ack_received == false) && (dodag->dao_counter < GNRC_RPL_DAO_SEND_RETRIES)) {
         dodag->dao_counter++;
         gnrc_rpl_send_DAO(dodag->instance, NULL, dodag->default_lifetime);
@@ -37,6 +37,10 @@
 #include "gnrc_rpl_internal/validation.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_NS
+#include "net/gnrc/rpl/ns.h"
+#endif
+
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p_structs.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
@@ -96,7 +100,10 @@ void gnrc_rpl_send(gnrc_pktsnip_t *pkt, kernel_pid_t iface, ipv6_addr_t *src, ip
     }
 
     if (src == NULL) {
-        src = gnrc_netif_ipv6_addr_best_src(netif, dst, true);
+        /* messages to the root of a non-storing mode DODAG are routed */
+        bool ll_only = ipv6_addr_is_link_local(dst) || ipv6_addr_is_multicast(dst);
+
+        src = gnrc_netif_ipv6_addr_best_src(netif, dst, ll_only);
 
         if (src == NULL) {
             DEBUG("RPL: no suitable src address found\n");
@@ -393,6 +400,55 @@ static inline uint32_t _sec_to_ms(uint32_t sec)
     }
 }
 
+#ifdef MODULE_GNRC_RPL_NS
+/* checks if addr is an address of this node, as root of dodag */
+static bool _is_root_addr(gnrc_rpl_dodag_t *dodag, const ipv6_addr_t *addr)
+{
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(dodag->iface);
+    eui64_t iid;
+
+    if (ipv6_addr_equal(addr, &dodag->dodag_id) ||
+        (gnrc_netif_get_by_ipv6_addr(addr) != NULL)) {
+        return true;
+    }
+    /* children derive the address of their parent from its link-local
+     * address, which need not match a configured DODAG ID */
+    return (netif != NULL) && (gnrc_netif_ipv6_get_iid(netif, &iid) >= 0) &&
+           (memcmp(&addr->u8[8], &iid, sizeof(iid)) == 0);
+}
+
+/* adds the targets preceding a transit option to the graph of the root */
+static void _ns_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_opt_target_t *target,
+                       gnrc_rpl_opt_transit_t *transit)
+{
+    const ipv6_addr_t *parent = (ipv6_addr_t *)(transit + 1);
+    uint32_t lifetime = transit->path_lifetime * dodag->lifetime_unit;
+
+    /* without validation the parent address may be missing */
+    if (transit->length < (sizeof(gnrc_rpl_opt_transit_t) -
+                           sizeof(gnrc_rpl_opt_t) + sizeof(ipv6_addr_t))) {
+        DEBUG("RPL: ignoring transit option without parent address\n");
+        return;
+    }
+    if (_is_root_addr(dodag, parent)) {
+        parent = NULL;
+    }
+    do {
+        if (target->prefix_length != IPV6_ADDR_BIT_LEN) {
+            DEBUG("RPL: ignoring prefix target in non-storing mode\n");
+        }
+        else if (gnrc_rpl_ns_update(&target->target, parent, lifetime,
+                                    dodag->iface) < 0) {
+            DEBUG("RPL: no space left for %s in non-storing mode graph\n",
+                  ipv6_addr_to_str(addr_str, &target->target, sizeof(addr_str)));
+        }
+        target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (target)) +
+                 sizeof(gnrc_rpl_opt_t) + target->length);
+    }
+    while (target->type == GNRC_RPL_OPT_TARGET);
+}
+#endif
+
 /** @todo allow target prefixes in target options to be of variable length */
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
                     ipv6_addr_t *src, uint32_t *included_opts)
@@ -516,6 +572,10 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 if (first_target == NULL) {
                     first_target = target;
                 }
+                if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+                    /* the root learns the route from the transit option */
+                    break;
+                }
 
                 DEBUG("RPL: adding FT entry %s/%d\n",
                       ipv6_addr_to_str(addr_str, &(target->target), (unsigned)sizeof(addr_str)),
@@ -536,6 +596,15 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                           "a preceding RPL TARGET DAO option\n");
                     break;
                 }
+                if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+#ifdef MODULE_GNRC_RPL_NS
+                    _ns_update(dodag, first_target, transit);
+#else
+                    DEBUG("RPL: non-storing mode root requires gnrc_rpl_ns\n");
+#endif
+                    first_target = NULL;
+                    break;
+                }
 
                 do {
                     DEBUG("RPL: updating FT entry %s/%d\n",
@@ -773,12 +842,14 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
     gnrc_rpl_parent_t *parent = NULL;
 
     if (!gnrc_rpl_parent_add_by_addr(dodag, src, &parent) && (parent == NULL)) {
-        DEBUG("RPL: Could not allocate new parent.\n");
-        return;
-    }
-    else if (parent != NULL) {
-        trickle_increment_counter(&dodag->trickle);
+        /* the parent table is full: replace the worst parent by a better one */
+        if (!gnrc_rpl_parent_evict_worse(dodag, src, byteorder_ntohs(dio->rank)) ||
+            !gnrc_rpl_parent_add_by_addr(dodag, src, &parent)) {
+            DEBUG("RPL: Could not allocate new parent.\n");
+            return;
+        }
     }
+    trickle_increment_counter(&dodag->trickle);
 
     /* gnrc_rpl_parent_add_by_addr should have set this already */
     assert(parent != NULL);
@@ -833,11 +904,13 @@ gnrc_pktsnip_t *_dao_target_build(gnrc_pktsnip_t *pkt, ipv6_addr_t *addr, uint8_
     return opt_snip;
 }
 
-gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external)
+gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external,
+                                   const ipv6_addr_t *parent)
 {
     gnrc_rpl_opt_transit_t *transit;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t),
+    size_t parent_len = (parent != NULL) ? sizeof(ipv6_addr_t) : 0;
+    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t) + parent_len,
                                GNRC_NETTYPE_UNDEF)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
@@ -851,9 +924,77 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     transit->path_control = 0;
     transit->path_sequence = 0;
     transit->path_lifetime = lifetime;
+    if (parent != NULL) {
+        /* non-storing mode: the root learns the topology from the parents */
+        transit->length += sizeof(ipv6_addr_t);
+        memcpy(transit + 1, parent, sizeof(ipv6_addr_t));
+    }
     return opt_snip;
 }
 
+/**
+ * @brief   Prepends the DAO base object to the options in @p pkt and sends the DAO
+ *
+ * @param[in] inst          Pointer to the instance
+ * @param[in] pkt           The DAO options, released on error
+ * @param[in] destination   Destination of the DAO
+ */
+static void _dao_send(gnrc_rpl_instance_t *inst, gnrc_pktsnip_t *pkt, ipv6_addr_t *destination)
+{
+    gnrc_rpl_dodag_t *dodag = &inst->dodag;
+    gnrc_pktsnip_t *tmp;
+    gnrc_rpl_dao_t *dao;
+    bool local_instance = (inst->id & GNRC_RPL_INSTANCE_ID_MSB) ? true : false;
+
+    if (local_instance) {
+        if ((tmp = gnrc_pktbuf_add(pkt, &dodag->dodag_id, sizeof(ipv6_addr_t),
+                                   GNRC_NETTYPE_UNDEF)) == NULL) {
+            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        pkt = tmp;
+    }
+
+    if ((tmp = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_dao_t), GNRC_NETTYPE_UNDEF)) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    pkt = tmp;
+    dao = pkt->data;
+    dao->instance_id = inst->id;
+    if (local_instance) {
+        /* set the D flag to indicate that a DODAG id is present */
+        dao->k_d_flags = GNRC_RPL_DAO_D_BIT;
+    }
+    else {
+        dao->k_d_flags = 0;
+    }
+
+    /* set the K flag to indicate that ACKs are required */
+    dao->k_d_flags |= GNRC_RPL_DAO_K_BIT;
+    dao->dao_sequence = dodag->dao_seq;
+    dao->reserved = 0;
+
+    if ((tmp = gnrc_icmpv6_build(pkt, ICMPV6_RPL_CTRL, GNRC_RPL_ICMPV6_CODE_DAO,
+                                 sizeof(icmpv6_hdr_t))) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    pkt = tmp;
+
+#ifdef MODULE_NETSTATS_RPL
+    gnrc_rpl_netstats_tx_DAO(&gnrc_rpl_netstats, gnrc_pkt_len(pkt),
+                             (destination && !ipv6_addr_is_multicast(destination)));
+#endif
+
+    gnrc_rpl_send(pkt, dodag->iface, NULL, destination, &dodag->dodag_id);
+
+    GNRC_RPL_COUNTER_INCREMENT(dodag->dao_seq);
+}
+
 void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t lifetime)
 {
     gnrc_rpl_dodag_t *dodag;
@@ -875,17 +1016,20 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     }
 #endif
 
-    if (destination == NULL) {
+    bool non_storing = (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE);
+
+    if ((destination == NULL) || non_storing) {
         if (dodag->parents == NULL) {
             DEBUG("RPL: dodag has no preferred parent\n");
             return;
         }
-
-        destination = &(dodag->parents->addr);
+    }
+    if (destination == NULL) {
+        /* in non-storing mode the DAO goes directly to the root */
+        destination = non_storing ? &dodag->dodag_id : &(dodag->parents->addr);
     }
 
-    gnrc_pktsnip_t *pkt = NULL, *tmp = NULL;
-    gnrc_rpl_dao_t *dao;
+    gnrc_pktsnip_t *pkt = NULL;
 
     /* find my address */
     ipv6_addr_t *me = NULL;
@@ -899,86 +1043,57 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     idx = gnrc_netif_ipv6_addr_match(netif, &dodag->dodag_id);
     me = &netif->ipv6.addrs[idx];
 
-    /* add external and RPL FT entries */
+    ipv6_addr_t parent;
+    const ipv6_addr_t *transit_parent = NULL;
+
+    if (non_storing) {
+        /* the global address of the parent: its interface identifier in the
+         * prefix of the DODAG, as configured from the prefix information */
+        parent = dodag->parents->addr;
+        ipv6_addr_init_prefix(&parent, me, IPV6_ADDR_BIT_LEN / 2);
+        transit_parent = &parent;
+    }
+    /* the targets precede the transit option they share */
+    if ((pkt = _dao_transit_build(pkt, lifetime, false, transit_parent)) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        return;
+    }
+    /* add RPL FT entries, a non-storing node has none */
     /* TODO: nib: dropped support for external transit options for now */
     void *ft_state = NULL;
     gnrc_ipv6_nib_ft_t fte;
-    while(gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
-        DEBUG("RPL: Send DAO - building transit option\n");
-
-        if ((pkt = _dao_transit_build(pkt, lifetime, false)) == NULL) {
-            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-            return;
+    unsigned targets = 0;
+    while (!non_storing && gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
+        if (!ipv6_addr_is_global(&fte.dst) || ipv6_addr_is_unspecified(&fte.next_hop)) {
+            continue;
         }
-        if (ipv6_addr_is_global(&fte.dst) &&
-            !ipv6_addr_is_unspecified(&fte.next_hop)) {
-            DEBUG("RPL: Send DAO - building target %s/%d\n",
-                  ipv6_addr_to_str(addr_str, &fte.dst, sizeof(addr_str)), fte.dst_len);
-
-            if ((pkt = _dao_target_build(pkt, &fte.dst, fte.dst_len)) == NULL) {
+        /* the own address is added to the last DAO */
+        if (targets == GNRC_RPL_DAO_TARGETS_NUMOF) {
+            _dao_send(inst, pkt, destination);
+            if ((pkt = _dao_transit_build(NULL, lifetime, false, NULL)) == NULL) {
                 DEBUG("RPL: Send DAO - no space left in packet buffer\n");
                 return;
             }
+            targets = 0;
         }
-    }
-
-    /* add own address */
-    DEBUG("RPL: Send DAO - building target %s/128\n",
-          ipv6_addr_to_str(addr_str, me, sizeof(addr_str)));
-    if ((pkt = _dao_target_build(pkt, me, IPV6_ADDR_BIT_LEN)) == NULL) {
-        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-        return;
-    }
+        DEBUG("RPL: Send DAO - building target %s/%d\n",
+              ipv6_addr_to_str(addr_str, &fte.dst, sizeof(addr_str)), fte.dst_len);
 
-    bool local_instance = (inst->id & GNRC_RPL_INSTANCE_ID_MSB) ? true : false;
-
-    if (local_instance) {
-        if ((tmp = gnrc_pktbuf_add(pkt, &dodag->dodag_id, sizeof(ipv6_addr_t),
-                                   GNRC_NETTYPE_UNDEF)) == NULL) {
+        if ((pkt = _dao_target_build(pkt, &fte.dst, fte.dst_len)) == NULL) {
             DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-            gnrc_pktbuf_release(pkt);
             return;
         }
-        pkt = tmp;
-    }
-
-    if ((tmp = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_dao_t), GNRC_NETTYPE_UNDEF)) == NULL) {
-        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-        gnrc_pktbuf_release(pkt);
-        return;
-    }
-    pkt = tmp;
-    dao = pkt->data;
-    dao->instance_id = inst->id;
-    if (local_instance) {
-        /* set the D flag to indicate that a DODAG id is present */
-        dao->k_d_flags = GNRC_RPL_DAO_D_BIT;
-    }
-    else {
-        dao->k_d_flags = 0;
+        targets++;
     }
 
-    /* set the K flag to indicate that ACKs are required */
-    dao->k_d_flags |= GNRC_RPL_DAO_K_BIT;
-    dao->dao_sequence = dodag->dao_seq;
-    dao->reserved = 0;
-
-    if ((tmp = gnrc_icmpv6_build(pkt, ICMPV6_RPL_CTRL, GNRC_RPL_ICMPV6_CODE_DAO,
-                                 sizeof(icmpv6_hdr_t))) == NULL) {
+    /* add own address */
+    DEBUG("RPL: Send DAO - building target %s/128\n",
+          ipv6_addr_to_str(addr_str, me, sizeof(addr_str)));
+    if ((pkt = _dao_target_build(pkt, me, IPV6_ADDR_BIT_LEN)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-        gnrc_pktbuf_release(pkt);
         return;
     }
-    pkt = tmp;
-
-#ifdef MODULE_NETSTATS_RPL
-    gnrc_rpl_netstats_tx_DAO(&gnrc_rpl_netstats, gnrc_pkt_len(pkt),
-                             (destination && !ipv6_addr_is_multicast(destination)));
-#endif
-
-    gnrc_rpl_send(pkt, dodag->iface, NULL, destination, &dodag->dodag_id);
-
-    GNRC_RPL_COUNTER_INCREMENT(dodag->dao_seq);
+    _dao_send(inst, pkt, destination);
 }
 
 void gnrc_rpl_send_DAO_ACK(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t seq)
@@ -1077,6 +1192,12 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
         return;
     }
 
+    /* in non-storing mode only the root keeps routes */
+    if ((inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) &&
+        (dodag->node_status != GNRC_RPL_ROOT_NODE)) {
+        return;
+    }
+
 #ifdef MODULE_GNRC_RPL_P2P
     if (dodag->instance->mop == GNRC_RPL_P2P_MOP) {
         return;
@@ -32,13 +32,17 @@
 #include "net/gnrc/rpl/p2p.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
 #endif
+#ifdef MODULE_GNRC_RPL_NS
+#include "net/gnrc/rpl/ns.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
-static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag);
+static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag,
+                                                          gnrc_rpl_parent_t *changed);
 
 static void _rpl_trickle_send_dio(void *args)
 {
@@ -115,6 +119,11 @@ bool gnrc_rpl_instance_remove(gnrc_rpl_instance_t *inst)
     gnrc_rpl_dodag_t *dodag = &inst->dodag;
 #ifdef MODULE_GNRC_RPL_P2P
     gnrc_rpl_p2p_ext_remove(dodag);
+#endif
+#ifdef MODULE_GNRC_RPL_NS
+    if (dodag->node_status == GNRC_RPL_ROOT_NODE) {
+        gnrc_rpl_ns_flush();
+    }
 #endif
     gnrc_rpl_dodag_remove_all_parents(dodag);
     trickle_stop(&dodag->trickle);
@@ -154,6 +163,7 @@ bool gnrc_rpl_dodag_init(gnrc_rpl_instance_t *instance, ipv6_addr_t *dodag_id, k
     dodag->dao_seq = GNRC_RPL_COUNTER_INIT;
     dodag->dtsn = 0;
     dodag->dao_ack_received = false;
+    dodag->dao_delayed = false;
     dodag->dao_counter = 0;
     dodag->instance = instance;
     dodag->iface = iface;
@@ -223,6 +233,38 @@ bool gnrc_rpl_parent_add_by_addr(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
     return false;
 }
 
+bool gnrc_rpl_parent_evict_worse(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
+                                 uint16_t rank)
+{
+    gnrc_rpl_parent_t *worst = dodag->parents;
+    gnrc_rpl_parent_t candidate;
+
+    if (worst == NULL) {
+        return false;
+    }
+    /* the parents are sorted, the worst one is the last */
+    while (worst->next != NULL) {
+        worst = worst->next;
+    }
+    /* never replace the preferred parent */
+    if (worst == dodag->parents) {
+        return false;
+    }
+    memset(&candidate, 0, sizeof(candidate));
+    candidate.dodag = dodag;
+    candidate.rank = rank;
+    candidate.addr = *addr;
+    if (dodag->instance->of->update_metric != NULL) {
+        dodag->instance->of->update_metric(&candidate);
+    }
+    if (dodag->instance->of->parent_cmp(&candidate, worst) >= 0) {
+        return false;
+    }
+    DEBUG("RPL: evict parent %s\n",
+          ipv6_addr_to_str(addr_str, &worst->addr, sizeof(addr_str)));
+    return gnrc_rpl_parent_remove(worst);
+}
+
 bool gnrc_rpl_parent_remove(gnrc_rpl_parent_t *parent)
 {
     assert(parent != NULL);
@@ -266,6 +308,44 @@ void gnrc_rpl_local_repair(gnrc_rpl_dodag_t *dodag)
     }
 }
 
+/**
+ * @brief   Move a parent, whose rank changed, to its place in the sorted parents list
+ *
+ * Parents ranking the same keep their order, so the preferred parent only
+ * changes for a strictly better one.
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ * @param[in] parent    Pointer to the parent
+ */
+static void _parent_sort(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
+{
+    int (*cmp)(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *) = dodag->instance->of->parent_cmp;
+    gnrc_rpl_parent_t *prev = NULL, *elt;
+
+    LL_FOREACH(dodag->parents, elt) {
+        if (elt == parent) {
+            break;
+        }
+        prev = elt;
+    }
+    if (((prev == NULL) || (cmp(prev, parent) <= 0)) &&
+        ((parent->next == NULL) || (cmp(parent, parent->next) <= 0))) {
+        return;
+    }
+    LL_DELETE(dodag->parents, parent);
+    LL_FOREACH(dodag->parents, elt) {
+        if (cmp(parent, elt) < 0) {
+            break;
+        }
+    }
+    if (elt != NULL) {
+        LL_PREPEND_ELEM(dodag->parents, elt, parent);
+    }
+    else {
+        LL_APPEND(dodag->parents, parent);
+    }
+}
+
 void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
 {
     /* update Parent lifetime */
@@ -288,7 +368,7 @@ void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
 #endif
     }
 
-    if (_gnrc_rpl_find_preferred_parent(dodag) == NULL) {
+    if (_gnrc_rpl_find_preferred_parent(dodag, parent) == NULL) {
         gnrc_rpl_local_repair(dodag);
     }
 }
@@ -297,12 +377,16 @@ void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
  * @brief   Find the parent with the lowest rank and update the DODAG's preferred parent
  *
  * @param[in] dodag     Pointer to the DODAG
+ * @param[in] changed   Pointer to the parent whose rank changed, NULL to
+ *                      re-evaluate all parents
  *
  * @return  Pointer to the preferred parent, on success.
  * @return  NULL, otherwise.
  */
-static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag)
+static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag,
+                                                          gnrc_rpl_parent_t *changed)
 {
+    gnrc_rpl_of_t *of = dodag->instance->of;
     gnrc_rpl_parent_t *old_best = dodag->parents;
     gnrc_rpl_parent_t *new_best = old_best;
     uint16_t old_rank = dodag->my_rank;
@@ -312,9 +396,38 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
         return NULL;
     }
 
-    LL_SORT(dodag->parents, dodag->instance->of->parent_cmp);
+    /* the parents are kept sorted, only the changed one may be out of place */
+    if ((changed != NULL) && (changed->state != GNRC_RPL_PARENT_UNUSED)) {
+        if (of->update_metric != NULL) {
+            of->update_metric(changed);
+        }
+        _parent_sort(dodag, changed);
+    }
+    else if (changed == NULL) {
+        /* link metrics may have changed for any parent */
+        gnrc_rpl_parent_t *parents[GNRC_RPL_PARENTS_NUMOF];
+        unsigned num = 0;
+
+        LL_FOREACH(dodag->parents, elt) {
+            if (of->update_metric != NULL) {
+                of->update_metric(elt);
+            }
+            parents[num++] = elt;
+        }
+        for (unsigned i = 0; i < num; i++) {
+            _parent_sort(dodag, parents[i]);
+        }
+    }
     new_best = dodag->parents;
 
+    /* the objective function may keep the preferred parent */
+    if ((new_best != old_best) &&
+        (of->which_parent(old_best, new_best) == old_best)) {
+        LL_DELETE(dodag->parents, old_best);
+        LL_PREPEND(dodag->parents, old_best);
+        new_best = old_best;
+    }
+
     if (new_best->rank == GNRC_RPL_INFINITE_RANK) {
         return NULL;
     }
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#include <string.h>
+
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netif/etx.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/mrhof.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* ETX object type of RFC 6551 */
+#define METRIC_TYPE_ETX     (7U)
+
+static uint16_t calc_rank(gnrc_rpl_parent_t *, uint16_t);
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static int parent_cmp(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+static void update_metric(gnrc_rpl_parent_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    GNRC_RPL_MRHOF_OCP,
+    calc_rank,
+    which_parent,
+    parent_cmp,
+    which_dodag,
+    reset,
+    NULL,
+    NULL,
+    NULL,
+    update_metric
+};
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+/* ETX of the link to a parent */
+static uint16_t _link_metric(gnrc_rpl_parent_t *parent)
+{
+    kernel_pid_t iface = parent->dodag->iface;
+    const uint8_t *iid = &parent->addr.u8[8];
+    gnrc_ipv6_nib_nc_t nce;
+    void *state = NULL;
+    uint8_t l2addr[8];
+    uint16_t etx = 0;
+
+    while (gnrc_ipv6_nib_nc_iter(iface, &state, &nce)) {
+        if ((nce.l2addr_len > 0) && ipv6_addr_equal(&nce.ipv6, &parent->addr)) {
+            etx = gnrc_netif_etx_get(iface, nce.l2addr, nce.l2addr_len);
+            break;
+        }
+    }
+    if (etx == 0) {
+        /* not resolved (yet), link-local addresses of 6LoWPAN nodes carry the
+         * link layer address in the interface identifier */
+        static const uint8_t short_iid[] = { 0x00, 0x00, 0x00, 0xff, 0xfe, 0x00 };
+
+        if (memcmp(iid, short_iid, sizeof(short_iid)) == 0) {
+            etx = gnrc_netif_etx_get(iface, &iid[6], 2);
+        }
+        else {
+            memcpy(l2addr, iid, sizeof(l2addr));
+            l2addr[0] ^= 0x02;
+            etx = gnrc_netif_etx_get(iface, l2addr, sizeof(l2addr));
+        }
+    }
+    return etx;
+}
+
+/* rank of the parent plus the cached ETX of the link to it */
+static uint32_t _path_cost(const gnrc_rpl_parent_t *parent)
+{
+    uint16_t etx = (uint16_t)parent->link_metric;
+
+    if ((parent->rank == GNRC_RPL_INFINITE_RANK) ||
+        (etx > GNRC_RPL_MRHOF_MAX_LINK_METRIC)) {
+        return UINT32_MAX;
+    }
+    return (uint32_t)parent->rank + etx;
+}
+
+static inline bool _acceptable(uint32_t cost)
+{
+    return cost <= GNRC_RPL_MRHOF_MAX_PATH_COST;
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    (void) dodag;
+}
+
+void update_metric(gnrc_rpl_parent_t *parent)
+{
+    parent->link_metric = _link_metric(parent);
+    parent->link_metric_type = METRIC_TYPE_ETX;
+}
+
+uint16_t calc_rank(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    if (base_rank == 0) {
+        if (parent == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+
+        base_rank = parent->rank;
+    }
+
+    uint16_t min_inc = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    uint32_t add = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+
+    if (parent != NULL) {
+        min_inc = parent->dodag->instance->min_hop_rank_inc;
+        /* a bad link still yields a rank, the parent just loses against
+         * better ones */
+        add = (uint16_t)parent->link_metric;
+        if (add < min_inc) {
+            add = min_inc;
+        }
+    }
+
+    uint32_t rank = (uint32_t)base_rank + add;
+
+    if (rank >= GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    /* keep the current rank while the path cost only jitters */
+    if (parent != NULL) {
+        uint16_t cur = parent->dodag->my_rank;
+
+        if ((cur != GNRC_RPL_INFINITE_RANK) && (cur >= base_rank + min_inc)) {
+            uint32_t diff = (rank > cur) ? (rank - cur) : (cur - rank);
+
+            if (diff < GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD) {
+                return cur;
+            }
+        }
+    }
+
+    return (uint16_t)rank;
+}
+
+/* the preferred parent p1 is only replaced by a clearly better one */
+gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2)
+{
+    uint32_t cost1 = _path_cost(p1);
+    uint32_t cost2 = _path_cost(p2);
+
+    if (!_acceptable(cost1)) {
+        return _acceptable(cost2) ? p2 : p1;
+    }
+    if (cost2 + GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD < cost1) {
+        return p2;
+    }
+    return p1;
+}
+
+int parent_cmp(gnrc_rpl_parent_t *parent1, gnrc_rpl_parent_t *parent2)
+{
+    uint32_t cost1 = _path_cost(parent1);
+    uint32_t cost2 = _path_cost(parent2);
+    bool ok1 = _acceptable(cost1);
+    bool ok2 = _acceptable(cost2);
+
+    if (ok1 != ok2) {
+        return ok1 ? -1 : 1;
+    }
+    if (cost1 < cost2) {
+        return -1;
+    }
+    else if (cost1 > cost2) {
+        return 1;
+    }
+    return 0;
+}
+
+/* Not used yet */
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
+
+/** @} */
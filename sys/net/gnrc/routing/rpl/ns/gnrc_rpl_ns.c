@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "xtimer.h"
+#include "net/gnrc/rpl/ns.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+
+#define NODE_UNUSED         (0U)    /**< entry is free */
+#define NODE_USED           (1U)    /**< entry holds a node */
+#define NODE_ROOT_CHILD     (2U)    /**< the parent of the node is the root */
+
+/**
+ * @brief   A node in the graph of the root, as reported by its DAO
+ */
+typedef struct {
+    ipv6_addr_t target;             /**< address of the node */
+    ipv6_addr_t parent;             /**< address of its parent */
+    uint32_t valid_until;           /**< expiry time in seconds */
+    uint8_t flags;                  /**< NODE_* flags */
+} _node_t;
+
+/**
+ * @brief   A computed route, as indices into the graph
+ */
+typedef struct {
+    ipv6_addr_t dst;                /**< destination of the route */
+    uint32_t valid_until;           /**< expiry of the shortest lived node */
+    uint16_t generation;            /**< graph generation it was computed in */
+    uint8_t used;                   /**< non-zero if the entry is in use */
+    uint8_t hops_num;               /**< number of intermediate hops */
+    uint8_t hops[GNRC_RPL_NS_MAX_HOPS]; /**< intermediate hops, root first */
+} _route_t;
+
+static _node_t _nodes[GNRC_RPL_NS_NODES_NUMOF];
+/* entries of _nodes in use, read without the lock to spare nodes which are
+ * not a non-storing root the lookup of a route */
+static unsigned _nodes_num;
+static _route_t _routes[GNRC_RPL_NS_ROUTE_CACHE_SIZE];
+static unsigned _routes_next;
+/* increased on every change of the graph to invalidate cached routes */
+static uint16_t _generation;
+static kernel_pid_t _iface = KERNEL_PID_UNDEF;
+static mutex_t _lock = MUTEX_INIT;
+
+static inline uint32_t _now_sec(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+static inline bool _node_valid(const _node_t *node, uint32_t now)
+{
+    return (node->flags & NODE_USED) && ((int32_t)(node->valid_until - now) > 0);
+}
+
+static int _node_find(const ipv6_addr_t *addr, uint32_t now)
+{
+    for (unsigned i = 0; i < GNRC_RPL_NS_NODES_NUMOF; i++) {
+        if (_node_valid(&_nodes[i], now) &&
+            ipv6_addr_equal(&_nodes[i].target, addr)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int gnrc_rpl_ns_update(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                       uint32_t lifetime, kernel_pid_t iface)
+{
+    uint32_t now = _now_sec();
+    _node_t *node = NULL;
+
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < GNRC_RPL_NS_NODES_NUMOF; i++) {
+        if ((_nodes[i].flags & NODE_USED) &&
+            ipv6_addr_equal(&_nodes[i].target, target)) {
+            node = &_nodes[i];
+            break;
+        }
+        /* reuse expired entries as well */
+        if ((node == NULL) && !_node_valid(&_nodes[i], now)) {
+            node = &_nodes[i];
+        }
+    }
+    if (lifetime == 0) {
+        if ((node != NULL) && ipv6_addr_equal(&node->target, target)) {
+            DEBUG("RPL-NS: remove %s\n",
+                  ipv6_addr_to_str(addr_str, target, sizeof(addr_str)));
+            if (node->flags & NODE_USED) {
+                _nodes_num--;
+            }
+            node->flags = NODE_UNUSED;
+            _generation++;
+        }
+        mutex_unlock(&_lock);
+        return 0;
+    }
+    if (node == NULL) {
+        mutex_unlock(&_lock);
+        DEBUG("RPL-NS: graph full\n");
+        return -ENOMEM;
+    }
+    uint8_t flags = NODE_USED | ((parent == NULL) ? NODE_ROOT_CHILD : 0);
+    /* only a new parent changes routes, a refreshed lifetime does not */
+    if (!_node_valid(node, now) || (node->flags != flags) ||
+        !ipv6_addr_equal(&node->target, target) ||
+        ((parent != NULL) && !ipv6_addr_equal(&node->parent, parent))) {
+        DEBUG("RPL-NS: new parent for %s%s\n",
+              ipv6_addr_to_str(addr_str, target, sizeof(addr_str)),
+              (parent == NULL) ? " (root)" : "");
+        memcpy(&node->target, target, sizeof(node->target));
+        if (parent != NULL) {
+            memcpy(&node->parent, parent, sizeof(node->parent));
+        }
+        else {
+            memset(&node->parent, 0, sizeof(node->parent));
+        }
+        if (!(node->flags & NODE_USED)) {
+            _nodes_num++;
+        }
+        node->flags = flags;
+        _generation++;
+    }
+    node->valid_until = now + lifetime;
+    _iface = iface;
+    mutex_unlock(&_lock);
+    return 0;
+}
+
+void gnrc_rpl_ns_flush(void)
+{
+    mutex_lock(&_lock);
+    memset(_nodes, 0, sizeof(_nodes));
+    memset(_routes, 0, sizeof(_routes));
+    _nodes_num = 0;
+    _generation++;
+    mutex_unlock(&_lock);
+}
+
+/* follows the parents of dst up to the root */
+static int _route_compute(_route_t *route, const ipv6_addr_t *dst, uint32_t now)
+{
+    uint8_t hops[GNRC_RPL_NS_MAX_HOPS];
+    unsigned num = 0;
+    int idx = _node_find(dst, now);
+
+    if (idx < 0) {
+        return -ENOENT;
+    }
+    route->valid_until = _nodes[idx].valid_until;
+    while (!(_nodes[idx].flags & NODE_ROOT_CHILD)) {
+        if ((idx = _node_find(&_nodes[idx].parent, now)) < 0) {
+            return -ENOENT;
+        }
+        /* a loop ends up here as well, once it ran around often enough */
+        if (num == GNRC_RPL_NS_MAX_HOPS) {
+            return -ELOOP;
+        }
+        hops[num++] = idx;
+        if ((int32_t)(_nodes[idx].valid_until - route->valid_until) < 0) {
+            route->valid_until = _nodes[idx].valid_until;
+        }
+    }
+    /* reverse into root-to-destination order */
+    for (unsigned i = 0; i < num; i++) {
+        route->hops[i] = hops[num - 1 - i];
+    }
+    route->hops_num = num;
+    memcpy(&route->dst, dst, sizeof(route->dst));
+    route->generation = _generation;
+    route->used = 1;
+    return num;
+}
+
+int gnrc_rpl_ns_get_route(const ipv6_addr_t *dst, ipv6_addr_t *hops,
+                          unsigned max_hops, kernel_pid_t *iface)
+{
+    uint32_t now;
+    _route_t *route = NULL;
+    int res;
+
+    if (_nodes_num == 0) {
+        return -ENOENT;
+    }
+    now = _now_sec();
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < GNRC_RPL_NS_ROUTE_CACHE_SIZE; i++) {
+        if (_routes[i].used && ipv6_addr_equal(&_routes[i].dst, dst)) {
+            route = &_routes[i];
+            break;
+        }
+    }
+    if ((route != NULL) && (route->generation == _generation) &&
+        ((int32_t)(route->valid_until - now) > 0)) {
+        res = route->hops_num;
+    }
+    else {
+        if (route == NULL) {
+            /* replace cached routes round robin */
+            route = &_routes[_routes_next];
+            _routes_next = (_routes_next + 1) % GNRC_RPL_NS_ROUTE_CACHE_SIZE;
+        }
+        route->used = 0;
+        res = _route_compute(route, dst, now);
+    }
+    if (res > (int)max_hops) {
+        res = -ELOOP;
+    }
+    else if (res >= 0) {
+        for (int i = 0; i < res; i++) {
+            memcpy(&hops[i], &_nodes[route->hops[i]].target, sizeof(hops[i]));
+        }
+        *iface = _iface;
+    }
+    mutex_unlock(&_lock);
+    return res;
+}
+
+void gnrc_rpl_ns_print(void)
+{
+    uint32_t now = _now_sec();
+
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < GNRC_RPL_NS_NODES_NUMOF; i++) {
+        if (!_node_valid(&_nodes[i], now)) {
+            continue;
+        }
+        printf("%s", ipv6_addr_to_str(addr_str, &_nodes[i].target,
+                                      sizeof(addr_str)));
+        if (_nodes[i].flags & NODE_ROOT_CHILD) {
+            printf(" via root");
+        }
+        else {
+            printf(" via %s", ipv6_addr_to_str(addr_str, &_nodes[i].parent,
+                                                sizeof(addr_str)));
+        }
+        printf(" (%" PRIu32 " s)\n", _nodes[i].valid_until - now);
+    }
+    mutex_unlock(&_lock);
+}
+
+/** @} */
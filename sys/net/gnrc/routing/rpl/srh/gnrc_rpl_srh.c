@@ -15,10 +15,15 @@
  * @author Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
 #include <string.h>
+#include "byteorder.h"
 #include "net/gnrc/netif/internal.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/protnum.h"
 #include "net/gnrc/ipv6/ext/rh.h"
 #include "net/gnrc/rpl/srh.h"
+#include "net/ipv6/ext/rh.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -124,4 +129,75 @@ int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh, void **err_ptr)
     return GNRC_IPV6_EXT_RH_FORWARDED;
 }
 
+/* number of leading octets a and b have in common, at most 15 */
+static uint8_t _common_octets(const ipv6_addr_t *a, const ipv6_addr_t *b)
+{
+    uint8_t octets = ipv6_addr_match_prefix(a, b) / 8;
+
+    return (octets < sizeof(ipv6_addr_t)) ? octets : (sizeof(ipv6_addr_t) - 1);
+}
+
+int gnrc_rpl_srh_insert(gnrc_pktsnip_t *ipv6, const ipv6_addr_t *hops,
+                        unsigned hops_num)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+    gnrc_pktsnip_t *snip;
+    gnrc_rpl_srh_t *rh;
+    uint8_t *addr_vec;
+    uint8_t compri = sizeof(ipv6_addr_t) - 1, compre = compri;
+    unsigned size;
+
+    assert(hops_num > 0);
+    /* every address is restored from the current destination address on
+     * its way, so all of them must share the elided prefix with it */
+    for (unsigned i = 0; i < hops_num; i++) {
+        uint8_t common = _common_octets(&hops[i], &hdr->dst);
+
+        if (common < compre) {
+            compre = common;
+        }
+        if (i > 0) {
+            common = _common_octets(&hops[i], &hops[0]);
+            if (common < compri) {
+                compri = common;
+            }
+        }
+    }
+    size = sizeof(gnrc_rpl_srh_t) +
+           ((hops_num - 1) * (sizeof(ipv6_addr_t) - compri)) +
+           (sizeof(ipv6_addr_t) - compre);
+    /* pad to a multiple of 8 octets */
+    unsigned pad = (8 - (size & 7)) & 7;
+
+    if ((snip = gnrc_pktbuf_add(ipv6->next, NULL, size + pad,
+                                GNRC_NETTYPE_IPV6_EXT)) == NULL) {
+        DEBUG("RPL SRH: no space left in packet buffer\n");
+        return -ENOMEM;
+    }
+    ipv6->next = snip;
+    rh = snip->data;
+    rh->nh = hdr->nh;
+    rh->len = ((size + pad) / 8) - 1;
+    rh->type = IPV6_EXT_RH_TYPE_RPL_SRH;
+    rh->seg_left = hops_num;
+    rh->compr = (compri << 4) | compre;
+    rh->pad_resv = pad << 4;
+    rh->resv = 0;
+    addr_vec = (uint8_t *)(rh + 1);
+    for (unsigned i = 1; i < hops_num; i++) {
+        memcpy(addr_vec, &hops[i].u8[compri], sizeof(ipv6_addr_t) - compri);
+        addr_vec += sizeof(ipv6_addr_t) - compri;
+    }
+    memcpy(addr_vec, &hdr->dst.u8[compre], sizeof(ipv6_addr_t) - compre);
+    memset(addr_vec + sizeof(ipv6_addr_t) - compre, 0, pad);
+
+    hdr->nh = PROTNUM_IPV6_EXT_RH;
+    hdr->len = byteorder_htons(byteorder_ntohs(hdr->len) + size + pad);
+    memcpy(&hdr->dst, &hops[0], sizeof(hdr->dst));
+
+    DEBUG("RPL SRH: inserted %u addresses, first hop %s\n", hops_num,
+          ipv6_addr_to_str(addr_str, &hdr->dst, sizeof(addr_str)));
+    return 0;
+}
+
 /** @} */
@@ -24,6 +24,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <sys/types.h>
 
 #include "mbox.h"
 #include "net/af.h"
@@ -75,6 +76,28 @@ struct sock_udp {
     uint16_t flags;                     /**< option flags */
 };
 
+/**
+ * @brief   Sends a UDP message, already stored in the packet buffer, to
+ *          remote end point
+ *
+ * In contrast to sock_udp_send() the payload is not copied: the caller builds
+ * it in place, e.g. with gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF),
+ * and hands it over to the stack.
+ *
+ * @pre `((sock != NULL || remote != NULL)) && (payload != NULL)`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ * @param[in] payload   The payload to send. The function takes ownership of
+ *                      @p payload, it is released on error as well.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  The same errors as sock_udp_send().
+ */
+ssize_t gnrc_sock_udp_send_pkt(sock_udp_t *sock, gnrc_pktsnip_t *payload,
+                               const sock_udp_ep_t *remote);
+
 #ifdef __cplusplus
 }
 #endif
@@ -220,18 +220,27 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     return res;
 }
 
-ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
-                      const sock_udp_ep_t *remote)
+/**
+ * @brief   Checks the end points for a send operation and binds @p sock
+ *          implicitly if it is unbound
+ *
+ * @param[in] sock          sock to send with. May be `NULL`.
+ * @param[in] remote        remote end point. May be `NULL`.
+ * @param[out] local        local end point to send from
+ * @param[out] remote_cpy   storage for a copy of @p remote
+ * @param[out] rem          remote end point to send to
+ * @param[out] src_port     source port
+ * @param[out] dst_port     destination port
+ *
+ * @return  0 on success
+ * @return  negative errno on error, see sock_udp_send()
+ */
+static int _send_prepare(sock_udp_t *sock, const sock_udp_ep_t *remote,
+                         sock_ip_ep_t *local, sock_udp_ep_t *remote_cpy,
+                         sock_ip_ep_t **rem, uint16_t *src_port,
+                         uint16_t *dst_port)
 {
-    int res;
-    gnrc_pktsnip_t *payload, *pkt;
-    uint16_t src_port = 0, dst_port;
-    sock_ip_ep_t local;
-    sock_udp_ep_t remote_cpy;
-    sock_ip_ep_t *rem;
-
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -258,8 +267,8 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
      * cppcheck is being weird here anyways) */
     if ((sock == NULL) || (sock->local.family == AF_UNSPEC)) {
         /* no sock or sock currently unbound */
-        memset(&local, 0, sizeof(local));
-        if ((src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
+        memset(local, 0, sizeof(*local));
+        if ((*src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
             return -EADDRINUSE;
         }
         /* cppcheck-suppress nullPointer
@@ -267,14 +276,14 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
          * well, see above) */
         if (sock != NULL) {
             /* bind sock object implicitly */
-            sock->local.port = src_port;
+            sock->local.port = *src_port;
             if (remote == NULL) {
                 sock->local.family = sock->remote.family;
             }
             else {
                 sock->local.family = remote->family;
             }
-            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, src_port);
+            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, *src_port);
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
             /* prepend to current socks */
             sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
@@ -283,41 +292,127 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         }
     }
     else {
-        src_port = sock->local.port;
-        memcpy(&local, &sock->local, sizeof(local));
+        *src_port = sock->local.port;
+        memcpy(local, &sock->local, sizeof(*local));
     }
     /* sock can't be NULL at this point */
     if (remote == NULL) {
-        rem = (sock_ip_ep_t *)&sock->remote;
-        dst_port = sock->remote.port;
+        *rem = (sock_ip_ep_t *)&sock->remote;
+        *dst_port = sock->remote.port;
     }
     else {
-        rem = (sock_ip_ep_t *)&remote_cpy;
-        gnrc_ep_set(rem, (sock_ip_ep_t *)remote, sizeof(sock_udp_ep_t));
-        dst_port = remote->port;
+        *rem = (sock_ip_ep_t *)remote_cpy;
+        gnrc_ep_set(*rem, (sock_ip_ep_t *)remote, sizeof(sock_udp_ep_t));
+        *dst_port = remote->port;
     }
     /* check for matching address families in local and remote */
-    if (local.family == AF_UNSPEC) {
-        local.family = rem->family;
+    if (local->family == AF_UNSPEC) {
+        local->family = (*rem)->family;
     }
-    else if (local.family != rem->family) {
+    else if (local->family != (*rem)->family) {
         return -EINVAL;
     }
-    /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
-    if (payload == NULL) {
-        return -ENOMEM;
-    }
+    return 0;
+}
+
+/**
+ * @brief   Prepends the UDP header to @p payload and sends it
+ *
+ * Takes ownership of @p payload, it is released on error.
+ */
+static ssize_t _send_payload(gnrc_pktsnip_t *payload, uint16_t src_port,
+                             uint16_t dst_port, sock_ip_ep_t *local,
+                             const sock_ip_ep_t *rem)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
     pkt = gnrc_udp_hdr_build(payload, src_port, dst_port);
     if (pkt == NULL) {
         gnrc_pktbuf_release(payload);
         return -ENOMEM;
     }
-    res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP);
+    res = gnrc_sock_send(pkt, local, rem, PROTNUM_UDP);
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
     }
     return res;
 }
 
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    int res;
+    gnrc_pktsnip_t *payload;
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_udp_ep_t remote_cpy;
+    sock_ip_ep_t *rem;
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+
+    res = _send_prepare(sock, remote, &local, &remote_cpy, &rem, &src_port,
+                        &dst_port);
+    if (res < 0) {
+        return res;
+    }
+    /* generate payload and header snips */
+    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -ENOMEM;
+    }
+    return _send_payload(payload, src_port, dst_port, &local, rem);
+}
+
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
+{
+    int res;
+    gnrc_pktsnip_t *payload;
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_udp_ep_t remote_cpy;
+    sock_ip_ep_t *rem;
+    uint8_t *ptr;
+
+    res = _send_prepare(sock, remote, &local, &remote_cpy, &rem, &src_port,
+                        &dst_port);
+    if (res < 0) {
+        return res;
+    }
+    /* gather the chain directly into a single payload snip */
+    payload = gnrc_pktbuf_add(NULL, NULL, iolist_size(snips),
+                              GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -ENOMEM;
+    }
+    ptr = payload->data;
+    for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+        assert((snip->iol_len == 0) || (snip->iol_base != NULL));
+        memcpy(ptr, snip->iol_base, snip->iol_len);
+        ptr += snip->iol_len;
+    }
+    return _send_payload(payload, src_port, dst_port, &local, rem);
+}
+
+ssize_t gnrc_sock_udp_send_pkt(sock_udp_t *sock, gnrc_pktsnip_t *payload,
+                               const sock_udp_ep_t *remote)
+{
+    int res;
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_udp_ep_t remote_cpy;
+    sock_ip_ep_t *rem;
+
+    assert(payload != NULL);
+
+    res = _send_prepare(sock, remote, &local, &remote_cpy, &rem, &src_port,
+                        &dst_port);
+    if (res < 0) {
+        gnrc_pktbuf_release(payload);
+        return res;
+    }
+    return _send_payload(payload, src_port, dst_port, &local, rem);
+}
+
 /** @} */
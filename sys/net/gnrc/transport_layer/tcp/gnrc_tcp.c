@@ -30,6 +30,7 @@
 #include "internal/option.h"
 #include "internal/eventloop.h"
 #include "internal/rcvbuf.h"
+#include "internal/cc.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -284,6 +285,25 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     mutex_init(&(tcb->function_lock));
 }
 
+int gnrc_tcp_tcb_set_rcv_buf(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+{
+    assert(tcb != NULL);
+    assert(buf != NULL);
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
+
+    /* The receive buffer is in use while the connection is open */
+    if (tcb->state != FSM_STATE_CLOSED) {
+        mutex_unlock(&(tcb->function_lock));
+        return -EISCONN;
+    }
+    tcb->rcv_buf_user = buf;
+    tcb->rcv_buf_user_size = len;
+    mutex_unlock(&(tcb->function_lock));
+    return 0;
+}
+
 int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
                          char *target_addr, uint16_t target_port,
                          uint16_t local_port)
@@ -347,7 +367,12 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     xtimer_t probe_timeout;
     cb_arg_t probe_timeout_arg = {MSG_TYPE_PROBE_TIMEOUT, &(tcb->mbox)};
     uint32_t probe_timeout_duration_us = 0;
+#ifdef MODULE_GNRC_TCP_PACING
+    cb_arg_t pacing_timeout_arg = {MSG_TYPE_PACING_TIMEOUT, &(tcb->mbox)};
+    xtimer_t pacing_timeout = { .callback = _cb_mbox_put_msg, .arg = &pacing_timeout_arg };
+#endif
     ssize_t ret = 0;
+    size_t sent = 0;
     bool probing_mode = false;
 
     /* Lock the TCB for this function call */
@@ -375,8 +400,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until all data was handed to the retransmission queue. The queued data is
+     * retransmitted by the TCP thread, so the call does not wait for the last ACKs. */
+    while (ret == 0 && sent < len) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -395,9 +421,19 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                            &probe_timeout_arg);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
-            ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+        /* Try to send data as long as windows allow it and we are not probing */
+        if (!probing_mode) {
+            sent += _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (uint8_t *) data + sent, len - sent);
+            if (sent == len) {
+                break;
+            }
+#ifdef MODULE_GNRC_TCP_PACING
+            /* Wake up when the next segment may be sent */
+            uint32_t delay = _cc_pacing_delay(tcb);
+            if (delay > 0) {
+                _setup_timeout(&pacing_timeout, delay, _cb_mbox_put_msg, &pacing_timeout_arg);
+            }
+#endif
         }
 
         /* Wait for responses */
@@ -411,7 +447,10 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
+                /* Drop the queued data only, if nothing was transmitted yet */
+                if (sent == 0) {
+                    _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
+                }
                 ret = -ETIMEDOUT;
                 break;
 
@@ -430,6 +469,12 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                 }
                 break;
 
+#ifdef MODULE_GNRC_TCP_PACING
+            case MSG_TYPE_PACING_TIMEOUT:
+                DEBUG("gnrc_tcp.c : gnrc_tcp_send() : PACING_TIMEOUT\n");
+                break;
+#endif
+
             case MSG_TYPE_NOTIFY_USER:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : NOTIFY_USER\n");
 
@@ -453,8 +498,16 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     xtimer_remove(&probe_timeout);
     xtimer_remove(&connection_timeout);
     xtimer_remove(&user_timeout);
+#ifdef MODULE_GNRC_TCP_PACING
+    xtimer_remove(&pacing_timeout);
+#endif
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
+
+    /* Report the amount of transmitted data, unless the connection failed */
+    if (ret == 0 || (ret == -ETIMEDOUT && sent > 0)) {
+        ret = sent;
+    }
     return ret;
 }
 
@@ -618,6 +671,27 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
     mutex_unlock(&(tcb->function_lock));
 }
 
+void gnrc_tcp_get_stats(gnrc_tcp_tcb_t *tcb, gnrc_tcp_stats_t *stats)
+{
+    assert(tcb != NULL);
+    assert(stats != NULL);
+
+    /* Lock the FSM only: a user call may block on this TCB */
+    mutex_lock(&(tcb->fsm_lock));
+    stats->cwnd = tcb->cwnd;
+    stats->ssthresh = tcb->ssthresh;
+    stats->flight = tcb->snd_nxt - tcb->snd_una;
+    stats->snd_wnd = tcb->snd_wnd;
+    stats->rcv_wnd = tcb->rcv_wnd;
+    stats->srtt = tcb->srtt;
+    stats->rtt_var = tcb->rtt_var;
+    stats->rto = tcb->rto;
+    stats->retransmits = tcb->cnt_retransmits;
+    stats->fast_retransmits = tcb->cnt_fast_retransmits;
+    stats->timeouts = tcb->cnt_timeouts;
+    mutex_unlock(&(tcb->fsm_lock));
+}
+
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
 {
     uint16_t csum;
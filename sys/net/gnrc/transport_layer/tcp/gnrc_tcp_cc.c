@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ * @}
+ */
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+#include "internal/common.h"
+#include "internal/pkt.h"
+#include "internal/cc.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Calculates the number of bytes in flight.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Number of sent but unacknowledged bytes.
+ */
+static inline uint32_t _flight_size(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->snd_nxt - tcb->snd_una;
+}
+
+/**
+ * @brief Sets the slow start threshold to half the flight size, at least
+ *        two segments (see RFC 5681, equation 4).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _reduce_ssthresh(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t half = _flight_size(tcb) / 2;
+    uint32_t min = 2 * _cc_smss(tcb);
+
+    tcb->ssthresh = (half > min) ? half : min;
+}
+
+/**
+ * @brief Retransmits the oldest unacknowledged segment without backing off the RTO.
+ *
+ * Unlike a timeout, this neither restarts the retransmission timer nor counts
+ * in tcb->retries.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _retransmit_first(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->pkt_retransmit[0] != NULL) {
+        /* Increase users: every send attempt consumes a user */
+        gnrc_pktbuf_hold(tcb->pkt_retransmit[0], 1);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
+    }
+}
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    DEBUG("gnrc_tcp_cc.c : _cc_init()\n");
+    tcb->cwnd = GNRC_TCP_CWND_INIT_SEGMENTS * _cc_smss(tcb);
+    tcb->ssthresh = UINT32_MAX;
+    tcb->recover = tcb->snd_una - 1;
+    tcb->dupacks = 0;
+    tcb->status &= ~(STATUS_FAST_RECOVERY | STATUS_LOSS_RECOVERY);
+#ifdef MODULE_GNRC_TCP_PACING
+    tcb->snd_pace = xtimer_now_usec();
+#endif
+    tcb->cnt_retransmits = 0;
+    tcb->cnt_fast_retransmits = 0;
+    tcb->cnt_timeouts = 0;
+}
+
+void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked)
+{
+    uint32_t smss = _cc_smss(tcb);
+
+    tcb->dupacks = 0;
+
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        /* Full acknowledgment: deflate the window and leave fast recovery */
+        if (LSS_32_BIT(tcb->recover, tcb->snd_una)) {
+            uint32_t flight = _flight_size(tcb);
+
+            flight = ((flight > smss) ? flight : smss) + smss;
+            tcb->cwnd = (tcb->ssthresh < flight) ? tcb->ssthresh : flight;
+            tcb->status &= ~STATUS_FAST_RECOVERY;
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : Full ACK, cwnd=%lu\n", (unsigned long)tcb->cwnd);
+        }
+        /* Partial acknowledgment: the next segment was lost as well (see RFC 6582) */
+        else {
+            _retransmit_first(tcb);
+            tcb->cwnd = ((tcb->cwnd > acked) ? (tcb->cwnd - acked) : 0) + smss;
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : Partial ACK, cwnd=%lu\n",
+                  (unsigned long)tcb->cwnd);
+        }
+        return;
+    }
+
+    /* After a timeout all segments sent before are retransmitted one by one */
+    if (tcb->status & STATUS_LOSS_RECOVERY) {
+        if (LSS_32_BIT(tcb->recover, tcb->snd_una)) {
+            tcb->status &= ~STATUS_LOSS_RECOVERY;
+        }
+        else {
+            _retransmit_first(tcb);
+        }
+    }
+
+    /* The window can't be used beyond the retransmission queue: don't grow it further */
+    if (tcb->cwnd >= GNRC_TCP_SND_SEGMENTS * smss) {
+        return;
+    }
+
+    /* Slow start */
+    if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    /* Congestion avoidance: about one segment per round trip time */
+    else {
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+}
+
+void _cc_dupack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _cc_smss(tcb);
+
+    tcb->dupacks += (tcb->dupacks < UINT8_MAX) ? 1 : 0;
+
+    /* Every further duplicate ACK signals a segment that left the network */
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        tcb->cwnd += smss;
+        tcb->status |= STATUS_NOTIFY_USER;
+        return;
+    }
+
+    /* Fast retransmit, unless the loss was already handled (see RFC 6582, section 3.2) */
+    if (tcb->dupacks == GNRC_TCP_DUPACK_THRESHOLD && !(tcb->status & STATUS_LOSS_RECOVERY) &&
+        LSS_32_BIT(tcb->recover, tcb->snd_una)) {
+        _reduce_ssthresh(tcb);
+        tcb->recover = tcb->snd_nxt - 1;
+        _retransmit_first(tcb);
+        tcb->cnt_fast_retransmits += 1;
+        tcb->cwnd = tcb->ssthresh + GNRC_TCP_DUPACK_THRESHOLD * smss;
+        tcb->status |= STATUS_FAST_RECOVERY | STATUS_NOTIFY_USER;
+        DEBUG("gnrc_tcp_cc.c : _cc_dupack() : Fast retransmit, ssthresh=%lu\n",
+              (unsigned long)tcb->ssthresh);
+    }
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _cc_smss(tcb);
+
+    /* Don't reduce ssthresh again, if the same segment times out repeatedly */
+    if (tcb->retries == 0) {
+        _reduce_ssthresh(tcb);
+    }
+    tcb->cwnd = smss;
+    tcb->dupacks = 0;
+    tcb->recover = tcb->snd_nxt - 1;
+    tcb->cnt_timeouts += 1;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+    tcb->status |= STATUS_LOSS_RECOVERY;
+    DEBUG("gnrc_tcp_cc.c : _cc_timeout() : ssthresh=%lu\n", (unsigned long)tcb->ssthresh);
+}
+
+#ifdef MODULE_GNRC_TCP_PACING
+void _cc_pacing_sent(gnrc_tcp_tcb_t *tcb)
+{
+    /* Without a round trip time sample there is nothing to pace with */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->cwnd == 0) {
+        return;
+    }
+    uint64_t interval = ((uint64_t)tcb->srtt * _cc_smss(tcb)) / tcb->cwnd;
+    tcb->snd_pace = xtimer_now_usec() + (uint32_t)interval;
+}
+
+uint32_t _cc_pacing_delay(const gnrc_tcp_tcb_t *tcb)
+{
+    int32_t delay = (int32_t)(tcb->snd_pace - xtimer_now_usec());
+
+    return (delay > 0) ? (uint32_t)delay : 0;
+}
+#endif
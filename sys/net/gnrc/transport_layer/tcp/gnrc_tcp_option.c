@@ -16,16 +16,33 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
 #include "internal/common.h"
 #include "internal/option.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+void _option_build_sack(uint8_t *opt_ptr, const uint32_t *blocks, unsigned num)
+{
+    assert(num <= TCP_SACK_BLOCKS_MAX);
+    opt_ptr[0] = TCP_OPTION_KIND_NOP;
+    opt_ptr[1] = TCP_OPTION_KIND_NOP;
+    opt_ptr[2] = TCP_OPTION_KIND_SACK;
+    opt_ptr[3] = TCP_OPTION_LENGTH_SACK_MIN + (num - 1) * 2 * sizeof(network_uint32_t);
+    opt_ptr += 4;
+    for (unsigned i = 0; i < 2 * num; ++i) {
+        network_uint32_t edge = byteorder_htonl(blocks[i]);
+        memcpy(opt_ptr, &edge, sizeof(edge));
+        opt_ptr += sizeof(edge);
+    }
+}
+
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
     /* Extract offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+    uint8_t offset = GET_OFFSET(ctl);
     if (offset <= TCP_HDR_OFFSET_MIN) {
         return 0;
     }
@@ -60,6 +77,30 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK permitted length.\n");
+                    return -1;
+                }
+                /* Only valid in SYN segments */
+                if (ctl & MSK_SYN) {
+                    tcb->status |= STATUS_SACK_PERMITTED;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK permitted option found.\n");
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (option->length < TCP_OPTION_LENGTH_SACK_MIN ||
+                    ((option->length - 2) % (2 * sizeof(network_uint32_t))) != 0) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK option length.\n");
+                    return -1;
+                }
+                /* The blocks are ignored on purpose: the sender keeps no SACK
+                 * scoreboard, NewReno (see gnrc_tcp_cc.c) retransmits the oldest
+                 * unacknowledged segment on fast retransmits and partial ACKs */
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK option found.\n");
+                break;
+
             default:
                 DEBUG("gnrc_tcp_option.c : _option_parse() : Unknown option found.\
                       KIND=%"PRIu8", LENGTH=%"PRIu8"\n", option->kind, option->length);
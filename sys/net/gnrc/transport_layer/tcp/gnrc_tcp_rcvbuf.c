@@ -16,6 +16,12 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include <utlist.h>
+#include "net/gnrc/pktbuf.h"
+#include "net/tcp.h"
+#include "internal/common.h"
+#include "internal/pkt.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
@@ -80,13 +86,21 @@ static void _rcvbuf_free(void * const buf)
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
+        size_t size = GNRC_TCP_RCV_BUF_SIZE;
+
+        if (tcb->rcv_buf_user != NULL) {
+            tcb->rcv_buf_raw = tcb->rcv_buf_user;
+            size = tcb->rcv_buf_user_size;
+        }
+        else {
+            tcb->rcv_buf_raw = _rcvbuf_alloc();
+        }
         if (tcb->rcv_buf_raw == NULL) {
             DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
             return -ENOMEM;
         }
         else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, size);
         }
     }
     return 0;
@@ -94,8 +108,159 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
+    /* Drop held out-of-order segments */
+    for (size_t i = 0; i < GNRC_TCP_RCV_OOO_SEGMENTS; ++i) {
+        if (tcb->rcv_ooo[i] != NULL) {
+            gnrc_pktbuf_release(tcb->rcv_ooo[i]);
+            tcb->rcv_ooo[i] = NULL;
+        }
+    }
     if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
+        if (tcb->rcv_buf_raw != tcb->rcv_buf_user) {
+            _rcvbuf_free(tcb->rcv_buf_raw);
+        }
         tcb->rcv_buf_raw = NULL;
     }
 }
+
+size_t _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, size_t offset)
+{
+    size_t added = 0;
+    gnrc_pktsnip_t *snp = NULL;
+
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_UNDEF);
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+        if (offset < snp->size) {
+            size_t len = snp->size - offset;
+            size_t copied = ringbuffer_add(&(tcb->rcv_buf), (char *) snp->data + offset, len);
+
+            added += copied;
+            /* Receive buffer is full */
+            if (copied < len) {
+                break;
+            }
+            offset = 0;
+        }
+        else {
+            offset -= snp->size;
+        }
+        snp = snp->next;
+    }
+    return added;
+}
+
+/**
+ * @brief Extracts the sequence number of a received segment.
+ *
+ * @param[in] pkt   Received segment.
+ *
+ * @returns   Sequence number of @p pkt.
+ */
+static uint32_t _get_seq(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snp = NULL;
+
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+    return byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+}
+
+int _rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t seg_seq,
+                    uint32_t pay_len)
+{
+    size_t pos;
+
+    /* Hold only segments that fit completely into the receive window */
+    if (LSS_32_BIT(tcb->rcv_nxt + tcb->rcv_wnd, seg_seq + pay_len)) {
+        return -ENOSPC;
+    }
+
+    /* Search position, ignore segments that are held already */
+    for (pos = 0; pos < GNRC_TCP_RCV_OOO_SEGMENTS && tcb->rcv_ooo[pos] != NULL; ++pos) {
+        uint32_t seq = _get_seq(tcb->rcv_ooo[pos]);
+
+        if (LEQ_32_BIT(seq, seg_seq) &&
+            LEQ_32_BIT(seg_seq + pay_len, seq + _pkt_get_pay_len(tcb->rcv_ooo[pos]))) {
+            tcb->rcv_ooo_last = seg_seq;
+            return 0;
+        }
+        if (LSS_32_BIT(seg_seq, seq)) {
+            break;
+        }
+    }
+    if (pos == GNRC_TCP_RCV_OOO_SEGMENTS) {
+        DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_ooo_add() : Out-of-order queue is full\n");
+        return -ENOMEM;
+    }
+
+    /* Make room by dropping the segment farthest away from rcv_nxt */
+    if (tcb->rcv_ooo[GNRC_TCP_RCV_OOO_SEGMENTS - 1] != NULL) {
+        gnrc_pktbuf_release(tcb->rcv_ooo[GNRC_TCP_RCV_OOO_SEGMENTS - 1]);
+    }
+    memmove(&tcb->rcv_ooo[pos + 1], &tcb->rcv_ooo[pos],
+            (GNRC_TCP_RCV_OOO_SEGMENTS - 1 - pos) * sizeof(tcb->rcv_ooo[0]));
+    gnrc_pktbuf_hold(pkt, 1);
+    tcb->rcv_ooo[pos] = pkt;
+    tcb->rcv_ooo_last = seg_seq;
+    return 0;
+}
+
+void _rcvbuf_ooo_process(gnrc_tcp_tcb_t *tcb)
+{
+    while (tcb->rcv_ooo[0] != NULL) {
+        uint32_t seq = _get_seq(tcb->rcv_ooo[0]);
+
+        /* There is still a gap in front of the first held segment */
+        if (LSS_32_BIT(tcb->rcv_nxt, seq)) {
+            break;
+        }
+        tcb->rcv_nxt += _rcvbuf_add(tcb, tcb->rcv_ooo[0], tcb->rcv_nxt - seq);
+        gnrc_pktbuf_release(tcb->rcv_ooo[0]);
+        memmove(&tcb->rcv_ooo[0], &tcb->rcv_ooo[1],
+                (GNRC_TCP_RCV_OOO_SEGMENTS - 1) * sizeof(tcb->rcv_ooo[0]));
+        tcb->rcv_ooo[GNRC_TCP_RCV_OOO_SEGMENTS - 1] = NULL;
+    }
+}
+
+unsigned _rcvbuf_ooo_get_sack_blocks(const gnrc_tcp_tcb_t *tcb, uint32_t *blocks,
+                                     unsigned max)
+{
+    uint32_t ranges[2 * GNRC_TCP_RCV_OOO_SEGMENTS];
+    unsigned num = 0;
+    unsigned latest = 0;
+    unsigned res = 1;
+
+    /* Merge adjacent and overlapping segments into ranges */
+    for (size_t i = 0; i < GNRC_TCP_RCV_OOO_SEGMENTS && tcb->rcv_ooo[i] != NULL; ++i) {
+        uint32_t left = _get_seq(tcb->rcv_ooo[i]);
+        uint32_t right = left + _pkt_get_pay_len(tcb->rcv_ooo[i]);
+
+        if (num > 0 && LEQ_32_BIT(left, ranges[2 * num - 1])) {
+            if (LSS_32_BIT(ranges[2 * num - 1], right)) {
+                ranges[2 * num - 1] = right;
+            }
+        }
+        else {
+            ranges[2 * num] = left;
+            ranges[2 * num + 1] = right;
+            num++;
+        }
+        if (LEQ_32_BIT(left, tcb->rcv_ooo_last) && LSS_32_BIT(tcb->rcv_ooo_last, right)) {
+            latest = num - 1;
+        }
+    }
+
+    /* Report the range holding the latest segment first, the others in order */
+    if (num == 0 || max == 0) {
+        return 0;
+    }
+    blocks[0] = ranges[2 * latest];
+    blocks[1] = ranges[2 * latest + 1];
+    for (unsigned i = 0; i < num && res < max; ++i) {
+        if (i != latest) {
+            blocks[2 * res] = ranges[2 * i];
+            blocks[2 * res + 1] = ranges[2 * i + 1];
+            res++;
+        }
+    }
+    return res;
+}
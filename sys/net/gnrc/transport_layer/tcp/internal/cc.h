@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       NewReno congestion control and send pacing declarations.
+ *
+ * @see         <a href="https://tools.ietf.org/html/rfc5681">RFC 5681</a>
+ * @see         <a href="https://tools.ietf.org/html/rfc6582">RFC 6582</a>
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/config.h"
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Calculates the sender maximum segment size (SMSS).
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Size of the largest segment the connection sends.
+ */
+static inline uint32_t _cc_smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->mss > 0 && tcb->mss < GNRC_TCP_MSS) ? tcb->mss : GNRC_TCP_MSS;
+}
+
+/**
+ * @brief Calculates the window usable for sending: the minimum of the
+ *        receivers advertised window and the congestion window.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Number of bytes allowed in flight.
+ */
+static inline uint32_t _cc_get_snd_wnd(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->cwnd < tcb->snd_wnd) ? tcb->cwnd : tcb->snd_wnd;
+}
+
+/**
+ * @brief Initializes congestion control after the connection was established.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Updates the congestion state after new data was acknowledged.
+ *
+ * Must be called after tcb->snd_una was advanced and the acknowledged
+ * segments were removed from the retransmission queue.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked);
+
+/**
+ * @brief Updates the congestion state on a duplicate ACK. Performs a fast
+ *        retransmit when GNRC_TCP_DUPACK_THRESHOLD is reached.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_dupack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Updates the congestion state after a retransmission timeout.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+
+#if defined(MODULE_GNRC_TCP_PACING) || defined(DOXYGEN)
+/**
+ * @brief Records that a segment was sent to pace the next one.
+ *
+ * The next segment may be sent srtt * SMSS / cwnd later, which spreads one
+ * congestion window over one round trip time.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_pacing_sent(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Calculates how long the next segment has to be delayed.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Remaining delay in microseconds, zero if sending is allowed.
+ */
+uint32_t _cc_pacing_delay(const gnrc_tcp_tcb_t *tcb);
+#else
+#define _cc_pacing_sent(tcb)    (void)(tcb)
+#define _cc_pacing_delay(tcb)   (0U)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
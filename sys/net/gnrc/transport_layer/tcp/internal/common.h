@@ -49,6 +49,10 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_SACK_PERMITTED (1 << 4)
+#define STATUS_RTT_MEASURE    (1 << 5)
+#define STATUS_FAST_RECOVERY  (1 << 6)
+#define STATUS_LOSS_RECOVERY  (1 << 7)
 /** @} */
 
 /**
@@ -89,6 +93,7 @@ extern "C" {
 #define MSG_TYPE_RETRANSMISSION     (GNRC_NETAPI_MSG_TYPE_ACK + 104)
 #define MSG_TYPE_TIMEWAIT           (GNRC_NETAPI_MSG_TYPE_ACK + 105)
 #define MSG_TYPE_NOTIFY_USER        (GNRC_NETAPI_MSG_TYPE_ACK + 106)
+#define MSG_TYPE_PACING_TIMEOUT     (GNRC_NETAPI_MSG_TYPE_ACK + 107)
 /** @} */
 
 /**
@@ -44,6 +44,41 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the SACK permitted option, preceded by two NOPs.
+ *
+ * @returns   SACK permitted option value.
+ */
+static inline uint32_t _option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
+/**
+ * @brief Calculates the size of a SACK option, preceded by two NOPs.
+ *
+ * @param[in] num   Number of SACK blocks.
+ *
+ * @returns   Size of the option in multiples of 32 bit.
+ */
+static inline uint8_t _option_sack_size(unsigned num)
+{
+    return 1 + 2 * num;
+}
+
+/**
+ * @brief Writes a SACK option, preceded by two NOPs.
+ *
+ * @pre @p opt_ptr points to at least _option_sack_size(@p num) * 4 bytes.
+ *
+ * @param[out] opt_ptr   Option field to write the option to.
+ * @param[in]  blocks    Left and right edge of each block.
+ * @param[in]  num       Number of blocks in @p blocks.
+ */
+void _option_build_sack(uint8_t *opt_ptr, const uint32_t *blocks, unsigned num);
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include "mutex.h"
+#include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
 
@@ -65,10 +66,81 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 /**
  * @brief Release allocated receive buffer.
  *
+ * @note Releases all held out-of-order segments as well.
+ *
  * @param[in,out] tcb   TCB holding the receive buffer that should be released.
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Calculates the receive window from the free space in the receive buffer.
+ *
+ * @param[in] tcb   TCB holding the receive buffer.
+ *
+ * @returns   Free space in the receive buffer, limited to the maximum window size.
+ */
+static inline uint16_t _rcvbuf_get_wnd(gnrc_tcp_tcb_t *tcb)
+{
+    unsigned free = ringbuffer_get_free(&(tcb->rcv_buf));
+
+    return (free > UINT16_MAX) ? UINT16_MAX : free;
+}
+
+/**
+ * @brief Copies the payload of a segment into the receive buffer.
+ *
+ * @param[in,out] tcb      TCB holding the receive buffer.
+ * @param[in]     pkt      Segment to copy the payload from.
+ * @param[in]     offset   Number of payload bytes to skip.
+ *
+ * @returns   Number of bytes copied into the receive buffer.
+ */
+size_t _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, size_t offset);
+
+/**
+ * @brief Holds a segment that was received out of order.
+ *
+ * @note If the queue is full, the held segment with the highest sequence number
+ *       is dropped in favor of @p pkt, if @p pkt is closer to the next expected
+ *       sequence number.
+ *
+ * @param[in,out] tcb       TCB holding the out-of-order queue.
+ * @param[in]     pkt       Received segment.
+ * @param[in]     seg_seq   Sequence number of @p pkt.
+ * @param[in]     pay_len   Payload length of @p pkt.
+ *
+ * @returns   Zero on success.
+ *            -ENOSPC if @p pkt does not fit into the receive window.
+ *            -ENOMEM if the queue is full with segments closer to the next expected
+ *                    sequence number.
+ */
+int _rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t seg_seq,
+                    uint32_t pay_len);
+
+/**
+ * @brief Moves held out-of-order segments, that became in order, into the receive
+ *        buffer and advances tcb->rcv_nxt accordingly.
+ *
+ * @param[in,out] tcb   TCB holding the out-of-order queue.
+ */
+void _rcvbuf_ooo_process(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Gets the SACK blocks describing the held out-of-order segments.
+ *
+ * @see https://tools.ietf.org/html/rfc2018#section-4
+ *
+ * @note The block containing the latest out-of-order segment is the first one.
+ *
+ * @param[in]  tcb      TCB holding the out-of-order queue.
+ * @param[out] blocks   Left and right edge of each block.
+ * @param[in]  max      Maximum number of blocks to store in @p blocks.
+ *
+ * @returns   Number of blocks stored in @p blocks.
+ */
+unsigned _rcvbuf_ooo_get_sack_blocks(const gnrc_tcp_tcb_t *tcb, uint32_t *blocks,
+                                     unsigned max);
+
 #ifdef __cplusplus
 }
 #endif
@@ -48,6 +48,13 @@ static char _stack[GNRC_UDP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 static char _stack[GNRC_UDP_STACK_SIZE];
 #endif
 
+#ifdef MODULE_GNRC_NETAPI_BURST
+/**
+ * @brief   Received packets not yet handed on to the receivers of their port
+ */
+static gnrc_netapi_burst_t _rx_burst;
+#endif
+
 /**
  * @brief   Calculate the UDP checksum dependent on the network protocol
  *
@@ -155,6 +162,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
     /* get port (netreg demux context) */
     port = (uint32_t)byteorder_ntohs(hdr->dst_port);
 
+#ifdef MODULE_GNRC_NETAPI_BURST
+    /* packets for the same port are handed on together */
+    if (gnrc_netreg_num(GNRC_NETTYPE_UDP, port) > 0) {
+        gnrc_netapi_burst_add(&_rx_burst, GNRC_NETTYPE_UDP, port, pkt);
+        return;
+    }
+#endif
     /* send payload to receivers */
     if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, port, pkt)) {
         DEBUG("udp: unable to forward packet as no one is interested in it\n");
@@ -225,8 +239,13 @@ static void *_event_loop(void *arg)
     (void)arg;
     msg_t msg, reply;
     msg_t msg_queue[GNRC_UDP_MSG_QUEUE_SIZE];
+#ifdef MODULE_GNRC_NETAPI_BURST
+    gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_BURST(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                              sched_active_pid);
+#else
     gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
     /* preset reply message */
     reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
     reply.content.value = (uint32_t)-ENOTSUP;
@@ -237,12 +256,31 @@ static void *_event_loop(void *arg)
 
     /* dispatch NETAPI messages */
     while (1) {
+#ifdef MODULE_GNRC_NETAPI_BURST
+        /* hand on the packets received so far before waiting */
+        if (msg_avail() == 0) {
+            gnrc_netapi_burst_flush(&_rx_burst);
+        }
+#endif
         msg_receive(&msg);
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
                 _receive(msg.content.ptr);
                 break;
+#ifdef MODULE_GNRC_NETAPI_BURST
+            case GNRC_NETAPI_MSG_TYPE_RCV_BURST: {
+                gnrc_pktsnip_t *burst = msg.content.ptr;
+                gnrc_pktsnip_t **pkts = gnrc_netapi_burst_pkts(burst);
+
+                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV_BURST\n");
+                for (unsigned i = 0; i < gnrc_netapi_burst_numof(burst); i++) {
+                    _receive(pkts[i]);
+                }
+                gnrc_pktbuf_release(burst);
+                break;
+            }
+#endif
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
                 _send(msg.content.ptr);
@@ -18,6 +18,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "log.h"
 #include "luid.h"
@@ -49,20 +50,23 @@ void auto_init_random(void)
     random_init(seed);
 }
 
+#ifndef MODULE_PRNG_XOSHIRO
+/* prng_xoshiro fills from the state of the calling thread itself */
 void random_bytes(uint8_t *target, size_t n)
 {
     uint32_t random;
-    uint8_t *random_pos = (uint8_t*)&random;
-    unsigned _n = 0;
 
-    while (n--) {
-        if (! (_n++ & 0x3)) {
-            random = random_uint32();
-            random_pos = (uint8_t *) &random;
-        }
-        *target++ = *random_pos++;
+    for (; n >= sizeof(random); n -= sizeof(random)) {
+        random = random_uint32();
+        memcpy(target, &random, sizeof(random));
+        target += sizeof(random);
+    }
+    if (n) {
+        random = random_uint32();
+        memcpy(target, &random, n);
     }
 }
+#endif
 
 uint32_t random_uint32_range(uint32_t a, uint32_t b)
 {
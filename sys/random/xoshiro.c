@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * The generator and jump polynomial are taken from the reference
+ * implementation by David Blackman and Sebastiano Vigna
+ * (http://prng.di.unimi.it/xoshiro128starstar.c), which is in the public
+ * domain.
+ */
+
+/**
+ * @ingroup sys_random
+ * @{
+ * @file
+ *
+ * @brief   xoshiro128** PRNG with one stream per thread
+ *
+ * Every thread draws from its own generator state, so threads neither lock
+ * nor disturb each other. A thread takes its state on its first call after
+ * random_init(): the state of the previous thread advanced by 2^64 numbers,
+ * so the streams never overlap. Interrupts and code running before the
+ * scheduler share one more stream, which is used with interrupts disabled.
+ *
+ * The streams depend on the order in which the threads first ask for
+ * numbers. This is not a CSPRNG.
+ *
+ * @author  Unwired Devices LLC <info@unwds.com>
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "irq.h"
+#include "random.h"
+#include "thread.h"
+
+/* streams of the threads, and the last one for interrupts */
+#define SHARED_STREAM   (MAXTHREADS)
+
+typedef struct {
+    uint32_t s[4];
+    uint32_t epoch;     /**< value of _epoch when s was taken */
+} _stream_t;
+
+static _stream_t _streams[MAXTHREADS + 1];
+/* state the next stream starts from */
+static uint32_t _next[4];
+/* bumped by each random_init(), 0 if it was not called yet */
+static uint32_t _epoch;
+
+static inline uint32_t _rotl(uint32_t x, unsigned k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+static inline uint32_t _xoshiro128ss(uint32_t *s)
+{
+    const uint32_t result = _rotl(s[1] * 5, 7) * 9;
+    const uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = _rotl(s[3], 11);
+
+    return result;
+}
+
+/* advance the state by 2^64 numbers */
+static void _jump(uint32_t *s)
+{
+    static const uint32_t jump[] = {
+        0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b
+    };
+    uint32_t acc[4] = { 0 };
+
+    for (unsigned i = 0; i < 4; i++) {
+        for (unsigned b = 0; b < 32; b++) {
+            if (jump[i] & (1UL << b)) {
+                for (unsigned j = 0; j < 4; j++) {
+                    acc[j] ^= s[j];
+                }
+            }
+            _xoshiro128ss(s);
+        }
+    }
+    memcpy(s, acc, sizeof(acc));
+}
+
+/* spreads a seed over the state, never leaves all of it zero */
+static uint32_t _splitmix32(uint32_t *x)
+{
+    uint32_t z = (*x += 0x9e3779b9);
+
+    z = (z ^ (z >> 16)) * 0x85ebca6b;
+    z = (z ^ (z >> 13)) * 0xc2b2ae35;
+    return z ^ (z >> 16);
+}
+
+static void _seed(uint32_t x)
+{
+    unsigned state = irq_disable();
+
+    for (unsigned i = 0; i < 4; i++) {
+        _next[i] = _splitmix32(&x);
+    }
+    if (++_epoch == 0) {
+        _epoch = 1;
+    }
+    irq_restore(state);
+}
+
+static uint32_t *_state(unsigned stream)
+{
+    _stream_t *st = &_streams[stream];
+
+    if ((st->epoch != _epoch) || (_epoch == 0)) {
+        unsigned state = irq_disable();
+
+        if (_epoch == 0) {
+            irq_restore(state);
+            random_init(RANDOM_SEED_DEFAULT);
+            state = irq_disable();
+        }
+        memcpy(st->s, _next, sizeof(st->s));
+        _jump(_next);
+        st->epoch = _epoch;
+        irq_restore(state);
+    }
+    return st->s;
+}
+
+/* the stream of the running thread, or SHARED_STREAM */
+static unsigned _stream(void)
+{
+    kernel_pid_t pid = thread_getpid();
+
+    if (irq_is_in() || !pid_is_valid(pid)) {
+        return SHARED_STREAM;
+    }
+    return pid - KERNEL_PID_FIRST;
+}
+
+void random_init(uint32_t val)
+{
+    _seed(val);
+}
+
+void random_init_by_array(uint32_t init_key[], int key_length)
+{
+    uint32_t x = key_length;
+
+    for (int i = 0; i < key_length; i++) {
+        x ^= init_key[i];
+        _splitmix32(&x);
+    }
+    _seed(x);
+}
+
+uint32_t random_uint32(void)
+{
+    unsigned stream = _stream();
+
+    if (stream != SHARED_STREAM) {
+        return _xoshiro128ss(_state(stream));
+    }
+
+    unsigned state = irq_disable();
+    uint32_t res = _xoshiro128ss(_state(stream));
+    irq_restore(state);
+    return res;
+}
+
+void random_bytes(uint8_t *target, size_t n)
+{
+    unsigned stream = _stream();
+
+    if (stream == SHARED_STREAM) {
+        /* interrupts are disabled for one number at a time */
+        for (; n >= sizeof(uint32_t); n -= sizeof(uint32_t)) {
+            uint32_t random = random_uint32();
+
+            memcpy(target, &random, sizeof(random));
+            target += sizeof(random);
+        }
+    }
+    else {
+        uint32_t *state = _state(stream);
+        uint32_t s[4];
+
+        /* the state is kept in locals while filling */
+        memcpy(s, state, sizeof(s));
+        for (; n >= sizeof(uint32_t); n -= sizeof(uint32_t)) {
+            uint32_t random = _xoshiro128ss(s);
+
+            memcpy(target, &random, sizeof(random));
+            target += sizeof(random);
+        }
+        memcpy(state, s, sizeof(s));
+    }
+
+    if (n) {
+        uint32_t random = random_uint32();
+
+        memcpy(target, &random, n);
+    }
+}
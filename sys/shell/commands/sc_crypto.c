@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command to list and select cipher backends
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/backend.h"
+
+static const char *_states[] = {
+    [CRYPTO_BACKEND_UNTESTED]       = "untested",
+    [CRYPTO_BACKEND_UNAVAILABLE]    = "unavailable",
+    [CRYPTO_BACKEND_FAILED]         = "failed",
+    [CRYPTO_BACKEND_PASSED]         = "passed",
+};
+
+static void _usage(char *cmd)
+{
+    printf("Usage: %s [list]\n", cmd);
+    printf("       %s set <algorithm> <backend>\n", cmd);
+    printf("       %s bench\n", cmd);
+}
+
+static void _list(void)
+{
+    crypto_backend_info_t info;
+
+    printf("%-10s %-10s %-12s %10s\n", "algorithm", "backend", "self-test",
+           "KiB/s");
+    for (unsigned i = 0; crypto_backend_info(i, &info) == 0; i++) {
+        printf("%-10s %-10s %-12s %10" PRIu32 "%s\n", info.algo, info.name,
+               _states[info.state], info.speed, info.selected ? " *" : "");
+    }
+}
+
+int _crypto_handler(int argc, char **argv)
+{
+    if ((argc < 2) || (strcmp(argv[1], "list") == 0)) {
+        _list();
+        return 0;
+    }
+
+    if (strcmp(argv[1], "bench") == 0) {
+        crypto_backend_init();
+        _list();
+        return 0;
+    }
+
+    if ((strcmp(argv[1], "set") == 0) && (argc == 4)) {
+        switch (crypto_backend_select(argv[2], argv[3])) {
+            case 0:
+                return 0;
+            case -2:
+                printf("error: %s %s is unavailable or did not pass the self-test\n",
+                       argv[2], argv[3]);
+                return 1;
+            default:
+                printf("error: no backend %s of %s\n", argv[3], argv[2]);
+                return 1;
+        }
+    }
+
+    _usage(argv[0]);
+    return 1;
+}
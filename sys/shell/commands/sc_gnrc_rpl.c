@@ -24,6 +24,12 @@
 #include "net/gnrc/rpl/dodag.h"
 #include "utlist.h"
 #include "trickle.h"
+#ifdef MODULE_GNRC_RPL_NS
+#include "net/gnrc/rpl/ns.h"
+#endif
+#ifdef MODULE_GNRC_NETIF_ETX
+#include "net/gnrc/netif/etx.h"
+#endif
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
@@ -434,7 +440,22 @@ int _gnrc_rpl(int argc, char **argv)
         return _stats();
     }
 #endif
+#ifdef MODULE_GNRC_RPL_NS
+    else if (strcmp(argv[1], "routes") == 0) {
+        gnrc_rpl_ns_print();
+        return 0;
+    }
+#endif
+#ifdef MODULE_GNRC_NETIF_ETX
+    else if (strcmp(argv[1], "etx") == 0) {
+        gnrc_netif_etx_print();
+        return 0;
+    }
+#endif
 
+#ifdef MODULE_GNRC_NETIF_ETX
+    puts("* etx\t\t\t\t\t- show the ETX of the links to the neighbors");
+#endif
 #ifdef MODULE_GNRC_RPL_P2P
     puts("* find <dodag_id> <target>\t\t\t- initiate a P2P-RPL route discovery");
 #endif
@@ -447,6 +468,9 @@ int _gnrc_rpl(int argc, char **argv)
     puts("* rm <instance_id>\t\t\t- delete the given instance and related dodag");
     puts("* root <inst_id> <dodag_id>\t\t- add a dodag to a new or existing instance");
     puts("* router <instance_id>\t\t\t- operate as router in the instance");
+#ifdef MODULE_GNRC_RPL_NS
+    puts("* routes\t\t\t\t- show the non-storing mode routes of the root");
+#endif
     puts("* send dis\t\t\t\t- send a multicast DIS");
     puts("* send dis <VID_flags> <version> <instance_id> <dodag_id> - send a multicast DIS with SOL option");
 #ifndef GNRC_RPL_WITHOUT_PIO
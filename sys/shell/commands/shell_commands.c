@@ -84,6 +84,10 @@ extern int _random_init(int argc, char **argv);
 extern int _random_get(int argc, char **argv);
 #endif
 
+#ifdef MODULE_CRYPTO_BACKEND
+extern int _crypto_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_IPV6_NIB
 extern int _gnrc_ipv6_nib(int argc, char **argv);
 #endif
@@ -205,6 +209,9 @@ const shell_command_t _shell_command_list[] = {
     { "random_init", "initializes the PRNG", _random_init },
     { "random_get", "returns 32 bit of pseudo randomness", _random_get },
 #endif
+#ifdef MODULE_CRYPTO_BACKEND
+    { "crypto", "list and select cipher backends", _crypto_handler },
+#endif
 #ifdef MODULE_PERIPH_RTC
     {"rtc", "control RTC peripheral interface",  _rtc_handler},
 #endif
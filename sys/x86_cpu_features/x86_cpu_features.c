@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_x86_cpu_features
+ * @{
+ *
+ * @file
+ * @brief       x86 CPU feature implementation
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include "x86_cpu_features.h"
+
+/* set in _features once the CPU was probed */
+#define PROBED      (1U << 31)
+
+static unsigned _features;
+
+unsigned x86_cpu_features(void)
+{
+    unsigned features = _features;
+
+    if (!(features & PROBED)) {
+        /* racing callers get the same result, so there is no lock */
+        features = PROBED;
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse2")) {
+            features |= X86_CPU_FEATURE_SSE2;
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            features |= X86_CPU_FEATURE_SSE41;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            features |= X86_CPU_FEATURE_SSE42;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            features |= X86_CPU_FEATURE_AVX2;
+        }
+        if (__builtin_cpu_supports("aes")) {
+            features |= X86_CPU_FEATURE_AES;
+        }
+        if (__builtin_cpu_supports("pclmul")) {
+            features |= X86_CPU_FEATURE_PCLMUL;
+        }
+        if (__builtin_cpu_supports("sha")) {
+            features |= X86_CPU_FEATURE_SHA;
+        }
+        _features = features;
+    }
+    return features & ~PROBED;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of ChaCha20, Poly1305 and ChaCha20-Poly1305
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/chacha.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/poly1305.h"
+#include "xtimer.h"
+
+#ifndef BENCH_BYTES
+#define BENCH_BYTES         (256UL * 1024UL)
+#endif
+
+#define BUF_SIZE            (4096U)
+
+static const uint16_t _sizes[] = { 16, 64, 256, 1024, 4096 };
+static uint8_t _in[BUF_SIZE];
+static uint8_t _out[BUF_SIZE + CHACHA20POLY1305_TAG_BYTES];
+
+/* RFC 8439, section 2.8.2 */
+static const uint8_t _key[CHACHA20POLY1305_KEY_BYTES] = {
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f
+};
+static const uint8_t _nonce[CHACHA20POLY1305_NONCE_BYTES] = {
+    0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43,
+    0x44, 0x45, 0x46, 0x47
+};
+static const uint8_t _aad[] = {
+    0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7
+};
+static const char _plain[] =
+    "Ladies and Gentlemen of the class of '99: If I could offer you only "
+    "one tip for the future, sunscreen would be it.";
+/* the first and last bytes of the ciphertext and the tag */
+static const uint8_t _cipher_head[] = { 0xd3, 0x1a, 0x8d, 0x34 };
+static const uint8_t _cipher_tail[] = { 0x61, 0x16 };
+static const uint8_t _tag[CHACHA20POLY1305_TAG_BYTES] = {
+    0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a,
+    0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60, 0x06, 0x91
+};
+
+static void _print(const char *name, uint16_t size, uint32_t runs,
+                   uint32_t time)
+{
+    uint64_t bytes = (uint64_t)runs * size;
+
+    printf("%8s %4u byte: %8" PRIu32 "us --- %6" PRIu32 " KiB/s\n",
+           name, (unsigned)size, time,
+           (uint32_t)((bytes * US_PER_SEC) /
+                      ((uint64_t)(time ? time : 1) * 1024)));
+}
+
+static int _check_vector(void)
+{
+    const size_t len = sizeof(_plain) - 1;
+
+    chacha20poly1305_encrypt(_out, (const uint8_t *)_plain, len,
+                             _aad, sizeof(_aad), _key, _nonce);
+    if (memcmp(_out, _cipher_head, sizeof(_cipher_head)) ||
+        memcmp(_out + len - sizeof(_cipher_tail), _cipher_tail,
+               sizeof(_cipher_tail)) ||
+        memcmp(_out + len, _tag, sizeof(_tag))) {
+        return 1;
+    }
+    if (chacha20poly1305_decrypt(_out, len + sizeof(_tag), _in, _aad,
+                                 sizeof(_aad), _key, _nonce) ||
+        memcmp(_in, _plain, len)) {
+        return 1;
+    }
+    return 0;
+}
+
+static void _bench(uint16_t size)
+{
+    uint32_t runs = BENCH_BYTES / size;
+    uint32_t time;
+    chacha_ctx ctx;
+
+    chacha_init(&ctx, 20, _key, sizeof(_key), _nonce + 4);
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        chacha_keystream_blocks(&ctx, _out, (size + 63) / 64);
+    }
+    time = xtimer_now_usec() - time;
+    _print("chacha20", size, runs, time);
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        poly1305_auth(_out, _in, size, _key);
+    }
+    time = xtimer_now_usec() - time;
+    _print("poly1305", size, runs, time);
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        chacha20poly1305_encrypt(_out, _in, size, _aad, sizeof(_aad),
+                                 _key, _nonce);
+    }
+    time = xtimer_now_usec() - time;
+    _print("aead", size, runs, time);
+}
+
+int main(void)
+{
+#ifdef MODULE_CRYPTO_CHACHA_SIMD
+    printf("ChaCha20 eight blocks at once (if SSE2 or AVX2 are available)");
+#else
+    printf("ChaCha20 one block at a time");
+#endif
+    printf(", Poly1305 with %u bit limbs\n\n", POLY1305_64BIT ? 64 : 32);
+
+    if (_check_vector()) {
+        puts("error: wrong ciphertext");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < sizeof(_in); i++) {
+        _in[i] = i;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        _bench(_sizes[i]);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
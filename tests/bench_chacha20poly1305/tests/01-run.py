@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+BENCHMARK_REGEXP = (r"\s*{name}\s+{size} byte:\s+\d+us --- \s*\d+ KiB/s\r\n")
+
+
+def testfunc(child):
+    child.expect(r'ChaCha20 ')
+    for size in (16, 64, 256, 1024, 4096):
+        for name in ('chacha20', 'poly1305', 'aead'):
+            child.expect(BENCHMARK_REGEXP.format(name=name, size=size),
+                         timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
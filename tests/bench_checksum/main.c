@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of CRC16-CCITT, CRC-32 and CRC-32C
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "checksum/crc32.h"
+#include "xtimer.h"
+
+#ifndef BENCH_BYTES
+#define BENCH_BYTES         (256UL * 1024UL)
+#endif
+
+#define BUF_SIZE            (4096U)
+
+static const uint16_t _sizes[] = { 16, 64, 256, 1024, 4096 };
+static uint8_t _buf[BUF_SIZE];
+/* keeps the compiler from dropping the calls */
+static volatile uint32_t _sink;
+
+static void _print(const char *name, uint16_t size, uint32_t runs,
+                   uint32_t time)
+{
+    uint64_t bytes = (uint64_t)runs * size;
+
+    printf("%7s %4u byte: %8" PRIu32 "us --- %7" PRIu32 " KiB/s\n",
+           name, (unsigned)size, time,
+           (uint32_t)((bytes * US_PER_SEC) /
+                      ((uint64_t)(time ? time : 1) * 1024)));
+}
+
+static uint32_t _crc32_pieces(uint16_t size)
+{
+    uint16_t piece = size / 4;
+    uint32_t crc = crc32_calc(_buf, piece);
+
+    for (uint16_t offset = piece; offset < size; offset += piece) {
+        crc = crc32_combine(crc, crc32_calc(_buf + offset, piece), piece);
+    }
+    return crc;
+}
+
+static void _bench(uint16_t size)
+{
+    uint32_t runs = BENCH_BYTES / size;
+    uint32_t time;
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        _sink = crc16_ccitt_calc(_buf, size);
+    }
+    time = xtimer_now_usec() - time;
+    _print("crc16", size, runs, time);
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        _sink = crc32_calc(_buf, size);
+    }
+    time = xtimer_now_usec() - time;
+    _print("crc32", size, runs, time);
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        _sink = crc32c_calc(_buf, size);
+    }
+    time = xtimer_now_usec() - time;
+    _print("crc32c", size, runs, time);
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        _sink = _crc32_pieces(size);
+    }
+    time = xtimer_now_usec() - time;
+    _print("crc32x4", size, runs, time);
+}
+
+int main(void)
+{
+    static const char check[] = "123456789";
+
+#if defined(MODULE_CHECKSUM_CRC32_PCLMUL) || defined(MODULE_CHECKSUM_CRC32C_SSE42)
+    puts("CRC, x86 instructions (if available)\n");
+#else
+    puts("CRC, slicing-by-8 tables\n");
+#endif
+
+    if ((crc32_calc(check, sizeof(check) - 1) != 0xCBF43926) ||
+        (crc32c_calc(check, sizeof(check) - 1) != 0xE3069283)) {
+        puts("error: wrong check value");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        _buf[i] = i;
+    }
+    if (_crc32_pieces(BUF_SIZE) != crc32_calc(_buf, BUF_SIZE)) {
+        puts("error: wrong combined CRC");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        _bench(_sizes[i]);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
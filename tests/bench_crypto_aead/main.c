@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of AES-128 in CCM and GCM mode, in one call and
+ *              through the streaming interface
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/gcm.h"
+#include "xtimer.h"
+
+#ifndef BENCH_BYTES
+#define BENCH_BYTES         (256UL * 1024UL)
+#endif
+
+#define BUF_SIZE            (4096U)
+#define PIECE_SIZE          (64U)
+#define TAG_LEN             (16U)
+/* leaves 12 byte for the nonce, as with GCM */
+#define CCM_LEN_ENCODING    (3U)
+
+static const uint16_t _sizes[] = { 16, 256, 1024, 4096 };
+static const uint8_t _key[AES_KEY_SIZE] = {
+    0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+    0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08
+};
+static const uint8_t _nonce[12] = {
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+    0xde, 0xca, 0xf8, 0x88
+};
+static const uint8_t _aad[16] = { 0 };
+static uint8_t _in[BUF_SIZE];
+static uint8_t _out[BUF_SIZE + TAG_LEN];
+static cipher_t _cipher;
+
+static void _print(const char *name, uint16_t size, uint32_t runs,
+                   uint32_t time)
+{
+    uint64_t bytes = (uint64_t)runs * size;
+
+    printf("%7s %4u byte: %8" PRIu32 "us --- %6" PRIu32 " KiB/s\n",
+           name, (unsigned)size, time,
+           (uint32_t)((bytes * US_PER_SEC) /
+                      ((uint64_t)(time ? time : 1) * 1024)));
+}
+
+static void _ccm_stream(uint16_t size)
+{
+    cipher_ccm_ctx_t ctx;
+
+    cipher_ccm_init(&ctx, &_cipher, TAG_LEN, CCM_LEN_ENCODING, _nonce,
+                    sizeof(_nonce), sizeof(_aad), size);
+    cipher_ccm_update_aad(&ctx, _aad, sizeof(_aad));
+    for (unsigned offset = 0; offset < size; offset += PIECE_SIZE) {
+        unsigned len = size - offset;
+
+        len = len < PIECE_SIZE ? len : PIECE_SIZE;
+        cipher_ccm_encrypt_update(&ctx, _in + offset, len, _out + offset);
+    }
+    cipher_ccm_encrypt_finish(&ctx, _out + size);
+}
+
+static void _gcm_stream(uint16_t size)
+{
+    cipher_gcm_ctx_t ctx;
+
+    cipher_gcm_init(&ctx, &_cipher, _nonce, sizeof(_nonce));
+    cipher_gcm_update_aad(&ctx, _aad, sizeof(_aad));
+    for (unsigned offset = 0; offset < size; offset += PIECE_SIZE) {
+        unsigned len = size - offset;
+
+        len = len < PIECE_SIZE ? len : PIECE_SIZE;
+        cipher_gcm_encrypt_update(&ctx, _in + offset, len, _out + offset);
+    }
+    cipher_gcm_encrypt_finish(&ctx, _out + size, TAG_LEN);
+}
+
+static void _bench(uint16_t size)
+{
+    uint32_t runs = BENCH_BYTES / size;
+    uint32_t time;
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        cipher_encrypt_ccm(&_cipher, _aad, sizeof(_aad), TAG_LEN,
+                           CCM_LEN_ENCODING, _nonce, sizeof(_nonce), _in,
+                           size, _out);
+    }
+    time = xtimer_now_usec() - time;
+    _print("ccm", size, runs, time);
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        _ccm_stream(size);
+    }
+    time = xtimer_now_usec() - time;
+    _print("ccm-64", size, runs, time);
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        cipher_encrypt_gcm(&_cipher, _aad, sizeof(_aad), TAG_LEN, _nonce,
+                           sizeof(_nonce), _in, size, _out);
+    }
+    time = xtimer_now_usec() - time;
+    _print("gcm", size, runs, time);
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        _gcm_stream(size);
+    }
+    time = xtimer_now_usec() - time;
+    _print("gcm-64", size, runs, time);
+}
+
+int main(void)
+{
+    /* test case 4 of the GCM specification */
+    static const uint8_t aad[] = {
+        0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+        0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+        0xab, 0xad, 0xda, 0xd2
+    };
+    static const uint8_t plain[] = {
+        0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5,
+        0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+        0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda,
+        0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+        0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53,
+        0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+        0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57,
+        0xba, 0x63, 0x7b, 0x39
+    };
+    static const uint8_t tag[TAG_LEN] = {
+        0x5b, 0xc9, 0x4f, 0xbc, 0x32, 0x21, 0xa5, 0xdb,
+        0x94, 0xfa, 0xe9, 0x5a, 0xe7, 0x12, 0x1a, 0x47
+    };
+
+#if defined(MODULE_CRYPTO_AES_NI)
+    printf("AES-128 CCM and GCM, AES instructions (if available)");
+#elif defined(MODULE_CRYPTO_AES_CT)
+    printf("AES-128 CCM and GCM, bitsliced AES");
+#else
+    printf("AES-128 CCM and GCM, AES with T tables");
+#endif
+#ifdef MODULE_CRYPTO_GCM_PCLMUL
+    puts(", GHASH with carry-less multiply (if available)\n");
+#else
+    puts(", GHASH with 4-bit tables\n");
+#endif
+
+    if (cipher_init(&_cipher, CIPHER_AES_128, _key, AES_KEY_SIZE) != 1) {
+        puts("error: unable to initialize the cipher");
+        return 1;
+    }
+    if ((cipher_encrypt_gcm(&_cipher, aad, sizeof(aad), TAG_LEN, _nonce,
+                            sizeof(_nonce), plain, sizeof(plain),
+                            _out) != sizeof(plain) + TAG_LEN) ||
+        memcmp(_out + sizeof(plain), tag, TAG_LEN) != 0) {
+        puts("error: wrong tag");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        _in[i] = i;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        _bench(_sizes[i]);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures AES-128 encryption one block per call, several blocks
+ *              per call and in counter mode
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "cpu.h"
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/ctr.h"
+#include "xtimer.h"
+
+#ifndef BENCH_BYTES
+#define BENCH_BYTES         (256UL * 1024UL)
+#endif
+
+#define BUF_SIZE            (1024U)
+
+static const uint16_t _sizes[] = { 16, 64, 256, 1024 };
+static const uint8_t _key[AES_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static uint8_t _in[BUF_SIZE];
+static uint8_t _out[BUF_SIZE];
+static cipher_t _cipher;
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HAS_CYCLES          (1)
+static void _cycles_init(void)
+{
+}
+
+static inline uint64_t _cycles(void)
+{
+    return __builtin_ia32_rdtsc();
+}
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+#define HAS_CYCLES          (1)
+static void _cycles_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/* wraps after 2^32 cycles, keep BENCH_BYTES small on fast MCUs */
+static inline uint64_t _cycles(void)
+{
+    return DWT->CYCCNT;
+}
+#else
+#define HAS_CYCLES          (0)
+static void _cycles_init(void)
+{
+}
+
+static inline uint64_t _cycles(void)
+{
+    return 0;
+}
+#endif
+
+static void _print(const char *name, uint16_t size, uint32_t runs,
+                   uint32_t time, uint64_t cycles)
+{
+    uint64_t bytes = (uint64_t)runs * size;
+    uint64_t kib_per_sec = (bytes * US_PER_SEC) /
+                           ((uint64_t)(time ? time : 1) * 1024);
+
+    printf("%7s %4u byte: %8" PRIu32 "us --- %6" PRIu32 " KiB/s",
+           name, (unsigned)size, time, (uint32_t)kib_per_sec);
+    if (HAS_CYCLES) {
+        uint32_t per_10 = (uint32_t)((cycles * 10) / bytes);
+
+        printf(", %4" PRIu32 ".%" PRIu32 " cycles/byte", per_10 / 10,
+               per_10 % 10);
+    }
+    puts("");
+}
+
+static void _bench(uint16_t size)
+{
+    uint32_t runs = BENCH_BYTES / size;
+    unsigned nblocks = size / AES_BLOCK_SIZE;
+    uint32_t time;
+    uint64_t cycles;
+
+    /* one block per call, as the modes did */
+    time = xtimer_now_usec();
+    cycles = _cycles();
+    for (uint32_t i = 0; i < runs; i++) {
+        for (unsigned n = 0; n < nblocks; n++) {
+            cipher_encrypt(&_cipher, _in + n * AES_BLOCK_SIZE,
+                           _out + n * AES_BLOCK_SIZE);
+        }
+    }
+    cycles = _cycles() - cycles;
+    time = xtimer_now_usec() - time;
+    _print("block", size, runs, time, cycles);
+
+    time = xtimer_now_usec();
+    cycles = _cycles();
+    for (uint32_t i = 0; i < runs; i++) {
+        cipher_encrypt_blocks(&_cipher, _in, _out, nblocks);
+    }
+    cycles = _cycles() - cycles;
+    time = xtimer_now_usec() - time;
+    _print("blocks", size, runs, time, cycles);
+
+    time = xtimer_now_usec();
+    cycles = _cycles();
+    for (uint32_t i = 0; i < runs; i++) {
+        uint8_t nonce_counter[16] = { 0 };
+
+        cipher_encrypt_ctr(&_cipher, nonce_counter, 8, _in, size, _out);
+    }
+    cycles = _cycles() - cycles;
+    time = xtimer_now_usec() - time;
+    _print("ctr", size, runs, time, cycles);
+}
+
+int main(void)
+{
+    /* FIPS-197, appendix C.1 */
+    static const uint8_t plain[AES_BLOCK_SIZE] = {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+    };
+    static const uint8_t expected[AES_BLOCK_SIZE] = {
+        0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+        0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+    };
+
+#if defined(MODULE_CRYPTO_AES_NI)
+    puts("AES-128 encryption with the AES instructions (if available)\n");
+#elif defined(MODULE_CRYPTO_AES_CT)
+    puts("AES-128 encryption, bitsliced\n");
+#else
+    puts("AES-128 encryption with T tables\n");
+#endif
+
+    _cycles_init();
+    if (cipher_init(&_cipher, CIPHER_AES_128, _key, AES_KEY_SIZE) != 1) {
+        puts("error: unable to initialize the cipher");
+        return 1;
+    }
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        _in[i] = plain[i % AES_BLOCK_SIZE];
+    }
+    cipher_encrypt_blocks(&_cipher, _in, _out, BUF_SIZE / AES_BLOCK_SIZE);
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        if (_out[i] != expected[i % AES_BLOCK_SIZE]) {
+            puts("error: wrong ciphertext");
+            return 1;
+        }
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        _bench(_sizes[i]);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the rate of QoS 1 publications with emCute, one by one
+ *              and batched
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/emcute.h"
+#include "net/ipv6/addr.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_MSGS
+#define BENCH_MSGS          (500U)
+#endif
+
+/* each message starts with its sequence number */
+#ifndef BENCH_MSG_SIZE
+#define BENCH_MSG_SIZE      (8U)
+#endif
+
+#define BENCH_PORT          (1883U)
+#define BENCH_ID            ("bench")
+#define BENCH_PRIO          (THREAD_PRIORITY_MAIN - 1)
+
+typedef int (*_pub_t)(emcute_topic_t *topic, const void *buf, size_t len,
+                      unsigned flags);
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+static void *_emcute_thread(void *arg)
+{
+    (void)arg;
+    emcute_run(BENCH_PORT, BENCH_ID);
+    return NULL;    /* should never be reached */
+}
+
+static void _bench(const char *name, _pub_t pub)
+{
+    emcute_topic_t topic;
+    char topic_name[16];
+    uint8_t msg[BENCH_MSG_SIZE];
+    unsigned errors = 0;
+    uint32_t time;
+
+    snprintf(topic_name, sizeof(topic_name), "bench/%s", name);
+    topic.name = topic_name;
+    if (emcute_reg(&topic) != EMCUTE_OK) {
+        printf("error: unable to register %s\n", topic_name);
+        return;
+    }
+
+    memset(msg, 0, sizeof(msg));
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < BENCH_MSGS; i++) {
+        network_uint32_t seq = byteorder_htonl(i);
+
+        memcpy(msg, &seq, sizeof(seq));
+        if (pub(&topic, msg, sizeof(msg), EMCUTE_QOS_1) != EMCUTE_OK) {
+            errors++;
+        }
+    }
+    if (emcute_pub_flush() != EMCUTE_OK) {
+        errors++;
+    }
+    time = xtimer_now_usec() - time;
+
+    printf("%6s: %u messages in %8" PRIu32 " us, %6" PRIu32 " messages/s, "
+           "%u errors\n", name, BENCH_MSGS, time,
+           (uint32_t)(((uint64_t)BENCH_MSGS * US_PER_SEC) / (time ? time : 1)),
+           errors);
+}
+
+static int _cmd_bench(int argc, char **argv)
+{
+    sock_udp_ep_t gw = { .family = AF_INET6 };
+
+    if (argc < 3) {
+        printf("usage: %s <gateway addr> <port>\n", argv[0]);
+        return 1;
+    }
+    if (ipv6_addr_from_str((ipv6_addr_t *)&gw.addr.ipv6, argv[1]) == NULL) {
+        puts("error: unable to parse the gateway address");
+        return 1;
+    }
+    gw.port = atoi(argv[2]);
+    if (emcute_con(&gw, true, NULL, NULL, 0, 0) != EMCUTE_OK) {
+        puts("error: unable to connect to the gateway");
+        return 1;
+    }
+
+    printf("emcute publish: window %u, %u messages of %u byte\n",
+           EMCUTE_PUB_WINDOW, BENCH_MSGS, BENCH_MSG_SIZE);
+    _bench("pub", emcute_pub);
+    _bench("batch", emcute_pub_batch);
+    emcute_discon();
+    puts("[SUCCESS]");
+    return 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "bench", "publish to a gateway", _cmd_bench },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    thread_create(_stack, sizeof(_stack), BENCH_PRIO, 0, _emcute_thread, NULL,
+                  "emcute");
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+# Runs a minimal MQTT-SN gateway on the host that acknowledges the node's
+# messages after DELAY_MS, and checks that every message published by the
+# node arrived.
+
+import heapq
+import os
+import re
+import select
+import socket
+import subprocess
+import sys
+import threading
+import time
+
+from testrunner import run
+
+TAP = os.environ.get("PORT", "tap0")
+GW_PORT = int(os.environ.get("EMCUTE_GW_PORT", 1885))
+NMSG = int(os.environ.get("EMCUTE_NMSG", 500))
+MSG_SIZE = int(os.environ.get("EMCUTE_MSG_SIZE", 8))
+DELAY_MS = float(os.environ.get("DELAY_MS", 10))
+TIMEOUT = 300
+
+CONNECT = 0x04
+CONNACK = 0x05
+REGISTER = 0x0a
+REGACK = 0x0b
+PUBLISH = 0x0c
+PUBACK = 0x0d
+PINGREQ = 0x16
+PINGRESP = 0x17
+DISCONNECT = 0x18
+QOS_1 = 0x20
+
+
+class Gateway(threading.Thread):
+    """Answers CONNECT, REGISTER, PUBLISH, PINGREQ and DISCONNECT, and
+    collects the sequence numbers of the messages published per topic."""
+
+    def __init__(self):
+        super().__init__(daemon=True)
+        self.sock = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+        self.sock.bind(("::", GW_PORT))
+        self.pending = []
+        self.count = 0
+        self.topics = {}
+        self.received = {}
+        self.running = True
+
+    def send(self, data, addr):
+        # a counter keeps equal due times in order
+        self.count += 1
+        heapq.heappush(self.pending, (time.monotonic() + DELAY_MS / 1000,
+                                      self.count, bytes(data), addr))
+
+    def handle(self, buf, addr):
+        pos = 3 if buf[0] == 0x01 else 1
+        msg_type = buf[pos]
+        if msg_type == CONNECT:
+            self.send([3, CONNACK, 0], addr)
+        elif msg_type == REGISTER:
+            name = buf[pos + 5:].decode()
+            tid = self.topics.setdefault(name, len(self.topics) + 1)
+            self.received.setdefault(name, set())
+            self.send([7, REGACK, tid >> 8, tid & 0xff] +
+                      list(buf[pos + 3:pos + 5]) + [0], addr)
+        elif msg_type == PUBLISH:
+            flags = buf[pos + 1]
+            tid = int.from_bytes(buf[pos + 2:pos + 4], "big")
+            data = buf[pos + 6:]
+            name = next(n for n, t in self.topics.items() if t == tid)
+            for i in range(0, len(data) - MSG_SIZE + 1, MSG_SIZE):
+                self.received[name].add(int.from_bytes(data[i:i + 4], "big"))
+            if flags & QOS_1:
+                self.send([7, PUBACK] + list(buf[pos + 2:pos + 6]) + [0],
+                          addr)
+        elif msg_type == PINGREQ:
+            self.send([2, PINGRESP], addr)
+        elif msg_type == DISCONNECT:
+            self.send([2, DISCONNECT], addr)
+
+    def run(self):
+        while self.running:
+            timeout = 0.1
+            if self.pending:
+                timeout = max(0, self.pending[0][0] - time.monotonic())
+            if select.select([self.sock], [], [], timeout)[0]:
+                buf, addr = self.sock.recvfrom(2048)
+                self.handle(buf, addr)
+            while self.pending and self.pending[0][0] <= time.monotonic():
+                _, _, data, addr = heapq.heappop(self.pending)
+                self.sock.sendto(data, addr)
+
+    def stop(self):
+        self.running = False
+        self.join()
+        self.sock.close()
+
+
+def host_addr():
+    out = subprocess.check_output(["ip", "-6", "addr", "show", "dev", TAP,
+                                   "scope", "link"]).decode()
+    return re.search(r"inet6 ([0-9a-f:]+)/", out).group(1)
+
+
+def testfunc(child):
+    gateway = Gateway()
+    gateway.start()
+    try:
+        child.sendline("bench {} {}".format(host_addr(), GW_PORT))
+        child.expect(r"emcute publish: window (\d+), \d+ messages of \d+ byte")
+        window = int(child.match.group(1))
+        for name in ("pub", "batch"):
+            child.expect(r"\s*{}: \d+ messages in\s+\d+ us,\s+(\d+) messages/s,"
+                         r" (\d+) errors".format(name), timeout=TIMEOUT)
+            assert int(child.match.group(2)) == 0
+            print("{{ \"mode\": \"{}\", \"window\": {}, \"delay_ms\": {}, "
+                  "\"msg_per_sec\": {} }}".format(name, window, DELAY_MS,
+                                                  child.match.group(1)))
+        child.expect_exact("[SUCCESS]")
+    finally:
+        gateway.stop()
+    for name in ("bench/pub", "bench/batch"):
+        assert len(gateway.received[name]) == NMSG
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=TIMEOUT))
@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of block-wise transfers with gcoap, for several
+ *              clients at once over the loopback address
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+/* size of the representation every client transfers */
+#ifndef BENCH_SIZE
+#define BENCH_SIZE          (64UL * 1024UL)
+#endif
+
+#ifndef BENCH_CLIENTS
+#define BENCH_CLIENTS       (4U)
+#endif
+
+/* requests for blocks a client sends before it waits for a response */
+#ifndef BENCH_WINDOW
+#define BENCH_WINDOW        (4U)
+#endif
+
+#define BENCH_PORT          (6000U)
+#define BENCH_TIMEOUT       (100U * US_PER_MS)
+#define BENCH_RETRIES_MAX   (100U)
+#define BLOCK_SZX           (NANOCOAP_BLOCK_SIZE_EXP_MAX - 4)
+#define BLOCK_SIZE          (1UL << NANOCOAP_BLOCK_SIZE_EXP_MAX)
+#define BLOCKS              ((BENCH_SIZE + BLOCK_SIZE - 1) / BLOCK_SIZE)
+
+typedef struct {
+    sock_udp_t sock;
+    unsigned next;                  /**< next block to request or send */
+    unsigned done;                  /**< blocks received or acknowledged */
+    uint8_t got[(BLOCKS + 7) / 8];  /**< blocks received */
+} _client_t;
+
+typedef struct {
+    size_t written;                 /**< bytes written in order */
+    unsigned errors;                /**< blocks with unexpected content */
+} _upload_t;
+
+static ssize_t _read(void *ctx, size_t offset, uint8_t *buf, size_t len);
+static int _write(void *ctx, size_t offset, const uint8_t *buf, size_t len,
+                  bool more);
+
+static const gcoap_block_resource_t _file = {
+    .read = _read,
+    .format = COAP_FORMAT_OCTET,
+};
+static _upload_t _uploads[BENCH_CLIENTS];
+static gcoap_block_resource_t _up[BENCH_CLIENTS];
+static char _up_paths[BENCH_CLIENTS][8];
+
+/* ordered by path */
+static coap_resource_t _resources[1 + BENCH_CLIENTS] = {
+    { "/file", COAP_GET, gcoap_block_handler, (void *)&_file },
+};
+static gcoap_listener_t _listener = {
+    .resources = _resources,
+    .resources_len = ARRAY_SIZE(_resources),
+    .next = NULL
+};
+
+static _client_t _clients[BENCH_CLIENTS];
+static sock_udp_ep_t _server = {
+    .family = AF_INET6,
+    .netif = SOCK_ADDR_ANY_NETIF,
+    .port = GCOAP_PORT
+};
+static uint8_t _buf[GCOAP_PDU_BUF_SIZE];
+static uint16_t _msgid;
+
+static inline uint8_t _pattern(size_t offset)
+{
+    return (uint8_t)((offset * 31) ^ (offset >> 8));
+}
+
+static ssize_t _read(void *ctx, size_t offset, uint8_t *buf, size_t len)
+{
+    (void)ctx;
+    if (offset >= BENCH_SIZE) {
+        return 0;
+    }
+    if (len > BENCH_SIZE - offset) {
+        len = BENCH_SIZE - offset;
+    }
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = _pattern(offset + i);
+    }
+    return len;
+}
+
+static int _write(void *ctx, size_t offset, const uint8_t *buf, size_t len,
+                  bool more)
+{
+    _upload_t *upload = ctx;
+    (void)more;
+
+    /* the response to the last block was lost, acknowledge it again */
+    if ((offset < upload->written) && (offset + len == upload->written)) {
+        return 0;
+    }
+    if (offset != upload->written) {
+        return -EINVAL;
+    }
+    if (offset + len > BENCH_SIZE) {
+        return -ENOSPC;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != _pattern(offset + i)) {
+            upload->errors++;
+            break;
+        }
+    }
+    upload->written += len;
+    return 0;
+}
+
+static bool _has_block(_client_t *client, unsigned blknum)
+{
+    return client->got[blknum / 8] & (1 << (blknum % 8));
+}
+
+/* sends a request for block blknum of client c, with a payload for a PUT */
+static void _send(unsigned c, unsigned method, unsigned blknum)
+{
+    _client_t *client = &_clients[c];
+    uint8_t token = c;
+    coap_pkt_t pdu;
+    size_t payload_len = 0;
+    ssize_t len;
+
+    len = coap_build_hdr((coap_hdr_t *)_buf, COAP_TYPE_NON, &token, 1, method,
+                         _msgid++);
+    coap_pkt_init(&pdu, _buf, sizeof(_buf), len);
+    if (method == COAP_METHOD_GET) {
+        coap_opt_add_string(&pdu, COAP_OPT_URI_PATH, "/file", '/');
+        coap_opt_add_uint(&pdu, COAP_OPT_BLOCK2, (blknum << 4) | BLOCK_SZX);
+        len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+    }
+    else {
+        size_t offset = blknum * BLOCK_SIZE;
+        bool more = (blknum + 1 < BLOCKS);
+
+        payload_len = more ? BLOCK_SIZE : BENCH_SIZE - offset;
+        coap_opt_add_string(&pdu, COAP_OPT_URI_PATH, _up_paths[c], '/');
+        coap_opt_add_uint(&pdu, COAP_OPT_BLOCK1,
+                          (blknum << 4) | (more ? 0x8 : 0) | BLOCK_SZX);
+        len = coap_opt_finish(&pdu, COAP_OPT_FINISH_PAYLOAD);
+        _read(NULL, offset, pdu.payload, payload_len);
+    }
+    sock_udp_send(&client->sock, _buf, len + payload_len, &_server);
+}
+
+/* handles a response for client c, returns false if it was unexpected */
+static bool _recv(unsigned c, unsigned method, ssize_t len)
+{
+    _client_t *client = &_clients[c];
+    coap_pkt_t pdu;
+    uint32_t blknum;
+    unsigned szx;
+
+    if (coap_parse(&pdu, _buf, len) < 0) {
+        return false;
+    }
+    if (method == COAP_METHOD_GET) {
+        if ((coap_get_code_raw(&pdu) != COAP_CODE_CONTENT) ||
+            (coap_get_blockopt(&pdu, COAP_OPT_BLOCK2, &blknum, &szx) < 0) ||
+            (szx != BLOCK_SZX) || (blknum >= BLOCKS)) {
+            return false;
+        }
+        size_t offset = blknum * BLOCK_SIZE;
+        for (unsigned i = 0; i < pdu.payload_len; i++) {
+            if (pdu.payload[i] != _pattern(offset + i)) {
+                return false;
+            }
+        }
+        if (!_has_block(client, blknum)) {
+            client->got[blknum / 8] |= (1 << (blknum % 8));
+            client->done++;
+        }
+        /* keep the window full */
+        if (client->next < BLOCKS) {
+            _send(c, method, client->next++);
+        }
+    }
+    else {
+        unsigned code = coap_get_code_raw(&pdu);
+
+        if (((code != COAP_CODE_CONTINUE) && (code != COAP_CODE_CHANGED)) ||
+            (coap_get_blockopt(&pdu, COAP_OPT_BLOCK1, &blknum, &szx) < 0)) {
+            return false;
+        }
+        /* blocks are written in order, one at a time */
+        if (blknum == client->done) {
+            client->done++;
+            client->next = client->done;
+            if (client->next < BLOCKS) {
+                _send(c, method, client->next);
+            }
+        }
+    }
+    return true;
+}
+
+static void _bench(const char *name, unsigned method, unsigned window)
+{
+    unsigned remaining = BENCH_CLIENTS * BLOCKS;
+    unsigned retries = 0, errors = 0;
+    uint32_t start, last;
+
+    memset(_uploads, 0, sizeof(_uploads));
+    start = xtimer_now_usec();
+    for (unsigned c = 0; c < BENCH_CLIENTS; c++) {
+        _client_t *client = &_clients[c];
+
+        client->next = 0;
+        client->done = 0;
+        memset(client->got, 0, sizeof(client->got));
+        while ((client->next < window) && (client->next < BLOCKS)) {
+            _send(c, method, client->next++);
+        }
+    }
+
+    last = start;
+    while ((remaining > 0) && (retries <= BENCH_RETRIES_MAX)) {
+        bool progress = false;
+
+        for (unsigned c = 0; c < BENCH_CLIENTS; c++) {
+            _client_t *client = &_clients[c];
+            unsigned done = client->done;
+            ssize_t len = sock_udp_recv(&client->sock, _buf, sizeof(_buf), 0,
+                                        NULL);
+
+            if (len <= 0) {
+                continue;
+            }
+            if (!_recv(c, method, len)) {
+                errors++;
+            }
+            remaining -= client->done - done;
+            progress = true;
+        }
+        if (progress) {
+            last = xtimer_now_usec();
+        }
+        else if (xtimer_now_usec() - last > BENCH_TIMEOUT) {
+            /* ask again for the first block that is missing */
+            for (unsigned c = 0; c < BENCH_CLIENTS; c++) {
+                _client_t *client = &_clients[c];
+                unsigned blknum = client->done;
+
+                if (method == COAP_METHOD_GET) {
+                    for (blknum = 0; blknum < BLOCKS; blknum++) {
+                        if (!_has_block(client, blknum)) {
+                            break;
+                        }
+                    }
+                }
+                if (blknum < BLOCKS) {
+                    _send(c, method, blknum);
+                    retries++;
+                }
+            }
+            last = xtimer_now_usec();
+        }
+    }
+
+    uint32_t time = xtimer_now_usec() - start;
+    uint64_t bytes = (uint64_t)(BENCH_CLIENTS * BLOCKS - remaining) *
+                     BLOCK_SIZE;
+
+    if (method != COAP_METHOD_GET) {
+        for (unsigned c = 0; c < BENCH_CLIENTS; c++) {
+            if (_uploads[c].written != BENCH_SIZE) {
+                errors++;
+            }
+            errors += _uploads[c].errors;
+        }
+    }
+    printf("%s window %u: %u x %lu byte in %8" PRIu32 " us, %6" PRIu32
+           " KiB/s, %u retries, %u errors, %u blocks missing\n", name, window,
+           BENCH_CLIENTS, (unsigned long)BENCH_SIZE, time,
+           (uint32_t)((bytes * US_PER_SEC) / ((uint64_t)(time ? time : 1) * 1024)),
+           retries, errors, remaining);
+}
+
+int main(void)
+{
+    for (unsigned c = 0; c < BENCH_CLIENTS; c++) {
+        sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+
+        snprintf(_up_paths[c], sizeof(_up_paths[c]), "/up/%u", c);
+        _up[c].write = _write;
+        _up[c].format = COAP_FORMAT_NONE;
+        _up[c].ctx = &_uploads[c];
+        _resources[1 + c].path = _up_paths[c];
+        _resources[1 + c].methods = COAP_PUT;
+        _resources[1 + c].handler = gcoap_block_handler;
+        _resources[1 + c].context = &_up[c];
+
+        local.port = BENCH_PORT + c;
+        if (sock_udp_create(&_clients[c].sock, &local, NULL, 0) < 0) {
+            puts("error: unable to create sock");
+            return 1;
+        }
+    }
+    gcoap_register_listener(&_listener);
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+
+    printf("gcoap block-wise: %lu byte, %lu byte blocks, %u clients, "
+           "window %u\n", (unsigned long)BENCH_SIZE, (unsigned long)BLOCK_SIZE,
+           BENCH_CLIENTS, BENCH_WINDOW);
+    _bench("get", COAP_METHOD_GET, 1);
+    _bench("get", COAP_METHOD_GET, BENCH_WINDOW);
+    _bench("put", COAP_METHOD_PUT, 1);
+    puts("[SUCCESS]");
+    return 0;
+}
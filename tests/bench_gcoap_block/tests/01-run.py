@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+RESULT_REGEXP = (r"{name} window \d+: \d+ x \d+ byte in\s+\d+ us,\s+\d+ KiB/s, "
+                 r"\d+ retries, (\d+) errors, (\d+) blocks missing")
+
+
+def testfunc(child):
+    child.expect(r"gcoap block-wise: \d+ byte, \d+ byte blocks, \d+ clients, "
+                 r"window \d+")
+    for name in ("get", "get", "put"):
+        child.expect(RESULT_REGEXP.format(name=name), timeout=TIMEOUT)
+        assert int(child.match.group(1)) == 0
+        assert int(child.match.group(2)) == 0
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
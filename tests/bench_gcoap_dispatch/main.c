@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Load generator for gcoap: measures the request rate for many
+ *              resources and registers many Observe clients over the loopback
+ *              address
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+/* resources the server provides, all in one listener */
+#ifndef BENCH_RESOURCES
+#define BENCH_RESOURCES     (128U)
+#endif
+
+/* requests sent one after another, each to the next resource */
+#ifndef BENCH_REQUESTS
+#define BENCH_REQUESTS      (4096U)
+#endif
+
+/* clients, each observing one resource from its own port */
+#ifndef BENCH_OBSERVERS
+#define BENCH_OBSERVERS     (64U)
+#endif
+
+#define BENCH_PORT          (6000U)
+#define BENCH_TIMEOUT       (100U * US_PER_MS)
+#define BENCH_PATH_LEN      (8U)
+
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, void *ctx);
+
+static char _paths[BENCH_RESOURCES][BENCH_PATH_LEN];
+static coap_resource_t _resources[BENCH_RESOURCES];
+static gcoap_listener_t _listener = {
+    .resources = _resources,
+    .resources_len = BENCH_RESOURCES,
+    .next = NULL
+};
+
+/* tables for all clients, the built-in ones are sized for a small node */
+static gcoap_request_memo_t _open_reqs[GCOAP_REQ_WAITING_MAX];
+static sock_udp_ep_t _observers[BENCH_OBSERVERS];
+static gcoap_observe_memo_t _observe_memos[BENCH_OBSERVERS];
+static const gcoap_pools_t _pools = {
+    .open_reqs = _open_reqs,
+    .open_reqs_numof = ARRAY_SIZE(_open_reqs),
+    .observers = _observers,
+    .observers_numof = ARRAY_SIZE(_observers),
+    .observe_memos = _observe_memos,
+    .observe_memos_numof = ARRAY_SIZE(_observe_memos),
+};
+
+static sock_udp_t _socks[BENCH_OBSERVERS];
+static sock_udp_ep_t _server = {
+    .family = AF_INET6,
+    .netif = SOCK_ADDR_ANY_NETIF,
+    .port = GCOAP_PORT
+};
+static uint8_t _buf[GCOAP_PDU_BUF_SIZE];
+
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, void *ctx)
+{
+    (void)ctx;
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    return gcoap_finish(pdu, 0, COAP_FORMAT_NONE);
+}
+
+/* the paths must be sorted within the listener, "/r/000" to "/r/127" are */
+static void _resources_init(void)
+{
+    for (unsigned i = 0; i < BENCH_RESOURCES; i++) {
+        snprintf(_paths[i], sizeof(_paths[i]), "/r/%03u", i);
+        _resources[i].path = _paths[i];
+        _resources[i].methods = COAP_GET;
+        _resources[i].handler = _handler;
+        _resources[i].context = NULL;
+    }
+}
+
+/* builds a GET for resource i with the token of client c, and an Observe
+ * option unless observe is negative */
+static ssize_t _build_get(unsigned c, unsigned i, int observe)
+{
+    coap_pkt_t pdu;
+    uint8_t token[4];
+    ssize_t hdrlen;
+
+    memcpy(token, &c, sizeof(token));
+    hdrlen = coap_build_hdr((coap_hdr_t *)_buf, COAP_TYPE_NON, token,
+                            sizeof(token), COAP_METHOD_GET, (uint16_t)i);
+    if (hdrlen < 0) {
+        return hdrlen;
+    }
+    coap_pkt_init(&pdu, _buf, sizeof(_buf), hdrlen);
+    if (observe >= 0) {
+        coap_opt_add_uint(&pdu, COAP_OPT_OBSERVE, observe);
+    }
+    coap_opt_add_string(&pdu, COAP_OPT_URI_PATH, _paths[i], '/');
+    return coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+}
+
+/* sends a request from client c and returns the response code, or 0 on
+ * timeout */
+static unsigned _request(unsigned c, ssize_t len, bool *observed)
+{
+    coap_pkt_t pdu;
+
+    if ((len < 0) || (sock_udp_send(&_socks[c], _buf, len, &_server) < 0)) {
+        return 0;
+    }
+    len = sock_udp_recv(&_socks[c], _buf, sizeof(_buf), BENCH_TIMEOUT, NULL);
+    if ((len <= 0) || (coap_parse(&pdu, _buf, len) < 0)) {
+        return 0;
+    }
+    if (observed) {
+        *observed = coap_has_observe(&pdu);
+    }
+    return coap_get_code_raw(&pdu);
+}
+
+static void _bench_requests(void)
+{
+    unsigned answered = 0;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned n = 0; n < BENCH_REQUESTS; n++) {
+        unsigned i = n % BENCH_RESOURCES;
+
+        if (_request(0, _build_get(0, i, -1), NULL) == COAP_CODE_CONTENT) {
+            answered++;
+        }
+    }
+
+    uint32_t time = xtimer_now_usec() - start;
+
+    printf("requests: %u/%u answered in %" PRIu32 " us, %" PRIu32
+           " requests/s\n", answered, BENCH_REQUESTS, time,
+           (uint32_t)(((uint64_t)answered * US_PER_SEC) / (time ? time : 1)));
+}
+
+/* client c observes resource c */
+static void _bench_observe(const char *name)
+{
+    unsigned registered = 0, notified = 0;
+
+    for (unsigned c = 0; c < BENCH_OBSERVERS; c++) {
+        bool observed = false;
+
+        _request(c, _build_get(c, c, COAP_OBS_REGISTER), &observed);
+        if (observed) {
+            registered++;
+        }
+    }
+
+    for (unsigned c = 0; c < BENCH_OBSERVERS; c++) {
+        coap_pkt_t pdu;
+
+        if (gcoap_obs_init(&pdu, _buf, sizeof(_buf),
+                           &_resources[c]) == GCOAP_OBS_INIT_OK) {
+            ssize_t len = gcoap_finish(&pdu, 0, COAP_FORMAT_NONE);
+
+            if (len > 0) {
+                gcoap_obs_send(_buf, len, &_resources[c]);
+            }
+        }
+    }
+    for (unsigned c = 0; c < BENCH_OBSERVERS; c++) {
+        ssize_t len = sock_udp_recv(&_socks[c], _buf, sizeof(_buf),
+                                    BENCH_TIMEOUT / 10, NULL);
+        coap_pkt_t pdu;
+
+        if ((len > 0) && (coap_parse(&pdu, _buf, len) == 0) &&
+            coap_has_observe(&pdu)) {
+            notified++;
+        }
+    }
+
+    for (unsigned c = 0; c < BENCH_OBSERVERS; c++) {
+        _request(c, _build_get(c, c, COAP_OBS_DEREGISTER), NULL);
+    }
+
+    printf("observe %s: %u/%u registered, %u/%u notified\n", name,
+           registered, BENCH_OBSERVERS, notified, BENCH_OBSERVERS);
+}
+
+int main(void)
+{
+    _resources_init();
+    gcoap_register_listener(&_listener);
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+
+    for (unsigned c = 0; c < BENCH_OBSERVERS; c++) {
+        sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+
+        local.port = BENCH_PORT + c;
+        if (sock_udp_create(&_socks[c], &local, NULL, 0) < 0) {
+            puts("error: unable to create sock");
+            return 1;
+        }
+    }
+
+    printf("gcoap dispatch: %u resources, index of %u entries\n",
+           BENCH_RESOURCES, GCOAP_RESOURCE_INDEX_SIZE);
+    _bench_requests();
+    _bench_observe("built-in tables");
+    if (gcoap_set_pools(&_pools) != 0) {
+        puts("error: unable to set the tables");
+        return 1;
+    }
+    _bench_observe("larger tables");
+    puts("[SUCCESS]");
+    return 0;
+}
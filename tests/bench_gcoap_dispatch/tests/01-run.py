@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def _observe(child, name):
+    child.expect(r"observe {}: (\d+)/(\d+) registered, "
+                 r"(\d+)/(\d+) notified".format(name))
+    return [int(child.match.group(i)) for i in range(1, 5)]
+
+
+def testfunc(child):
+    child.expect(r"gcoap dispatch: \d+ resources, index of \d+ entries")
+    child.expect(r"requests: (\d+)/(\d+) answered in \d+ us, "
+                 r"\d+ requests/s")
+    assert child.match.group(1) == child.match.group(2)
+    registered, clients, notified, _ = _observe(child, "built-in tables")
+    # the built-in tables only hold a few clients
+    assert registered < clients
+    assert notified == registered
+    registered, clients, notified, _ = _observe(child, "larger tables")
+    assert registered == clients
+    assert notified == clients
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
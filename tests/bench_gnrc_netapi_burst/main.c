@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the rate of UDP packets received through gnrc_netif,
+ *              gnrc_ipv6 and gnrc_udp, and the context switches per packet,
+ *              when a device reports several frames per interrupt
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/ethernet.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/udp.h"
+#include "sched.h"
+#include "thread.h"
+#include "xtimer.h"
+
+/* interrupts, each reporting a number of frames */
+#ifndef BENCH_ISRS
+#define BENCH_ISRS          (2000U)
+#endif
+
+#ifndef BENCH_PAYLOAD
+#define BENCH_PAYLOAD       (32U)
+#endif
+
+#define BENCH_PORT          (5683U)
+#define FRAME_LEN           (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) + \
+                             sizeof(udp_hdr_t) + BENCH_PAYLOAD)
+#define QUEUE_SIZE          (32U)
+
+static const uint8_t _dev_addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const uint8_t _src_addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+static netdev_test_t _dev;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static char _listener_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _listener_queue[QUEUE_SIZE];
+static gnrc_netreg_entry_t _listener_entry;
+static uint8_t _frame[FRAME_LEN];
+static unsigned _frames_per_isr;
+static volatile uint32_t _received;
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len >= sizeof(_dev_addr));
+    memcpy(value, _dev_addr, sizeof(_dev_addr));
+    return sizeof(_dev_addr);
+}
+
+/* the device drains a receive ring of _frames_per_isr frames */
+static void _dev_isr(netdev_t *dev)
+{
+    for (unsigned i = 0; i < _frames_per_isr; i++) {
+        dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+    }
+}
+
+static int _dev_recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return sizeof(_frame);
+    }
+    if (len < (int)sizeof(_frame)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, sizeof(_frame));
+    return sizeof(_frame);
+}
+
+/* router and neighbor solicitations go nowhere */
+static int _dev_send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    return iolist_size(iolist);
+}
+
+static void *_listener(void *arg)
+{
+    (void)arg;
+    msg_init_queue(_listener_queue, QUEUE_SIZE);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+            _received++;
+        }
+    }
+    return NULL;
+}
+
+/* a UDP packet from fe80::1 to the link-local address of the interface */
+static void _frame_init(const ipv6_addr_t *dst)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+    uint8_t *payload = (uint8_t *)(udp + 1);
+    uint16_t len = sizeof(udp_hdr_t) + BENCH_PAYLOAD;
+    uint16_t csum;
+
+    memcpy(eth->dst, _dev_addr, sizeof(eth->dst));
+    memcpy(eth->src, _src_addr, sizeof(eth->src));
+    eth->type = byteorder_htons(ETHERTYPE_IPV6);
+
+    memset(ipv6, 0, sizeof(*ipv6));
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(len);
+    ipv6->nh = PROTNUM_UDP;
+    ipv6->hl = 64;
+    ipv6_addr_set_link_local_prefix(&ipv6->src);
+    ipv6->src.u8[15] = 1;
+    ipv6->dst = *dst;
+
+    udp->src_port = byteorder_htons(BENCH_PORT);
+    udp->dst_port = byteorder_htons(BENCH_PORT);
+    udp->length = byteorder_htons(len);
+    udp->checksum = byteorder_htons(0);
+    for (unsigned i = 0; i < BENCH_PAYLOAD; i++) {
+        payload[i] = i;
+    }
+    csum = ipv6_hdr_inet_csum(0, ipv6, PROTNUM_UDP, len);
+    csum = ~inet_csum(csum, (uint8_t *)udp, len);
+    udp->checksum = byteorder_htons(csum ? csum : 0xffff);
+}
+
+static unsigned _schedules(void)
+{
+    unsigned schedules = 0;
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        schedules += sched_pidlist[pid].schedules;
+    }
+    return schedules;
+}
+
+static void _run(unsigned frames_per_isr)
+{
+    uint32_t sent = BENCH_ISRS * frames_per_isr;
+    uint32_t time;
+    unsigned schedules;
+
+    _frames_per_isr = frames_per_isr;
+    _received = 0;
+    schedules = _schedules();
+    time = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_ISRS; i++) {
+        /* the stack runs at a higher priority and is done on return */
+        _dev.netdev.event_callback(&_dev.netdev, NETDEV_EVENT_ISR);
+    }
+    time = xtimer_now_usec() - time;
+    schedules = _schedules() - schedules;
+
+    uint32_t per_100 = (uint32_t)(((uint64_t)schedules * 100) /
+                                  (_received ? _received : 1));
+
+    printf("%2u frames per interrupt: %6" PRIu32 "/%6" PRIu32 " received in %8"
+           PRIu32 " us, %7" PRIu32 " packets/s, %2" PRIu32 ".%02" PRIu32
+           " context switches per packet\n", frames_per_isr, _received, sent,
+           time, (uint32_t)(((uint64_t)_received * US_PER_SEC) / (time ? time : 1)),
+           per_100 / 100, per_100 % 100);
+}
+
+int main(void)
+{
+    static const unsigned frames_per_isr[] = { 1, 4, 16 };
+    gnrc_netif_t *netif;
+    kernel_pid_t pid;
+
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PACKET_SIZE, _get_max_packet_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS, _get_address);
+    netdev_test_set_isr_cb(&_dev, _dev_isr);
+    netdev_test_set_recv_cb(&_dev, _dev_recv);
+    netdev_test_set_send_cb(&_dev, _dev_send);
+    netif = gnrc_netif_ethernet_create(_netif_stack, sizeof(_netif_stack),
+                                       GNRC_NETIF_PRIO, "bench_eth",
+                                       &_dev.netdev);
+
+    /* skip duplicate address detection for the link-local address */
+    netif->ipv6.addrs_flags[0] &= ~GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_MASK;
+    netif->ipv6.addrs_flags[0] |= GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID;
+    _frame_init(&netif->ipv6.addrs[0]);
+
+    pid = thread_create(_listener_stack, sizeof(_listener_stack),
+                        THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                        _listener, NULL, "listener");
+    gnrc_netreg_entry_init_pid(&_listener_entry, BENCH_PORT, pid);
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &_listener_entry);
+
+#ifdef MODULE_GNRC_NETAPI_BURST
+    printf("gnrc receive path: %u interrupts, bursts of up to %u packets\n",
+           BENCH_ISRS, GNRC_NETAPI_BURST_SIZE);
+#else
+    printf("gnrc receive path: %u interrupts, one packet per message\n",
+           BENCH_ISRS);
+#endif
+    for (unsigned i = 0; i < ARRAY_SIZE(frames_per_isr); i++) {
+        _run(frames_per_isr[i]);
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
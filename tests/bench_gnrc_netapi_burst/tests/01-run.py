@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+BENCHMARK_REGEXP = (r"\s*{frames} frames per interrupt:\s+\d+/\s*\d+ received in"
+                    r"\s+\d+ us,\s+\d+ packets/s,\s+\d+\.\d+ context switches "
+                    r"per packet\r\n")
+
+
+def testfunc(child):
+    child.expect(r'gnrc receive path: \d+ interrupts, ')
+    for frames in (1, 4, 16):
+        child.expect(BENCHMARK_REGEXP.format(frames=frames), timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
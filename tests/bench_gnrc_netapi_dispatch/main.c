@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures dispatching UDP packets to several threads registered
+ *              for the same port
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_LISTENERS
+#define BENCH_LISTENERS     (4U)
+#endif
+
+/* entries registered for other ports */
+#ifndef BENCH_OTHER
+#define BENCH_OTHER         (32U)
+#endif
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10000UL)
+#endif
+
+#define BENCH_PORT          (5683U)
+#define QUEUE_SIZE          (8U)
+
+static char _stacks[BENCH_LISTENERS][THREAD_STACKSIZE_DEFAULT];
+static msg_t _queues[BENCH_LISTENERS][QUEUE_SIZE];
+static gnrc_netreg_entry_t _entries[BENCH_LISTENERS];
+static gnrc_netreg_entry_t _other[BENCH_OTHER];
+static uint32_t _received[BENCH_LISTENERS];
+
+static void *_listener(void *arg)
+{
+    unsigned i = (unsigned)(uintptr_t)arg;
+
+    msg_init_queue(_queues[i], QUEUE_SIZE);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+            _received[i]++;
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    static const uint8_t payload[8] = { 0 };
+    unsigned failed = 0;
+    uint32_t missed = 0;
+    uint32_t time;
+
+    printf("gnrc_netapi dispatch: %u listeners, %u other entries\n",
+           BENCH_LISTENERS, BENCH_OTHER);
+
+    for (unsigned i = 0; i < BENCH_OTHER; i++) {
+        gnrc_netreg_entry_init_pid(&_other[i], BENCH_PORT + 1 + i,
+                                   thread_getpid());
+        gnrc_netreg_register(GNRC_NETTYPE_UDP, &_other[i]);
+    }
+    for (unsigned i = 0; i < BENCH_LISTENERS; i++) {
+        kernel_pid_t pid = thread_create(_stacks[i], sizeof(_stacks[i]),
+                                         THREAD_PRIORITY_MAIN - 1,
+                                         THREAD_CREATE_STACKTEST, _listener,
+                                         (void *)(uintptr_t)i, "listener");
+
+        gnrc_netreg_entry_init_pid(&_entries[i], BENCH_PORT, pid);
+        gnrc_netreg_register(GNRC_NETTYPE_UDP, &_entries[i]);
+    }
+
+    time = xtimer_now_usec();
+    for (uint32_t n = 0; n < BENCH_RUNS; n++) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, payload, sizeof(payload),
+                                              GNRC_NETTYPE_UDP);
+
+        if (pkt == NULL) {
+            failed++;
+            continue;
+        }
+        if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, BENCH_PORT,
+                                         pkt) == 0) {
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    time = xtimer_now_usec() - time;
+
+    for (unsigned i = 0; i < BENCH_LISTENERS; i++) {
+        missed += BENCH_RUNS - _received[i];
+    }
+    printf("%lu packets in %8" PRIu32 " us --- %5" PRIu32 " ns per packet, %"
+           PRIu32 " missed\n", (unsigned long)BENCH_RUNS, time,
+           (uint32_t)(((uint64_t)time * 1000) / BENCH_RUNS), missed);
+    if (failed) {
+        printf("%u packets not allocated\n", failed);
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+
+
+def testfunc(child):
+    child.expect(r'gnrc_netapi dispatch: \d+ listeners, \d+ other entries')
+    child.expect(r'\d+ packets in\s+\d+ us --- \s*\d+ ns per packet, '
+                 r'0 missed\r\n', timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Simulate the DAOs of a storing mode RPL mesh after a restart of
+ *              the root and measure the control traffic and convergence time
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/icmpv6.h"
+#include "net/ipv6.h"
+#include "net/gnrc/rpl.h"
+#include "random.h"
+
+#ifndef BENCH_NODES
+#define BENCH_NODES         (256U)
+#endif
+
+#ifndef BENCH_FANOUT
+#define BENCH_FANOUT        (4U)
+#endif
+
+#ifndef BENCH_SEED
+#define BENCH_SEED          (1U)
+#endif
+
+#define ROOT                (BENCH_NODES)
+#define PARENT(i)           (((i) < BENCH_FANOUT) ? ROOT : (((i) / BENCH_FANOUT) - 1))
+#define WORDS               ((BENCH_NODES + 31) / 32)
+
+#define DIO_INTERVAL_MIN    (1U << GNRC_RPL_DEFAULT_DIO_INTERVAL_MIN)
+
+/**
+ * @brief   DAO state of a simulated node
+ */
+typedef struct {
+    uint32_t due;               /**< time the scheduled DAO is sent (in ms) */
+    uint32_t delay_since;       /**< time the scheduled DAO was first delayed */
+    bool pending;               /**< a DAO is scheduled */
+    bool delayed;               /**< the scheduled DAO aggregates targets */
+    uint32_t known[WORDS];      /**< targets learned from DAOs of children */
+} _node_t;
+
+typedef struct {
+    unsigned daos;              /**< number of DAOs */
+    uint32_t bytes;             /**< ICMPv6 bytes of DAOs and DAO-ACKs */
+    unsigned largest;           /**< size of the largest DAO */
+    unsigned oversized;         /**< DAOs above the minimal IPv6 MTU */
+    uint32_t converged;         /**< time the root learned all targets */
+} _stats_t;
+
+/* the root is the last node */
+static _node_t _nodes[BENCH_NODES + 1];
+
+static unsigned _count(const uint32_t *set)
+{
+    unsigned num = 0;
+
+    for (unsigned i = 0; i < WORDS; i++) {
+        for (uint32_t w = set[i]; w; w &= w - 1) {
+            num++;
+        }
+    }
+    return num;
+}
+
+/* as gnrc_rpl_delay_dao() before and after DAO aggregation */
+static void _delay_dao(_node_t *node, uint32_t now, bool aggregate)
+{
+    if (aggregate) {
+        if (!node->delayed) {
+            node->delayed = true;
+            node->delay_since = now;
+        }
+        else if (((now - node->delay_since) + GNRC_RPL_DAO_DELAY_DEFAULT +
+                  GNRC_RPL_DAO_DELAY_JITTER) > GNRC_RPL_DAO_DELAY_MAX) {
+            return;
+        }
+    }
+    node->due = now + random_uint32_range(GNRC_RPL_DAO_DELAY_DEFAULT,
+                                          GNRC_RPL_DAO_DELAY_DEFAULT +
+                                          GNRC_RPL_DAO_DELAY_JITTER);
+    node->pending = true;
+}
+
+static void _dao_sent(_stats_t *stats, unsigned targets, unsigned transits)
+{
+    unsigned len = sizeof(icmpv6_hdr_t) + sizeof(gnrc_rpl_dao_t) +
+                   targets * sizeof(gnrc_rpl_opt_target_t) +
+                   transits * sizeof(gnrc_rpl_opt_transit_t);
+
+    stats->daos++;
+    /* every DAO is acknowledged */
+    stats->bytes += len + sizeof(icmpv6_hdr_t) + sizeof(gnrc_rpl_dao_ack_t);
+    if (len > stats->largest) {
+        stats->largest = len;
+    }
+    /* above the minimal MTU a DAO needs to be fragmented at the IPv6 layer */
+    if ((len + sizeof(ipv6_hdr_t)) > IPV6_MIN_MTU) {
+        stats->oversized++;
+    }
+}
+
+/* sends the DAO of node i with all targets it knows to its parent */
+static void _dao_fire(unsigned i, bool aggregate, _stats_t *stats)
+{
+    _node_t *node = &_nodes[i];
+    _node_t *parent = &_nodes[PARENT(i)];
+    unsigned routes = _count(node->known);
+    unsigned daos = 1;
+    uint32_t now = node->due;
+
+    node->pending = false;
+    node->delayed = false;
+    if (aggregate) {
+        /* the routes share one transit option, split into DAOs of
+         * GNRC_RPL_DAO_TARGETS_NUMOF, the own address goes into the last */
+        daos += (routes > 0) ? ((routes - 1) / GNRC_RPL_DAO_TARGETS_NUMOF) : 0;
+        for (unsigned d = 1; d < daos; d++) {
+            _dao_sent(stats, GNRC_RPL_DAO_TARGETS_NUMOF, 1);
+        }
+        _dao_sent(stats, routes - (daos - 1) * GNRC_RPL_DAO_TARGETS_NUMOF + 1, 1);
+    }
+    else {
+        /* one transit option for every route */
+        _dao_sent(stats, routes + 1, (routes > 0) ? routes : 1);
+    }
+
+    for (unsigned w = 0; w < WORDS; w++) {
+        parent->known[w] |= node->known[w];
+    }
+    parent->known[i / 32] |= 1UL << (i % 32);
+    if (parent == &_nodes[ROOT]) {
+        if ((stats->converged == 0) && (_count(parent->known) == BENCH_NODES)) {
+            stats->converged = now;
+        }
+        return;
+    }
+    for (unsigned d = 0; d < daos; d++) {
+        _delay_dao(parent, now, aggregate);
+    }
+}
+
+static void _simulate(bool aggregate, _stats_t *stats)
+{
+    static uint32_t join[BENCH_NODES];
+
+    memset(_nodes, 0, sizeof(_nodes));
+    memset(stats, 0, sizeof(*stats));
+    random_init(BENCH_SEED);
+
+    /* the restarted root's DIOs reach one level per DIO interval; the
+     * nodes are sorted by depth, so their parents joined before */
+    for (unsigned i = 0; i < BENCH_NODES; i++) {
+        join[i] = (PARENT(i) == ROOT) ? 0 : join[PARENT(i)];
+        join[i] += random_uint32_range(DIO_INTERVAL_MIN / 2, DIO_INTERVAL_MIN);
+        _delay_dao(&_nodes[i], join[i], aggregate);
+    }
+
+    while (1) {
+        unsigned next = BENCH_NODES;
+
+        for (unsigned i = 0; i < BENCH_NODES; i++) {
+            if (_nodes[i].pending &&
+                ((next == BENCH_NODES) ||
+                 ((int32_t)(_nodes[i].due - _nodes[next].due) < 0))) {
+                next = i;
+            }
+        }
+        if (next == BENCH_NODES) {
+            break;
+        }
+        _dao_fire(next, aggregate, stats);
+    }
+}
+
+static void _print(const char *name, const _stats_t *stats)
+{
+    printf("%10s: %5u DAOs %7" PRIu32 " byte, largest DAO %5u byte "
+           "(%u above MTU), converged after %6" PRIu32 " ms\n",
+           name, stats->daos, stats->bytes, stats->largest, stats->oversized,
+           stats->converged);
+}
+
+int main(void)
+{
+    _stats_t stats;
+
+    printf("RPL DAOs after root restart: %u nodes, fanout %u\n",
+           (unsigned)BENCH_NODES, (unsigned)BENCH_FANOUT);
+    _simulate(false, &stats);
+    _print("restart", &stats);
+    _simulate(true, &stats);
+    _print("aggregate", &stats);
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+RESULT_REGEXP = (r"\s*{name}:\s+\d+ DAOs\s+\d+ byte, largest DAO\s+\d+ byte "
+                 r"\((\d+) above MTU\), converged after\s+\d+ ms")
+
+
+def testfunc(child):
+    child.expect(r"RPL DAOs after root restart: \d+ nodes, fanout \d+")
+    child.expect(RESULT_REGEXP.format(name="restart"))
+    child.expect(RESULT_REGEXP.format(name="aggregate"))
+    # aggregated DAOs never need IPv6 fragmentation
+    assert int(child.match.group(1)) == 0
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Simulate upward traffic in a lossy RPL mesh and compare the
+ *              packets delivered per transmission with OF0 and MRHOF
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/netif/etx.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/mrhof.h"
+#include "net/gnrc/rpl/of_manager.h"
+#include "random.h"
+
+#ifdef BENCH_MATRIX
+/* defines BENCH_NODES and _pdr[BENCH_NODES][BENCH_NODES] in percent */
+#include BENCH_MATRIX
+#else
+#ifndef BENCH_GRID_W
+#define BENCH_GRID_W        (8U)
+#endif
+#ifndef BENCH_GRID_H
+#define BENCH_GRID_H        (8U)
+#endif
+/* packet delivery ratio (in percent) by squared distance on the grid */
+#ifndef BENCH_PDR_1
+#define BENCH_PDR_1         (95U)
+#endif
+#ifndef BENCH_PDR_2
+#define BENCH_PDR_2         (80U)
+#endif
+#ifndef BENCH_PDR_4
+#define BENCH_PDR_4         (40U)
+#endif
+#ifndef BENCH_PDR_5
+#define BENCH_PDR_5         (25U)
+#endif
+#define BENCH_NODES         (BENCH_GRID_W * BENCH_GRID_H)
+static uint8_t _pdr[BENCH_NODES][BENCH_NODES];
+#endif
+
+/* link layer retries per frame, as macMaxFrameRetries */
+#ifndef BENCH_RETRIES
+#define BENCH_RETRIES       (3U)
+#endif
+
+/* unicast probes to each neighbor before the parents are chosen */
+#ifndef BENCH_PROBES
+#define BENCH_PROBES        (16U)
+#endif
+
+/* packets each node sends to the root, in BENCH_EPOCHS rounds of parent
+ * selection */
+#ifndef BENCH_PACKETS
+#define BENCH_PACKETS       (100U)
+#endif
+#ifndef BENCH_EPOCHS
+#define BENCH_EPOCHS        (4U)
+#endif
+
+#ifndef BENCH_SEED
+#define BENCH_SEED          (1U)
+#endif
+
+#define ROOT                (0U)
+#define MAX_HOPS            (64U)
+#define MAX_ROUNDS          (64U)
+/* interface numbers of the simulated nodes, clear of any real interface */
+#define IFACE(i)            ((kernel_pid_t)(100 + (i)))
+
+typedef struct {
+    unsigned sent;              /**< packets sent */
+    unsigned delivered;         /**< packets that reached the root */
+    uint32_t tx;                /**< frames transmitted, including retries */
+    uint32_t hops;              /**< hops of all delivered packets */
+    unsigned rounds;            /**< rounds until the parents were stable */
+} _stats_t;
+
+/* the DODAG of node i, its parents are all its neighbors */
+static gnrc_rpl_instance_t _inst[BENCH_NODES];
+static gnrc_rpl_parent_t _parents[BENCH_NODES][BENCH_NODES];
+
+static void _l2addr(unsigned node, uint8_t *l2addr)
+{
+    memset(l2addr, 0, 8);
+    l2addr[6] = 0x12;
+    l2addr[7] = node;
+}
+
+static void _ll_addr(unsigned node, ipv6_addr_t *addr)
+{
+    ipv6_addr_set_link_local_prefix(addr);
+    _l2addr(node, &addr->u8[8]);
+    addr->u8[8] ^= 0x02;
+}
+
+#ifndef BENCH_MATRIX
+static void _grid_init(void)
+{
+    static const uint8_t pdr[] = { 100, BENCH_PDR_1, BENCH_PDR_2, 0,
+                                   BENCH_PDR_4, BENCH_PDR_5 };
+
+    for (unsigned i = 0; i < BENCH_NODES; i++) {
+        for (unsigned j = 0; j < BENCH_NODES; j++) {
+            int dx = (int)(i % BENCH_GRID_W) - (int)(j % BENCH_GRID_W);
+            int dy = (int)(i / BENCH_GRID_W) - (int)(j / BENCH_GRID_W);
+            unsigned d2 = dx * dx + dy * dy;
+
+            _pdr[i][j] = ((i != j) && (d2 < ARRAY_SIZE(pdr))) ? pdr[d2] : 0;
+        }
+    }
+}
+#endif
+
+/* sends a frame with retries and feeds the result to the ETX estimator,
+ * returns true if it was acknowledged */
+static bool _send_frame(unsigned from, unsigned to, uint32_t *tx)
+{
+    uint8_t l2addr[8];
+    unsigned i;
+    bool acked = false;
+
+    for (i = 1; i <= BENCH_RETRIES + 1; i++) {
+        (*tx)++;
+        if (random_uint32_range(0, 100) < _pdr[from][to]) {
+            acked = true;
+            break;
+        }
+    }
+    _l2addr(to, l2addr);
+    gnrc_netif_etx_update(IFACE(from), l2addr, sizeof(l2addr),
+                          acked ? i : BENCH_RETRIES + 1, acked);
+    return acked;
+}
+
+static void _init(gnrc_rpl_of_t *of)
+{
+    memset(_inst, 0, sizeof(_inst));
+    memset(_parents, 0, sizeof(_parents));
+    for (unsigned i = 0; i < BENCH_NODES; i++) {
+        _inst[i].of = of;
+        _inst[i].min_hop_rank_inc = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+        _inst[i].dodag.instance = &_inst[i];
+        _inst[i].dodag.iface = IFACE(i);
+        _inst[i].dodag.my_rank = GNRC_RPL_INFINITE_RANK;
+        for (unsigned j = 0; j < BENCH_NODES; j++) {
+            _parents[i][j].dodag = &_inst[i].dodag;
+            _ll_addr(j, &_parents[i][j].addr);
+        }
+    }
+    _inst[ROOT].dodag.my_rank = GNRC_RPL_ROOT_RANK;
+    gnrc_netif_etx_reset();
+}
+
+/* chooses the preferred parent of node i from the ranks of its neighbors,
+ * returns true if its rank or preferred parent changed */
+static bool _select(unsigned i)
+{
+    gnrc_rpl_dodag_t *dodag = &_inst[i].dodag;
+    gnrc_rpl_of_t *of = _inst[i].of;
+    gnrc_rpl_parent_t *sorted[BENCH_NODES];
+    gnrc_rpl_parent_t *old_best = dodag->parents;
+    uint16_t old_rank = dodag->my_rank;
+    unsigned num = 0;
+
+    for (unsigned j = 0; j < BENCH_NODES; j++) {
+        gnrc_rpl_parent_t *parent = &_parents[i][j];
+
+        parent->rank = _inst[j].dodag.my_rank;
+        if ((_pdr[i][j] == 0) || (parent->rank == GNRC_RPL_INFINITE_RANK)) {
+            continue;
+        }
+        if (of->update_metric != NULL) {
+            of->update_metric(parent);
+        }
+        /* insert after all parents it does not beat, as gnrc_rpl does */
+        unsigned k = num++;
+        while ((k > 0) && (of->parent_cmp(parent, sorted[k - 1]) < 0)) {
+            sorted[k] = sorted[k - 1];
+            k--;
+        }
+        sorted[k] = parent;
+    }
+    /* the objective function may keep the preferred parent */
+    for (unsigned k = 1; (old_best != NULL) && (k < num); k++) {
+        if (sorted[k] != old_best) {
+            continue;
+        }
+        if (of->which_parent(old_best, sorted[0]) == old_best) {
+            memmove(&sorted[1], &sorted[0], k * sizeof(sorted[0]));
+            sorted[0] = old_best;
+        }
+        break;
+    }
+    dodag->parents = NULL;
+    for (unsigned k = num; k > 0; k--) {
+        sorted[k - 1]->next = dodag->parents;
+        dodag->parents = sorted[k - 1];
+    }
+    dodag->my_rank = of->calc_rank(dodag->parents, 0);
+    return (dodag->parents != old_best) || (dodag->my_rank != old_rank);
+}
+
+static unsigned _select_all(void)
+{
+    unsigned rounds;
+
+    for (rounds = 1; rounds <= MAX_ROUNDS; rounds++) {
+        bool changed = false;
+
+        for (unsigned i = 0; i < BENCH_NODES; i++) {
+            if (i != ROOT) {
+                changed |= _select(i);
+            }
+        }
+        if (!changed) {
+            break;
+        }
+    }
+    return rounds;
+}
+
+static unsigned _node(const gnrc_rpl_parent_t *parent)
+{
+    return parent - _parents[parent->dodag->instance - _inst];
+}
+
+static void _run(const char *name, gnrc_rpl_of_t *of)
+{
+    _stats_t stats;
+
+    memset(&stats, 0, sizeof(stats));
+    random_init(BENCH_SEED);
+    _init(of);
+
+    /* the ETX estimates start from some unicast traffic to every neighbor */
+    for (unsigned p = 0; p < BENCH_PROBES; p++) {
+        for (unsigned i = 0; i < BENCH_NODES; i++) {
+            for (unsigned j = 0; j < BENCH_NODES; j++) {
+                if ((i != ROOT) && (_pdr[i][j] > 0)) {
+                    uint32_t tx = 0;
+                    _send_frame(i, j, &tx);
+                }
+            }
+        }
+    }
+
+    for (unsigned e = 0; e < BENCH_EPOCHS; e++) {
+        stats.rounds += _select_all();
+        for (unsigned p = 0; p < BENCH_PACKETS / BENCH_EPOCHS; p++) {
+            for (unsigned i = 0; i < BENCH_NODES; i++) {
+                unsigned node = i, hops = 0;
+
+                if (i == ROOT) {
+                    continue;
+                }
+                stats.sent++;
+                while ((node != ROOT) && (hops < MAX_HOPS)) {
+                    gnrc_rpl_parent_t *parent = _inst[node].dodag.parents;
+
+                    if ((parent == NULL) ||
+                        !_send_frame(node, _node(parent), &stats.tx)) {
+                        break;
+                    }
+                    node = _node(parent);
+                    hops++;
+                }
+                if (node == ROOT) {
+                    stats.delivered++;
+                    stats.hops += hops;
+                }
+            }
+        }
+    }
+
+    unsigned per_100tx = (unsigned)(((uint64_t)stats.delivered * 10000) /
+                                    (stats.tx ? stats.tx : 1));
+    unsigned hops_10 = (unsigned)((stats.hops * 10) /
+                                  (stats.delivered ? stats.delivered : 1));
+
+    printf("%6s: %5u/%5u delivered %7" PRIu32 " tx, %3u.%02u delivered per "
+           "100 tx, %2u.%u hops, %3u rounds\n", name, stats.delivered,
+           stats.sent, stats.tx, per_100tx / 100, per_100tx % 100,
+           hops_10 / 10, hops_10 % 10, stats.rounds);
+}
+
+int main(void)
+{
+#ifndef BENCH_MATRIX
+    _grid_init();
+#endif
+    gnrc_rpl_of_manager_init();
+
+    printf("RPL upward traffic: %u nodes, %u retries, %u packets per node\n",
+           BENCH_NODES, BENCH_RETRIES, BENCH_PACKETS);
+    /* OF0 has OCP 0 */
+    _run("of0", gnrc_rpl_get_of_for_ocp(0));
+    _run("mrhof", gnrc_rpl_get_of_for_ocp(GNRC_RPL_MRHOF_OCP));
+    puts("[SUCCESS]");
+    return 0;
+}
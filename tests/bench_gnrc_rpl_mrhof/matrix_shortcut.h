@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Link matrix of a chain with lossy shortcuts
+ *
+ * Nodes 1 to 6 form a chain to the root 0 over good links. Every node also
+ * reaches the node two hops closer to the root over a link that loses most
+ * frames, which hop count based parent selection prefers.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#ifndef MATRIX_SHORTCUT_H
+#define MATRIX_SHORTCUT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BENCH_NODES         (7U)
+
+/* packet delivery ratio in percent, from row to column */
+static const uint8_t _pdr[BENCH_NODES][BENCH_NODES] = {
+    {  0, 95, 20,  0,  0,  0,  0 },
+    { 95,  0, 95, 20,  0,  0,  0 },
+    { 20, 95,  0, 95, 20,  0,  0 },
+    {  0, 20, 95,  0, 95, 20,  0 },
+    {  0,  0, 20, 95,  0, 95, 20 },
+    {  0,  0,  0, 20, 95,  0, 95 },
+    {  0,  0,  0,  0, 20, 95,  0 },
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MATRIX_SHORTCUT_H */
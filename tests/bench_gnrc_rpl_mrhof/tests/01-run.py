@@ -0,0 +1,33 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+RESULT_REGEXP = (r"\s*{name}:\s+(\d+)/\s*\d+ delivered\s+\d+ tx,\s+(\d+)\.(\d+) "
+                 r"delivered per 100 tx,\s+\d+\.\d hops,\s+\d+ rounds")
+
+
+def _result(child, name):
+    child.expect(RESULT_REGEXP.format(name=name))
+    return int(child.match.group(2)) * 100 + int(child.match.group(3))
+
+
+def testfunc(child):
+    child.expect(r"RPL upward traffic: \d+ nodes, \d+ retries, "
+                 r"\d+ packets per node")
+    of0 = _result(child, "of0")
+    mrhof = _result(child, "mrhof")
+    # avoiding lossy links takes fewer transmissions per delivered packet
+    assert mrhof > of0
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
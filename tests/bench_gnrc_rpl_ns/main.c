@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Simulate a large RPL DODAG in non-storing mode and measure the
+ *              route setup at the root and the routing state of the nodes
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/rpl/ns.h"
+#include "net/gnrc/rpl/srh.h"
+#include "xtimer.h"
+
+#ifndef BENCH_NODES
+#define BENCH_NODES         (256U)
+#endif
+
+#ifndef BENCH_FANOUT
+#define BENCH_FANOUT        (4U)
+#endif
+
+#ifndef BENCH_LOOKUPS
+#define BENCH_LOOKUPS       (10000UL)
+#endif
+
+#define DAO_LIFETIME        (3600U)
+
+/* nodes 0 .. BENCH_FANOUT - 1 are children of the root */
+#define PARENT(i)           (((i) / BENCH_FANOUT) - 1)
+
+static ipv6_addr_t _hops[GNRC_RPL_NS_MAX_HOPS];
+/* downward routes a node needs in storing mode: one per node below it */
+static uint16_t _subtree[BENCH_NODES];
+
+static void _node_addr(ipv6_addr_t *addr, unsigned i)
+{
+    /* 2001:db8::<i + 1> */
+    memset(addr, 0, sizeof(*addr));
+    addr->u8[0] = 0x20;
+    addr->u8[1] = 0x01;
+    addr->u8[2] = 0x0d;
+    addr->u8[3] = 0xb8;
+    addr->u16[7] = byteorder_htons(i + 1);
+}
+
+static unsigned _depth(unsigned i)
+{
+    unsigned depth = 1;
+
+    while (i >= BENCH_FANOUT) {
+        i = PARENT(i);
+        depth++;
+    }
+    return depth;
+}
+
+static uint32_t _per_sec(uint32_t num, uint32_t time)
+{
+    return (uint32_t)(((uint64_t)num * US_PER_SEC) / (time ? time : 1));
+}
+
+int main(void)
+{
+    ipv6_addr_t target, parent, root;
+    kernel_pid_t iface;
+    uint32_t start, time;
+    unsigned max_depth = 0, max_subtree = 0;
+    uint32_t sum_subtree = 0;
+    int res;
+
+    printf("RPL non-storing mode: %u nodes, fanout %u\n",
+           (unsigned)BENCH_NODES, (unsigned)BENCH_FANOUT);
+
+    /* every node sends its DAO to the root */
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_NODES; i++) {
+        _node_addr(&target, i);
+        if (i >= BENCH_FANOUT) {
+            _node_addr(&parent, PARENT(i));
+        }
+        res = gnrc_rpl_ns_update(&target, (i < BENCH_FANOUT) ? NULL : &parent,
+                                 DAO_LIFETIME, KERNEL_PID_UNDEF);
+        if (res < 0) {
+            printf("gnrc_rpl_ns_update() : %d\n", res);
+            return 1;
+        }
+    }
+    time = xtimer_now_usec() - start;
+    printf("DAO processing: %8" PRIu32 " us --- %8" PRIu32 " DAOs/s\n",
+           time, _per_sec(BENCH_NODES, time));
+
+    /* first route to every node, mostly cache misses */
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_NODES; i++) {
+        _node_addr(&target, i);
+        res = gnrc_rpl_ns_get_route(&target, _hops, ARRAY_SIZE(_hops), &iface);
+        if (res != (int)_depth(i) - 1) {
+            printf("gnrc_rpl_ns_get_route(%u) : %d\n", i, res);
+            return 1;
+        }
+    }
+    time = xtimer_now_usec() - start;
+    printf("route setup:    %8" PRIu32 " us --- %8" PRIu32 " routes/s\n",
+           time, _per_sec(BENCH_NODES, time));
+
+    /* repeated route to the deepest node, served from the cache */
+    _node_addr(&target, BENCH_NODES - 1);
+    start = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_LOOKUPS; i++) {
+        res = gnrc_rpl_ns_get_route(&target, _hops, ARRAY_SIZE(_hops), &iface);
+    }
+    time = xtimer_now_usec() - start;
+    printf("cached route:   %8" PRIu32 " us --- %8" PRIu32 " routes/s\n",
+           time, _per_sec(BENCH_LOOKUPS, time));
+
+    /* routing header for the deepest node */
+    if (res <= 0) {
+        printf("no intermediate hops to node %u\n", BENCH_NODES - 1);
+        return 1;
+    }
+    memset(&root, 0, sizeof(root));
+    memcpy(&root, &target, sizeof(root) / 2);
+    root.u8[15] = 0xff;
+    start = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_LOOKUPS; i++) {
+        gnrc_pktsnip_t *pkt = gnrc_ipv6_hdr_build(NULL, &root, &target);
+
+        if ((pkt == NULL) || (gnrc_rpl_srh_insert(pkt, _hops, res) < 0)) {
+            puts("gnrc_rpl_srh_insert() failed");
+            return 1;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    time = xtimer_now_usec() - start;
+    printf("SRH insertion:  %8" PRIu32 " us --- %8" PRIu32 " headers/s\n",
+           time, _per_sec(BENCH_LOOKUPS, time));
+
+    /* routing state of the nodes */
+    for (unsigned i = BENCH_NODES; i-- > 0;) {
+        unsigned depth = _depth(i);
+
+        if (depth > max_depth) {
+            max_depth = depth;
+        }
+        if (_subtree[i] > max_subtree) {
+            max_subtree = _subtree[i];
+        }
+        sum_subtree += _subtree[i];
+        if (i >= BENCH_FANOUT) {
+            _subtree[PARENT(i)] += _subtree[i] + 1;
+        }
+    }
+    printf("depth: %u hops\n", max_depth);
+    printf("root: %u byte for %u graph entries and %u cached routes\n",
+           (unsigned)(BENCH_NODES * (2 * sizeof(ipv6_addr_t) + 8) +
+                      GNRC_RPL_NS_ROUTE_CACHE_SIZE *
+                      (sizeof(ipv6_addr_t) + 8 + GNRC_RPL_NS_MAX_HOPS)),
+           (unsigned)BENCH_NODES, (unsigned)GNRC_RPL_NS_ROUTE_CACHE_SIZE);
+    printf("node: storing mode %u routes max, %" PRIu32 " avg --- "
+           "non-storing mode 0 routes\n",
+           max_subtree, sum_subtree / BENCH_NODES);
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+STEPS = ("DAO processing", "route setup", "cached route", "SRH insertion")
+
+
+def testfunc(child):
+    child.expect(r"RPL non-storing mode: \d+ nodes, fanout \d+")
+    for step in STEPS:
+        child.expect(r"{}:\s+\d+ us --- \s*\d+ \w+/s".format(step),
+                     timeout=TIMEOUT)
+    child.expect(r"depth: \d+ hops")
+    child.expect(r"root: \d+ byte for \d+ graph entries and \d+ cached routes")
+    child.expect(r"node: storing mode \d+ routes max, \d+ avg --- "
+                 r"non-storing mode 0 routes")
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the receive throughput of GNRC TCP
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/af.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+static uint8_t _rcv_buf[RCV_BUF_SIZE];
+static uint8_t _buf[GNRC_TCP_MSS];
+
+/* "ifconfig" shell command */
+extern int _gnrc_netif_config(int argc, char **argv);
+
+int main(void)
+{
+    gnrc_netif_t *netif;
+    gnrc_tcp_tcb_t tcb;
+
+    if (!(netif = gnrc_netif_iter(NULL))) {
+        puts("No valid network interface found");
+        return -1;
+    }
+
+    /* Set pre-configured IP address */
+    char if_pid[] = {netif->pid + '0', '\0'};
+    char *cmd[] = {"ifconfig", if_pid, "add", "unicast", LOCAL_ADDR};
+    _gnrc_netif_config(5, cmd);
+
+    printf("GNRC TCP receive benchmark: LOCAL_ADDR=%s, LOCAL_PORT=%d, "
+           "RCV_BUF_SIZE=%u, NBYTE=%lu\n", LOCAL_ADDR, LOCAL_PORT,
+           (unsigned)RCV_BUF_SIZE, (unsigned long)NBYTE);
+
+    while (1) {
+        uint32_t start;
+        uint32_t rcvd = 0;
+        int ret;
+
+        gnrc_tcp_tcb_init(&tcb);
+        gnrc_tcp_tcb_set_rcv_buf(&tcb, _rcv_buf, sizeof(_rcv_buf));
+        puts("Listening");
+        ret = gnrc_tcp_open_passive(&tcb, AF_INET6, NULL, LOCAL_PORT);
+        if (ret < 0) {
+            printf("gnrc_tcp_open_passive() : %d\n", ret);
+            return -1;
+        }
+        start = xtimer_now_usec();
+        while (rcvd < NBYTE) {
+            ret = gnrc_tcp_recv(&tcb, _buf, sizeof(_buf),
+                                GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+            if (ret < 0) {
+                printf("gnrc_tcp_recv() : %d\n", ret);
+                break;
+            }
+            rcvd += ret;
+        }
+        uint32_t time = xtimer_now_usec() - start;
+        printf("Received %" PRIu32 " byte in %" PRIu32 " us: %" PRIu32 " byte/s\n",
+               rcvd, time,
+               (uint32_t)(((uint64_t)rcvd * US_PER_SEC) / (time ? time : 1)));
+        gnrc_tcp_close(&tcb);
+    }
+    return 0;
+}
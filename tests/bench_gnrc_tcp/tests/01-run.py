@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+# Sends TCP_NBYTE bytes from the host to the node over the TAP interface and
+# reports the throughput measured by the node. With LOSS (in percent) set, the
+# host drops packets towards the node with netem, which requires sudo.
+
+import os
+import socket
+import subprocess
+import sys
+
+from testrunner import run
+
+TAP = os.environ.get("PORT", "tap0")
+ADDR = os.environ.get("TCP_LOCAL_ADDR", "fe80::affe")
+PORT = int(os.environ.get("TCP_LOCAL_PORT", 8080))
+NBYTE = int(os.environ.get("TCP_NBYTE", 262144))
+LOSS = float(os.environ.get("LOSS", 0))
+RUNS = int(os.environ.get("RUNS", 3))
+TIMEOUT = 300
+
+
+def netem(*args):
+    subprocess.check_call(["sudo", "tc", "qdisc"] + list(args) +
+                          ["dev", TAP, "root"] +
+                          (["netem", "loss", "{}%".format(LOSS)]
+                           if args[0] != "del" else []))
+
+
+def send_data():
+    addr = socket.getaddrinfo("{}%{}".format(ADDR, TAP), PORT,
+                              socket.AF_INET6, socket.SOCK_STREAM)[0][4]
+    with socket.socket(socket.AF_INET6, socket.SOCK_STREAM) as sock:
+        sock.settimeout(TIMEOUT)
+        sock.connect(addr)
+        data = bytes(i & 0xff for i in range(NBYTE))
+        sock.sendall(data)
+
+
+def testfunc(child):
+    child.expect_exact("GNRC TCP receive benchmark")
+    if LOSS > 0:
+        netem("replace")
+    try:
+        for _ in range(RUNS):
+            child.expect_exact("Listening")
+            send_data()
+            child.expect(r"Received (\d+) byte in (\d+) us: (\d+) byte/s",
+                         timeout=TIMEOUT)
+            assert int(child.match.group(1)) == NBYTE
+            print("{{ \"loss\": {}, \"bytes\": {}, \"byte_per_sec\": {} }}"
+                  .format(LOSS, NBYTE, child.match.group(3)))
+    finally:
+        if LOSS > 0:
+            netem("del")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=TIMEOUT))
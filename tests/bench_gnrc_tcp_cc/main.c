@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the send throughput and congestion control of GNRC TCP
+ *              over a link with emulated delay and loss
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iolist.h"
+#include "msg.h"
+#include "mutex.h"
+#include "net/af.h"
+#include "net/ethernet.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tcp.h"
+#include "random.h"
+#include "thread.h"
+#include "xtimer.h"
+
+/**
+ * @brief   Number of frames the emulated link holds, further frames are dropped
+ */
+#define EMU_SLOTS           (32U)
+
+/**
+ * @brief   A frame on the emulated link
+ */
+typedef struct {
+    uint32_t due;                       /**< time to send the frame (in usec) */
+    size_t len;                         /**< length of the frame */
+    uint8_t data[ETHERNET_MAX_LEN];     /**< the frame */
+} _frame_t;
+
+static const netdev_driver_t *_tap_driver;
+static netdev_driver_t _emu_driver;
+static netdev_t *_emu_dev;
+static _frame_t _frames[EMU_SLOTS];
+static unsigned _frames_head;
+static unsigned _frames_num;
+static mutex_t _frames_lock = MUTEX_INIT;
+static uint32_t _dropped;
+static kernel_pid_t _delay_pid;
+static char _delay_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _delay_queue[8];
+
+static uint8_t _buf[4 * GNRC_TCP_MSS];
+
+/* "ifconfig" shell command */
+extern int _gnrc_netif_config(int argc, char **argv);
+
+/* drops frames randomly and queues the others on the emulated link */
+static int _emu_send(netdev_t *dev, const iolist_t *iolist)
+{
+    size_t len = iolist_size(iolist);
+    msg_t msg;
+
+    if (random_uint32_range(0, 1000) < EMU_LOSS_PERMILLE) {
+        _dropped++;
+        return len;
+    }
+    if (EMU_DELAY_MS == 0) {
+        return _tap_driver->send(dev, iolist);
+    }
+    mutex_lock(&_frames_lock);
+    if ((_frames_num == EMU_SLOTS) || (len > ETHERNET_MAX_LEN)) {
+        /* tail drop */
+        mutex_unlock(&_frames_lock);
+        _dropped++;
+        return len;
+    }
+    _frame_t *frame = &_frames[(_frames_head + _frames_num) % EMU_SLOTS];
+    frame->due = xtimer_now_usec() + (EMU_DELAY_MS * US_PER_MS);
+    frame->len = 0;
+    for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
+        memcpy(&frame->data[frame->len], iol->iol_base, iol->iol_len);
+        frame->len += iol->iol_len;
+    }
+    _frames_num++;
+    mutex_unlock(&_frames_lock);
+    msg_try_send(&msg, _delay_pid);
+    return len;
+}
+
+/* sends the queued frames of the emulated link when they are due */
+static void *_delay_thread(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    msg_init_queue(_delay_queue, ARRAY_SIZE(_delay_queue));
+    while (1) {
+        mutex_lock(&_frames_lock);
+        if (_frames_num == 0) {
+            mutex_unlock(&_frames_lock);
+            msg_receive(&msg);
+            continue;
+        }
+        _frame_t *frame = &_frames[_frames_head];
+        int32_t wait = (int32_t)(frame->due - xtimer_now_usec());
+        mutex_unlock(&_frames_lock);
+        if (wait > 0) {
+            xtimer_usleep(wait);
+            continue;
+        }
+        /* the frame's slot is not reused before it is removed below */
+        iolist_t iol = { .iol_next = NULL, .iol_base = frame->data,
+                         .iol_len = frame->len };
+        _tap_driver->send(_emu_dev, &iol);
+        mutex_lock(&_frames_lock);
+        _frames_head = (_frames_head + 1) % EMU_SLOTS;
+        _frames_num--;
+        mutex_unlock(&_frames_lock);
+    }
+    return NULL;
+}
+
+static void _emu_init(gnrc_netif_t *netif)
+{
+    _emu_dev = netif->dev;
+    _tap_driver = _emu_dev->driver;
+    _emu_driver = *_tap_driver;
+    _emu_driver.send = _emu_send;
+    _delay_pid = thread_create(_delay_stack, sizeof(_delay_stack),
+                               THREAD_PRIORITY_MAIN - 3, THREAD_CREATE_STACKTEST,
+                               _delay_thread, NULL, "emu_link");
+    _emu_dev->driver = &_emu_driver;
+}
+
+int main(void)
+{
+    gnrc_netif_t *netif;
+    gnrc_tcp_tcb_t tcb;
+
+    if (!(netif = gnrc_netif_iter(NULL))) {
+        puts("No valid network interface found");
+        return -1;
+    }
+
+    /* Set pre-configured IP address */
+    char if_pid[] = {netif->pid + '0', '\0'};
+    char *cmd[] = {"ifconfig", if_pid, "add", "unicast", LOCAL_ADDR};
+    _gnrc_netif_config(5, cmd);
+
+    memset(_buf, 'x', sizeof(_buf));
+    _emu_init(netif);
+
+    printf("GNRC TCP congestion control benchmark: LOCAL_ADDR=%s, LOCAL_PORT=%d, "
+           "NBYTE=%lu, SND_SEGMENTS=%u, DELAY=%u ms, LOSS=%u permille\n",
+           LOCAL_ADDR, LOCAL_PORT, (unsigned long)NBYTE,
+           (unsigned)GNRC_TCP_SND_SEGMENTS, (unsigned)EMU_DELAY_MS,
+           (unsigned)EMU_LOSS_PERMILLE);
+
+    while (1) {
+        gnrc_tcp_stats_t stats;
+        uint32_t start;
+        uint32_t sent = 0;
+        uint32_t dropped;
+        int ret;
+
+        gnrc_tcp_tcb_init(&tcb);
+        puts("Listening");
+        ret = gnrc_tcp_open_passive(&tcb, AF_INET6, NULL, LOCAL_PORT);
+        if (ret < 0) {
+            printf("gnrc_tcp_open_passive() : %d\n", ret);
+            return -1;
+        }
+        dropped = _dropped;
+        start = xtimer_now_usec();
+        while (sent < NBYTE) {
+            size_t len = ((NBYTE - sent) < sizeof(_buf)) ? (NBYTE - sent) : sizeof(_buf);
+
+            ret = gnrc_tcp_send(&tcb, _buf, len, 0);
+            if (ret < 0) {
+                printf("gnrc_tcp_send() : %d\n", ret);
+                break;
+            }
+            sent += ret;
+        }
+        /* gnrc_tcp_send() returns before the last segments are acknowledged */
+        do {
+            xtimer_usleep(US_PER_MS);
+            gnrc_tcp_get_stats(&tcb, &stats);
+        } while ((ret >= 0) && (stats.flight > 0));
+        uint32_t time = xtimer_now_usec() - start;
+        gnrc_tcp_close(&tcb);
+        printf("Sent %" PRIu32 " byte in %" PRIu32 " us: %" PRIu32 " byte/s\n",
+               sent, time,
+               (uint32_t)(((uint64_t)sent * US_PER_SEC) / (time ? time : 1)));
+        printf("cwnd=%" PRIu32 " ssthresh=%" PRIu32 " srtt=%" PRId32 " us "
+               "retransmits=%" PRIu32 " fast_retransmits=%" PRIu32
+               " timeouts=%" PRIu32 " dropped=%" PRIu32 "\n",
+               stats.cwnd, stats.ssthresh, stats.srtt, stats.retransmits,
+               stats.fast_retransmits, stats.timeouts, _dropped - dropped);
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+# Receives TCP_NBYTE bytes from the node over the TAP interface and reports the
+# throughput and congestion control statistics measured by the node. Delay and
+# loss are applied by the node to its outgoing frames.
+
+import os
+import socket
+import sys
+
+from testrunner import run
+
+TAP = os.environ.get("PORT", "tap0")
+ADDR = os.environ.get("TCP_LOCAL_ADDR", "fe80::affe")
+PORT = int(os.environ.get("TCP_LOCAL_PORT", 8080))
+NBYTE = int(os.environ.get("TCP_NBYTE", 262144))
+DELAY = int(os.environ.get("EMU_DELAY_MS", 20))
+LOSS = int(os.environ.get("EMU_LOSS_PERMILLE", 10))
+PACING = int(os.environ.get("PACING", 0))
+RUNS = int(os.environ.get("RUNS", 3))
+TIMEOUT = 300
+
+
+def receive_data():
+    addr = socket.getaddrinfo("{}%{}".format(ADDR, TAP), PORT,
+                              socket.AF_INET6, socket.SOCK_STREAM)[0][4]
+    rcvd = 0
+    with socket.socket(socket.AF_INET6, socket.SOCK_STREAM) as sock:
+        sock.settimeout(TIMEOUT)
+        sock.connect(addr)
+        while rcvd < NBYTE:
+            data = sock.recv(4096)
+            if not data:
+                break
+            rcvd += len(data)
+    return rcvd
+
+
+def testfunc(child):
+    child.expect_exact("GNRC TCP congestion control benchmark")
+    for _ in range(RUNS):
+        child.expect_exact("Listening")
+        assert receive_data() == NBYTE
+        child.expect(r"Sent (\d+) byte in (\d+) us: (\d+) byte/s",
+                     timeout=TIMEOUT)
+        assert int(child.match.group(1)) == NBYTE
+        rate = child.match.group(3)
+        child.expect(r"cwnd=(\d+) ssthresh=(\d+) srtt=(-?\d+) us "
+                     r"retransmits=(\d+) fast_retransmits=(\d+) "
+                     r"timeouts=(\d+) dropped=(\d+)")
+        print("{{ \"delay_ms\": {}, \"loss_permille\": {}, \"pacing\": {}, "
+              "\"byte_per_sec\": {}, \"srtt_us\": {}, \"retransmits\": {}, "
+              "\"fast_retransmits\": {}, \"timeouts\": {}, \"dropped\": {} }}"
+              .format(DELAY, LOSS, PACING, rate, child.match.group(3),
+                      child.match.group(4), child.match.group(5),
+                      child.match.group(6), child.match.group(7)))
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=TIMEOUT))
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of SHA-256, one message at a time and several
+ *              messages side by side
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "xtimer.h"
+
+#ifndef BENCH_BYTES
+#define BENCH_BYTES         (256UL * 1024UL)
+#endif
+
+#define BUF_SIZE            (4096U)
+#define MB_MESSAGES         (2 * SHA256_MB_LANES)
+
+static const uint16_t _sizes[] = { 16, 64, 256, 1024, 4096 };
+static uint8_t _in[BUF_SIZE + MB_MESSAGES];
+static uint8_t _digest[MB_MESSAGES][SHA256_DIGEST_LENGTH];
+
+/* FIPS 180-2, appendix B */
+static const char _abc[] = "abc";
+static const char _448[] =
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+static const uint8_t _abc_digest[SHA256_DIGEST_LENGTH] = {
+    0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+    0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+    0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+    0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+};
+static const uint8_t _448_digest[SHA256_DIGEST_LENGTH] = {
+    0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8,
+    0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+    0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67,
+    0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1
+};
+static const uint8_t _million_a_digest[SHA256_DIGEST_LENGTH] = {
+    0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92,
+    0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+    0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e,
+    0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0
+};
+
+static void _print(const char *name, uint16_t size, uint32_t runs,
+                   uint32_t time)
+{
+    uint64_t bytes = (uint64_t)runs * size;
+
+    printf("%9s %4u byte: %8" PRIu32 "us --- %6" PRIu32 " KiB/s\n",
+           name, (unsigned)size, time,
+           (uint32_t)((bytes * US_PER_SEC) /
+                      ((uint64_t)(time ? time : 1) * 1024)));
+}
+
+static int _check_vectors(void)
+{
+    const void *data[] = { _abc, _448, _abc };
+    size_t len[] = { sizeof(_abc) - 1, sizeof(_448) - 1, sizeof(_abc) - 1 };
+    void *digest[] = { _digest[0], _digest[1], _digest[2] };
+    sha256_context_t ctx;
+
+    sha256(_abc, sizeof(_abc) - 1, _digest[0]);
+    sha256(_448, sizeof(_448) - 1, _digest[1]);
+    if (memcmp(_digest[0], _abc_digest, SHA256_DIGEST_LENGTH) ||
+        memcmp(_digest[1], _448_digest, SHA256_DIGEST_LENGTH)) {
+        return 1;
+    }
+
+    memset(_in, 'a', 1000);
+    sha256_init(&ctx);
+    for (unsigned i = 0; i < 1000; i++) {
+        sha256_update(&ctx, _in, 1000);
+    }
+    sha256_final(&ctx, _digest[0]);
+    if (memcmp(_digest[0], _million_a_digest, SHA256_DIGEST_LENGTH)) {
+        return 1;
+    }
+
+    memset(_digest, 0, sizeof(_digest));
+    sha256_mb(data, len, digest, ARRAY_SIZE(data));
+    if (memcmp(_digest[0], _abc_digest, SHA256_DIGEST_LENGTH) ||
+        memcmp(_digest[1], _448_digest, SHA256_DIGEST_LENGTH) ||
+        memcmp(_digest[2], _abc_digest, SHA256_DIGEST_LENGTH)) {
+        return 1;
+    }
+    return 0;
+}
+
+static void _bench(uint16_t size)
+{
+    uint32_t runs = BENCH_BYTES / size;
+    uint32_t time;
+    const void *data[MB_MESSAGES];
+    size_t len[MB_MESSAGES];
+    void *digest[MB_MESSAGES];
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        sha256(_in, size, _digest[0]);
+    }
+    time = xtimer_now_usec() - time;
+    _print("sha256", size, runs, time);
+
+    for (unsigned i = 0; i < MB_MESSAGES; i++) {
+        data[i] = _in + i;
+        len[i] = size;
+        digest[i] = _digest[i];
+    }
+    runs = (runs + MB_MESSAGES - 1) / MB_MESSAGES;
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        sha256_mb(data, len, digest, MB_MESSAGES);
+    }
+    time = xtimer_now_usec() - time;
+    _print("sha256_mb", size, runs * MB_MESSAGES, time);
+}
+
+int main(void)
+{
+#if defined(MODULE_HASHES_SHA256_NI)
+    printf("SHA-256, SHA instructions (if available)");
+#elif defined(MODULE_HASHES_SHA256_UNROLL)
+    printf("SHA-256, unrolled rounds");
+#else
+    printf("SHA-256, reference rounds");
+#endif
+    printf(", %u lanes for sha256_mb\n\n", (unsigned)SHA256_MB_LANES);
+
+    if (_check_vectors()) {
+        puts("error: wrong digest");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < sizeof(_in); i++) {
+        _in[i] = i;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        _bench(_sizes[i]);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of the Internet Checksum
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+#ifndef BENCH_BYTES
+#define BENCH_BYTES         (4UL * 1024UL * 1024UL)
+#endif
+
+#define BUF_SIZE            (1280U + sizeof(uint32_t))
+
+static const uint16_t _sizes[] = { 8, 20, 40, 64, 127, 256, 512, 1280 };
+static uint32_t _buf[BUF_SIZE / sizeof(uint32_t)];
+static volatile uint16_t _sink;
+
+/* the byte pair loop inet_csum_slice() used before, as baseline */
+static uint16_t _csum_bytewise(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if (len & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void _print(const char *name, uint16_t size, unsigned misalign,
+                   uint32_t runs, uint32_t time)
+{
+    uint64_t kib_per_sec = ((uint64_t)runs * size * US_PER_SEC) /
+                           ((uint64_t)(time ? time : 1) * 1024);
+
+    printf("%10s %4u byte (+%u): %8" PRIu32 "us --- %8" PRIu32 " KiB/s\n",
+           name, (unsigned)size, misalign, time, (uint32_t)kib_per_sec);
+}
+
+static void _bench(uint16_t size, unsigned misalign)
+{
+    const uint8_t *buf = ((uint8_t *)_buf) + misalign;
+    uint32_t runs = BENCH_BYTES / size;
+    uint32_t time;
+
+    if (_csum_bytewise(0, buf, size) != inet_csum(0, buf, size)) {
+        printf("checksum mismatch for %u byte (+%u)\n", (unsigned)size,
+               misalign);
+    }
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        _sink = _csum_bytewise(0, buf, size);
+    }
+    time = xtimer_now_usec() - time;
+    _print("bytewise", size, misalign, runs, time);
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < runs; i++) {
+        _sink = inet_csum(0, buf, size);
+    }
+    time = xtimer_now_usec() - time;
+    _print("inet_csum", size, misalign, runs, time);
+}
+
+int main(void)
+{
+    puts("Internet Checksum throughput\n");
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        ((uint8_t *)_buf)[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (unsigned i = 0; i < sizeof(_sizes) / sizeof(_sizes[0]); i++) {
+        _bench(_sizes[i], 0);
+        _bench(_sizes[i], 1);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
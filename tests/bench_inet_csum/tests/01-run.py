@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{name}\s+{size} byte \(\+{misalign}\):\s+\d+us --- \s*\d+ KiB/s"
+SIZES = (8, 20, 40, 64, 127, 256, 512, 1280)
+
+
+def testfunc(child):
+    child.expect_exact('Internet Checksum throughput')
+    for size in SIZES:
+        for misalign in (0, 1):
+            for name in ("bytewise", "inet_csum"):
+                child.expect(BENCHMARK_REGEXP.format(name=name, size=size,
+                                                     misalign=misalign),
+                             timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures encrypting and authenticating LoRaLAN frames with
+ *              the keys passed per frame and with the expanded keys of a
+ *              session
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "ls-crypto.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (2000UL)
+#endif
+
+static const uint8_t _sizes[] = { 16, 51, 115, 222 };
+static uint8_t _mic_key[LS_MIC_KEY_LEN];
+static uint8_t _aes_key[AES_KEY_SIZE];
+static ls_crypto_session_t _session;
+static ls_frame_t _frame;
+static ls_frame_t _copy;
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HAS_CYCLES          (1)
+static void _cycles_init(void)
+{
+}
+
+static inline uint64_t _cycles(void)
+{
+    return __builtin_ia32_rdtsc();
+}
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+#define HAS_CYCLES          (1)
+static void _cycles_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/* wraps after 2^32 cycles, keep BENCH_RUNS small on fast MCUs */
+static inline uint64_t _cycles(void)
+{
+    return DWT->CYCCNT;
+}
+#else
+#define HAS_CYCLES          (0)
+static void _cycles_init(void)
+{
+}
+
+static inline uint64_t _cycles(void)
+{
+    return 0;
+}
+#endif
+
+static void _frame_init(uint8_t size)
+{
+    memset(&_frame, 0, sizeof(_frame));
+    _frame.header.type = LS_UL_UNC;
+    _frame.header.dev_addr = 0x01020304;
+    _frame.header.fid = 42;
+    _frame.payload.len = size;
+    for (unsigned i = 0; i < size; i++) {
+        _frame.payload.data[i] = i;
+    }
+}
+
+static void _print(const char *name, uint8_t size, uint32_t time,
+                   uint64_t cycles)
+{
+    printf("%8s %3u byte: %8" PRIu32 "us --- %5" PRIu32 " us per frame",
+           name, (unsigned)size, time, (uint32_t)(time / BENCH_RUNS));
+    if (HAS_CYCLES) {
+        printf(", %7" PRIu32 " cycles per frame",
+               (uint32_t)(cycles / BENCH_RUNS));
+    }
+    puts("");
+}
+
+static void _bench(uint8_t size)
+{
+    uint32_t time;
+    uint64_t cycles;
+    size_t len;
+
+    /* both must produce the same frame */
+    _frame_init(size);
+    ls_encrypt_frame(_mic_key, _aes_key, &_frame, &len);
+    _copy = _frame;
+    _frame_init(size);
+    ls_session_encrypt_frame(&_session, &_frame, &len);
+    if (memcmp(&_copy, &_frame, sizeof(_frame)) ||
+        !ls_validate_frame_mic(_mic_key, &_frame)) {
+        printf("error: frames of %u byte differ\n", (unsigned)size);
+    }
+
+    time = xtimer_now_usec();
+    cycles = _cycles();
+    for (uint32_t i = 0; i < BENCH_RUNS; i++) {
+        ls_encrypt_frame(_mic_key, _aes_key, &_frame, &len);
+    }
+    cycles = _cycles() - cycles;
+    time = xtimer_now_usec() - time;
+    _print("keys", size, time, cycles);
+
+    time = xtimer_now_usec();
+    cycles = _cycles();
+    for (uint32_t i = 0; i < BENCH_RUNS; i++) {
+        ls_session_encrypt_frame(&_session, &_frame, &len);
+    }
+    cycles = _cycles() - cycles;
+    time = xtimer_now_usec() - time;
+    _print("session", size, time, cycles);
+}
+
+int main(void)
+{
+    puts("LoRaLAN frame encryption and MIC\n");
+
+    _cycles_init();
+    ls_derive_keys(0x12345678, 0x9abcdef0, 0x01020304, _mic_key, _aes_key);
+    ls_crypto_session_init(&_session, _mic_key, _aes_key);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        _bench(_sizes[i]);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       LoRaLAN frames per second whose MIC is validated by the
+ *              gateway, one at a time and in batches
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ls-crypto.h"
+#include "xtimer.h"
+
+#ifndef BENCH_FRAMES
+#define BENCH_FRAMES        (16U)
+#endif
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (256UL)
+#endif
+
+static const uint8_t _sizes[] = { 16, 51, 115, 222 };
+static uint8_t _keys[BENCH_FRAMES][LS_MIC_KEY_LEN];
+static ls_frame_t _frames[BENCH_FRAMES];
+static const uint8_t *_key_ptrs[BENCH_FRAMES];
+static ls_frame_t *_frame_ptrs[BENCH_FRAMES];
+static bool _valid[BENCH_FRAMES];
+
+/* a burst of frames from different nodes, each with its own key */
+static void _frames_init(uint8_t size)
+{
+    for (unsigned i = 0; i < BENCH_FRAMES; i++) {
+        ls_frame_t *frame = &_frames[i];
+        size_t len;
+
+        ls_derive_keys(0x12345678 + i, 0x9abcdef0, i + 1, _keys[i], NULL);
+        memset(frame, 0, sizeof(*frame));
+        frame->header.type = LS_UL_UNC;
+        frame->header.dev_addr = i + 1;
+        frame->header.fid = i;
+        frame->payload.len = size;
+        for (unsigned j = 0; j < size; j++) {
+            frame->payload.data[j] = i + j;
+        }
+        ls_encrypt_frame(_keys[i], _keys[i], frame, &len);
+        _key_ptrs[i] = _keys[i];
+        _frame_ptrs[i] = frame;
+    }
+}
+
+/* every frame is valid, but the forged one */
+static int _check(uint8_t size)
+{
+    unsigned forged = BENCH_FRAMES / 2;
+
+    _frames[forged].header.mic ^= 1;
+    ls_validate_frames_mic(_key_ptrs, _frame_ptrs, _valid, BENCH_FRAMES);
+    for (unsigned i = 0; i < BENCH_FRAMES; i++) {
+        bool expected = (i != forged);
+
+        if ((_valid[i] != expected) ||
+            (ls_validate_frame_mic(_keys[i], &_frames[i]) != expected)) {
+            printf("error: MIC of frame %u of %u byte\n", i, (unsigned)size);
+            return 1;
+        }
+    }
+    _frames[forged].header.mic ^= 1;
+    return 0;
+}
+
+static void _print(const char *name, uint8_t size, uint32_t time)
+{
+    printf("%6s %3u byte: %8" PRIu32 "us --- %7" PRIu32 " frames/s\n",
+           name, (unsigned)size, time,
+           (uint32_t)(((uint64_t)BENCH_RUNS * BENCH_FRAMES * US_PER_SEC) /
+                      (time ? time : 1)));
+}
+
+static int _bench(uint8_t size)
+{
+    uint32_t time;
+
+    _frames_init(size);
+    if (_check(size)) {
+        return 1;
+    }
+
+    time = xtimer_now_usec();
+    for (uint32_t n = 0; n < BENCH_RUNS; n++) {
+        for (unsigned i = 0; i < BENCH_FRAMES; i++) {
+            _valid[i] = ls_validate_frame_mic(_keys[i], &_frames[i]);
+        }
+    }
+    time = xtimer_now_usec() - time;
+    _print("frame", size, time);
+
+    time = xtimer_now_usec();
+    for (uint32_t n = 0; n < BENCH_RUNS; n++) {
+        ls_validate_frames_mic(_key_ptrs, _frame_ptrs, _valid, BENCH_FRAMES);
+    }
+    time = xtimer_now_usec() - time;
+    _print("batch", size, time);
+
+    return 0;
+}
+
+int main(void)
+{
+    printf("LoRaLAN MIC validation of %u frames, %u SHA-256 lanes\n\n",
+           BENCH_FRAMES, SHA256_MB_LANES);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        if (_bench(_sizes[i])) {
+            return 1;
+        }
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
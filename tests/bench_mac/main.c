@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       MACs per second of HMAC-SHA256 and AES-CMAC, with the key set
+ *              up per message and precomputed once
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/cmac.h"
+#include "hashes/sha256.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (4096UL)
+#endif
+
+#define BUF_SIZE            (256U)
+
+/* LoRaLAN frames, CoAP and OSCORE messages */
+static const uint16_t _sizes[] = { 16, 32, 64, 128, 256 };
+static uint8_t _in[BUF_SIZE];
+static uint8_t _mac[SHA256_DIGEST_LENGTH];
+
+/* RFC 4231, test case 2 */
+static const char _hmac_key[] = "Jefe";
+static const char _hmac_msg[] = "what do ya want for nothing?";
+static const uint8_t _hmac_exp[SHA256_DIGEST_LENGTH] = {
+    0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e,
+    0x6a, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xc7,
+    0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27, 0x39, 0x83,
+    0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43
+};
+
+/* RFC 4493, example 2 */
+static const uint8_t _cmac_key[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const uint8_t _cmac_msg[16] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+    0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a
+};
+static const uint8_t _cmac_exp[CMAC_BLOCK_SIZE] = {
+    0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44,
+    0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c
+};
+
+static hmac_sha256_key_t _hmac_pre;
+static cmac_key_t _cmac_pre;
+
+static void _print(const char *name, uint16_t size, uint32_t time)
+{
+    printf("%9s %4u byte: %8" PRIu32 "us --- %7" PRIu32 " MAC/s\n",
+           name, (unsigned)size, time,
+           (uint32_t)(((uint64_t)BENCH_RUNS * US_PER_SEC) /
+                      (time ? time : 1)));
+}
+
+static void _hmac(const void *data, size_t len)
+{
+    hmac_context_t ctx;
+
+    hmac_sha256_init(&ctx, _hmac_key, sizeof(_hmac_key) - 1);
+    hmac_sha256_update(&ctx, data, len);
+    hmac_sha256_final(&ctx, _mac);
+}
+
+static void _hmac_key_pre(const void *data, size_t len)
+{
+    hmac_context_t ctx;
+
+    hmac_sha256_init_key(&ctx, &_hmac_pre);
+    hmac_sha256_update(&ctx, data, len);
+    hmac_sha256_final(&ctx, _mac);
+}
+
+static void _cmac(const void *data, size_t len)
+{
+    cmac_context_t ctx;
+
+    cmac_init(&ctx, _cmac_key, sizeof(_cmac_key));
+    cmac_update(&ctx, data, len);
+    cmac_final(&ctx, _mac);
+}
+
+static void _cmac_key_pre(const void *data, size_t len)
+{
+    cmac_context_t ctx;
+
+    cmac_init_key(&ctx, &_cmac_pre);
+    cmac_update(&ctx, data, len);
+    cmac_final(&ctx, _mac);
+}
+
+static const struct {
+    const char *name;
+    void (*mac)(const void *data, size_t len);
+    const void *msg;
+    size_t msg_len;
+    const uint8_t *exp;
+    size_t exp_len;
+} _macs[] = {
+    { "hmac", _hmac, _hmac_msg, sizeof(_hmac_msg) - 1,
+      _hmac_exp, sizeof(_hmac_exp) },
+    { "hmac_key", _hmac_key_pre, _hmac_msg, sizeof(_hmac_msg) - 1,
+      _hmac_exp, sizeof(_hmac_exp) },
+    { "cmac", _cmac, _cmac_msg, sizeof(_cmac_msg),
+      _cmac_exp, sizeof(_cmac_exp) },
+    { "cmac_key", _cmac_key_pre, _cmac_msg, sizeof(_cmac_msg),
+      _cmac_exp, sizeof(_cmac_exp) },
+};
+
+int main(void)
+{
+    puts("HMAC-SHA256 and AES-CMAC, key per message and precomputed\n");
+
+    hmac_sha256_key_init(&_hmac_pre, _hmac_key, sizeof(_hmac_key) - 1);
+    cmac_key_init(&_cmac_pre, _cmac_key, sizeof(_cmac_key));
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_macs); i++) {
+        _macs[i].mac(_macs[i].msg, _macs[i].msg_len);
+        if (memcmp(_mac, _macs[i].exp, _macs[i].exp_len)) {
+            printf("error: wrong %s\n", _macs[i].name);
+            return 1;
+        }
+    }
+
+    for (unsigned i = 0; i < sizeof(_in); i++) {
+        _in[i] = i;
+    }
+    for (unsigned s = 0; s < ARRAY_SIZE(_sizes); s++) {
+        for (unsigned i = 0; i < ARRAY_SIZE(_macs); i++) {
+            uint32_t time = xtimer_now_usec();
+
+            for (uint32_t n = 0; n < BENCH_RUNS; n++) {
+                _macs[i].mac(_in, _sizes[s]);
+            }
+            time = xtimer_now_usec() - time;
+            _print(_macs[i].name, _sizes[s], time);
+        }
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
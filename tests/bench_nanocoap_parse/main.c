@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures parsing and dispatching typical sensor requests with
+ *              nanocoap
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100000UL)
+#endif
+
+#define BUF_SIZE            (128U)
+
+typedef struct {
+    const char *name;           /**< name of the request in the output */
+    uint8_t buf[BUF_SIZE];      /**< the request */
+    size_t len;                 /**< length of the request */
+} _req_t;
+
+static uint8_t _resp[BUF_SIZE];
+static volatile unsigned _sink;
+
+/* reads the options a sensor would look at, then replies */
+static ssize_t _sensor_handler(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                               void *context)
+{
+    uint8_t *value;
+    uint32_t blknum;
+    unsigned szx;
+    unsigned format = COAP_FORMAT_TEXT;
+    (void)context;
+
+    if (coap_opt_get_opaque(pkt, COAP_OPT_ACCEPT, &value) == 1) {
+        format = *value;
+    }
+    _sink = coap_get_content_type(pkt) +
+            (coap_opt_get_opaque(pkt, COAP_OPT_OBSERVE, &value) >= 0) +
+            coap_get_blockopt(pkt, COAP_OPT_BLOCK2, &blknum, &szx) +
+            (coap_opt_get_opaque(pkt, COAP_OPT_ETAG, &value) > 0);
+
+    return coap_reply_simple(pkt, COAP_CODE_205, buf, len, format,
+                             (uint8_t *)"21.5", 4);
+}
+
+static ssize_t _config_handler(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                               void *context)
+{
+    uint8_t query[NANOCOAP_URI_MAX];
+    (void)context;
+
+    _sink = coap_get_content_type(pkt) +
+            coap_get_uri_query(pkt, query);
+    return coap_reply_simple(pkt, COAP_CODE_CHANGED, buf, len, 0, NULL, 0);
+}
+
+/* ordered by path */
+const coap_resource_t coap_resources[] = {
+    COAP_WELL_KNOWN_CORE_DEFAULT_HANDLER,
+    { "/config/interval", COAP_PUT, _config_handler, NULL },
+    { "/fw/image", COAP_GET, _sensor_handler, NULL },
+    { "/sensors/humidity", COAP_GET, _sensor_handler, NULL },
+    { "/sensors/temp", COAP_GET, _sensor_handler, NULL },
+};
+
+const unsigned coap_resources_numof = ARRAY_SIZE(coap_resources);
+
+static _req_t _reqs[] = {
+    { .name = "get" },
+    { .name = "get-accept" },
+    { .name = "observe" },
+    { .name = "block2" },
+    { .name = "put-query" },
+};
+
+static void _build(_req_t *req, unsigned type, unsigned code, uint8_t tkl)
+{
+    static const uint8_t token[] = { 0xDA, 0xEC, 0x1F, 0x2E };
+    coap_pkt_t pkt;
+    size_t len;
+
+    len = coap_build_hdr((coap_hdr_t *)req->buf, type, (uint8_t *)token, tkl,
+                         code, 0x1234);
+    coap_pkt_init(&pkt, req->buf, sizeof(req->buf), len);
+
+    if (req == &_reqs[0]) {
+        coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, "/sensors/temp", '/');
+    }
+    else if (req == &_reqs[1]) {
+        coap_opt_add_string(&pkt, COAP_OPT_URI_HOST, "sensor.local", 0);
+        coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, "/sensors/humidity", '/');
+        coap_opt_add_uint(&pkt, COAP_OPT_ACCEPT, COAP_FORMAT_CBOR);
+    }
+    else if (req == &_reqs[2]) {
+        coap_opt_add_uint(&pkt, COAP_OPT_OBSERVE, 0);
+        coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, "/sensors/temp", '/');
+        coap_opt_add_uint(&pkt, COAP_OPT_ACCEPT, COAP_FORMAT_TEXT);
+    }
+    else if (req == &_reqs[3]) {
+        coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, "/fw/image", '/');
+        coap_opt_add_uint(&pkt, COAP_OPT_BLOCK2, (37 << 4) | 2);
+    }
+    else {
+        coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, "/config/interval", '/');
+        coap_opt_add_uint(&pkt, COAP_OPT_CONTENT_FORMAT, COAP_FORMAT_TEXT);
+        coap_opt_add_string(&pkt, COAP_OPT_URI_QUERY, "unit=s&persist=1", '&');
+    }
+    if (code == COAP_METHOD_PUT) {
+        req->len = coap_opt_finish(&pkt, COAP_OPT_FINISH_PAYLOAD);
+        memcpy(pkt.payload, "60", 2);
+        req->len += 2;
+    }
+    else {
+        req->len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+    }
+}
+
+static void _bench(const _req_t *req)
+{
+    uint8_t buf[BUF_SIZE];
+    coap_pkt_t pkt;
+    uint32_t time;
+    unsigned failed = 0;
+
+    time = xtimer_now_usec();
+    for (uint32_t i = 0; i < BENCH_RUNS; i++) {
+        /* parsing in place would not leave the request intact */
+        memcpy(buf, req->buf, req->len);
+        if ((coap_parse(&pkt, buf, req->len) < 0) ||
+            (coap_handle_req(&pkt, _resp, sizeof(_resp)) <= 0)) {
+            failed++;
+        }
+    }
+    time = xtimer_now_usec() - time;
+
+    printf("%12s %3u byte: %8" PRIu32 "us --- %5" PRIu32 " ns per request",
+           req->name, (unsigned)req->len, time,
+           (uint32_t)(((uint64_t)time * 1000) / BENCH_RUNS));
+    if (failed) {
+        printf(", %u failed", failed);
+    }
+    puts("");
+}
+
+int main(void)
+{
+    puts("nanocoap parse and dispatch\n");
+
+    _build(&_reqs[0], COAP_TYPE_NON, COAP_METHOD_GET, 2);
+    _build(&_reqs[1], COAP_TYPE_CON, COAP_METHOD_GET, 4);
+    _build(&_reqs[2], COAP_TYPE_NON, COAP_METHOD_GET, 4);
+    _build(&_reqs[3], COAP_TYPE_CON, COAP_METHOD_GET, 2);
+    _build(&_reqs[4], COAP_TYPE_CON, COAP_METHOD_PUT, 2);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_reqs); i++) {
+        _bench(&_reqs[i]);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{name}\s+\d+ byte:\s+\d+us --- \s*\d+ ns per request\r\n"
+REQUESTS = ("get", "get-accept", "observe", "block2", "put-query")
+
+
+def testfunc(child):
+    child.expect_exact('nanocoap parse and dispatch')
+    for name in REQUESTS:
+        # a failed request is reported after the time, and does not match
+        child.expect(BENCHMARK_REGEXP.format(name=name), timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
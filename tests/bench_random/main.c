@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Random numbers per second drawn by several threads at once
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "random.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_THREADS
+#define BENCH_THREADS       (4U)
+#endif
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+/* numbers drawn by a thread before it yields to the next one */
+#define BATCH               (64U)
+
+enum {
+    MODE_UINT32,    /**< random_uint32() */
+    MODE_LOCKED,    /**< random_uint32() behind a mutex */
+    MODE_BYTES,     /**< random_bytes() of BATCH numbers */
+};
+
+static const char *_names[] = { "uint32", "uint32+mutex", "bytes" };
+
+static char _stacks[BENCH_THREADS][THREAD_STACKSIZE_DEFAULT];
+static uint32_t _count[BENCH_THREADS];
+static volatile unsigned _flag;
+static unsigned _mode;
+static mutex_t _lock = MUTEX_INIT;
+/* keeps the compiler from dropping the calls */
+static volatile uint32_t _sink;
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static void *_worker(void *arg)
+{
+    uint32_t *count = arg;
+    uint32_t buf[BATCH];
+
+    while (!_flag) {
+        switch (_mode) {
+            case MODE_UINT32:
+                for (unsigned i = 0; i < BATCH; i++) {
+                    _sink = random_uint32();
+                }
+                break;
+            case MODE_LOCKED:
+                for (unsigned i = 0; i < BATCH; i++) {
+                    mutex_lock(&_lock);
+                    _sink = random_uint32();
+                    mutex_unlock(&_lock);
+                }
+                break;
+            default:
+                random_bytes((uint8_t *)buf, sizeof(buf));
+                _sink = buf[BATCH - 1];
+                break;
+        }
+        *count += BATCH;
+        thread_yield();
+    }
+
+    return NULL;
+}
+
+static void _bench(unsigned mode, unsigned threads)
+{
+    xtimer_t timer = { .callback = _timer_callback };
+    uint64_t total = 0;
+    uint32_t time;
+
+    _mode = mode;
+    _flag = 0;
+    memset(_count, 0, sizeof(_count));
+
+    for (unsigned i = 0; i < threads; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]),
+                      THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_WOUT_YIELD,
+                      _worker, &_count[i], "worker");
+    }
+
+    /* the workers run until the timer fires, then they exit */
+    time = xtimer_now_usec();
+    xtimer_set(&timer, TEST_DURATION);
+    thread_yield_higher();
+    time = xtimer_now_usec() - time;
+
+    for (unsigned i = 0; i < threads; i++) {
+        total += _count[i];
+    }
+    printf("%12s %u threads: %9" PRIu32 " numbers/s\n", _names[mode],
+           threads, (uint32_t)((total * US_PER_SEC) / (time ? time : 1)));
+}
+
+int main(void)
+{
+    uint32_t numbers[2];
+    uint32_t bytes[2];
+
+    puts("PRNG throughput of concurrent threads\n");
+
+    random_init(1);
+    numbers[0] = random_uint32();
+    numbers[1] = random_uint32();
+    random_init(1);
+    random_bytes((uint8_t *)bytes, sizeof(bytes));
+    if (memcmp(numbers, bytes, sizeof(bytes))) {
+        puts("error: random_bytes differs from random_uint32");
+        return 1;
+    }
+
+    for (unsigned mode = MODE_UINT32; mode <= MODE_BYTES; mode++) {
+        _bench(mode, 1);
+        _bench(mode, BENCH_THREADS);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
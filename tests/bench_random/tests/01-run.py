@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 30
+BENCHMARK_REGEXP = (r"\s*{name} \d+ threads:\s+\d+ numbers/s\r\n")
+
+
+def testfunc(child):
+    child.expect_exact('PRNG throughput of concurrent threads')
+    for name in ('uint32', r'uint32\+mutex', 'bytes'):
+        for _ in range(2):
+            child.expect(BENCHMARK_REGEXP.format(name=name), timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+# Sets up a chain of native nodes connected by point-to-point ZEP links,
+# pings from one end to the other with fragmented datagrams and reports the
+# round-trip time and the packet buffer high-water mark of every forwarder.
+
+import os
+import re
+import sys
+
+import pexpect
+
+HOPS = int(os.environ.get("HOPS", 5))
+PAYLOAD = int(os.environ.get("PAYLOAD", 400))
+COUNT = int(os.environ.get("COUNT", 20))
+BASE_PORT = int(os.environ.get("BASE_PORT", 17800))
+PREFIX = "2001:db8::"
+TIMEOUT = 10
+
+
+def _port(node, side):
+    # local port of the left (0) or right (1) interface of node
+    return BASE_PORT + 2 * node + side
+
+
+def spawn(elf, node, nodes):
+    # the unused outer interfaces of the end nodes point to unbound ports
+    left_remote = _port(node - 1, 1) if node > 0 else _port(nodes, 0)
+    right_remote = _port(node + 1, 0) if node < (nodes - 1) else _port(nodes, 1)
+    cmd = "{} -z [::1]:{},[::1]:{} -z [::1]:{},[::1]:{}".format(
+        elf, _port(node, 0), left_remote, _port(node, 1), right_remote)
+    child = pexpect.spawnu(cmd, timeout=TIMEOUT)
+    child.expect("6LoWPAN fragment forwarding benchmark node")
+    return child
+
+
+def interfaces(child):
+    child.sendline("ifconfig")
+    child.expect(r"Iface\s+(\d+)")
+    ifaces = []
+    iface = int(child.match.group(1))
+    while True:
+        child.expect(r"Long HWaddr: ([0-9A-Fa-f:]+)")
+        hwaddr = child.match.group(1)
+        child.expect(r"inet6 addr: (fe80::[0-9a-f:]+)\s+scope: local")
+        ifaces.append((iface, hwaddr, child.match.group(1)))
+        if child.expect([r"Iface\s+(\d+)", r"> $"]) == 1:
+            break
+        iface = int(child.match.group(1))
+    return sorted(ifaces)
+
+
+def cmd(child, line):
+    child.sendline(line)
+    child.expect("> ")
+
+
+def setup_chain(nodes):
+    infos = [interfaces(child) for child in nodes]
+    last = len(nodes) - 1
+    cmd(nodes[0], "ifconfig {} add {}1/128".format(infos[0][1][0], PREFIX))
+    cmd(nodes[last], "ifconfig {} add {}{:x}/128".format(infos[last][0][0],
+                                                       PREFIX, last + 1))
+    for i, child in enumerate(nodes):
+        if i > 0:
+            # route towards the source via the left neighbor
+            iface = infos[i][0][0]
+            hwaddr, ll_addr = infos[i - 1][1][1:]
+            cmd(child, "nib neigh add {} {} {}".format(iface, ll_addr, hwaddr))
+            cmd(child, "nib route add {} {}1/128 {}".format(iface, PREFIX,
+                                                            ll_addr))
+        if i < last:
+            # route towards the sink via the right neighbor
+            iface = infos[i][1][0]
+            hwaddr, ll_addr = infos[i + 1][0][1:]
+            cmd(child, "nib neigh add {} {} {}".format(iface, ll_addr, hwaddr))
+            cmd(child, "nib route add {} {}{:x}/128 {}".format(iface, PREFIX,
+                                                               last + 1,
+                                                               ll_addr))
+
+
+def ping(child, dst):
+    child.sendline("ping6 {} {} {}".format(COUNT, dst, PAYLOAD))
+    child.expect(r"(\d+) packets transmitted, (\d+) received",
+                 timeout=COUNT * TIMEOUT)
+    received = int(child.match.group(2))
+    if received == 0:
+        return received, None
+    child.expect(r"rtt min/avg/max = [\d.]+/([\d.]+)/[\d.]+ ms")
+    return received, float(child.match.group(1))
+
+
+def pktbuf_high_water(child):
+    child.sendline("pktbuf")
+    child.expect(r"position of last byte used: (\d+)")
+    return int(child.match.group(1))
+
+
+def main():
+    elf = os.environ["ELFFILE"]
+    nodes = []
+    try:
+        for i in range(HOPS + 1):
+            nodes.append(spawn(elf, i, HOPS + 1))
+        setup_chain(nodes)
+        # warm up neighbor caches
+        ping(nodes[0], "{}{:x}".format(PREFIX, HOPS + 1))
+        received, avg = ping(nodes[0], "{}{:x}".format(PREFIX, HOPS + 1))
+        print("{{ \"hops\": {}, \"payload\": {}, \"received\": {}/{}, "
+              "\"rtt_avg_ms\": {} }}".format(HOPS, PAYLOAD, received, COUNT,
+                                             avg))
+        for i, child in enumerate(nodes[1:-1], start=1):
+            print("{{ \"node\": {}, \"pktbuf_high_water\": {} }}"
+                  .format(i, pktbuf_high_water(child)))
+        return 0 if received > 0 else 1
+    finally:
+        for child in nodes:
+            child.terminate(force=True)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare the copying, gathering and zero-copy send paths of
+ *              sock_udp on GNRC
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iolist.h"
+#include "net/af.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#ifndef BENCH_PACKETS
+#define BENCH_PACKETS       (10000UL)
+#endif
+
+#define MAX_BODY_SIZE       (1024U)
+
+/**
+ * @brief   Application header, sent in front of each body
+ */
+typedef struct {
+    uint32_t seq;                       /**< sequence number */
+    uint32_t len;                       /**< length of the body */
+} _app_hdr_t;
+
+typedef ssize_t (*_send_t)(sock_udp_t *sock, _app_hdr_t *hdr);
+
+static const uint16_t _sizes[] = { 16, 64, 256, 512, 1024 };
+static uint8_t _body[MAX_BODY_SIZE];
+static uint8_t _msg[sizeof(_app_hdr_t) + MAX_BODY_SIZE];
+
+/* concatenates header and body, the stack copies the result again */
+static ssize_t _send(sock_udp_t *sock, _app_hdr_t *hdr)
+{
+    memcpy(_msg, hdr, sizeof(*hdr));
+    memcpy(&_msg[sizeof(*hdr)], _body, hdr->len);
+    return sock_udp_send(sock, _msg, sizeof(*hdr) + hdr->len, NULL);
+}
+
+/* the stack gathers header and body into the packet */
+static ssize_t _sendv(sock_udp_t *sock, _app_hdr_t *hdr)
+{
+    iolist_t body = { .iol_next = NULL, .iol_base = _body,
+                      .iol_len = hdr->len };
+    iolist_t head = { .iol_next = &body, .iol_base = hdr,
+                      .iol_len = sizeof(*hdr) };
+
+    return sock_udp_sendv(sock, &head, NULL);
+}
+
+/* the message is built in the packet buffer, as if the body was produced
+ * there directly (e.g. by reading a sensor) */
+static ssize_t _send_pkt(sock_udp_t *sock, _app_hdr_t *hdr)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add(NULL, NULL,
+                                              sizeof(*hdr) + hdr->len,
+                                              GNRC_NETTYPE_UNDEF);
+
+    if (payload == NULL) {
+        return -ENOMEM;
+    }
+    memcpy(payload->data, hdr, sizeof(*hdr));
+    memset((uint8_t *)payload->data + sizeof(*hdr), 'x', hdr->len);
+    return gnrc_sock_udp_send_pkt(sock, payload, NULL);
+}
+
+static const struct {
+    const char *name;
+    _send_t send;
+    unsigned copies;        /**< payload copies per packet */
+} _variants[] = {
+    { "send", _send, 2 },
+    { "sendv", _sendv, 1 },
+    { "send_pkt", _send_pkt, 0 },
+};
+
+int main(void)
+{
+    sock_udp_t sock;
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = 5683,
+                             .netif = SOCK_ADDR_ANY_NETIF };
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    int res;
+
+    /* 2001:db8::1, unreachable */
+    remote.addr.ipv6[0] = 0x20;
+    remote.addr.ipv6[1] = 0x01;
+    remote.addr.ipv6[2] = 0x0d;
+    remote.addr.ipv6[3] = 0xb8;
+    remote.addr.ipv6[15] = 0x01;
+    local.port = 5683;
+    if ((res = sock_udp_create(&sock, &local, &remote, 0)) < 0) {
+        printf("sock_udp_create() : %d\n", res);
+        return 1;
+    }
+    memset(_body, 'x', sizeof(_body));
+
+    printf("sock_udp send path: %lu packets per measurement\n",
+           (unsigned long)BENCH_PACKETS);
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        for (unsigned j = 0; j < ARRAY_SIZE(_variants); j++) {
+            _app_hdr_t hdr = { .len = _sizes[i] };
+            uint32_t start = xtimer_now_usec();
+
+            for (hdr.seq = 0; hdr.seq < BENCH_PACKETS; hdr.seq++) {
+                if ((res = _variants[j].send(&sock, &hdr)) < 0) {
+                    printf("%s: error %d\n", _variants[j].name, res);
+                    return 1;
+                }
+            }
+            uint32_t time = xtimer_now_usec() - start;
+            printf("%10s %4u byte: %u copies/packet --- %8" PRIu32 " packets/s\n",
+                   _variants[j].name, _sizes[i], _variants[j].copies,
+                   (uint32_t)(((uint64_t)BENCH_PACKETS * US_PER_SEC) /
+                              (time ? time : 1)));
+        }
+    }
+    sock_udp_close(&sock);
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{name}\s+{size} byte:\s+{copies} copies/packet --- \s*\d+ packets/s"
+SIZES = (16, 64, 256, 512, 1024)
+VARIANTS = (("send", 2), ("sendv", 1), ("send_pkt", 0))
+
+
+def testfunc(child):
+    child.expect_exact('sock_udp send path')
+    for size in SIZES:
+        for name, copies in VARIANTS:
+            child.expect(BENCHMARK_REGEXP.format(name=name, size=size,
+                                                 copies=copies),
+                         timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the sock DNS cache against a stub resolver on the loopback
+ *              address
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <arpa/inet.h>
+
+#include "msg.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/dns.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SERVER_PORT         (5353U)
+#define NEG_TTL             (2U)
+#define SLOW_DELAY          (200U * US_PER_MS)
+
+#define CHECK(cond) \
+    if (!(cond)) { \
+        printf("FAILED line %d: %s\n", __LINE__, #cond); \
+        _failed++; \
+    }
+
+typedef struct {
+    const char *name;
+    uint16_t type;
+    uint32_t ttl;
+    uint32_t delay;             /**< time to wait before answering [in us] */
+    uint8_t addr[16];
+} _record_t;
+
+static const _record_t _records[] = {
+    { "broker.example", DNS_TYPE_AAAA, 300, 0,
+      { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x01 } },
+    { "ntp.example", DNS_TYPE_A, 300, 0, { 192, 0, 2, 123 } },
+    { "short.example", DNS_TYPE_AAAA, 1, 0,
+      { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x02 } },
+    { "slow.example", DNS_TYPE_AAAA, 300, SLOW_DELAY,
+      { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x03 } },
+};
+
+static char _server_stack[THREAD_STACKSIZE_MAIN];
+static char _client_stacks[2][THREAD_STACKSIZE_MAIN];
+static volatile unsigned _queries;
+static unsigned _failed;
+
+static size_t _put(uint8_t *buf, uint32_t val, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = val >> (8 * (len - 1 - i));
+    }
+    return len;
+}
+
+/* answers a query for one name, returns the length of the reply */
+static size_t _answer(uint8_t *buf, size_t len, uint32_t *delay)
+{
+    sock_dns_hdr_t *hdr = (sock_dns_hdr_t *)buf;
+    char name[SOCK_DNS_MAX_NAME_LEN + 1];
+    size_t pos = sizeof(*hdr), name_len = 0;
+    const _record_t *record = NULL;
+    bool exists = false;
+
+    /* decode "\6broker\7example" to "broker.example" */
+    while ((pos < len) && buf[pos]) {
+        unsigned part = buf[pos++];
+        if ((name_len + part + 1 > sizeof(name)) || (pos + part > len)) {
+            return 0;
+        }
+        if (name_len) {
+            name[name_len++] = '.';
+        }
+        memcpy(&name[name_len], &buf[pos], part);
+        name_len += part;
+        pos += part;
+    }
+    name[name_len] = '\0';
+    pos += 1;
+    if (pos + 4 > len) {
+        return 0;
+    }
+    uint16_t type = (buf[pos] << 8) | buf[pos + 1];
+    pos += 4;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_records); i++) {
+        if (strcmp(_records[i].name, name) == 0) {
+            exists = true;
+            if (_records[i].type == type) {
+                record = &_records[i];
+            }
+        }
+    }
+
+    *delay = record ? record->delay : 0;
+    hdr->flags = htons(0x8180 | (exists ? 0 : 3));
+    hdr->qdcount = htons(1);
+    hdr->ancount = htons(record ? 1 : 0);
+    hdr->nscount = htons(record ? 0 : 1);
+    hdr->arcount = 0;
+    /* name pointer to the question */
+    pos += _put(&buf[pos], 0xc00c, 2);
+    if (record) {
+        unsigned addrlen = (type == DNS_TYPE_A) ? 4 : 16;
+
+        pos += _put(&buf[pos], type, 2);
+        pos += _put(&buf[pos], DNS_CLASS_IN, 2);
+        pos += _put(&buf[pos], record->ttl, 4);
+        pos += _put(&buf[pos], addrlen, 2);
+        memcpy(&buf[pos], record->addr, addrlen);
+        pos += addrlen;
+    }
+    else {
+        /* SOA with empty names, serial, refresh, retry, expire and minimum */
+        pos += _put(&buf[pos], DNS_TYPE_SOA, 2);
+        pos += _put(&buf[pos], DNS_CLASS_IN, 2);
+        pos += _put(&buf[pos], 3600, 4);
+        pos += _put(&buf[pos], 22, 2);
+        pos += _put(&buf[pos], 0, 2);
+        pos += _put(&buf[pos], 1, 4);
+        pos += _put(&buf[pos], 3600, 4);
+        pos += _put(&buf[pos], 600, 4);
+        pos += _put(&buf[pos], 86400, 4);
+        pos += _put(&buf[pos], NEG_TTL, 4);
+    }
+    return pos;
+}
+
+static void *_server(void *arg)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t remote;
+    sock_udp_t sock;
+    uint8_t buf[256];
+    (void)arg;
+
+    local.port = SERVER_PORT;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("error: unable to create the server sock");
+        return NULL;
+    }
+    while (1) {
+        ssize_t len = sock_udp_recv(&sock, buf, sizeof(buf) - 64,
+                                    SOCK_NO_TIMEOUT, &remote);
+        uint32_t delay;
+
+        if (len <= 0) {
+            continue;
+        }
+        _queries++;
+        len = _answer(buf, len, &delay);
+        if (len > 0) {
+            if (delay) {
+                xtimer_usleep(delay);
+            }
+            sock_udp_send(&sock, buf, len, &remote);
+        }
+    }
+    return NULL;
+}
+
+static void *_client(void *arg)
+{
+    kernel_pid_t main_pid = (kernel_pid_t)(intptr_t)arg;
+    uint8_t addr[16];
+    msg_t msg;
+
+    msg.content.value = sock_dns_query("slow.example", addr, AF_INET6);
+    if ((int)msg.content.value == 16) {
+        msg.content.value = (memcmp(addr, _records[3].addr, 16) == 0) ? 16 : 0;
+    }
+    msg_send(&msg, main_pid);
+    return NULL;
+}
+
+static void test_positive(void)
+{
+    uint8_t addr[16];
+    unsigned queries = _queries;
+
+    CHECK(sock_dns_query("broker.example", addr, AF_INET6) == 16);
+    CHECK(memcmp(addr, _records[0].addr, 16) == 0);
+    memset(addr, 0, sizeof(addr));
+    CHECK(sock_dns_query("broker.example", addr, AF_INET6) == 16);
+    CHECK(memcmp(addr, _records[0].addr, 16) == 0);
+    CHECK(sock_dns_query("ntp.example", addr, AF_INET) == 4);
+    CHECK(memcmp(addr, _records[1].addr, 4) == 0);
+    CHECK(sock_dns_query("ntp.example", addr, AF_INET) == 4);
+    CHECK(_queries == queries + 2);
+}
+
+static void test_negative(void)
+{
+    uint8_t addr[16];
+    unsigned queries = _queries;
+
+    /* no such name */
+    CHECK(sock_dns_query("missing.example", addr, AF_INET6) == -EHOSTUNREACH);
+    CHECK(sock_dns_query("missing.example", addr, AF_INET6) == -EHOSTUNREACH);
+    /* no address of that family */
+    CHECK(sock_dns_query("broker.example", addr, AF_INET) == -EHOSTUNREACH);
+    CHECK(sock_dns_query("broker.example", addr, AF_INET) == -EHOSTUNREACH);
+    CHECK(_queries == queries + 2);
+}
+
+static void test_expiry(void)
+{
+    uint8_t addr[16];
+    unsigned queries;
+
+    sock_dns_cache_flush();
+    queries = _queries;
+    CHECK(sock_dns_query("short.example", addr, AF_INET6) == 16);
+    CHECK(sock_dns_query("missing.example", addr, AF_INET6) == -EHOSTUNREACH);
+    CHECK(sock_dns_query("short.example", addr, AF_INET6) == 16);
+    CHECK(sock_dns_query("missing.example", addr, AF_INET6) == -EHOSTUNREACH);
+    CHECK(_queries == queries + 2);
+    /* both TTLs run out */
+    xtimer_usleep((NEG_TTL + 1) * US_PER_SEC);
+    CHECK(sock_dns_query("short.example", addr, AF_INET6) == 16);
+    CHECK(sock_dns_query("missing.example", addr, AF_INET6) == -EHOSTUNREACH);
+    CHECK(_queries == queries + 4);
+}
+
+static void test_coalesce(void)
+{
+    sock_dns_cache_stats_t before, after;
+    unsigned queries = _queries;
+    msg_t msg;
+
+    sock_dns_cache_stats(&before);
+    for (unsigned i = 0; i < ARRAY_SIZE(_client_stacks); i++) {
+        thread_create(_client_stacks[i], sizeof(_client_stacks[i]),
+                      THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                      _client, (void *)(intptr_t)thread_getpid(), "client");
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_client_stacks); i++) {
+        msg_receive(&msg);
+        CHECK(msg.content.value == 16);
+    }
+    sock_dns_cache_stats(&after);
+    CHECK(_queries == queries + 1);
+    CHECK(after.coalesced == before.coalesced + 1);
+}
+
+static void test_eviction(void)
+{
+    sock_dns_cache_stats_t before, after;
+    uint8_t addr[16];
+    char name[16];
+
+    sock_dns_cache_flush();
+    sock_dns_cache_stats(&before);
+    for (unsigned i = 0; i <= SOCK_DNS_CACHE_SIZE; i++) {
+        snprintf(name, sizeof(name), "gone%u.example", i);
+        CHECK(sock_dns_query(name, addr, AF_INET6) == -EHOSTUNREACH);
+    }
+    sock_dns_cache_stats(&after);
+    CHECK(after.misses == before.misses + SOCK_DNS_CACHE_SIZE + 1);
+    CHECK(after.evictions == before.evictions + 1);
+}
+
+int main(void)
+{
+    sock_dns_cache_stats_t stats;
+
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST, _server,
+                  NULL, "resolver");
+    ipv6_addr_set_loopback((ipv6_addr_t *)&sock_dns_server.addr.ipv6);
+    sock_dns_server.family = AF_INET6;
+    sock_dns_server.port = SERVER_PORT;
+
+    test_positive();
+    test_negative();
+    test_expiry();
+    test_coalesce();
+    test_eviction();
+
+    sock_dns_cache_stats(&stats);
+    printf("hits %u, negative %u, misses %u, coalesced %u, evictions %u\n",
+           (unsigned)stats.hits, (unsigned)stats.neg_hits,
+           (unsigned)stats.misses, (unsigned)stats.coalesced,
+           (unsigned)stats.evictions);
+    if (_failed) {
+        printf("[FAILED] %u checks\n", _failed);
+    }
+    else {
+        puts("[SUCCESS]");
+    }
+    return 0;
+}
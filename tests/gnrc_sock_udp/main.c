@@ -22,6 +22,8 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "iolist.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/sock/udp.h"
 #include "xtimer.h"
 
@@ -693,6 +695,61 @@ static void test_sock_udp_send__no_sock(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_sendv__socketed(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t tail = { .iol_next = NULL, .iol_base = "CD",
+                      .iol_len = sizeof("CD") };
+    iolist_t head = { .iol_next = &tail, .iol_base = "AB", .iol_len = 2 };
+
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    assert(sizeof("ABCD") == sock_udp_sendv(&_sock, &head, NULL));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
+static void test_sock_udp_send_pkt__ENOTCONN(void)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add(NULL, "ABCD", sizeof("ABCD"),
+                                              GNRC_NETTYPE_UNDEF);
+
+    assert(payload != NULL);
+    assert(0 == sock_udp_create(&_sock, NULL, NULL, SOCK_FLAGS_REUSE_EP));
+    /* payload is released on error */
+    assert(-ENOTCONN == gnrc_sock_udp_send_pkt(&_sock, payload, NULL));
+    assert(_check_net());
+}
+
+static void test_sock_udp_send_pkt__no_sock(void)
+{
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .netif = _TEST_NETIF,
+                                          .port = _TEST_PORT_REMOTE };
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add(NULL, "ABCD", sizeof("ABCD"),
+                                              GNRC_NETTYPE_UNDEF);
+
+    assert(payload != NULL);
+    assert(sizeof("ABCD") == gnrc_sock_udp_send_pkt(NULL, payload, &remote));
+    assert(_check_packet(&ipv6_addr_unspecified, &dst_addr, 0,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, true));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -741,6 +798,9 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_sock_udp_sendv__socketed());
+    CALL(test_sock_udp_send_pkt__ENOTCONN());
+    CALL(test_sock_udp_send_pkt__no_sock());
 
     puts("ALL TESTS SUCCESSFUL");
 
@@ -1124,6 +1124,30 @@ static void test_sock_udp_send6__socketed(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_sendv6__socketed(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR6_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR6_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR6_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR6_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t tail = { .iol_next = NULL, .iol_base = "CD",
+                      .iol_len = sizeof("CD") };
+    iolist_t head = { .iol_next = &tail, .iol_base = "AB", .iol_len = 2 };
+
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    assert(sizeof("ABCD") == sock_udp_sendv(&_sock, &head, NULL));
+    assert(_check_6packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                          _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let lwIP stack finish */
+    assert(_check_net());
+}
+
 static void test_sock_udp_send6__socketed_other_remote(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR6_LOCAL };
@@ -1362,6 +1386,7 @@ int main(void)
     CALL(test_sock_udp_send6__socketed_no_netif());
     CALL(test_sock_udp_send6__socketed_no_local());
     CALL(test_sock_udp_send6__socketed());
+    CALL(test_sock_udp_sendv6__socketed());
     CALL(test_sock_udp_send6__socketed_other_remote());
     CALL(test_sock_udp_send6__unsocketed_no_local_no_netif());
     CALL(test_sock_udp_send6__unsocketed_no_netif());
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "checksum/crc32.h"
+
+#include "tests-checksum.h"
+
+static int calc_and_compare_crc(const unsigned char *buf, size_t len,
+        uint32_t expected, uint32_t expected_c)
+{
+    size_t split = len / 2;
+    uint32_t first;
+
+    if ((crc32_calc(buf, len) != expected) ||
+        (crc32c_calc(buf, len) != expected_c)) {
+        return 0;
+    }
+
+    /* in two pieces, and the pieces combined */
+    first = crc32_calc(buf, split);
+    if ((crc32_update(first, buf + split, len - split) != expected) ||
+        (crc32_combine(first, crc32_calc(buf + split, len - split),
+                       len - split) != expected)) {
+        return 0;
+    }
+    first = crc32c_calc(buf, split);
+    if ((crc32c_update(first, buf + split, len - split) != expected_c) ||
+        (crc32c_combine(first, crc32c_calc(buf + split, len - split),
+                        len - split) != expected_c)) {
+        return 0;
+    }
+    return 1;
+}
+
+static void test_checksum_crc32_sequence_empty(void)
+{
+    unsigned char buf[] = "";
+
+    TEST_ASSERT(calc_and_compare_crc(buf, sizeof(buf) - 1, 0, 0));
+}
+
+static void test_checksum_crc32_sequence_1a(void)
+{
+    unsigned char buf[] = "A";
+
+    TEST_ASSERT(calc_and_compare_crc(buf, sizeof(buf) - 1,
+                0xD3D99E8B, 0xE16DCDEE));
+}
+
+static void test_checksum_crc32_sequence_256a(void)
+{
+    unsigned char buf[256];
+
+    memset(buf, 'A', sizeof(buf));
+    TEST_ASSERT(calc_and_compare_crc(buf, sizeof(buf),
+                0x49975B13, 0xFC55F5E7));
+}
+
+static void test_checksum_crc32_sequence_1to9(void)
+{
+    unsigned char buf[] = "123456789";
+
+    /* the check values of both polynomials */
+    TEST_ASSERT(calc_and_compare_crc(buf, sizeof(buf) - 1,
+                0xCBF43926, 0xE3069283));
+}
+
+static void test_checksum_crc32_sequence_4bytes(void)
+{
+    unsigned char buf[] = { 0x12, 0x34, 0x56, 0x78 };
+
+    TEST_ASSERT(calc_and_compare_crc(buf, sizeof(buf),
+                0x4A090E98, 0x4300918A));
+}
+
+static void test_checksum_crc32_sequence_1000bytes(void)
+{
+    static unsigned char buf[1001];
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = i * 7 + 3;
+    }
+    TEST_ASSERT(calc_and_compare_crc(buf, 1000, 0x17BC2A46, 0xDD2EDFF7));
+    /* unaligned, each tail length of the 16 byte blocks */
+    for (unsigned len = 985; len <= 1000; len++) {
+        TEST_ASSERT_EQUAL_INT(crc32_calc(buf, len),
+                              crc32_combine(crc32_calc(buf, 1),
+                                            crc32_calc(buf + 1, len - 1),
+                                            len - 1));
+        TEST_ASSERT_EQUAL_INT(crc32c_calc(buf, len),
+                              crc32c_combine(crc32c_calc(buf, 1),
+                                             crc32c_calc(buf + 1, len - 1),
+                                             len - 1));
+    }
+}
+
+Test *tests_checksum_crc32_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        /* Reference values computed bit by bit */
+        new_TestFixture(test_checksum_crc32_sequence_empty),
+        new_TestFixture(test_checksum_crc32_sequence_1a),
+        new_TestFixture(test_checksum_crc32_sequence_256a),
+        new_TestFixture(test_checksum_crc32_sequence_1to9),
+        new_TestFixture(test_checksum_crc32_sequence_4bytes),
+        new_TestFixture(test_checksum_crc32_sequence_1000bytes),
+    };
+
+    EMB_UNIT_TESTCALLER(checksum_crc32_tests, NULL, NULL, fixtures);
+
+    return (Test *)&checksum_crc32_tests;
+}
@@ -36,6 +36,13 @@ void tests_checksum(void);
  */
 Test *tests_checksum_crc16_ccitt_tests(void);
 
+/**
+ * @brief   Generates tests for checksum/crc32.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_checksum_crc32_tests(void);
+
 /**
  * @brief   Generates tests for checksum/fletcher16.h
  *
@@ -7,6 +7,7 @@
  */
 
 #include <limits.h>
+#include <string.h>
 
 #include "embUnit.h"
 #include "crypto/aes.h"
@@ -61,6 +62,96 @@ static void test_crypto_aes_encrypt(void)
     TEST_ASSERT_MESSAGE(1 == compare(TEST_1_ENC, data, AES_BLOCK_SIZE), "wrong ciphertext");
 }
 
+static void test_crypto_aes_encrypt_blocks(void)
+{
+    cipher_context_t ctx;
+    int err;
+    uint8_t input[5 * AES_BLOCK_SIZE];
+    uint8_t data[sizeof(input)];
+    uint8_t block[AES_BLOCK_SIZE];
+
+    /* an odd number of distinct blocks, more than are encrypted at once */
+    memcpy(input, TEST_0_INP, AES_BLOCK_SIZE);
+    for (unsigned i = AES_BLOCK_SIZE; i < sizeof(input); i++) {
+        input[i] = i * 7;
+    }
+
+    err = aes_init(&ctx, TEST_0_KEY, AES_KEY_SIZE);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    err = aes_encrypt_blocks(&ctx, input, data, 5);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_0_ENC, data, AES_BLOCK_SIZE), "wrong ciphertext");
+    for (unsigned i = 0; i < sizeof(input); i += AES_BLOCK_SIZE) {
+        err = aes_encrypt(&ctx, input + i, block);
+        TEST_ASSERT_EQUAL_INT(1, err);
+        TEST_ASSERT_MESSAGE(1 == compare(block, data + i, AES_BLOCK_SIZE), "wrong ciphertext");
+    }
+
+    /* in place */
+    err = aes_encrypt_blocks(&ctx, input, input, 5);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    TEST_ASSERT_MESSAGE(1 == compare(data, input, sizeof(input)), "wrong ciphertext");
+}
+
+static void test_crypto_aes_schedule(void)
+{
+    aes_schedule_t sched;
+    int err;
+    uint8_t data[2 * AES_BLOCK_SIZE];
+
+    err = aes_schedule_init(&sched, TEST_0_KEY, AES_KEY_SIZE - 1);
+    TEST_ASSERT_EQUAL_INT(CIPHER_ERR_INVALID_KEY_SIZE, err);
+
+    err = aes_schedule_init(&sched, TEST_1_KEY, AES_KEY_SIZE);
+    TEST_ASSERT_EQUAL_INT(CIPHER_INIT_SUCCESS, err);
+
+    /* the key is expanded once for several calls */
+    for (unsigned i = 0; i < 2; i++) {
+        memcpy(data, TEST_1_INP, AES_BLOCK_SIZE);
+        memcpy(data + AES_BLOCK_SIZE, TEST_1_INP, AES_BLOCK_SIZE);
+        err = aes_schedule_encrypt_blocks(&sched, data, data, 2);
+        TEST_ASSERT_EQUAL_INT(1, err);
+        TEST_ASSERT_MESSAGE(1 == compare(TEST_1_ENC, data, AES_BLOCK_SIZE), "wrong ciphertext");
+        TEST_ASSERT_MESSAGE(1 == compare(TEST_1_ENC, data + AES_BLOCK_SIZE, AES_BLOCK_SIZE), "wrong ciphertext");
+    }
+}
+
+static void test_crypto_aes_backends(void)
+{
+    const aes_backend_t *prev = aes_backend_get();
+    aes_schedule_t sched;
+    cipher_t cipher;
+    int err;
+    uint8_t data[AES_BLOCK_SIZE];
+
+    err = aes_schedule_init(&sched, TEST_1_KEY, AES_KEY_SIZE);
+    TEST_ASSERT_EQUAL_INT(CIPHER_INIT_SUCCESS, err);
+
+    for (unsigned i = 0; i < AES_BACKEND_NUMOF; i++) {
+        if (!aes_backend_available(&aes_backends[i])) {
+            TEST_ASSERT_EQUAL_INT(-1, aes_backend_set(&aes_backends[i]));
+            continue;
+        }
+        TEST_ASSERT_EQUAL_INT(0, aes_backend_set(&aes_backends[i]));
+        TEST_ASSERT(aes_backend_get() == &aes_backends[i]);
+
+        /* cipher_t uses the selected backend */
+        err = cipher_init(&cipher, CIPHER_AES_128, TEST_0_KEY, AES_KEY_SIZE);
+        TEST_ASSERT_EQUAL_INT(1, err);
+        err = cipher_encrypt(&cipher, TEST_0_INP, data);
+        TEST_ASSERT_EQUAL_INT(1, err);
+        TEST_ASSERT_MESSAGE(1 == compare(TEST_0_ENC, data, AES_BLOCK_SIZE), "wrong ciphertext");
+
+        /* a schedule keeps the backend it was expanded by */
+        err = aes_schedule_encrypt_blocks(&sched, TEST_1_INP, data, 1);
+        TEST_ASSERT_EQUAL_INT(1, err);
+        TEST_ASSERT_MESSAGE(1 == compare(TEST_1_ENC, data, AES_BLOCK_SIZE), "wrong ciphertext");
+    }
+
+    aes_backend_set(prev);
+}
+
 static void test_crypto_aes_decrypt(void)
 {
 
@@ -87,6 +178,9 @@ Test* tests_crypto_aes_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_aes_encrypt),
+                        new_TestFixture(test_crypto_aes_encrypt_blocks),
+                        new_TestFixture(test_crypto_aes_schedule),
+                        new_TestFixture(test_crypto_aes_backends),
                         new_TestFixture(test_crypto_aes_decrypt),
     };
 
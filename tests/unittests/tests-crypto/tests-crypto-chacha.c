@@ -130,12 +130,32 @@ static void test_crypto_chacha20_tc8(void)
                         TC8_CHACHA20_BLOCK0, TC8_CHACHA20_BLOCK1);
 }
 
+static void test_crypto_chacha20_blocks(void)
+{
+    chacha_ctx ctx, ref;
+    uint8_t blocks[11 * 64];
+    uint8_t block[64];
+
+    /* a counter carry into the upper word within the blocks */
+    chacha_init(&ctx, 20, TC8_KEY, 16, TC8_IV);
+    ctx.state[12] = 0xfffffffb;
+    ref = ctx;
+
+    chacha_keystream_blocks(&ctx, blocks, 11);
+    for (unsigned i = 0; i < 11; i++) {
+        chacha_keystream_bytes(&ref, block);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(block, blocks + 64 * i, 64));
+    }
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ctx.state, ref.state, 64));
+}
+
 Test *tests_crypto_chacha_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_chacha8_tc8),
         new_TestFixture(test_crypto_chacha12_tc8),
         new_TestFixture(test_crypto_chacha20_tc8),
+        new_TestFixture(test_crypto_chacha20_blocks),
     };
     EMB_UNIT_TESTCALLER(crypto_chacha_tests, NULL, NULL, fixtures);
     return (Test *) &crypto_chacha_tests;
@@ -189,6 +189,72 @@ static void test_crypto_modes_ccm_decrypt(void)
     do_test_decrypt_op(2);
 }
 
+/* pieces that do not line up with the blocks */
+static void test_crypto_modes_ccm_stream(void)
+{
+    static const size_t pieces[] = { 5, 16, 3 };
+    const uint8_t *adata = TEST_2_INPUT, *plain = TEST_2_INPUT + TEST_2_ADATA_LEN;
+    const uint8_t *expected = TEST_2_EXPECTED + TEST_2_ADATA_LEN;
+    size_t len_encoding = nonce_and_len_encoding_size - TEST_2_NONCE_LEN;
+    size_t plain_len = TEST_2_INPUT_LEN;
+    cipher_ccm_ctx_t ctx;
+    cipher_t cipher;
+    size_t offset = 0;
+    int err;
+
+    err = cipher_init(&cipher, CIPHER_AES_128, TEST_2_KEY, TEST_2_KEY_LEN);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    err = cipher_ccm_init(&ctx, &cipher, TEST_2_MAC_LEN, len_encoding,
+                          TEST_2_NONCE, TEST_2_NONCE_LEN, TEST_2_ADATA_LEN,
+                          plain_len);
+    TEST_ASSERT_EQUAL_INT(0, err);
+    TEST_ASSERT_EQUAL_INT(0, cipher_ccm_update_aad(&ctx, adata, 3));
+    TEST_ASSERT_EQUAL_INT(0, cipher_ccm_update_aad(&ctx, adata + 3,
+                                                   TEST_2_ADATA_LEN - 3));
+    for (unsigned i = 0; i < sizeof(pieces) / sizeof(pieces[0]); i++) {
+        err = cipher_ccm_encrypt_update(&ctx, plain + offset, pieces[i],
+                                        data + offset);
+        TEST_ASSERT_EQUAL_INT(pieces[i], err);
+        offset += pieces[i];
+    }
+    TEST_ASSERT_EQUAL_INT(plain_len, offset);
+    err = cipher_ccm_encrypt_finish(&ctx, data + offset);
+    TEST_ASSERT_EQUAL_INT(TEST_2_MAC_LEN, err);
+    TEST_ASSERT_MESSAGE(1 == compare(expected, data,
+                                     plain_len + TEST_2_MAC_LEN),
+                        "wrong ciphertext");
+
+    /* decrypt in place, in the same pieces */
+    cipher_ccm_init(&ctx, &cipher, TEST_2_MAC_LEN, len_encoding,
+                    TEST_2_NONCE, TEST_2_NONCE_LEN, TEST_2_ADATA_LEN,
+                    plain_len);
+    cipher_ccm_update_aad(&ctx, adata, TEST_2_ADATA_LEN);
+    for (offset = 0; offset < plain_len; offset += pieces[0]) {
+        size_t len = plain_len - offset;
+
+        len = len < pieces[0] ? len : pieces[0];
+        err = cipher_ccm_decrypt_update(&ctx, data + offset, len,
+                                        data + offset);
+        TEST_ASSERT_EQUAL_INT(len, err);
+    }
+    err = cipher_ccm_decrypt_finish(&ctx, data + plain_len);
+    TEST_ASSERT_EQUAL_INT(0, err);
+    TEST_ASSERT_MESSAGE(1 == compare(plain, data, plain_len),
+                        "wrong plaintext");
+
+    /* a modified MAC and more data than announced */
+    cipher_ccm_init(&ctx, &cipher, TEST_2_MAC_LEN, len_encoding,
+                    TEST_2_NONCE, TEST_2_NONCE_LEN, TEST_2_ADATA_LEN,
+                    plain_len);
+    cipher_ccm_update_aad(&ctx, adata, TEST_2_ADATA_LEN);
+    cipher_ccm_decrypt_update(&ctx, expected, plain_len, data);
+    err = cipher_ccm_decrypt_update(&ctx, expected, 1, data);
+    TEST_ASSERT_EQUAL_INT(CCM_ERR_INVALID_DATA_LENGTH, err);
+    memcpy(data, expected + plain_len, TEST_2_MAC_LEN);
+    data[0] ^= 0x01;
+    err = cipher_ccm_decrypt_finish(&ctx, data);
+    TEST_ASSERT_EQUAL_INT(CCM_ERR_INVALID_CBC_MAC, err);
+}
 
 typedef int (*func_ccm_t)(cipher_t*, const uint8_t*, uint32_t,
                           uint8_t, uint8_t, const uint8_t*, size_t,
@@ -260,6 +326,7 @@ Test* tests_crypto_modes_ccm_tests(void)
         new_TestFixture(test_crypto_modes_ccm_encrypt),
         new_TestFixture(test_crypto_modes_ccm_decrypt),
         new_TestFixture(test_crypto_modes_ccm_check_len),
+        new_TestFixture(test_crypto_modes_ccm_stream),
     };
 
     EMB_UNIT_TESTCALLER(crypto_modes_ccm_tests, NULL, NULL, fixtures);
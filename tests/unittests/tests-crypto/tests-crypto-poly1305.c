@@ -213,9 +213,23 @@ static const uint8_t tag_11[] = {
 static void _test_poly1305(const uint8_t *key, const uint8_t *msg, size_t msglen, const uint8_t *tag)
 {
     uint8_t gen_tag[16];
+    poly1305_ctx_t ctx;
 
     poly1305_auth(gen_tag, msg, msglen, key);
-    for (unsigned i = 0; i < sizeof(tag); i++) {
+    for (unsigned i = 0; i < sizeof(gen_tag); i++) {
+        TEST_ASSERT_EQUAL_INT(gen_tag[i], tag[i]);
+    }
+
+    /* pieces of growing length, which cross the block boundaries */
+    poly1305_init(&ctx, key);
+    for (size_t i = 0, piece = 1; i < msglen; i += piece, piece++) {
+        if (piece > msglen - i) {
+            piece = msglen - i;
+        }
+        poly1305_update(&ctx, msg + i, piece);
+    }
+    poly1305_finish(&ctx, gen_tag);
+    for (unsigned i = 0; i < sizeof(gen_tag); i++) {
         TEST_ASSERT_EQUAL_INT(gen_tag[i], tag[i]);
     }
 }
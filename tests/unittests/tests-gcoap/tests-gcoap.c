@@ -12,12 +12,17 @@
  * @file
  */
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
 #include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "timex.h"
 
 #include "unittests-constants.h"
 #include "tests-gcoap.h"
@@ -365,6 +370,440 @@ static void test_gcoap__server_get_resource_list(void)
     TEST_ASSERT_EQUAL_STRING(resource_list_str, (char *)res);
 }
 
+/*
+ * Replace the request and Observe tables, then restore the built-in ones.
+ */
+static void test_gcoap__set_pools(void)
+{
+    static gcoap_request_memo_t open_reqs[4];
+    static uint8_t resend_bufs[2 * GCOAP_PDU_BUF_SIZE];
+    static sock_udp_ep_t observers[8];
+    static gcoap_observe_memo_t observe_memos[8];
+    gcoap_pools_t pools = {
+        .open_reqs = open_reqs,
+        .open_reqs_numof = ARRAY_SIZE(open_reqs),
+        .resend_bufs = resend_bufs,
+        .resend_bufs_numof = 2,
+        .observers = observers,
+        .observers_numof = ARRAY_SIZE(observers),
+        .observe_memos = observe_memos,
+        .observe_memos_numof = ARRAY_SIZE(observe_memos),
+    };
+
+    TEST_ASSERT_EQUAL_INT(0, gcoap_set_pools(&pools));
+    TEST_ASSERT_EQUAL_INT(0, gcoap_op_state());
+
+    memset(&pools, 0, sizeof(pools));
+    TEST_ASSERT_EQUAL_INT(0, gcoap_set_pools(&pools));
+    TEST_ASSERT_EQUAL_INT(0, gcoap_op_state());
+}
+
+/*
+ * Resources for the tests of the resource index. The handler responds with
+ * the context of the resource, so the tests see which one was found.
+ */
+static ssize_t _index_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx)
+{
+    const char *name = ctx;
+
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    memcpy(pdu->payload, name, strlen(name));
+    return gcoap_finish(pdu, strlen(name), COAP_FORMAT_TEXT);
+}
+
+/* the paths differ in the last character by 16, so they share a slot in an
+ * index of 16 entries */
+static const coap_resource_t resources_index[] = {
+    { .path = "/idx/a", .methods = COAP_GET, .handler = _index_handler,
+      .context = (void *)"a" },
+    { .path = "/idx/q", .methods = COAP_GET, .handler = _index_handler,
+      .context = (void *)"q" },
+};
+
+/* not in alphabetical order, as the linear search would require */
+static const coap_resource_t resources_unsorted[] = {
+    { .path = "/idx/z", .methods = COAP_GET, .handler = _index_handler,
+      .context = (void *)"z" },
+    { .path = "/idx/m", .methods = COAP_GET, .handler = _index_handler,
+      .context = (void *)"m" },
+    { .path = "/idx/b", .methods = COAP_GET, .handler = _index_handler,
+      .context = (void *)"b" },
+};
+
+/* a path of another listener again, for another method */
+static const coap_resource_t resources_post[] = {
+    { .path = "/idx/m", .methods = COAP_POST, .handler = _index_handler,
+      .context = (void *)"post" },
+};
+
+static gcoap_listener_t listener_index = {
+    .resources     = &resources_index[0],
+    .resources_len = ARRAY_SIZE(resources_index),
+    .next          = NULL
+};
+
+static gcoap_listener_t listener_unsorted = {
+    .resources     = &resources_unsorted[0],
+    .resources_len = ARRAY_SIZE(resources_unsorted),
+    .next          = NULL
+};
+
+static gcoap_listener_t listener_post = {
+    .resources     = &resources_post[0],
+    .resources_len = ARRAY_SIZE(resources_post),
+    .next          = NULL
+};
+
+/* more resources than fit into the index, whatever is registered before */
+#define INDEX_FULL_NUMOF    ((GCOAP_RESOURCE_INDEX_SIZE * 3) / 4 + 1)
+
+static char full_paths[INDEX_FULL_NUMOF][sizeof("/full/0000")];
+static coap_resource_t resources_full[INDEX_FULL_NUMOF];
+
+static gcoap_listener_t listener_full = {
+    .resources     = &resources_full[0],
+    .resources_len = INDEX_FULL_NUMOF,
+    .next          = NULL
+};
+
+#define INDEX_TIMEOUT       (100U * US_PER_MS)
+
+static sock_udp_t index_sock;
+static bool index_ready;
+static uint16_t index_msgid;
+
+/* registers the listeners and opens a socket to send requests to gcoap */
+static void _index_setup(void)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+
+    if (index_ready) {
+        return;
+    }
+    local.port = GCOAP_PORT + 1;
+    TEST_ASSERT_EQUAL_INT(0, sock_udp_create(&index_sock, &local, NULL, 0));
+    gcoap_register_listener(&listener_index);
+    gcoap_register_listener(&listener_unsorted);
+    gcoap_register_listener(&listener_post);
+    index_ready = true;
+}
+
+/*
+ * Sends a request to gcoap over the loopback address and parses the response
+ * into pdu. Observe is not included if observe is negative.
+ */
+static void _index_req(coap_pkt_t *pdu, uint8_t *buf, unsigned method,
+                       const char *path, int observe)
+{
+    /* the same token for all requests, so an observer can deregister */
+    uint8_t token[2] = { 0x1d, 0x70 };
+    sock_udp_ep_t remote = {
+        .family = AF_INET6,
+        .netif  = SOCK_ADDR_ANY_NETIF,
+        .port   = GCOAP_PORT,
+    };
+    ssize_t len;
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, token,
+                         sizeof(token), method, index_msgid++);
+    coap_pkt_init(pdu, buf, GCOAP_PDU_BUF_SIZE, len);
+    if (observe >= 0) {
+        coap_opt_add_uint(pdu, COAP_OPT_OBSERVE, observe);
+    }
+    coap_opt_add_string(pdu, COAP_OPT_URI_PATH, path, '/');
+    len = coap_opt_finish(pdu, COAP_OPT_FINISH_NONE);
+
+    TEST_ASSERT(sock_udp_send(&index_sock, buf, len, &remote) > 0);
+    len = sock_udp_recv(&index_sock, buf, GCOAP_PDU_BUF_SIZE, INDEX_TIMEOUT,
+                        NULL);
+    TEST_ASSERT(len > 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(pdu, buf, len));
+}
+
+/* expects the response code, and the name of the resource if not NULL */
+static void _index_expect(unsigned method, const char *path, unsigned code,
+                          const char *name)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+
+    _index_req(&pdu, buf, method, path, -1);
+    TEST_ASSERT_EQUAL_INT(code, coap_get_code_raw(&pdu));
+    if (name != NULL) {
+        TEST_ASSERT_EQUAL_INT(strlen(name), pdu.payload_len);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(pdu.payload, name, strlen(name)));
+    }
+}
+
+/*
+ * A request finds its resource by the hash of the path.
+ */
+static void test_gcoap__server_index_hit(void)
+{
+    _index_setup();
+
+    _index_expect(COAP_METHOD_GET, "/idx/a", COAP_CODE_CONTENT, "a");
+    _index_expect(COAP_METHOD_GET, "/idx/q", COAP_CODE_CONTENT, "q");
+    _index_expect(COAP_METHOD_GET, "/idx/x", COAP_CODE_PATH_NOT_FOUND, NULL);
+}
+
+/*
+ * A known path with a method the resource does not allow is 4.05, and a
+ * later resource with the same path may allow it.
+ */
+static void test_gcoap__server_index_wrong_method(void)
+{
+    _index_setup();
+
+    _index_expect(COAP_METHOD_POST, "/idx/a", COAP_CODE_METHOD_NOT_ALLOWED,
+                  NULL);
+    _index_expect(COAP_METHOD_PUT, "/idx/m", COAP_CODE_METHOD_NOT_ALLOWED,
+                  NULL);
+    _index_expect(COAP_METHOD_GET, "/idx/m", COAP_CODE_CONTENT, "m");
+    _index_expect(COAP_METHOD_POST, "/idx/m", COAP_CODE_CONTENT, "post");
+}
+
+/*
+ * The index finds resources of a listener that are not sorted.
+ */
+static void test_gcoap__server_index_unsorted(void)
+{
+    _index_setup();
+
+    _index_expect(COAP_METHOD_GET, "/idx/z", COAP_CODE_CONTENT, "z");
+    _index_expect(COAP_METHOD_GET, "/idx/m", COAP_CODE_CONTENT, "m");
+    _index_expect(COAP_METHOD_GET, "/idx/b", COAP_CODE_CONTENT, "b");
+}
+
+/*
+ * The Observe registration cached in the index is dropped when the observer
+ * deregisters.
+ */
+static void test_gcoap__server_index_obs_memo(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+
+    _index_setup();
+
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_INIT_UNUSED,
+                          gcoap_obs_init(&pdu, buf, sizeof(buf),
+                                         &resources_index[0]));
+    _index_req(&pdu, buf, COAP_METHOD_GET, "/idx/a", COAP_OBS_REGISTER);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, coap_get_code_raw(&pdu));
+    TEST_ASSERT(coap_has_observe(&pdu));
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_INIT_OK,
+                          gcoap_obs_init(&pdu, buf, sizeof(buf),
+                                         &resources_index[0]));
+
+    _index_req(&pdu, buf, COAP_METHOD_GET, "/idx/a", COAP_OBS_DEREGISTER);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, coap_get_code_raw(&pdu));
+    TEST_ASSERT(!coap_has_observe(&pdu));
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_INIT_UNUSED,
+                          gcoap_obs_init(&pdu, buf, sizeof(buf),
+                                         &resources_index[0]));
+
+    /* the freed memo may now be taken by another resource */
+    _index_req(&pdu, buf, COAP_METHOD_GET, "/idx/q", COAP_OBS_REGISTER);
+    TEST_ASSERT(coap_has_observe(&pdu));
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_INIT_UNUSED,
+                          gcoap_obs_init(&pdu, buf, sizeof(buf),
+                                         &resources_index[0]));
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_INIT_OK,
+                          gcoap_obs_init(&pdu, buf, sizeof(buf),
+                                         &resources_index[1]));
+    _index_req(&pdu, buf, COAP_METHOD_GET, "/idx/q", COAP_OBS_DEREGISTER);
+    TEST_ASSERT(!coap_has_observe(&pdu));
+}
+
+/*
+ * Once the index is 3/4 full, requests search the listeners. Must be the last
+ * of the index tests, the index stays unused.
+ */
+static void test_gcoap__server_index_full(void)
+{
+    const char *last = full_paths[INDEX_FULL_NUMOF - 1];
+
+    _index_setup();
+
+    /* sorted, as the linear search requires */
+    for (unsigned i = 0; i < INDEX_FULL_NUMOF; i++) {
+        snprintf(full_paths[i], sizeof(full_paths[i]), "/full/%04u", i);
+        resources_full[i].path    = full_paths[i];
+        resources_full[i].methods = COAP_GET;
+        resources_full[i].handler = _index_handler;
+        resources_full[i].context = full_paths[i];
+    }
+    gcoap_register_listener(&listener_full);
+
+    /* the last resource did not fit into the index */
+    _index_expect(COAP_METHOD_GET, last, COAP_CODE_CONTENT, last);
+    _index_expect(COAP_METHOD_GET, full_paths[0], COAP_CODE_CONTENT,
+                  full_paths[0]);
+    _index_expect(COAP_METHOD_POST, full_paths[0],
+                  COAP_CODE_METHOD_NOT_ALLOWED, NULL);
+    _index_expect(COAP_METHOD_GET, "/idx/q", COAP_CODE_CONTENT, "q");
+    _index_expect(COAP_METHOD_GET, "/full/none", COAP_CODE_PATH_NOT_FOUND,
+                  NULL);
+}
+
+/* 40 byte representation for the block-wise tests */
+static uint8_t block_repr[40];
+static size_t block_written;
+static bool block_more;
+
+static ssize_t _block_read(void *ctx, size_t offset, uint8_t *buf, size_t len)
+{
+    (void)ctx;
+    if (offset >= sizeof(block_repr)) {
+        return 0;
+    }
+    if (len > sizeof(block_repr) - offset) {
+        len = sizeof(block_repr) - offset;
+    }
+    memcpy(buf, &block_repr[offset], len);
+    return len;
+}
+
+static int _block_write(void *ctx, size_t offset, const uint8_t *buf,
+                        size_t len, bool more)
+{
+    (void)ctx;
+    if (offset != block_written) {
+        return -EINVAL;
+    }
+    if (len > sizeof(block_repr) - offset) {
+        return -ENOSPC;
+    }
+    memcpy(&block_repr[offset], buf, len);
+    block_written += len;
+    block_more = more;
+    return 0;
+}
+
+static gcoap_block_resource_t block_resource = {
+    .read = _block_read,
+    .write = _block_write,
+    .format = COAP_FORMAT_OCTET,
+    .ctx = NULL,
+};
+
+/* writes a request for /fw with a block option, if blkopt is non-negative */
+static void _block_req(coap_pkt_t *pdu, uint8_t *buf, unsigned method,
+                       uint16_t option, int32_t blkopt, size_t payload_len)
+{
+    gcoap_req_init(pdu, buf, GCOAP_PDU_BUF_SIZE, method, "/fw");
+    if (blkopt >= 0) {
+        coap_opt_add_uint(pdu, option, blkopt);
+    }
+    ssize_t len = coap_opt_finish(pdu, payload_len ? COAP_OPT_FINISH_PAYLOAD
+                                                   : COAP_OPT_FINISH_NONE);
+    memset(pdu->payload, 0xA5, payload_len);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(pdu, buf, len + payload_len));
+}
+
+/* handles the request and parses the response in place */
+static void _block_resp(coap_pkt_t *pdu, uint8_t *buf)
+{
+    ssize_t len = gcoap_block_handler(pdu, buf, GCOAP_PDU_BUF_SIZE,
+                                      &block_resource);
+
+    TEST_ASSERT(len > 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(pdu, buf, len));
+}
+
+/*
+ * Server reads a representation in blocks of the size the client asks for.
+ */
+static void test_gcoap__server_block2(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    uint32_t blknum;
+    unsigned szx;
+
+    for (unsigned i = 0; i < sizeof(block_repr); i++) {
+        block_repr[i] = i;
+    }
+
+    /* second block of 16 bytes, more follow */
+    _block_req(&pdu, buf, COAP_METHOD_GET, COAP_OPT_BLOCK2, (1 << 4) | 0, 0);
+    _block_resp(&pdu, buf);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, coap_get_code_raw(&pdu));
+    TEST_ASSERT_EQUAL_INT(COAP_FORMAT_OCTET, coap_get_content_type(&pdu));
+    TEST_ASSERT_EQUAL_INT(1, coap_get_blockopt(&pdu, COAP_OPT_BLOCK2,
+                                               &blknum, &szx));
+    TEST_ASSERT_EQUAL_INT(1, blknum);
+    TEST_ASSERT_EQUAL_INT(0, szx);
+    TEST_ASSERT_EQUAL_INT(16, pdu.payload_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pdu.payload, &block_repr[16], 16));
+
+    /* last block is shorter */
+    _block_req(&pdu, buf, COAP_METHOD_GET, COAP_OPT_BLOCK2, (2 << 4) | 0, 0);
+    _block_resp(&pdu, buf);
+    TEST_ASSERT_EQUAL_INT(0, coap_get_blockopt(&pdu, COAP_OPT_BLOCK2,
+                                               &blknum, &szx));
+    TEST_ASSERT_EQUAL_INT(8, pdu.payload_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pdu.payload, &block_repr[32], 8));
+
+    /* without Block2, the first block of the largest size is sent */
+    _block_req(&pdu, buf, COAP_METHOD_GET, COAP_OPT_BLOCK2, -1, 0);
+    _block_resp(&pdu, buf);
+    TEST_ASSERT_EQUAL_INT(0, coap_get_blockopt(&pdu, COAP_OPT_BLOCK2,
+                                               &blknum, &szx));
+    TEST_ASSERT_EQUAL_INT(0, blknum);
+    TEST_ASSERT_EQUAL_INT(NANOCOAP_BLOCK_SIZE_EXP_MAX - 4, szx);
+    TEST_ASSERT_EQUAL_INT(sizeof(block_repr), pdu.payload_len);
+
+    /* beyond the end */
+    _block_req(&pdu, buf, COAP_METHOD_GET, COAP_OPT_BLOCK2, (3 << 4) | 0, 0);
+    _block_resp(&pdu, buf);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_BAD_OPTION, coap_get_code_raw(&pdu));
+}
+
+/*
+ * Server passes blocks to the write callback and asks for the next one.
+ */
+static void test_gcoap__server_block1(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    uint32_t blknum;
+    unsigned szx;
+
+    block_written = 0;
+
+    /* first block of 16 bytes, more follow */
+    _block_req(&pdu, buf, COAP_METHOD_PUT, COAP_OPT_BLOCK1,
+               (0 << 4) | 0x8 | 0, 16);
+    _block_resp(&pdu, buf);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTINUE, coap_get_code_raw(&pdu));
+    TEST_ASSERT_EQUAL_INT(1, coap_get_blockopt(&pdu, COAP_OPT_BLOCK1,
+                                               &blknum, &szx));
+    TEST_ASSERT_EQUAL_INT(0, blknum);
+    TEST_ASSERT_EQUAL_INT(16, block_written);
+    TEST_ASSERT(block_more);
+
+    /* a block out of order */
+    _block_req(&pdu, buf, COAP_METHOD_PUT, COAP_OPT_BLOCK1,
+               (2 << 4) | 0x8 | 0, 16);
+    _block_resp(&pdu, buf);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_REQUEST_ENTITY_INCOMPLETE,
+                          coap_get_code_raw(&pdu));
+
+    /* last block */
+    _block_req(&pdu, buf, COAP_METHOD_PUT, COAP_OPT_BLOCK1, (1 << 4) | 0, 10);
+    _block_resp(&pdu, buf);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CHANGED, coap_get_code_raw(&pdu));
+    TEST_ASSERT_EQUAL_INT(0, coap_get_blockopt(&pdu, COAP_OPT_BLOCK1,
+                                               &blknum, &szx));
+    TEST_ASSERT_EQUAL_INT(1, blknum);
+    TEST_ASSERT_EQUAL_INT(26, block_written);
+    TEST_ASSERT(!block_more);
+}
+
 Test *tests_gcoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -377,7 +816,15 @@ Test *tests_gcoap_tests(void)
         new_TestFixture(test_gcoap__server_get_resp),
         new_TestFixture(test_gcoap__server_con_req),
         new_TestFixture(test_gcoap__server_con_resp),
-        new_TestFixture(test_gcoap__server_get_resource_list)
+        new_TestFixture(test_gcoap__server_get_resource_list),
+        new_TestFixture(test_gcoap__set_pools),
+        new_TestFixture(test_gcoap__server_index_hit),
+        new_TestFixture(test_gcoap__server_index_wrong_method),
+        new_TestFixture(test_gcoap__server_index_unsorted),
+        new_TestFixture(test_gcoap__server_index_obs_memo),
+        new_TestFixture(test_gcoap__server_index_full),
+        new_TestFixture(test_gcoap__server_block2),
+        new_TestFixture(test_gcoap__server_block1)
     };
 
     EMB_UNIT_TESTCALLER(gcoap_tests, NULL, NULL, fixtures);
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "thread.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_netapi_burst.h"
+
+#define TEST_MSG_QUEUE_SIZE (2 * GNRC_NETAPI_BURST_SIZE)
+
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static gnrc_netapi_burst_t _burst;
+static gnrc_pktsnip_t *_pkts[GNRC_NETAPI_BURST_SIZE + 1];
+static gnrc_netreg_entry_t _burst_entry;
+static gnrc_netreg_entry_t _pid_entry;
+
+static void set_up(void)
+{
+    gnrc_netreg_init();
+    gnrc_pktbuf_init();
+    memset(&_burst, 0, sizeof(_burst));
+    for (unsigned i = 0; i < ARRAY_SIZE(_pkts); i++) {
+        _pkts[i] = gnrc_pktbuf_add(NULL, NULL, TEST_UINT8, GNRC_NETTYPE_TEST);
+    }
+    gnrc_netreg_entry_init_burst(&_burst_entry, TEST_UINT16, thread_getpid());
+    gnrc_netreg_entry_init_pid(&_pid_entry, TEST_UINT16, thread_getpid());
+}
+
+static void tear_down(void)
+{
+    msg_t msg;
+
+    /* neither leave messages nor packets to the next test */
+    TEST_ASSERT_EQUAL_INT(-1, msg_try_receive(&msg));
+    for (unsigned i = 0; i < ARRAY_SIZE(_pkts); i++) {
+        gnrc_pktbuf_release(_pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void _add(unsigned first, unsigned numof, uint32_t demux_ctx)
+{
+    for (unsigned i = first; i < (first + numof); i++) {
+        /* the test holds on to the packets to check them */
+        gnrc_pktbuf_hold(_pkts[i], 1);
+        gnrc_netapi_burst_add(&_burst, GNRC_NETTYPE_TEST, demux_ctx, _pkts[i]);
+    }
+}
+
+static void _expect_rcv(unsigned idx)
+{
+    msg_t msg;
+
+    TEST_ASSERT_EQUAL_INT(1, msg_try_receive(&msg));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV, msg.type);
+    TEST_ASSERT(_pkts[idx] == msg.content.ptr);
+    gnrc_pktbuf_release(msg.content.ptr);
+}
+
+static void _expect_rcv_burst(unsigned first, unsigned numof)
+{
+    gnrc_pktsnip_t *burst;
+    gnrc_pktsnip_t **pkts;
+    msg_t msg;
+
+    TEST_ASSERT_EQUAL_INT(1, msg_try_receive(&msg));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV_BURST, msg.type);
+    burst = msg.content.ptr;
+    pkts = gnrc_netapi_burst_pkts(burst);
+    TEST_ASSERT_EQUAL_INT(numof, gnrc_netapi_burst_numof(burst));
+    for (unsigned i = 0; i < numof; i++) {
+        TEST_ASSERT(_pkts[first + i] == pkts[i]);
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    gnrc_pktbuf_release(burst);
+}
+
+static void test_netapi_burst__no_receivers(void)
+{
+    _add(0, 3, TEST_UINT16);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netapi_burst_flush(&_burst));
+    /* only the test's own references are left */
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(1, _pkts[i]->users);
+    }
+}
+
+static void test_netapi_burst__flush_empty(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netapi_burst_flush(&_burst));
+}
+
+static void test_netapi_burst__not_before_flush(void)
+{
+    msg_t msg;
+
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &_burst_entry);
+    _add(0, 3, TEST_UINT16);
+    TEST_ASSERT_EQUAL_INT(-1, msg_try_receive(&msg));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_burst_flush(&_burst));
+    _expect_rcv_burst(0, 3);
+}
+
+static void test_netapi_burst__single_pkt(void)
+{
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &_burst_entry);
+    _add(0, 1, TEST_UINT16);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_burst_flush(&_burst));
+    /* one packet is not worth a list */
+    _expect_rcv(0);
+}
+
+static void test_netapi_burst__pid_receiver(void)
+{
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &_pid_entry);
+    _add(0, 3, TEST_UINT16);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_burst_flush(&_burst));
+    for (unsigned i = 0; i < 3; i++) {
+        _expect_rcv(i);
+    }
+}
+
+static void test_netapi_burst__mixed_receivers(void)
+{
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &_burst_entry);
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &_pid_entry);
+    _add(0, 3, TEST_UINT16);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netapi_burst_flush(&_burst));
+    /* in the order of the registry, which prepends new entries */
+    for (unsigned i = 0; i < 3; i++) {
+        _expect_rcv(i);
+    }
+    _expect_rcv_burst(0, 3);
+}
+
+static void test_netapi_burst__full(void)
+{
+    msg_t msg;
+
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &_burst_entry);
+    _add(0, GNRC_NETAPI_BURST_SIZE, TEST_UINT16);
+    /* handed on without flushing */
+    _expect_rcv_burst(0, GNRC_NETAPI_BURST_SIZE);
+    _add(GNRC_NETAPI_BURST_SIZE, 1, TEST_UINT16);
+    TEST_ASSERT_EQUAL_INT(-1, msg_try_receive(&msg));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_burst_flush(&_burst));
+    _expect_rcv(GNRC_NETAPI_BURST_SIZE);
+}
+
+static void test_netapi_burst__other_receivers(void)
+{
+    gnrc_netreg_entry_t other;
+
+    gnrc_netreg_entry_init_burst(&other, TEST_UINT16 + 1, thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &_burst_entry);
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &other);
+    _add(0, 2, TEST_UINT16);
+    /* a packet for other receivers hands on the ones before it first */
+    _add(2, 2, TEST_UINT16 + 1);
+    _add(4, 2, TEST_UINT16);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_burst_flush(&_burst));
+    _expect_rcv_burst(0, 2);
+    _expect_rcv_burst(2, 2);
+    _expect_rcv_burst(4, 2);
+}
+
+Test *tests_gnrc_netapi_burst_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netapi_burst__no_receivers),
+        new_TestFixture(test_netapi_burst__flush_empty),
+        new_TestFixture(test_netapi_burst__not_before_flush),
+        new_TestFixture(test_netapi_burst__single_pkt),
+        new_TestFixture(test_netapi_burst__pid_receiver),
+        new_TestFixture(test_netapi_burst__mixed_receivers),
+        new_TestFixture(test_netapi_burst__full),
+        new_TestFixture(test_netapi_burst__other_receivers),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_netapi_burst_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_netapi_burst_tests;
+}
+
+void tests_gnrc_netapi_burst(void)
+{
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    TESTS_RUN(tests_gnrc_netapi_burst_tests());
+}
+/** @} */
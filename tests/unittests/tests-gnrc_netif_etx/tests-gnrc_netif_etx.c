@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/netif/etx.h"
+
+#include "tests-gnrc_netif_etx.h"
+
+#define IFACE       (7)
+
+static uint8_t _addr[GNRC_NETIF_ETX_NUMOF + 1][2];
+
+static void set_up(void)
+{
+    gnrc_netif_etx_reset();
+    for (unsigned i = 0; i < GNRC_NETIF_ETX_NUMOF + 1; i++) {
+        _addr[i][0] = 0xab;
+        _addr[i][1] = i;
+    }
+}
+
+static void test_gnrc_netif_etx__unknown(void)
+{
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT,
+                          gnrc_netif_etx_get(IFACE, _addr[0], 2));
+}
+
+static void test_gnrc_netif_etx__acked(void)
+{
+    uint16_t etx = GNRC_NETIF_ETX_INIT;
+
+    for (unsigned i = 0; i < 64; i++) {
+        gnrc_netif_etx_update(IFACE, _addr[0], 2, 1, true);
+        uint16_t cur = gnrc_netif_etx_get(IFACE, _addr[0], 2);
+        TEST_ASSERT(cur <= etx);
+        etx = cur;
+    }
+    /* converges to one transmission per frame */
+    TEST_ASSERT(etx < GNRC_NETIF_ETX_DIVISOR + (1U << GNRC_NETIF_ETX_EWMA_SHIFT));
+    /* retries count as transmissions */
+    gnrc_netif_etx_update(IFACE, _addr[0], 2, 3, true);
+    TEST_ASSERT(gnrc_netif_etx_get(IFACE, _addr[0], 2) > etx);
+}
+
+static void test_gnrc_netif_etx__noack(void)
+{
+    gnrc_netif_etx_update(IFACE, _addr[0], 2, 1, false);
+    TEST_ASSERT_EQUAL_INT(((GNRC_NETIF_ETX_INIT * ((1U << GNRC_NETIF_ETX_EWMA_SHIFT) - 1)) +
+                           (GNRC_NETIF_ETX_NOACK * GNRC_NETIF_ETX_DIVISOR)) >>
+                          GNRC_NETIF_ETX_EWMA_SHIFT,
+                          gnrc_netif_etx_get(IFACE, _addr[0], 2));
+    /* other neighbors and interfaces are not affected */
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT,
+                          gnrc_netif_etx_get(IFACE, _addr[1], 2));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT,
+                          gnrc_netif_etx_get(IFACE + 1, _addr[0], 2));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT,
+                          gnrc_netif_etx_get(IFACE, _addr[0], 1));
+}
+
+static void test_gnrc_netif_etx__replace_lru(void)
+{
+    for (unsigned i = 0; i < GNRC_NETIF_ETX_NUMOF; i++) {
+        gnrc_netif_etx_update(IFACE, _addr[i], 2, 1, false);
+    }
+    /* makes _addr[1] the least recently used */
+    gnrc_netif_etx_get(IFACE, _addr[0], 2);
+    gnrc_netif_etx_update(IFACE, _addr[GNRC_NETIF_ETX_NUMOF], 2, 1, false);
+    TEST_ASSERT(gnrc_netif_etx_get(IFACE, _addr[0], 2) != GNRC_NETIF_ETX_INIT);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT,
+                          gnrc_netif_etx_get(IFACE, _addr[1], 2));
+    TEST_ASSERT(gnrc_netif_etx_get(IFACE, _addr[GNRC_NETIF_ETX_NUMOF], 2) !=
+                GNRC_NETIF_ETX_INIT);
+}
+
+static void test_gnrc_netif_etx__reset(void)
+{
+    gnrc_netif_etx_update(IFACE, _addr[0], 2, 1, false);
+    gnrc_netif_etx_reset();
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT,
+                          gnrc_netif_etx_get(IFACE, _addr[0], 2));
+}
+
+Test *tests_gnrc_netif_etx_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_netif_etx__unknown),
+        new_TestFixture(test_gnrc_netif_etx__acked),
+        new_TestFixture(test_gnrc_netif_etx__noack),
+        new_TestFixture(test_gnrc_netif_etx__replace_lru),
+        new_TestFixture(test_gnrc_netif_etx__reset),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_netif_etx_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_netif_etx_tests;
+}
+
+void tests_gnrc_netif_etx(void)
+{
+    TESTS_RUN(tests_gnrc_netif_etx_tests());
+}
+/** @} */
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/icmpv6.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/dodag.h"
+#include "net/gnrc/rpl/ns.h"
+#include "net/gnrc/rpl/structs.h"
+#include "gnrc_rpl_internal/globals.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_rpl_ns.h"
+
+#define TEST_INSTANCE_ID    (TEST_UINT8)
+#define TEST_IFACE          (KERNEL_PID_LAST)
+#define TEST_LIFETIME       (1U)
+
+/* the root, a child of it and a grandchild */
+static ipv6_addr_t _root = { .u8 = {
+        0xfd, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 } };
+static ipv6_addr_t _child = { .u8 = {
+        0xfd, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02 } };
+static ipv6_addr_t _grandchild = { .u8 = {
+        0xfd, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x03 } };
+
+static gnrc_rpl_instance_t *_inst;
+static uint8_t _dao_buf[128];
+static unsigned _dao_len;
+
+static void set_up(void)
+{
+    evtimer_init_msg(&gnrc_rpl_evtimer);
+    gnrc_rpl_instance_add(TEST_INSTANCE_ID, &_inst);
+    _inst->mop = GNRC_RPL_MOP_NON_STORING_MODE;
+    gnrc_rpl_dodag_init(_inst, &_root, TEST_IFACE);
+    _inst->dodag.node_status = GNRC_RPL_ROOT_NODE;
+
+    memset(_dao_buf, 0, sizeof(_dao_buf));
+    gnrc_rpl_dao_t *dao = (gnrc_rpl_dao_t *)_dao_buf;
+    dao->instance_id = TEST_INSTANCE_ID;
+    _dao_len = sizeof(gnrc_rpl_dao_t);
+}
+
+static void tear_down(void)
+{
+    /* also flushes the graph and stops the DAO timer */
+    gnrc_rpl_instance_remove(_inst);
+}
+
+static void _add_target(const ipv6_addr_t *target)
+{
+    gnrc_rpl_opt_target_t *opt = (gnrc_rpl_opt_target_t *)&_dao_buf[_dao_len];
+
+    opt->type = GNRC_RPL_OPT_TARGET;
+    opt->length = GNRC_RPL_OPT_TARGET_LEN;
+    opt->prefix_length = IPV6_ADDR_BIT_LEN;
+    opt->target = *target;
+    _dao_len += sizeof(*opt);
+}
+
+/* adds a transit option, which has no parent address if cut is true */
+static void _add_transit(const ipv6_addr_t *parent, bool cut)
+{
+    gnrc_rpl_opt_transit_t *opt = (gnrc_rpl_opt_transit_t *)&_dao_buf[_dao_len];
+
+    opt->type = GNRC_RPL_OPT_TRANSIT;
+    opt->length = GNRC_RPL_OPT_TRANSIT_INFO_LEN;
+    opt->path_lifetime = TEST_LIFETIME;
+    _dao_len += sizeof(*opt);
+    /* a cut option is followed by the parent address nonetheless, so reading
+     * past the option is noticed */
+    memcpy(&_dao_buf[_dao_len], parent, sizeof(ipv6_addr_t));
+    if (!cut) {
+        opt->length += sizeof(ipv6_addr_t);
+        _dao_len += sizeof(ipv6_addr_t);
+    }
+}
+
+static void _recv_dao(void)
+{
+    gnrc_rpl_recv_DAO((gnrc_rpl_dao_t *)_dao_buf, TEST_IFACE, &_child, &_root,
+                      sizeof(icmpv6_hdr_t) + _dao_len);
+}
+
+static int _get_route(const ipv6_addr_t *dst)
+{
+    ipv6_addr_t hops[GNRC_RPL_NS_MAX_HOPS];
+    kernel_pid_t iface;
+
+    return gnrc_rpl_ns_get_route(dst, hops, GNRC_RPL_NS_MAX_HOPS, &iface);
+}
+
+static void test_gnrc_rpl_ns__dao(void)
+{
+    _add_target(&_child);
+    _add_transit(&_root, false);
+    _add_target(&_grandchild);
+    _add_transit(&_child, false);
+    _recv_dao();
+    TEST_ASSERT_EQUAL_INT(0, _get_route(&_child));
+    TEST_ASSERT_EQUAL_INT(1, _get_route(&_grandchild));
+}
+
+static void test_gnrc_rpl_ns__dao_transit_without_parent(void)
+{
+    _add_target(&_child);
+    _add_transit(&_root, true);
+    _recv_dao();
+    TEST_ASSERT_EQUAL_INT(-ENOENT, _get_route(&_child));
+}
+
+static void test_gnrc_rpl_ns__dao_transit_without_parent_first(void)
+{
+    _add_target(&_grandchild);
+    _add_transit(&_root, true);
+    _add_target(&_child);
+    _add_transit(&_root, false);
+    _recv_dao();
+    /* only the broken option is dropped, not the whole DAO */
+    TEST_ASSERT_EQUAL_INT(-ENOENT, _get_route(&_grandchild));
+    TEST_ASSERT_EQUAL_INT(0, _get_route(&_child));
+}
+
+Test *tests_gnrc_rpl_ns_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_rpl_ns__dao),
+        new_TestFixture(test_gnrc_rpl_ns__dao_transit_without_parent),
+        new_TestFixture(test_gnrc_rpl_ns__dao_transit_without_parent_first),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_rpl_ns_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_rpl_ns_tests;
+}
+
+void tests_gnrc_rpl_ns(void)
+{
+    TESTS_RUN(tests_gnrc_rpl_ns_tests());
+}
+/** @} */
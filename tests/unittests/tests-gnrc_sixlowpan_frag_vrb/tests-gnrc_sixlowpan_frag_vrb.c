@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "xtimer.h"
+
+#include "tests-gnrc_sixlowpan_frag_vrb.h"
+
+#define TEST_SRC            { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 }
+#define TEST_OUT_DST        { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 }
+#define TEST_DATAGRAM_SIZE  (1232U)
+#define TEST_TAG            (0x2345U)
+
+static const uint8_t _src[] = TEST_SRC;
+static const uint8_t _out_dst[] = TEST_OUT_DST;
+static gnrc_netif_t _netif;
+static gnrc_pktsnip_t _pkt = { .size = TEST_DATAGRAM_SIZE };
+static gnrc_sixlowpan_rbuf_t _rbuf = {
+    .pkt = &_pkt,
+    .src = TEST_SRC,
+    .src_len = sizeof(_src),
+    .tag = TEST_TAG,
+};
+
+static void set_up(void)
+{
+    gnrc_sixlowpan_frag_vrb_reset();
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_add(void)
+{
+    return gnrc_sixlowpan_frag_vrb_add(&_rbuf, &_netif, _out_dst,
+                                       sizeof(_out_dst));
+}
+
+static void test_vrb_add__success(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrb = _add();
+
+    TEST_ASSERT_NOT_NULL(vrb);
+    TEST_ASSERT(vrb->out_netif == &_netif);
+    TEST_ASSERT_EQUAL_INT(sizeof(_src), vrb->src_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_src, vrb->src, sizeof(_src)));
+    TEST_ASSERT_EQUAL_INT(sizeof(_out_dst), vrb->out_dst_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_out_dst, vrb->out_dst, sizeof(_out_dst)));
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, vrb->datagram_size);
+    TEST_ASSERT_EQUAL_INT(TEST_TAG, vrb->tag);
+    TEST_ASSERT_EQUAL_INT(0, vrb->current_size);
+}
+
+static void test_vrb_add__full(void)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        _rbuf.tag = TEST_TAG + i;
+        TEST_ASSERT_NOT_NULL(_add());
+    }
+    _rbuf.tag = TEST_TAG;
+    TEST_ASSERT_NULL(_add());
+}
+
+static void test_vrb_get__success(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrb = _add();
+
+    TEST_ASSERT(vrb == gnrc_sixlowpan_frag_vrb_get(_src, sizeof(_src),
+                                                   TEST_DATAGRAM_SIZE,
+                                                   TEST_TAG));
+}
+
+static void test_vrb_get__no_match(void)
+{
+    TEST_ASSERT_NOT_NULL(_add());
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_src, sizeof(_src),
+                                                 TEST_DATAGRAM_SIZE,
+                                                 TEST_TAG + 1));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_src, sizeof(_src),
+                                                 TEST_DATAGRAM_SIZE - 8,
+                                                 TEST_TAG));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_src, 2, TEST_DATAGRAM_SIZE,
+                                                 TEST_TAG));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_out_dst, sizeof(_out_dst),
+                                                 TEST_DATAGRAM_SIZE,
+                                                 TEST_TAG));
+}
+
+static void test_vrb_rm(void)
+{
+    gnrc_sixlowpan_frag_vrb_rm(_add());
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_src, sizeof(_src),
+                                                 TEST_DATAGRAM_SIZE,
+                                                 TEST_TAG));
+}
+
+static void test_vrb_gc(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *old = _add();
+    gnrc_sixlowpan_frag_vrb_t *vrb;
+
+    _rbuf.tag = TEST_TAG + 1;
+    vrb = _add();
+    _rbuf.tag = TEST_TAG;
+    TEST_ASSERT_NOT_NULL(old);
+    TEST_ASSERT_NOT_NULL(vrb);
+    old->arrival = xtimer_now_usec() - GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT - 1;
+    gnrc_sixlowpan_frag_vrb_gc();
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_src, sizeof(_src),
+                                                 TEST_DATAGRAM_SIZE,
+                                                 TEST_TAG));
+    TEST_ASSERT(vrb == gnrc_sixlowpan_frag_vrb_get(_src, sizeof(_src),
+                                                   TEST_DATAGRAM_SIZE,
+                                                   TEST_TAG + 1));
+}
+
+static void test_vrb_received__in_order(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrb = _add();
+
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 0, 96));
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 96, 96));
+    TEST_ASSERT_EQUAL_INT(192, vrb->current_size);
+    TEST_ASSERT_EQUAL_INT(1, vrb->ints_num);
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 192,
+                                                 TEST_DATAGRAM_SIZE - 192));
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, vrb->current_size);
+}
+
+static void test_vrb_received__duplicate(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrb = _add();
+
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 0, 96));
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 96, 96));
+    TEST_ASSERT(!gnrc_sixlowpan_frag_vrb_received(vrb, 96, 96));
+    TEST_ASSERT(!gnrc_sixlowpan_frag_vrb_received(vrb, 0, 96));
+    TEST_ASSERT(!gnrc_sixlowpan_frag_vrb_received(vrb, 40, 80));
+    TEST_ASSERT_EQUAL_INT(192, vrb->current_size);
+}
+
+static void test_vrb_received__out_of_order(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrb = _add();
+
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 0, 96));
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 384, 96));
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 192, 96));
+    TEST_ASSERT_EQUAL_INT(3, vrb->ints_num);
+    TEST_ASSERT(!gnrc_sixlowpan_frag_vrb_received(vrb, 384, 96));
+    TEST_ASSERT_EQUAL_INT(288, vrb->current_size);
+    /* fills the gaps, partly overlapping what was received before */
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 64, 160));
+    TEST_ASSERT_EQUAL_INT(2, vrb->ints_num);
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 288, 96));
+    TEST_ASSERT_EQUAL_INT(1, vrb->ints_num);
+    TEST_ASSERT_EQUAL_INT(480, vrb->current_size);
+    TEST_ASSERT_EQUAL_INT(0, vrb->ints[0].start);
+    TEST_ASSERT_EQUAL_INT(479, vrb->ints[0].end);
+}
+
+static void test_vrb_received__too_many_gaps(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrb = _add();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_INTS; i++) {
+        TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, i * 192, 96));
+    }
+    /* still forwarded, but not counted */
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_received(vrb, 1128, 96));
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_FRAG_VRB_INTS * 96,
+                          vrb->current_size);
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_FRAG_VRB_INTS, vrb->ints_num);
+}
+
+Test *tests_gnrc_sixlowpan_frag_vrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_vrb_add__success),
+        new_TestFixture(test_vrb_add__full),
+        new_TestFixture(test_vrb_get__success),
+        new_TestFixture(test_vrb_get__no_match),
+        new_TestFixture(test_vrb_rm),
+        new_TestFixture(test_vrb_gc),
+        new_TestFixture(test_vrb_received__in_order),
+        new_TestFixture(test_vrb_received__duplicate),
+        new_TestFixture(test_vrb_received__out_of_order),
+        new_TestFixture(test_vrb_received__too_many_gaps),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_sixlowpan_frag_vrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_sixlowpan_frag_vrb_tests;
+}
+
+void tests_gnrc_sixlowpan_frag_vrb(void)
+{
+    TESTS_RUN(tests_gnrc_sixlowpan_frag_vrb_tests());
+}
+/** @} */
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "thread.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/addr.h"
+
+#include "internal/common.h"
+#include "internal/cc.h"
+#include "internal/fsm.h"
+#include "internal/pkt.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define SMSS        (100U)
+#define ISS         (1000U)
+#define SEGMENTS    (GNRC_TCP_SND_SEGMENTS)
+
+static gnrc_tcp_tcb_t _tcb;
+static uint8_t _payload[SMSS];
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static gnrc_pktsnip_t *_sent[SEGMENTS];
+static unsigned _sent_num;
+
+/* stands in for the TCP thread and records the segments passed down */
+static void *_eventloop(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    while (1) {
+        msg_receive(&msg);
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_SND) {
+            continue;
+        }
+        if (_sent_num < ARRAY_SIZE(_sent)) {
+            _sent[_sent_num] = msg.content.ptr;
+        }
+        _sent_num++;
+        gnrc_pktbuf_release(msg.content.ptr);
+    }
+    return NULL;
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_tcp_tcb_init(&_tcb);
+    ipv6_addr_from_str((ipv6_addr_t *)_tcb.local_addr, "fe80::1");
+    ipv6_addr_from_str((ipv6_addr_t *)_tcb.peer_addr, "fe80::2");
+    _tcb.local_port = 8080;
+    _tcb.peer_port = 8081;
+    _tcb.state = FSM_STATE_ESTABLISHED;
+    _tcb.mss = SMSS;
+    _tcb.iss = ISS;
+    _tcb.snd_una = ISS;
+    _tcb.snd_nxt = ISS;
+    _tcb.snd_wnd = UINT16_MAX;
+    _tcb.rcv_nxt = 1;
+    _tcb.rcv_wnd = UINT16_MAX;
+    _cc_init(&_tcb);
+    _sent_num = 0;
+}
+
+static void tear_down(void)
+{
+    _fsm(&_tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/* sends SEGMENTS full segments, as gnrc_tcp_send() does */
+static void _send_segments(void)
+{
+    for (unsigned i = 0; i < SEGMENTS; i++) {
+        gnrc_pktsnip_t *pkt;
+        uint16_t seq_con;
+
+        TEST_ASSERT_EQUAL_INT(0, _pkt_build(&_tcb, &pkt, &seq_con, MSK_ACK,
+                                            _tcb.snd_nxt, _tcb.rcv_nxt,
+                                            _payload, SMSS));
+        TEST_ASSERT_EQUAL_INT(0, _pkt_setup_retransmit(&_tcb, pkt, false));
+        _pkt_send(&_tcb, pkt, seq_con, false);
+    }
+    TEST_ASSERT_EQUAL_INT(SEGMENTS, _sent_num);
+    TEST_ASSERT_EQUAL_INT(ISS + SEGMENTS * SMSS, _tcb.snd_nxt);
+    _sent_num = 0;
+}
+
+static void _ack(uint32_t ack)
+{
+    uint32_t acked = ack - _tcb.snd_una;
+
+    _tcb.snd_una = ack;
+    _pkt_acknowledge(&_tcb, ack);
+    _cc_ack(&_tcb, acked);
+}
+
+static void test_gnrc_tcp_cc__fast_retransmit(void)
+{
+    gnrc_pktsnip_t *oldest;
+
+    _send_segments();
+    oldest = _tcb.pkt_retransmit[0];
+    for (unsigned i = 1; i < GNRC_TCP_DUPACK_THRESHOLD; i++) {
+        _cc_dupack(&_tcb);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _sent_num);
+    _cc_dupack(&_tcb);
+    TEST_ASSERT_EQUAL_INT(1, _sent_num);
+    TEST_ASSERT(_sent[0] == oldest);
+    TEST_ASSERT(_tcb.status & STATUS_FAST_RECOVERY);
+    TEST_ASSERT_EQUAL_INT(SEGMENTS * SMSS / 2, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(_tcb.ssthresh + GNRC_TCP_DUPACK_THRESHOLD * SMSS,
+                          _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(1, _tcb.cnt_fast_retransmits);
+    TEST_ASSERT_EQUAL_INT(1, _tcb.cnt_retransmits);
+    /* only timeouts count as retries */
+    TEST_ASSERT_EQUAL_INT(0, _tcb.retries);
+
+    /* further duplicate ACKs inflate the window, but send nothing */
+    _cc_dupack(&_tcb);
+    TEST_ASSERT_EQUAL_INT(1, _sent_num);
+    TEST_ASSERT_EQUAL_INT(_tcb.ssthresh + (GNRC_TCP_DUPACK_THRESHOLD + 1) * SMSS,
+                          _tcb.cwnd);
+}
+
+static void test_gnrc_tcp_cc__partial_ack(void)
+{
+    _send_segments();
+    for (unsigned i = 0; i < GNRC_TCP_DUPACK_THRESHOLD; i++) {
+        _cc_dupack(&_tcb);
+    }
+    _sent_num = 0;
+
+    /* the second segment was lost as well: retransmit it at once */
+    _ack(ISS + SMSS);
+    TEST_ASSERT_EQUAL_INT(1, _sent_num);
+    TEST_ASSERT(_sent[0] == _tcb.pkt_retransmit[0]);
+    TEST_ASSERT(_tcb.status & STATUS_FAST_RECOVERY);
+    TEST_ASSERT_EQUAL_INT(2, _tcb.cnt_retransmits);
+    TEST_ASSERT_EQUAL_INT(1, _tcb.cnt_fast_retransmits);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.retries);
+
+    /* all data sent before the loss is acknowledged: leave fast recovery */
+    _ack(_tcb.snd_nxt);
+    TEST_ASSERT_EQUAL_INT(1, _sent_num);
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+    TEST_ASSERT_EQUAL_INT(2 * SMSS, _tcb.cwnd);
+    TEST_ASSERT_NULL(_tcb.pkt_retransmit[0]);
+}
+
+static void test_gnrc_tcp_cc__timeout(void)
+{
+    gnrc_pktsnip_t *oldest;
+
+    _send_segments();
+    oldest = _tcb.pkt_retransmit[0];
+    /* a fast retransmit does not count as a retry of the timeout */
+    for (unsigned i = 0; i < GNRC_TCP_DUPACK_THRESHOLD; i++) {
+        _cc_dupack(&_tcb);
+    }
+    _tcb.ssthresh = UINT32_MAX;
+    _sent_num = 0;
+
+    _fsm(&_tcb, FSM_EVENT_TIMEOUT_RETRANSMIT, NULL, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(1, _sent_num);
+    TEST_ASSERT(_sent[0] == oldest);
+    TEST_ASSERT_EQUAL_INT(1, _tcb.retries);
+    TEST_ASSERT_EQUAL_INT(1, _tcb.cnt_timeouts);
+    TEST_ASSERT_EQUAL_INT(SEGMENTS * SMSS / 2, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(SMSS, _tcb.cwnd);
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+    TEST_ASSERT(_tcb.status & STATUS_LOSS_RECOVERY);
+
+    /* the same segment timing out again does not reduce ssthresh again */
+    _tcb.ssthresh = UINT32_MAX;
+    _fsm(&_tcb, FSM_EVENT_TIMEOUT_RETRANSMIT, NULL, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(2, _sent_num);
+    TEST_ASSERT_EQUAL_INT(2, _tcb.retries);
+    TEST_ASSERT(_tcb.ssthresh == UINT32_MAX);
+
+    /* duplicate ACKs after a timeout don't trigger a fast retransmit */
+    for (unsigned i = 0; i < GNRC_TCP_DUPACK_THRESHOLD; i++) {
+        _cc_dupack(&_tcb);
+    }
+    TEST_ASSERT_EQUAL_INT(2, _sent_num);
+
+    /* progress resets the retries and retransmits the next segment */
+    _ack(ISS + SMSS);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.retries);
+    TEST_ASSERT_EQUAL_INT(3, _sent_num);
+    TEST_ASSERT(_sent[2] == _tcb.pkt_retransmit[0]);
+    TEST_ASSERT(_tcb.status & STATUS_LOSS_RECOVERY);
+}
+
+Test *tests_gnrc_tcp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_tcp_cc__fast_retransmit),
+        new_TestFixture(test_gnrc_tcp_cc__partial_ack),
+        new_TestFixture(test_gnrc_tcp_cc__timeout),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_tcp_tests;
+}
+
+void tests_gnrc_tcp(void)
+{
+    kernel_pid_t pid = gnrc_tcp_pid;
+
+    gnrc_tcp_pid = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                                 THREAD_CREATE_STACKTEST, _eventloop, NULL,
+                                 "tcp");
+    TESTS_RUN(tests_gnrc_tcp_tests());
+    gnrc_tcp_pid = pid;
+}
+/** @} */
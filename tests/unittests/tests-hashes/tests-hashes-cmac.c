@@ -86,6 +86,21 @@ static int calc_and_compare_hash(const uint8_t *hash, size_t size, const uint8_t
     return memcmp(digest, expected, 16);
 }
 
+static int calc_and_compare_hash_key(const cmac_key_t *key,
+                                     const uint8_t *hash, size_t size,
+                                     const uint8_t *expected)
+{
+    uint8_t digest[16];
+    cmac_context_t ctx;
+
+    /* in two pieces, the first one not of whole blocks */
+    cmac_init_key(&ctx, key);
+    cmac_update(&ctx, hash, size / 3);
+    cmac_update(&ctx, hash + size / 3, size - size / 3);
+    cmac_final(&ctx, digest);
+    return memcmp(digest, expected, 16);
+}
+
 static void test_hashes_cmac(void)
 {
     TEST_ASSERT_EQUAL_INT(calc_and_compare_hash(NULL, 0, TEST_EMPTY_EXP), 0);
@@ -94,18 +109,33 @@ static void test_hashes_cmac(void)
     TEST_ASSERT_EQUAL_INT(calc_and_compare_hash(TEST_3_INP, 64, TEST_3_EXP), 0);
 }
 
+static void test_hashes_cmac_key(void)
+{
+    cmac_key_t key;
+
+    /* the same key for all messages */
+    TEST_ASSERT_EQUAL_INT(cmac_key_init(&key, CMAC_KEY, 16), CIPHER_INIT_SUCCESS);
+    TEST_ASSERT_EQUAL_INT(calc_and_compare_hash_key(&key, NULL, 0, TEST_EMPTY_EXP), 0);
+    TEST_ASSERT_EQUAL_INT(calc_and_compare_hash_key(&key, TEST_1_INP, 16, TEST_1_EXP), 0);
+    TEST_ASSERT_EQUAL_INT(calc_and_compare_hash_key(&key, TEST_2_INP, 40, TEST_2_EXP), 0);
+    TEST_ASSERT_EQUAL_INT(calc_and_compare_hash_key(&key, TEST_3_INP, 64, TEST_3_EXP), 0);
+}
+
 static void test_hashes_cmac_keysize(void)
 {
     cmac_context_t ctx;
+    cmac_key_t key;
 
     TEST_ASSERT_EQUAL_INT(cmac_init(&ctx, CMAC_KEY, 15), CIPHER_ERR_INVALID_KEY_SIZE);
     TEST_ASSERT_EQUAL_INT(cmac_init(&ctx, CMAC_KEY, 16), CIPHER_INIT_SUCCESS);
+    TEST_ASSERT_EQUAL_INT(cmac_key_init(&key, CMAC_KEY, 15), CIPHER_ERR_INVALID_KEY_SIZE);
 }
 
 Test *tests_hashes_cmac_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_hashes_cmac),
+        new_TestFixture(test_hashes_cmac_key),
         new_TestFixture(test_hashes_cmac_keysize),
     };
 
@@ -328,6 +328,78 @@ static void test_hashes_hmac_sha256_ite_hash_PRF6_split(void)
                  "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2", hmac));
 }
 
+static void test_hashes_hmac_sha256_key_PRF5_PRF6(void)
+{
+    /* Test Cases PRF-5 and PRF-6 with one precomputed key */
+    hmac_sha256_key_t key;
+    hmac_context_t ctx;
+    const unsigned char strPRF5[] = "Test Using Larger Than Block-Size Key - Hash Key First";
+    const unsigned char strPRF6[] = "This is a test using a larger than block-size key and a "
+                           "larger than block-size data. The key needs to be hashed "
+                           "before being used by the HMAC algorithm.";
+    unsigned char longKey[131];
+    static unsigned char hmac[SHA256_DIGEST_LENGTH];
+    memset(longKey, 0xaa, sizeof(longKey));
+
+    hmac_sha256_key_init(&key, longKey, sizeof(longKey));
+
+    hmac_sha256_init_key(&ctx, &key);
+    hmac_sha256_update(&ctx, strPRF5, strlen((char*)strPRF5));
+    hmac_sha256_final(&ctx, hmac);
+
+    TEST_ASSERT(compare_str_vs_digest(
+                 "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54", hmac));
+
+    hmac_sha256_init_key(&ctx, &key);
+    hmac_sha256_update(&ctx, strPRF6, strlen((char*)strPRF6));
+    hmac_sha256_final(&ctx, hmac);
+
+    TEST_ASSERT(compare_str_vs_digest(
+                 "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2", hmac));
+}
+
+static void test_hashes_hmac_sha256_mb(void)
+{
+    /* more messages than lanes, around the boundaries of the padding */
+    static const size_t lengths[] = { 20, 0, 55, 56, 64, 119, 120, 9, 200 };
+    static unsigned char msg[200 + ARRAY_SIZE(lengths)];
+    static unsigned char keys[ARRAY_SIZE(lengths)][131];
+    static hmac_sha256_key_t key[ARRAY_SIZE(lengths)];
+    static unsigned char hmac[ARRAY_SIZE(lengths)][SHA256_DIGEST_LENGTH];
+    unsigned char expected[SHA256_DIGEST_LENGTH];
+    const void *k[ARRAY_SIZE(lengths)];
+    const void *data[ARRAY_SIZE(lengths)];
+    void *digest[ARRAY_SIZE(lengths)];
+
+    for (unsigned i = 0; i < sizeof(msg); i++) {
+        msg[i] = i * 7 + 3;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(lengths); i++) {
+        for (unsigned j = 0; j < sizeof(keys[i]); j++) {
+            keys[i][j] = i * 31 + j;
+        }
+        k[i] = keys[i];
+        data[i] = msg + i;
+        digest[i] = hmac[i];
+    }
+
+    /* keys of LoRaLAN, of a whole block and longer than a block */
+    static const size_t key_lengths[] = { 16, 64, 131 };
+    for (unsigned kl = 0; kl < ARRAY_SIZE(key_lengths); kl++) {
+        for (unsigned num = 1; num <= ARRAY_SIZE(lengths); num++) {
+            memset(hmac, 0, sizeof(hmac));
+            hmac_sha256_key_init_mb(key, k, key_lengths[kl], num);
+            hmac_sha256_mb(key, data, lengths, digest, num);
+            for (unsigned i = 0; i < num; i++) {
+                hmac_sha256(keys[i], key_lengths[kl], data[i], lengths[i],
+                            expected);
+                TEST_ASSERT_EQUAL_INT(0, memcmp(expected, hmac[i],
+                                                SHA256_DIGEST_LENGTH));
+            }
+        }
+    }
+}
+
 Test *tests_hashes_sha256_hmac_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -346,6 +418,8 @@ Test *tests_hashes_sha256_hmac_tests(void)
         new_TestFixture(test_hashes_hmac_sha256_ite_hash_PRF5),
         new_TestFixture(test_hashes_hmac_sha256_ite_hash_PRF6),
         new_TestFixture(test_hashes_hmac_sha256_ite_hash_PRF6_split),
+        new_TestFixture(test_hashes_hmac_sha256_key_PRF5_PRF6),
+        new_TestFixture(test_hashes_hmac_sha256_mb),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
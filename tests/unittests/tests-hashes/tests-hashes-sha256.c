@@ -28,6 +28,7 @@
 #include <stdlib.h>
 
 #include "embUnit/embUnit.h"
+#include "kernel_defines.h"
 
 #include "hashes/sha256.h"
 
@@ -212,6 +213,66 @@ static void test_hashes_sha256_hash_long_sequence(void)
                     hlong_sequence));
 }
 
+static void test_hashes_sha256_mb_known(void)
+{
+    static const char *const str[] = {
+        "1234567890_1", "1234567890_2", "1234567890_3", "1234567890_4",
+        "0123456789abcde-0123456789abcde-0123456789abcde-0123456789abcde-",
+        "Franz jagt im komplett verwahrlosten Taxi quer durch Bayern",
+        "",
+    };
+    static const unsigned char *const expected[] = {
+        h01, h02, h03, h04, hdigits_letters, hpangramm, hempty,
+    };
+    static unsigned char hash[ARRAY_SIZE(str)][SHA256_DIGEST_LENGTH];
+    const void *data[ARRAY_SIZE(str)];
+    size_t len[ARRAY_SIZE(str)];
+    void *digest[ARRAY_SIZE(str)];
+
+    for (unsigned i = 0; i < ARRAY_SIZE(str); i++) {
+        data[i] = str[i];
+        len[i] = strlen(str[i]);
+        digest[i] = hash[i];
+    }
+    sha256_mb(data, len, digest, ARRAY_SIZE(str));
+    for (unsigned i = 0; i < ARRAY_SIZE(str); i++) {
+        TEST_ASSERT_EQUAL_INT(0, memcmp(expected[i], hash[i],
+                                        SHA256_DIGEST_LENGTH));
+    }
+}
+
+static void test_hashes_sha256_mb_lengths(void)
+{
+    /* around the boundaries of the padding, more messages than lanes */
+    static const size_t lengths[] = {
+        300, 0, 1, 55, 56, 57, 63, 64, 65, 119, 120, 128, 200,
+    };
+    static unsigned char msg[300 + ARRAY_SIZE(lengths)];
+    static unsigned char hash[ARRAY_SIZE(lengths)][SHA256_DIGEST_LENGTH];
+    unsigned char expected[SHA256_DIGEST_LENGTH];
+    const void *data[ARRAY_SIZE(lengths)];
+    void *digest[ARRAY_SIZE(lengths)];
+
+    for (unsigned i = 0; i < sizeof(msg); i++) {
+        msg[i] = i * 7 + 3;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(lengths); i++) {
+        /* unaligned as well */
+        data[i] = msg + i;
+        digest[i] = hash[i];
+    }
+    /* every number of messages, down to a single one */
+    for (unsigned num = 1; num <= ARRAY_SIZE(lengths); num++) {
+        memset(hash, 0, sizeof(hash));
+        sha256_mb(data, lengths, digest, num);
+        for (unsigned i = 0; i < num; i++) {
+            sha256(data[i], lengths[i], expected);
+            TEST_ASSERT_EQUAL_INT(0, memcmp(expected, hash[i],
+                                            SHA256_DIGEST_LENGTH));
+        }
+    }
+}
+
 Test *tests_hashes_sha256_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -227,6 +288,8 @@ Test *tests_hashes_sha256_tests(void)
         new_TestFixture(test_hashes_sha256_hash_sequence_failing_compare),
 
         new_TestFixture(test_hashes_sha256_hash_long_sequence),
+        new_TestFixture(test_hashes_sha256_mb_known),
+        new_TestFixture(test_hashes_sha256_mb_lengths),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,68 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__unaligned(void)
+{
+    /* source: https://www.cloudshark.org/captures/ea72fbab241b (No. 1) */
+    static const uint8_t data[] = {
+        0xc0, 0xa8, 0x01, 0x91, 0x4b, 0x4b, 0x4b, 0x4b, /* IPv4 source + dest*/
+        0xf6, 0xfb, 0x00, 0x35, 0x00, 0x27, 0xd1, 0xa2, /* UDP header */
+        0xa5, 0x6f, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, /* DNS payload */
+        0x00, 0x00, 0x00, 0x00, 0x09, 0x74, 0x65, 0x73,
+        0x74, 0x2d, 0x69, 0x70, 0x76, 0x36, 0x03, 0x63,
+        0x6f, 0x6d, 0x00, 0x00, 0x01, 0x00, 0x01,
+    };
+    uint32_t buf[(sizeof(data) + 4) / sizeof(uint32_t) + 1];
+
+    /* the result must not depend on the alignment of the buffer */
+    for (unsigned i = 0; i < 4; i++) {
+        uint8_t *start = ((uint8_t *)buf) + i;
+
+        memcpy(start, data, sizeof(data));
+        TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(17 + 39, start, sizeof(data)));
+        /* same for an odd number of bytes accumulated before */
+        TEST_ASSERT_EQUAL_INT(0xffff,
+                              inet_csum_slice(inet_csum(17 + 39, start, 9),
+                                              start + 9, sizeof(data) - 9, 9));
+    }
+}
+
+static void test_inet_csum__update_rfc_example(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1624#section-4 */
+    TEST_ASSERT_EQUAL_INT(0x0000, inet_csum_update(0xdd2f, 0x5555, 0x3285));
+}
+
+static void test_inet_csum__update_ttl(void)
+{
+    /* IPv4 header from test_inet_csum__calculate_csum with checksum 0xb861;
+     * decrement TTL (0x40) to 0x3f */
+    TEST_ASSERT_EQUAL_INT(0xb961, inet_csum_update(0xb861, 0x4011, 0x3f11));
+}
+
+static void test_inet_csum__update_buf(void)
+{
+    uint8_t data[] = {
+        0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+        0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01,
+        0xc0, 0xa8, 0x00, 0xc7,
+    };
+    uint8_t ttl = 0x3f, prot = 0x06;
+
+    /* even offset: TTL is the top half of its 16-bit word */
+    TEST_ASSERT_EQUAL_INT(0xb961, inet_csum_update_buf(0xb861, &data[8], &ttl,
+                                                       sizeof(ttl), 8));
+    /* odd offset: protocol is the bottom half of its 16-bit word */
+    TEST_ASSERT_EQUAL_INT(0xb86c, inet_csum_update_buf(0xb861, &data[9], &prot,
+                                                       sizeof(prot), 9));
+    data[8] = ttl;
+    data[9] = prot;
+    TEST_ASSERT_EQUAL_INT((uint16_t)~0xb96c, inet_csum(0, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0xb96c, inet_csum_update_buf(0xb861,
+                                                       (uint8_t[]){ 0x40, 0x11 },
+                                                       &data[8], 2, 8));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +239,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__unaligned),
+        new_TestFixture(test_inet_csum__update_rfc_example),
+        new_TestFixture(test_inet_csum__update_ttl),
+        new_TestFixture(test_inet_csum__update_buf),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
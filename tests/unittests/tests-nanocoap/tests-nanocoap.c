@@ -131,6 +131,57 @@ static void test_nanocoap__put_req(void)
     TEST_ASSERT_EQUAL_INT(&buf[0] + _BUF_SIZE - pkt.payload, pkt.payload_len);
 }
 
+/*
+ * Builds on get_req test, to test reading options from a parsed request.
+ */
+static void test_nanocoap__get_opts(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    uint16_t msgid = 0xABCD;
+    uint8_t token[2] = {0xDA, 0xEC};
+    char path[] = "/riot/value";
+    uint8_t *value;
+    uint32_t blknum;
+    unsigned szx;
+
+    size_t len = coap_build_hdr((coap_hdr_t *)&buf[0], COAP_TYPE_NON,
+                                &token[0], 2, COAP_METHOD_GET, msgid);
+    coap_pkt_init(&pkt, &buf[0], sizeof(buf), len);
+    coap_opt_add_uint(&pkt, COAP_OPT_OBSERVE, 0);
+    coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, &path[0], '/');
+    coap_opt_add_uint(&pkt, COAP_OPT_ACCEPT, COAP_FORMAT_CBOR);
+    coap_opt_add_uint(&pkt, COAP_OPT_BLOCK2, (5 << 4) | 2);
+    len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, &buf[0], len));
+    /* Uri-Path is indexed once */
+    TEST_ASSERT_EQUAL_INT(4, pkt.options_len);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_opt_get_opaque(&pkt, COAP_OPT_OBSERVE,
+                                                 &value));
+    TEST_ASSERT_EQUAL_INT(4, coap_opt_get_opaque(&pkt, COAP_OPT_URI_PATH,
+                                                 &value));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(value, "riot", 4));
+    TEST_ASSERT_EQUAL_INT(1, coap_opt_get_opaque(&pkt, COAP_OPT_ACCEPT,
+                                                 &value));
+    TEST_ASSERT_EQUAL_INT(COAP_FORMAT_CBOR, *value);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_opt_get_opaque(&pkt, COAP_OPT_ETAG,
+                                                       &value));
+    TEST_ASSERT_EQUAL_INT(COAP_FORMAT_NONE, coap_get_content_type(&pkt));
+
+    TEST_ASSERT_EQUAL_INT(0, coap_get_blockopt(&pkt, COAP_OPT_BLOCK2,
+                                               &blknum, &szx));
+    TEST_ASSERT_EQUAL_INT(5, blknum);
+    TEST_ASSERT_EQUAL_INT(2, szx);
+    TEST_ASSERT_EQUAL_INT(-1, coap_get_blockopt(&pkt, COAP_OPT_BLOCK1,
+                                                &blknum, &szx));
+
+    char uri[sizeof(path)] = {0};
+    coap_get_uri_path(&pkt, (uint8_t *)&uri[0]);
+    TEST_ASSERT_EQUAL_STRING((char *)path, (char *)uri);
+}
+
 /*
  * Builds on get_req test, to test path with multiple segments.
  */
@@ -547,6 +598,7 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__hdr),
         new_TestFixture(test_nanocoap__get_req),
         new_TestFixture(test_nanocoap__put_req),
+        new_TestFixture(test_nanocoap__get_opts),
         new_TestFixture(test_nanocoap__get_multi_path),
         new_TestFixture(test_nanocoap__get_path_trailing_slash),
         new_TestFixture(test_nanocoap__get_root_path),